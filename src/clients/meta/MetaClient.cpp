@@ -1215,7 +1215,7 @@ void MetaClient::loadRemoteListeners() {
 
 /// ================================== public methods =================================
 
-PartitionID MetaClient::partId(int32_t numParts, const VertexID id) const {
+PartitionID MetaClient::partId(int32_t numParts, const VertexID id) {
   memory::MemoryCheckOffGuard g;
   // If the length of the id is 8, we will treat it as int64_t to be compatible
   // with the version 1.0
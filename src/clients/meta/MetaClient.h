@@ -548,7 +548,7 @@ class MetaClient : public BaseMetaClient {
 
   StatusOr<int32_t> partsNum(GraphSpaceID spaceId);
 
-  PartitionID partId(int32_t numParts, VertexID id) const;
+  static PartitionID partId(int32_t numParts, VertexID id);
 
   StatusOr<std::shared_ptr<const NebulaSchemaProvider>> getTagSchemaFromCache(GraphSpaceID spaceId,
                                                                               TagID tagID,
@@ -0,0 +1,96 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef CLIENTS_STORAGE_RPCCOALESCER_H_
+#define CLIENTS_STORAGE_RPCCOALESCER_H_
+
+#include <folly/Synchronized.h>
+#include <folly/futures/Future.h>
+#include <folly/futures/SharedPromise.h>
+
+#include "common/base/Base.h"
+#include "common/time/WallClock.h"
+
+namespace nebula {
+namespace storage {
+
+/**
+ * @brief RpcCoalescer shares one call in flight among the identical calls issued shortly after it.
+ *
+ * The calls are identified by a key given by the caller, which is usually the host and the
+ * encoded request. A call joins the one in flight of the same key if it's sent no more than the
+ * window ago, and gets a copy of its result, otherwise it's sent by itself. So only the read
+ * requests could be coalesced, and a joined call may not see a write finished after the shared
+ * one was sent, which is bounded by the window.
+ */
+template <class T>
+class RpcCoalescer final {
+ public:
+  /**
+   * @brief Get the result of the call of the key
+   *
+   * @param key Identity of the call
+   * @param windowUs How long a call in flight could be joined after it's sent
+   * @param send Send the call if there is none to join, returns folly::Future<T>
+   * @param joined Set to whether the call in flight is joined, could be null
+   * @return folly::Future<T>
+   */
+  template <class SendFunc>
+  folly::Future<T> call(const std::string& key,
+                        int64_t windowUs,
+                        SendFunc&& send,
+                        bool* joined = nullptr) {
+    auto now = time::WallClock::fastNowInMicroSec();
+    std::shared_ptr<Call> call;
+    {
+      auto calls = calls_.wlock();
+      auto it = calls->find(key);
+      if (it != calls->end() && now - it->second->sentAt <= windowUs) {
+        if (joined != nullptr) {
+          *joined = true;
+        }
+        return it->second->promise.getFuture();
+      }
+      // Replace the one too old to join, it's still alive for its own callers
+      call = std::make_shared<Call>();
+      call->sentAt = now;
+      (*calls)[key] = call;
+    }
+    if (joined != nullptr) {
+      *joined = false;
+    }
+
+    auto future = call->promise.getFuture();
+    folly::makeFutureWith(std::forward<SendFunc>(send))
+        .thenTry([this, key, call](folly::Try<T>&& result) {
+          {
+            auto calls = calls_.wlock();
+            auto it = calls->find(key);
+            if (it != calls->end() && it->second == call) {
+              calls->erase(it);
+            }
+          }
+          call->promise.setTry(std::move(result));
+        });
+    return future;
+  }
+
+  // Number of the calls in flight which could be joined or not
+  size_t size() const {
+    return calls_.rlock()->size();
+  }
+
+ private:
+  struct Call {
+    folly::SharedPromise<T> promise;
+    int64_t sentAt{0};
+  };
+
+  folly::Synchronized<std::unordered_map<std::string, std::shared_ptr<Call>>> calls_;
+};
+
+}  // namespace storage
+}  // namespace nebula
+#endif  // CLIENTS_STORAGE_RPCCOALESCER_H_
@@ -7,6 +7,11 @@
 
 #include "common/base/Base.h"
 
+DEFINE_bool(storage_client_snapshot_read,
+            false,
+            "whether each query reads from the snapshots of storaged taken at its first read, so "
+            "that all steps of it see the same data of the parts on a storaged");
+
 using nebula::cpp2::PropertyType;
 using nebula::storage::cpp2::ExecResponse;
 using nebula::storage::cpp2::GetDstBySrcResponse;
@@ -37,6 +42,14 @@ cpp2::RequestCommon StorageClient::CommonRequestParam::toReqCommon() const {
   return common;
 }
 
+cpp2::RequestCommon StorageClient::CommonRequestParam::toReadReqCommon() const {
+  auto common = toReqCommon();
+  if (FLAGS_storage_client_snapshot_read) {
+    common.snapshot_read_ref() = true;
+  }
+  return common;
+}
+
 StorageRpcRespFuture<cpp2::GetNeighborsResponse> StorageClient::getNeighbors(
     const CommonRequestParam& param,
     std::vector<std::string> colNames,
@@ -65,7 +78,7 @@ StorageRpcRespFuture<cpp2::GetNeighborsResponse> StorageClient::getNeighbors(
   }
 
   auto& clusters = status.value();
-  auto common = param.toReqCommon();
+  auto common = param.toReadReqCommon();
   std::unordered_map<HostAddr, cpp2::GetNeighborsRequest> requests;
   for (auto& c : clusters) {
     auto& host = c.first;
@@ -104,11 +117,13 @@ StorageRpcRespFuture<cpp2::GetNeighborsResponse> StorageClient::getNeighbors(
     req.traverse_spec_ref() = std::move(spec);
   }
 
-  return collectResponse(param.evb,
-                         std::move(requests),
-                         [](ThriftClientType* client, const cpp2::GetNeighborsRequest& r) {
-                           return client->future_getNeighbors(r);
-                         });
+  return collectResponse(
+      param.evb,
+      std::move(requests),
+      [](ThriftClientType* client, const cpp2::GetNeighborsRequest& r) {
+        return client->future_getNeighbors(r);
+      },
+      param.onNeighborsArrival);
 }
 
 StorageRpcRespFuture<cpp2::GetDstBySrcResponse> StorageClient::getDstBySrc(
@@ -128,7 +143,7 @@ StorageRpcRespFuture<cpp2::GetDstBySrcResponse> StorageClient::getDstBySrc(
   }
 
   auto& clusters = status.value();
-  auto common = param.toReqCommon();
+  auto common = param.toReadReqCommon();
   std::unordered_map<HostAddr, cpp2::GetDstBySrcRequest> requests;
   for (auto& c : clusters) {
     auto& host = c.first;
@@ -248,7 +263,7 @@ StorageRpcRespFuture<cpp2::GetPropResponse> StorageClient::getProps(
 
   auto& clusters = status.value();
   std::unordered_map<HostAddr, cpp2::GetPropRequest> requests;
-  auto common = param.toReqCommon();
+  auto common = param.toReadReqCommon();
   for (auto& c : clusters) {
     auto& host = c.first;
     auto& req = requests[host];
@@ -533,7 +548,7 @@ StorageRpcRespFuture<cpp2::LookupIndexResp> StorageClient::lookupIndex(
 
   auto& clusters = status.value();
   std::unordered_map<HostAddr, cpp2::LookupIndexRequest> requests;
-  auto common = param.toReqCommon();
+  auto common = param.toReadReqCommon();
   for (auto& c : clusters) {
     auto& host = c.first;
     auto& req = requests[host];
@@ -568,7 +583,7 @@ StorageRpcRespFuture<cpp2::GetNeighborsResponse> StorageClient::lookupAndTravers
 
   auto& clusters = status.value();
   std::unordered_map<HostAddr, cpp2::LookupAndTraverseRequest> requests;
-  auto common = param.toReqCommon();
+  auto common = param.toReadReqCommon();
   for (auto& c : clusters) {
     auto& host = c.first;
     auto& req = requests[host];
@@ -608,7 +623,7 @@ StorageRpcRespFuture<cpp2::ScanResponse> StorageClient::scanEdge(
     if (filter != nullptr) {
       req.filter_ref() = filter->encode();
     }
-    req.common_ref() = param.toReqCommon();
+    req.common_ref() = param.toReadReqCommon();
   }
 
   return collectResponse(
@@ -639,7 +654,7 @@ StorageRpcRespFuture<cpp2::ScanResponse> StorageClient::scanVertex(
     if (filter != nullptr) {
       req.filter_ref() = filter->encode();
     }
-    req.common_ref() = param.toReqCommon();
+    req.common_ref() = param.toReadReqCommon();
   }
 
   return collectResponse(param.evb,
@@ -725,6 +740,29 @@ folly::SemiFuture<StorageRpcResponse<cpp2::ExecResponse>> StorageClient::remove(
       });
 }
 
+StorageRpcRespFuture<cpp2::ExecResponse> StorageClient::releaseReadSnapshots(
+    SessionID session, ExecutionPlanID plan, folly::EventBase* evb) {
+  auto hosts = takeSnapshotReadHosts(session, plan);
+  if (hosts.empty()) {
+    return folly::makeSemiFuture(StorageRpcResponse<cpp2::ExecResponse>(0));
+  }
+
+  std::unordered_map<HostAddr, cpp2::ReleaseReadSnapshotsRequest> requests;
+  for (auto& host : hosts) {
+    auto& req = requests[host.first];
+    req.space_id_ref() = host.second;
+    req.session_id_ref() = session;
+    req.plan_id_ref() = plan;
+  }
+
+  return collectResponse(
+      evb,
+      std::move(requests),
+      [](ThriftClientType* client, const cpp2::ReleaseReadSnapshotsRequest& r) {
+        return client->future_releaseReadSnapshots(r);
+      });
+}
+
 StatusOr<std::function<const VertexID&(const Row&)>> StorageClient::getIdFromRow(
     GraphSpaceID space, bool isEdgeProps) const {
   auto vidTypeStatus = metaClient_->getSpaceVidType(space);
@@ -46,6 +46,9 @@ class StorageClient
     bool profile{false};
     bool useExperimentalFeature{false};
     folly::EventBase* evb{nullptr};
+    // Called with the response of each host of getNeighbors once it arrives, see
+    // StorageClientBase::collectResponse
+    ResponseHook<cpp2::GetNeighborsResponse> onNeighborsArrival;
 
     CommonRequestParam(GraphSpaceID space_,
                        SessionID sess,
@@ -55,6 +58,10 @@ class StorageClient
                        folly::EventBase* evb_ = nullptr);
 
     cpp2::RequestCommon toReqCommon() const;
+
+    // The common of the read requests, which ask for snapshot reads by
+    // --storage_client_snapshot_read. The mutations always write the latest data.
+    cpp2::RequestCommon toReadReqCommon() const;
   };
 
   StorageClient(std::shared_ptr<folly::IOThreadPoolExecutor> ioThreadPool,
@@ -176,6 +183,11 @@ class StorageClient
                                                                    std::vector<std::string> keys,
                                                                    folly::EventBase* evb = nullptr);
 
+  // Release the read snapshots of the plan on the hosts which have served its snapshot reads
+  StorageRpcRespFuture<cpp2::ExecResponse> releaseReadSnapshots(SessionID session,
+                                                                ExecutionPlanID plan,
+                                                                folly::EventBase* evb = nullptr);
+
  private:
   StatusOr<std::function<const VertexID&(const Row&)>> getIdFromRow(GraphSpaceID space,
                                                                     bool isEdgeProps) const;
@@ -7,12 +7,15 @@
 #define CLIENTS_STORAGE_STORAGECLIENTBASE_INL_H
 
 #include <folly/ExceptionWrapper.h>
+#include <folly/Random.h>
 #include <folly/Try.h>
 #include <folly/futures/Future.h>
+#include <thrift/lib/cpp2/protocol/Serializer.h>
 
 #include <optional>
 #include <unordered_map>
 
+#include "clients/storage/RpcCoalescer.h"
 #include "clients/storage/stats/StorageClientStats.h"
 #include "common/base/Logging.h"
 #include "common/base/StatusOr.h"
@@ -20,6 +23,8 @@
 #include "common/memory/MemoryTracker.h"
 #include "common/ssl/SSLConfig.h"
 #include "common/stats/StatsManager.h"
+#include "common/thrift/ThriftCompression.h"
+#include "common/thrift/ThriftLocalClientManager.h"
 #include "common/thrift/ThriftTypes.h"
 #include "common/time/WallClock.h"
 #include "interface/gen-cpp2/common_types.h"
@@ -75,7 +80,8 @@ folly::SemiFuture<StorageRpcResponse<Response>>
 StorageClientBase<ClientType, ClientManagerType>::collectResponse(
     folly::EventBase* evb,
     std::unordered_map<HostAddr, Request> requests,
-    RemoteFunc&& remoteFunc) {
+    RemoteFunc&& remoteFunc,
+    ResponseHook<Response> onArrival) {
   memory::MemoryCheckOffGuard offGuard;
   std::vector<folly::Future<StatusOr<Response>>> respFutures;
   respFutures.reserve(requests.size());
@@ -95,6 +101,20 @@ StorageClientBase<ClientType, ClientManagerType>::collectResponse(
                    .ensure([totalLatencies, i, start]() {
                      (*totalLatencies)[i] = time::WallClock::fastNowInMicroSec() - start;
                    });
+    if (onArrival) {
+      fut = std::move(fut).thenValue(
+          [onArrival, host = req.first](
+              StatusOr<Response>&& status) -> folly::Future<StatusOr<Response>> {
+            if (!status.ok()) {
+              return folly::makeFuture<StatusOr<Response>>(std::move(status));
+            }
+            // Kept at the same address until the hook is done with it
+            auto resp = std::make_shared<StatusOr<Response>>(std::move(status));
+            return onArrival(host, resp->value()).thenValue([resp](auto&&) {
+              return std::move(*resp);
+            });
+          });
+    }
 
     respFutures.emplace_back(std::move(fut));
   }
@@ -159,25 +179,117 @@ folly::Future<StatusOr<Response>> StorageClientBase<ClientType, ClientManagerTyp
   static_assert(
       folly::isFuture<std::invoke_result_t<RemoteFunc, ClientType*, const Request&>>::value);
 
-  stats::StatsManager::addValue(kNumRpcSentToStoraged);
   if (evb == nullptr) {
     evb = DCHECK_NOTNULL(ioThreadPool_)->getEventBase();
   }
 
-  auto spaceId = request.get_space_id();
-  return folly::via(evb)
-      .thenValue([remoteFunc = std::move(remoteFunc), request, evb, host, this](auto&&) {
+  // Copied once and shared by the callbacks, it's alive until the response is handled
+  auto copy = std::make_shared<Request>(request);
+  std::string coalesceKey;
+  if constexpr (IsCoalescableRequest<Request>::value &&
+                !thrift::IsLocalClientManager<ClientManagerType>::value) {
+    coalesceKey = getCoalesceKey(*copy);
+  }
+  std::shared_ptr<const Request> req = std::move(copy);
+
+  if constexpr (IsCoalescableRequest<Request>::value) {
+    // Remember the host, so that its snapshots of the plan are released when the query ends
+    if (req->common_ref().has_value() && req->common_ref()->snapshot_read_ref().value_or(false)) {
+      auto key = std::make_pair(req->common_ref()->session_id_ref().value_or(0),
+                                req->common_ref()->plan_id_ref().value_or(0));
+      (*snapshotReadHosts_.wlock())[key][host] = req->get_space_id();
+    }
+  }
+
+  if constexpr (AcceptsFollowerRead<Request>::value &&
+                !thrift::IsLocalClientManager<ClientManagerType>::value) {
+    // The follower serves the snapshot reads of a query from its own snapshots
+    bool snapshotRead = req->common_ref().has_value() &&
+                        req->common_ref()->snapshot_read_ref().value_or(false);
+    if (FLAGS_storage_client_hedge_percentile > 0 && req->get_enable_read_from_follower() &&
+        !snapshotRead) {
+      auto delayUs = getHedgeDelayUs(host);
+      if (delayUs > 0) {
+        auto follower = getHedgeHost(req->get_space_id(), getReqPartsId(*req), host);
+        if (follower.has_value()) {
+          return sendHedgedRequest<Request, RemoteFunc, Response>(
+              evb, host, *follower, delayUs, std::move(req), coalesceKey, remoteFunc);
+        }
+      }
+    }
+  }
+  return sendRequest<Request, RemoteFunc, Response>(
+      evb, host, std::move(req), coalesceKey, remoteFunc);
+}
+
+template <typename ClientType, typename ClientManagerType>
+template <class Request, class RemoteFunc, class Response>
+folly::Future<StatusOr<Response>> StorageClientBase<ClientType, ClientManagerType>::sendRequest(
+    folly::EventBase* evb,
+    const HostAddr& host,
+    std::shared_ptr<const Request> req,
+    const std::string& coalesceKey,
+    const RemoteFunc& remoteFunc) {
+  auto spaceId = req->get_space_id();
+  auto start = time::WallClock::fastNowInMicroSec();
+  auto respFuture = folly::Future<Response>::makeEmpty();
+  if constexpr (thrift::IsLocalClientManager<ClientManagerType>::value) {
+    stats::StatsManager::addValue(kNumRpcSentToStoraged);
+    // In process, there is no channel to create and nothing to encode, so call the handler on
+    // the current thread rather than hopping to the IO thread.
+    auto client = clientsMan_->client(host);
+    respFuture = folly::makeFutureWith([&remoteFunc, &client, &req]() {
+      memory::MemoryCheckGuard guard;
+      return remoteFunc(client.get(), *req);
+    });
+  } else {
+    auto send = [remoteFunc, req, evb, host, this]() {
+      stats::StatsManager::addValue(kNumRpcSentToStoraged);
+      return folly::via(evb).thenValue([remoteFunc, req, evb, host, this](auto&&) {
         // MemoryTrackerVerified
         memory::MemoryCheckGuard guard;
         // NOTE: Create new channel on each thread to avoid TIMEOUT RPC error
         auto client = clientsMan_->client(host, evb, false, FLAGS_storage_client_timeout_ms);
         // Encoding invoke Cpp2Ops::write the request to protocol is in current thread,
         // do not need to turn on in Cpp2Ops::write
-        return remoteFunc(client.get(), request);
+        return remoteFunc(client.get(), *req);
+      });
+    };
+    if (coalesceKey.empty()) {
+      respFuture = send();
+    } else {
+      // One for each call site, shared by the clients
+      static RpcCoalescer<Response> coalescer;
+      bool joined = false;
+      respFuture = coalescer.call(host.toString() + coalesceKey,
+                                  FLAGS_storage_client_coalesce_window_us,
+                                  send,
+                                  &joined);
+      if (joined) {
+        stats::StatsManager::addValue(kNumRpcCoalesced);
+        // The shared RPC carries the session and plan of the query which sent it, if that query
+        // is killed, the waiters of the other queries are detached and send their own requests
+        respFuture = std::move(respFuture)
+                         .thenValue([req, send, this](Response&& resp) -> folly::Future<Response> {
+                           if (killedByOthers(*req, resp)) {
+                             return send();
+                           }
+                           return std::move(resp);
+                         });
+      }
+    }
+  }
+  return std::move(respFuture)
+      .ensure([host, start, this]() {
+        stats::StatsManager::addValue(getHostLatencyStat(host),
+                                      time::WallClock::fastNowInMicroSec() - start);
       })
       .thenValue([spaceId, this](Response&& resp) mutable -> StatusOr<Response> {
         // MemoryTrackerVerified
         memory::MemoryCheckGuard guard;
+        if constexpr (!thrift::IsLocalClientManager<ClientManagerType>::value) {
+          thrift::sampleCompression(resp, kStorageRpcCompressedPercent, kStorageRpcCompressionUs);
+        }
         auto& result = resp.get_result();
         for (auto& part : result.get_failed_parts()) {
           auto partId = part.get_part_id();
@@ -213,7 +325,7 @@ folly::Future<StatusOr<Response>> StorageClientBase<ClientType, ClientManagerTyp
             return folly::makeFuture<StatusOr<Response>>(Status::GraphMemoryExceeded(
                 "(%d)", static_cast<int32_t>(nebula::cpp2::ErrorCode::E_GRAPH_MEMORY_EXCEEDED)));
           })
-      .thenError([request, host, spaceId, this](
+      .thenError([req, host, spaceId, this](
                      folly::exception_wrapper&& exWrapper) mutable -> StatusOr<Response> {
         stats::StatsManager::addValue(kNumRpcSentToStoragedFailed);
 
@@ -228,7 +340,7 @@ folly::Future<StatusOr<Response>> StorageClientBase<ClientType, ClientManagerTyp
             return Status::Error("RPC failure in StorageClient: %s", ex->what());
           }
         } else {
-          auto partsId = getReqPartsId(request);
+          auto partsId = getReqPartsId(*req);
           invalidLeader(spaceId, partsId);
           LOG(ERROR) << "Request to " << host << " failed.";
           return Status::Error("RPC failure in StorageClient.");
@@ -236,6 +348,183 @@ folly::Future<StatusOr<Response>> StorageClientBase<ClientType, ClientManagerTyp
       });
 }
 
+template <typename ClientType, typename ClientManagerType>
+template <class Request, class RemoteFunc, class Response>
+folly::Future<StatusOr<Response>>
+StorageClientBase<ClientType, ClientManagerType>::sendHedgedRequest(
+    folly::EventBase* evb,
+    const HostAddr& leader,
+    const HostAddr& follower,
+    int64_t delayUs,
+    std::shared_ptr<const Request> req,
+    const std::string& coalesceKey,
+    const RemoteFunc& remoteFunc) {
+  struct HedgeState {
+    folly::Promise<StatusOr<Response>> promise;
+    std::atomic<bool> done{false};
+    std::atomic<int32_t> pending{2};
+  };
+  auto state = std::make_shared<HedgeState>();
+  // The first succeeded response wins, or the last failed one if both fail
+  auto onResult = [state](folly::Try<StatusOr<Response>>&& t) {
+    bool last = state->pending.fetch_sub(1) == 1;
+    StatusOr<Response> resp = t.hasException()
+                                  ? StatusOr<Response>(Status::Error(
+                                        "RPC failure in StorageClient: %s",
+                                        t.exception().what().c_str()))
+                                  : std::move(t).value();
+    if ((resp.ok() || last) && !state->done.exchange(true)) {
+      state->promise.setValue(std::move(resp));
+    }
+  };
+  auto future = state->promise.getFuture();
+
+  sendRequest<Request, RemoteFunc, Response>(evb, leader, req, coalesceKey, remoteFunc)
+      .thenTry(onResult);
+  folly::futures::sleep(std::chrono::microseconds(delayUs))
+      .via(evb)
+      .thenValue([state, evb, follower, req, coalesceKey, remoteFunc, this](
+                     auto&&) -> folly::Future<StatusOr<Response>> {
+        if (state->done.load()) {
+          return folly::makeFuture<StatusOr<Response>>(
+              Status::Error("The leader has responded, no need to hedge"));
+        }
+        stats::StatsManager::addValue(kNumHedgedRpcSentToStoraged);
+        VLOG(2) << "Send the hedged request to " << follower;
+        return sendRequest<Request, RemoteFunc, Response>(
+            evb, follower, req, coalesceKey, remoteFunc);
+      })
+      .thenTry(onResult);
+  return future;
+}
+
+template <typename ClientType, typename ClientManagerType>
+template <class Request>
+std::string StorageClientBase<ClientType, ClientManagerType>::getCoalesceKey(Request& req) const {
+  if (FLAGS_storage_client_coalesce_window_us <= 0) {
+    return "";
+  }
+  // The session and the plan differ between queries, they are not a part of the key
+  std::optional<cpp2::RequestCommon> common;
+  if (req.common_ref().has_value()) {
+    if (req.common_ref()->profile_detail_ref().value_or(false)) {
+      // Every profiled request has its own stats
+      return "";
+    }
+    if (req.common_ref()->snapshot_read_ref().value_or(false)) {
+      // Every query reading from snapshots has its own ones
+      return "";
+    }
+    common = std::move(*req.common_ref());
+    req.common_ref().reset();
+  }
+  auto key = apache::thrift::CompactSerializer::serialize<std::string>(req);
+  if (common.has_value()) {
+    req.common_ref() = std::move(*common);
+  }
+  return key;
+}
+
+template <typename ClientType, typename ClientManagerType>
+template <class Request, class Response>
+bool StorageClientBase<ClientType, ClientManagerType>::killedByOthers(const Request& req,
+                                                                      const Response& resp) {
+  const auto& failedParts = resp.get_result().get_failed_parts();
+  bool killed = std::any_of(failedParts.begin(), failedParts.end(), [](const auto& part) {
+    return part.get_code() == nebula::cpp2::ErrorCode::E_PLAN_IS_KILLED;
+  });
+  if (!killed) {
+    return false;
+  }
+  if (!req.common_ref().has_value()) {
+    return true;
+  }
+  auto session = req.common_ref()->session_id_ref().value_or(0);
+  auto plan = req.common_ref()->plan_id_ref().value_or(0);
+  return metaClient_ == nullptr || !metaClient_->checkIsPlanKilled(session, plan);
+}
+
+template <typename ClientType, typename ClientManagerType>
+std::unordered_map<HostAddr, GraphSpaceID>
+StorageClientBase<ClientType, ClientManagerType>::takeSnapshotReadHosts(SessionID session,
+                                                                        ExecutionPlanID plan) {
+  std::unordered_map<HostAddr, GraphSpaceID> hosts;
+  auto locked = snapshotReadHosts_.wlock();
+  auto iter = locked->find(std::make_pair(session, plan));
+  if (iter != locked->end()) {
+    hosts = std::move(iter->second);
+    locked->erase(iter);
+  }
+  return hosts;
+}
+
+template <typename ClientType, typename ClientManagerType>
+std::optional<HostAddr> StorageClientBase<ClientType, ClientManagerType>::getHedgeHost(
+    GraphSpaceID spaceId, const std::vector<PartitionID>& parts, const HostAddr& leader) const {
+  std::vector<HostAddr> candidates;
+  for (size_t i = 0; i < parts.size(); i++) {
+    auto partHosts = getPartHosts(spaceId, parts[i]);
+    if (!partHosts.ok()) {
+      return std::nullopt;
+    }
+    const auto& hosts = partHosts.value().hosts_;
+    if (i == 0) {
+      std::copy_if(hosts.begin(),
+                   hosts.end(),
+                   std::back_inserter(candidates),
+                   [&leader](const auto& h) { return h != leader; });
+    } else {
+      candidates.erase(std::remove_if(candidates.begin(),
+                                      candidates.end(),
+                                      [&hosts](const auto& h) {
+                                        return std::find(hosts.begin(), hosts.end(), h) ==
+                                               hosts.end();
+                                      }),
+                       candidates.end());
+    }
+    if (candidates.empty()) {
+      return std::nullopt;
+    }
+  }
+  if (candidates.empty()) {
+    return std::nullopt;
+  }
+  return candidates[folly::Random::rand32(candidates.size())];
+}
+
+template <typename ClientType, typename ClientManagerType>
+int64_t StorageClientBase<ClientType, ClientManagerType>::getHedgeDelayUs(const HostAddr& host) {
+  auto latency = stats::StatsManager::readHisto(getHostLatencyStat(host),
+                                                stats::StatsManager::TimeRange::ONE_MINUTE,
+                                                FLAGS_storage_client_hedge_percentile);
+  if (!latency.ok() || latency.value() <= 0) {
+    // No latency of the host recently
+    return 0;
+  }
+  return std::max<int64_t>(latency.value(), FLAGS_storage_client_hedge_min_delay_us);
+}
+
+template <typename ClientType, typename ClientManagerType>
+stats::CounterId StorageClientBase<ClientType, ClientManagerType>::getHostLatencyStat(
+    const HostAddr& host) {
+  {
+    auto stats = hostLatencyStats_.rlock();
+    auto it = stats->find(host);
+    if (it != stats->end()) {
+      return it->second;
+    }
+  }
+  auto stats = hostLatencyStats_.wlock();
+  auto it = stats->find(host);
+  if (it != stats->end()) {
+    return it->second;
+  }
+  auto id = stats::StatsManager::histoWithLabels(kStorageRpcLatencyUs,
+                                                 {{"host", host.toString()}});
+  stats->emplace(host, id);
+  return id;
+}
+
 template <typename ClientType, typename ClientManagerType>
 template <class Container, class GetIdFunc>
 StatusOr<std::unordered_map<
@@ -9,6 +9,31 @@ DEFINE_int32(storage_client_timeout_ms, 60 * 1000, "storage client timeout");
 DEFINE_uint32(storage_client_retry_interval_ms,
               1000,
               "storage client sleep interval milliseconds between retry");
+DEFINE_int64(storage_client_coalesce_window_us,
+             0,
+             "the identical read requests to a storaged sent within the window share one RPC in "
+             "flight, 0 to disable");
+DEFINE_double(storage_client_hedge_percentile,
+              0,
+              "send the read request accepting follower reads to a follower as well, if the "
+              "leader doesn't respond in this percentile of its latency, in (0, 100], e.g. 99, "
+              "0 to disable");
+DEFINE_int64(storage_client_hedge_min_delay_us,
+             10000,
+             "the least delay before sending the hedged request to a follower");
+
+// Sanity-checking Flag Values
+static bool ValidateHedgePercentile(const char* flagname, double value) {
+  // The percentiles of the histograms are in [0, 100]
+  if (value >= 0 && value <= 100) {
+    return true;
+  }
+  FLOG_WARN("Invalid value for --%s: %f, the percentile should be between 0 and 100, e.g. 99\n",
+            flagname,
+            value);
+  return false;
+}
+DEFINE_validator(storage_client_hedge_percentile, &ValidateHedgePercentile);
 
 namespace nebula {
 namespace storage {}  // namespace storage
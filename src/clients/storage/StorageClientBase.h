@@ -6,19 +6,27 @@
 #ifndef CLIENTS_STORAGE_STORAGECLIENTBASE_H_
 #define CLIENTS_STORAGE_STORAGECLIENTBASE_H_
 
+#include <folly/Synchronized.h>
+#include <folly/container/F14Map.h>
 #include <folly/executors/IOThreadPoolExecutor.h>
 #include <folly/futures/Future.h>
 
+#include <optional>
+
 #include "clients/meta/MetaClient.h"
 #include "common/base/Base.h"
 #include "common/base/StatusOr.h"
 #include "common/datatypes/HostAddr.h"
 #include "common/meta/Common.h"
+#include "common/stats/StatsManager.h"
 #include "common/thrift/ThriftClientManager.h"
 #include "interface/gen-cpp2/storage_types.h"
 
 DECLARE_int32(storage_client_timeout_ms);
 DECLARE_uint32(storage_client_retry_interval_ms);
+DECLARE_int64(storage_client_coalesce_window_us);
+DECLARE_double(storage_client_hedge_percentile);
+DECLARE_int64(storage_client_hedge_min_delay_us);
 
 namespace nebula {
 namespace storage {
@@ -104,6 +112,43 @@ class StorageRpcResponse final {
   std::vector<std::tuple<HostAddr, int32_t, int32_t>> hostLatency_;
 };
 
+// Called with a host and its response once it arrives, see collectResponse. The host of each
+// collected response is in StorageRpcResponse::hostLatency.
+template <class Response>
+using ResponseHook = std::function<folly::Future<folly::Unit>(const HostAddr&, const Response&)>;
+
+// The read requests whose identical calls to a host could share one RPC, see RpcCoalescer
+template <class Request>
+struct IsCoalescableRequest : std::false_type {};
+
+template <>
+struct IsCoalescableRequest<cpp2::GetNeighborsRequest> : std::true_type {};
+
+template <>
+struct IsCoalescableRequest<cpp2::GetDstBySrcRequest> : std::true_type {};
+
+template <>
+struct IsCoalescableRequest<cpp2::GetPropRequest> : std::true_type {};
+
+template <>
+struct IsCoalescableRequest<cpp2::LookupIndexRequest> : std::true_type {};
+
+template <>
+struct IsCoalescableRequest<cpp2::ScanVertexRequest> : std::true_type {};
+
+template <>
+struct IsCoalescableRequest<cpp2::ScanEdgeRequest> : std::true_type {};
+
+// The read requests which could be served by a follower if enable_read_from_follower is set
+template <class Request>
+struct AcceptsFollowerRead : std::false_type {};
+
+template <>
+struct AcceptsFollowerRead<cpp2::ScanVertexRequest> : std::true_type {};
+
+template <>
+struct AcceptsFollowerRead<cpp2::ScanEdgeRequest> : std::true_type {};
+
 /**
  * A base class for all storage clients
  */
@@ -121,6 +166,10 @@ class StorageClientBase {
   void invalidLeader(GraphSpaceID spaceId, PartitionID partId);
   void invalidLeader(GraphSpaceID spaceId, std::vector<PartitionID>& partsId);
 
+  // The responses are collected in the order of the hosts. If onArrival is given, it's called with
+  // each succeeded response as soon as it arrives, so the caller could process the responses of
+  // the hosts in parallel with waiting for the slower ones. The responses are collected after all
+  // the futures returned by it are done.
   template <class Request,
             class RemoteFunc,
             class Response =
@@ -128,7 +177,8 @@ class StorageClientBase {
   folly::SemiFuture<StorageRpcResponse<Response>> collectResponse(
       folly::EventBase* evb,
       std::unordered_map<HostAddr, Request> requests,
-      RemoteFunc&& remoteFunc);
+      RemoteFunc&& remoteFunc,
+      ResponseHook<Response> onArrival = nullptr);
 
   template <class Request,
             class RemoteFunc,
@@ -194,16 +244,70 @@ class StorageClientBase {
     return {req.get_part_id()};
   }
 
+  std::vector<PartitionID> getReqPartsId(const cpp2::ReleaseReadSnapshotsRequest&) const {
+    return {};
+  }
+
   bool isValidHostPtr(const HostAddr* addr) {
     return addr != nullptr && !addr->host.empty() && addr->port != 0;
   }
 
+  // The hosts which have served the snapshot reads of the plan with the space read from each,
+  // they are forgotten once taken
+  std::unordered_map<HostAddr, GraphSpaceID> takeSnapshotReadHosts(SessionID session,
+                                                                   ExecutionPlanID plan);
+
  protected:
   meta::MetaClient* metaClient_{nullptr};
 
+ private:
+  // Send the request to the host, the identical calls of the same non-empty key are coalesced
+  template <class Request, class RemoteFunc, class Response>
+  folly::Future<StatusOr<Response>> sendRequest(folly::EventBase* evb,
+                                                const HostAddr& host,
+                                                std::shared_ptr<const Request> req,
+                                                const std::string& coalesceKey,
+                                                const RemoteFunc& remoteFunc);
+
+  // Send the request to the leader, and also to the follower if the leader doesn't respond in
+  // the delay, the first succeeded response is returned
+  template <class Request, class RemoteFunc, class Response>
+  folly::Future<StatusOr<Response>> sendHedgedRequest(folly::EventBase* evb,
+                                                      const HostAddr& leader,
+                                                      const HostAddr& follower,
+                                                      int64_t delayUs,
+                                                      std::shared_ptr<const Request> req,
+                                                      const std::string& coalesceKey,
+                                                      const RemoteFunc& remoteFunc);
+
+  // The key of the request to coalesce, empty if it should be sent by itself. The common of the
+  // request is left out of the key, so the identical reads of different queries share one RPC
+  template <class Request>
+  std::string getCoalesceKey(Request& req) const;
+
+  // Whether the response of a shared RPC is failed by the kill of another query than the one of
+  // the request
+  template <class Request, class Response>
+  bool killedByOthers(const Request& req, const Response& resp);
+
+  // A follower which holds all the parts, to send the hedged request to
+  std::optional<HostAddr> getHedgeHost(GraphSpaceID spaceId,
+                                       const std::vector<PartitionID>& parts,
+                                       const HostAddr& leader) const;
+
+  // How long to wait for the host before sending the hedged request, 0 for never
+  int64_t getHedgeDelayUs(const HostAddr& host);
+
+  stats::CounterId getHostLatencyStat(const HostAddr& host);
+
  private:
   std::shared_ptr<folly::IOThreadPoolExecutor> ioThreadPool_;
   std::unique_ptr<ClientManagerType> clientsMan_;
+  folly::Synchronized<std::unordered_map<HostAddr, stats::CounterId>> hostLatencyStats_;
+  // (session, plan) => the hosts which hold the read snapshots of it => space
+  folly::Synchronized<folly::F14FastMap<std::pair<SessionID, ExecutionPlanID>,
+                                        std::unordered_map<HostAddr, GraphSpaceID>>>
+      snapshotReadHosts_;
 };
 
 }  // namespace storage
@@ -9,12 +9,26 @@ namespace nebula {
 
 stats::CounterId kNumRpcSentToStoraged;
 stats::CounterId kNumRpcSentToStoragedFailed;
+stats::CounterId kNumRpcCoalesced;
+stats::CounterId kNumHedgedRpcSentToStoraged;
+stats::CounterId kStorageRpcLatencyUs;
+stats::CounterId kStorageRpcCompressedPercent;
+stats::CounterId kStorageRpcCompressionUs;
 
 void initStorageClientStats() {
   kNumRpcSentToStoraged =
       stats::StatsManager::registerStats("num_rpc_sent_to_storaged", "rate, sum");
   kNumRpcSentToStoragedFailed =
       stats::StatsManager::registerStats("num_rpc_sent_to_storaged_failed", "rate, sum");
+  kNumRpcCoalesced = stats::StatsManager::registerStats("num_rpc_coalesced", "rate, sum");
+  kNumHedgedRpcSentToStoraged =
+      stats::StatsManager::registerStats("num_hedged_rpc_sent_to_storaged", "rate, sum");
+  kStorageRpcLatencyUs = stats::StatsManager::registerHisto(
+      "storage_rpc_latency_us", 1000, 0, 2000000, "avg, p75, p95, p99, p999");
+  kStorageRpcCompressedPercent = stats::StatsManager::registerHisto(
+      "storage_rpc_compressed_percent", 1, 0, 100, "avg, p75, p95, p99, p999");
+  kStorageRpcCompressionUs = stats::StatsManager::registerHisto(
+      "storage_rpc_compression_us", 1000, 0, 2000000, "avg, p75, p95, p99, p999");
 }
 
 }  // namespace nebula
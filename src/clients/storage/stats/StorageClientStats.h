@@ -12,6 +12,13 @@ namespace nebula {
 
 extern stats::CounterId kNumRpcSentToStoraged;
 extern stats::CounterId kNumRpcSentToStoragedFailed;
+extern stats::CounterId kNumRpcCoalesced;
+extern stats::CounterId kNumHedgedRpcSentToStoraged;
+// The latency of the RPC to storaged, labeled by the host
+extern stats::CounterId kStorageRpcLatencyUs;
+// Sampled compression of the responses from storaged, see thrift::sampleCompression
+extern stats::CounterId kStorageRpcCompressedPercent;
+extern stats::CounterId kStorageRpcCompressionUs;
 
 void initStorageClientStats();
 
@@ -0,0 +1,95 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "clients/storage/RpcCoalescer.h"
+#include "common/base/Base.h"
+
+namespace nebula {
+namespace storage {
+
+TEST(RpcCoalescerTest, JoinInFlight) {
+  RpcCoalescer<int> coalescer;
+  folly::Promise<int> promise;
+  int sent = 0;
+  auto send = [&]() {
+    sent++;
+    return promise.getFuture();
+  };
+
+  bool joined = true;
+  auto f1 = coalescer.call("host:key", 1000000, send, &joined);
+  EXPECT_FALSE(joined);
+  auto f2 = coalescer.call("host:key", 1000000, send, &joined);
+  EXPECT_TRUE(joined);
+  EXPECT_EQ(1, sent);
+  EXPECT_EQ(1, coalescer.size());
+
+  promise.setValue(42);
+  EXPECT_EQ(42, std::move(f1).get());
+  EXPECT_EQ(42, std::move(f2).get());
+  // The finished call is not joined any more
+  EXPECT_EQ(0, coalescer.size());
+  auto f3 = coalescer.call(
+      "host:key", 1000000, []() { return folly::makeFuture(7); }, &joined);
+  EXPECT_FALSE(joined);
+  EXPECT_EQ(7, std::move(f3).get());
+}
+
+TEST(RpcCoalescerTest, DifferentKeys) {
+  RpcCoalescer<int> coalescer;
+  folly::Promise<int> p1;
+  folly::Promise<int> p2;
+  auto f1 = coalescer.call("host1:key", 1000000, [&]() { return p1.getFuture(); });
+  auto f2 = coalescer.call("host2:key", 1000000, [&]() { return p2.getFuture(); });
+  EXPECT_EQ(2, coalescer.size());
+  p2.setValue(2);
+  p1.setValue(1);
+  EXPECT_EQ(1, std::move(f1).get());
+  EXPECT_EQ(2, std::move(f2).get());
+}
+
+TEST(RpcCoalescerTest, WindowExpired) {
+  RpcCoalescer<int> coalescer;
+  folly::Promise<int> p1;
+  folly::Promise<int> p2;
+  bool joined = true;
+  auto f1 = coalescer.call("host:key", 0, [&]() { return p1.getFuture(); }, &joined);
+  EXPECT_FALSE(joined);
+  std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  auto f2 = coalescer.call("host:key", 0, [&]() { return p2.getFuture(); }, &joined);
+  EXPECT_FALSE(joined);
+  EXPECT_EQ(1, coalescer.size());
+
+  // The replaced call doesn't remove the new one
+  p1.setValue(1);
+  EXPECT_EQ(1, coalescer.size());
+  p2.setValue(2);
+  EXPECT_EQ(0, coalescer.size());
+  EXPECT_EQ(1, std::move(f1).get());
+  EXPECT_EQ(2, std::move(f2).get());
+}
+
+TEST(RpcCoalescerTest, Exception) {
+  RpcCoalescer<int> coalescer;
+  folly::Promise<int> promise;
+  auto f1 = coalescer.call("host:key", 1000000, [&]() { return promise.getFuture(); });
+  auto f2 = coalescer.call("host:key", 1000000, [&]() { return promise.getFuture(); });
+  promise.setException(std::runtime_error("timeout"));
+  EXPECT_THROW(std::move(f1).get(), std::runtime_error);
+  EXPECT_THROW(std::move(f2).get(), std::runtime_error);
+  EXPECT_EQ(0, coalescer.size());
+}
+
+}  // namespace storage
+}  // namespace nebula
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  folly::init(&argc, &argv, true);
+  google::SetStderrLogging(google::INFO);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,155 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "codec/RowDecoder.h"
+
+namespace nebula {
+
+using nebula::cpp2::PropertyType;
+
+namespace {
+
+bool isFixedNumeric(PropertyType type) {
+  switch (type) {
+    case PropertyType::BOOL:
+    case PropertyType::INT8:
+    case PropertyType::INT16:
+    case PropertyType::INT32:
+    case PropertyType::INT64:
+    case PropertyType::FLOAT:
+    case PropertyType::DOUBLE:
+    case PropertyType::TIMESTAMP:
+      return true;
+    default:
+      return false;
+  }
+}
+
+template <typename T>
+T load(const char* p) {
+  T val;
+  memcpy(reinterpret_cast<void*>(&val), p, sizeof(T));
+  return val;
+}
+
+}  // namespace
+
+RowDecoder::RowDecoder(const meta::NebulaSchemaProvider* schema,
+                       const std::vector<std::string>& props)
+    : schema_(schema) {
+  DCHECK(!!schema_);
+  size_t numNullables = schema_->getNumNullableFields();
+  numNullBytes_ = numNullables > 0 ? ((numNullables - 1) >> 3) + 1 : 0;
+  fixedLen_ = schema_->size();
+
+  slots_.resize(props.size());
+  for (size_t i = 0; i < props.size(); ++i) {
+    auto& slot = slots_[i];
+    if (props[i].empty()) {
+      continue;
+    }
+    auto index = schema_->getFieldIndex(props[i]);
+    if (index < 0) {
+      slot.kind = Slot::Kind::kUnknown;
+      fixedOnly_ = false;
+      continue;
+    }
+    auto field = schema_->field(index);
+    slot.kind = Slot::Kind::kField;
+    slot.type = field->type();
+    slot.size = field->size();
+    slot.offset = field->offset();
+    slot.nullable = field->nullable();
+    if (slot.nullable) {
+      slot.nullByte = field->nullFlagPos() >> 3;
+      slot.nullBit = 0x80 >> (field->nullFlagPos() & 0x07);
+    }
+    if (slot.nullable || !isFixedNumeric(slot.type)) {
+      fixedOnly_ = false;
+    }
+  }
+}
+
+bool RowDecoder::decode(folly::StringPiece row, std::vector<Value>& values) const {
+  values.resize(slots_.size());
+  // only the rows of version 2
+  if (row.empty() || (row[0] & 0x18) != 0x08) {
+    return false;
+  }
+  size_t headerLen = (row[0] & 0x07) + 1;
+  size_t base = headerLen + numNullBytes_;
+  if (row.size() < base + fixedLen_) {
+    return false;
+  }
+  if (fixedOnly_) {
+    decodeFixed(row, base, values);
+    return true;
+  }
+
+  for (size_t i = 0; i < slots_.size(); ++i) {
+    const auto& slot = slots_[i];
+    switch (slot.kind) {
+      case Slot::Kind::kSkip:
+        values[i].clear();
+        break;
+      case Slot::Kind::kUnknown:
+        values[i] = Value(NullType::UNKNOWN_PROP);
+        break;
+      case Slot::Kind::kField:
+        if (slot.nullable && (row[headerLen + slot.nullByte] & slot.nullBit)) {
+          values[i] = Value(NullType::__NULL__);
+        } else {
+          values[i] = RowReaderV2::decodeField(row, slot.type, slot.size, base + slot.offset);
+        }
+        break;
+    }
+  }
+  return true;
+}
+
+// All the props are fixed width numeric and not nullable, so there is neither the null flag
+// nor the string to check, and the values are assigned in place without building a temporary.
+void RowDecoder::decodeFixed(folly::StringPiece row,
+                             size_t base,
+                             std::vector<Value>& values) const {
+  const char* data = row.data() + base;
+  for (size_t i = 0; i < slots_.size(); ++i) {
+    const auto& slot = slots_[i];
+    auto& value = values[i];
+    if (slot.kind == Slot::Kind::kSkip) {
+      value.clear();
+      continue;
+    }
+    const char* p = data + slot.offset;
+    switch (slot.type) {
+      case PropertyType::BOOL:
+        value.setBool(*p != 0);
+        break;
+      case PropertyType::INT8:
+        value.setInt(static_cast<int64_t>(static_cast<int8_t>(*p)));
+        break;
+      case PropertyType::INT16:
+        value.setInt(static_cast<int64_t>(load<int16_t>(p)));
+        break;
+      case PropertyType::INT32:
+        value.setInt(static_cast<int64_t>(load<int32_t>(p)));
+        break;
+      case PropertyType::INT64:
+      case PropertyType::TIMESTAMP:
+        value.setInt(load<int64_t>(p));
+        break;
+      case PropertyType::FLOAT:
+        value.setFloat(static_cast<double>(load<float>(p)));
+        break;
+      case PropertyType::DOUBLE:
+        value.setFloat(load<double>(p));
+        break;
+      default:
+        LOG(FATAL) << "Not a fixed width numeric type: " << static_cast<int>(slot.type);
+    }
+  }
+}
+
+}  // namespace nebula
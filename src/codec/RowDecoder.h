@@ -0,0 +1,87 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef CODEC_ROWDECODER_H_
+#define CODEC_ROWDECODER_H_
+
+#include "codec/RowReaderV2.h"
+#include "common/base/Base.h"
+#include "common/meta/NebulaSchemaProvider.h"
+
+namespace nebula {
+
+/**
+ * @brief RowDecoder decodes a projection of the props of the rows encoded in one schema version.
+ *
+ * It's compiled once for the schema and the props to read: the field lookup by name, the type
+ * dispatch, the offsets and the null flag positions are resolved when it's constructed, so that
+ * decoding a row is a single pass over the projected fields. It holds no state of the row, so the
+ * same decoder could be shared by threads.
+ */
+class RowDecoder final {
+ public:
+  /**
+   * @brief Compile the decoder
+   *
+   * @param schema Schema of the rows to decode, must outlive the decoder
+   * @param props Name of the props to decode in order, an empty name is skipped when decoding
+   */
+  RowDecoder(const meta::NebulaSchemaProvider* schema, const std::vector<std::string>& props);
+
+  /**
+   * @brief Decode the props of a row into values, which is resized to the number of props. The
+   * value of a prop not in the schema is NullType::UNKNOWN_PROP, the same as
+   * RowReaderV2::getValueByName, and the value of a skipped prop is left empty.
+   *
+   * @param row Row encoded in the schema of the decoder
+   * @param values Output buffer, reused by the caller across rows to avoid allocation
+   * @return Whether the row is of version 2 and long enough for the schema
+   */
+  bool decode(folly::StringPiece row, std::vector<Value>& values) const;
+
+  const meta::NebulaSchemaProvider* schema() const {
+    return schema_;
+  }
+
+  size_t numProps() const {
+    return slots_.size();
+  }
+
+  // Whether all the props are of fixed width numeric types and not nullable
+  bool fixedOnly() const {
+    return fixedOnly_;
+  }
+
+ private:
+  struct Slot {
+    enum class Kind : uint8_t {
+      kSkip,
+      kUnknown,
+      kField,
+    };
+
+    Kind kind{Kind::kSkip};
+    nebula::cpp2::PropertyType type{nebula::cpp2::PropertyType::UNKNOWN};
+    size_t size{0};
+    // offset after the null flags
+    size_t offset{0};
+    bool nullable{false};
+    // offset of the null flag after the header, and the bit of it
+    size_t nullByte{0};
+    uint8_t nullBit{0};
+  };
+
+  void decodeFixed(folly::StringPiece row, size_t base, std::vector<Value>& values) const;
+
+  const meta::NebulaSchemaProvider* schema_;
+  std::vector<Slot> slots_;
+  size_t numNullBytes_{0};
+  // length of the fixed part of a row after the header
+  size_t fixedLen_{0};
+  bool fixedOnly_{true};
+};
+
+}  // namespace nebula
+#endif  // CODEC_ROWDECODER_H_
@@ -62,83 +62,89 @@ Value RowReaderV2::getValueByIndex(const int64_t index) const {
   if (field->nullable() && isNull(field->nullFlagPos())) {
     return NullType::__NULL__;
   }
+  return decodeField(data_, field->type(), field->size(), offset);
+}
 
-  switch (field->type()) {
+Value RowReaderV2::decodeField(folly::StringPiece data,
+                               PropertyType type,
+                               size_t size,
+                               size_t offset) {
+  switch (type) {
     case PropertyType::BOOL: {
-      if (data_[offset]) {
+      if (data[offset]) {
         return true;
       } else {
         return false;
       }
     }
     case PropertyType::INT8: {
-      return static_cast<int8_t>(data_[offset]);
+      return static_cast<int8_t>(data[offset]);
     }
     case PropertyType::INT16: {
       int16_t val;
-      memcpy(reinterpret_cast<void*>(&val), &data_[offset], sizeof(int16_t));
+      memcpy(reinterpret_cast<void*>(&val), &data[offset], sizeof(int16_t));
       return val;
     }
     case PropertyType::INT32: {
       int32_t val;
-      memcpy(reinterpret_cast<void*>(&val), &data_[offset], sizeof(int32_t));
+      memcpy(reinterpret_cast<void*>(&val), &data[offset], sizeof(int32_t));
       return val;
     }
     case PropertyType::INT64: {
       int64_t val;
-      memcpy(reinterpret_cast<void*>(&val), &data_[offset], sizeof(int64_t));
+      memcpy(reinterpret_cast<void*>(&val), &data[offset], sizeof(int64_t));
       return val;
     }
     case PropertyType::VID: {
       // This is to be compatible with V1, so we treat it as
       // 8-byte long string
-      return std::string(&data_[offset], sizeof(int64_t));
+      return std::string(&data[offset], sizeof(int64_t));
     }
     case PropertyType::FLOAT: {
       float val;
-      memcpy(reinterpret_cast<void*>(&val), &data_[offset], sizeof(float));
+      memcpy(reinterpret_cast<void*>(&val), &data[offset], sizeof(float));
       return val;
     }
     case PropertyType::DOUBLE: {
       double val;
-      memcpy(reinterpret_cast<void*>(&val), &data_[offset], sizeof(double));
+      memcpy(reinterpret_cast<void*>(&val), &data[offset], sizeof(double));
       return val;
     }
     case PropertyType::STRING: {
       int32_t strOffset;
       int32_t strLen;
-      memcpy(reinterpret_cast<void*>(&strOffset), &data_[offset], sizeof(int32_t));
-      memcpy(reinterpret_cast<void*>(&strLen), &data_[offset + sizeof(int32_t)], sizeof(int32_t));
-      if (static_cast<size_t>(strOffset) == data_.size() && strLen == 0) {
+      memcpy(reinterpret_cast<void*>(&strOffset), &data[offset], sizeof(int32_t));
+      memcpy(reinterpret_cast<void*>(&strLen), &data[offset + sizeof(int32_t)], sizeof(int32_t));
+      if (static_cast<size_t>(strOffset) == data.size() && strLen == 0) {
         return std::string();
       }
-      CHECK_LT(strOffset, data_.size());
-      return std::string(&data_[strOffset], strLen);
+      CHECK_LT(strOffset, data.size());
+      return std::string(&data[strOffset], strLen);
     }
     case PropertyType::FIXED_STRING: {
-      return std::string(&data_[offset], field->size());
+      return std::string(&data[offset], size);
     }
     case PropertyType::TIMESTAMP: {
       Timestamp ts;
-      memcpy(reinterpret_cast<void*>(&ts), &data_[offset], sizeof(Timestamp));
+      memcpy(reinterpret_cast<void*>(&ts), &data[offset], sizeof(Timestamp));
       return ts;
     }
     case PropertyType::DATE: {
       Date dt;
-      memcpy(reinterpret_cast<void*>(&dt.year), &data_[offset], sizeof(int16_t));
-      memcpy(reinterpret_cast<void*>(&dt.month), &data_[offset + sizeof(int16_t)], sizeof(int8_t));
+      memcpy(reinterpret_cast<void*>(&dt.year), &data[offset], sizeof(int16_t));
+      memcpy(reinterpret_cast<void*>(&dt.month), &data[offset + sizeof(int16_t)], sizeof(int8_t));
       memcpy(reinterpret_cast<void*>(&dt.day),
-             &data_[offset + sizeof(int16_t) + sizeof(int8_t)],
+             &data[offset + sizeof(int16_t) + sizeof(int8_t)],
              sizeof(int8_t));
       return dt;
     }
     case PropertyType::TIME: {
       Time t;
-      memcpy(reinterpret_cast<void*>(&t.hour), &data_[offset], sizeof(int8_t));
-      memcpy(reinterpret_cast<void*>(&t.minute), &data_[offset + sizeof(int8_t)], sizeof(int8_t));
-      memcpy(reinterpret_cast<void*>(&t.sec), &data_[offset + 2 * sizeof(int8_t)], sizeof(int8_t));
+      memcpy(reinterpret_cast<void*>(&t.hour), &data[offset], sizeof(int8_t));
+      memcpy(reinterpret_cast<void*>(&t.minute), &data[offset + sizeof(int8_t)], sizeof(int8_t));
+      memcpy(reinterpret_cast<void*>(&t.sec), &data[offset + 2 * sizeof(int8_t)], sizeof(int8_t));
       memcpy(reinterpret_cast<void*>(&t.microsec),
-             &data_[offset + 3 * sizeof(int8_t)],
+             &data[offset + 3 * sizeof(int8_t)],
              sizeof(int32_t));
       return t;
     }
@@ -151,22 +157,22 @@ Value RowReaderV2::getValueByIndex(const int64_t index) const {
       int8_t minute;
       int8_t sec;
       int32_t microsec;
-      memcpy(reinterpret_cast<void*>(&year), &data_[offset], sizeof(int16_t));
-      memcpy(reinterpret_cast<void*>(&month), &data_[offset + sizeof(int16_t)], sizeof(int8_t));
+      memcpy(reinterpret_cast<void*>(&year), &data[offset], sizeof(int16_t));
+      memcpy(reinterpret_cast<void*>(&month), &data[offset + sizeof(int16_t)], sizeof(int8_t));
       memcpy(reinterpret_cast<void*>(&day),
-             &data_[offset + sizeof(int16_t) + sizeof(int8_t)],
+             &data[offset + sizeof(int16_t) + sizeof(int8_t)],
              sizeof(int8_t));
       memcpy(reinterpret_cast<void*>(&hour),
-             &data_[offset + sizeof(int16_t) + 2 * sizeof(int8_t)],
+             &data[offset + sizeof(int16_t) + 2 * sizeof(int8_t)],
              sizeof(int8_t));
       memcpy(reinterpret_cast<void*>(&minute),
-             &data_[offset + sizeof(int16_t) + 3 * sizeof(int8_t)],
+             &data[offset + sizeof(int16_t) + 3 * sizeof(int8_t)],
              sizeof(int8_t));
       memcpy(reinterpret_cast<void*>(&sec),
-             &data_[offset + sizeof(int16_t) + 4 * sizeof(int8_t)],
+             &data[offset + sizeof(int16_t) + 4 * sizeof(int8_t)],
              sizeof(int8_t));
       memcpy(reinterpret_cast<void*>(&microsec),
-             &data_[offset + sizeof(int16_t) + 5 * sizeof(int8_t)],
+             &data[offset + sizeof(int16_t) + 5 * sizeof(int8_t)],
              sizeof(int32_t));
       dt.year = year;
       dt.month = month;
@@ -179,25 +185,25 @@ Value RowReaderV2::getValueByIndex(const int64_t index) const {
     }
     case PropertyType::DURATION: {
       Duration d;
-      memcpy(reinterpret_cast<void*>(&d.seconds), &data_[offset], sizeof(int64_t));
+      memcpy(reinterpret_cast<void*>(&d.seconds), &data[offset], sizeof(int64_t));
       memcpy(reinterpret_cast<void*>(&d.microseconds),
-             &data_[offset + sizeof(int64_t)],
+             &data[offset + sizeof(int64_t)],
              sizeof(int32_t));
       memcpy(reinterpret_cast<void*>(&d.months),
-             &data_[offset + sizeof(int64_t) + sizeof(int32_t)],
+             &data[offset + sizeof(int64_t) + sizeof(int32_t)],
              sizeof(int32_t));
       return d;
     }
     case PropertyType::GEOGRAPHY: {
       int32_t strOffset;
       int32_t strLen;
-      memcpy(reinterpret_cast<void*>(&strOffset), &data_[offset], sizeof(int32_t));
-      memcpy(reinterpret_cast<void*>(&strLen), &data_[offset + sizeof(int32_t)], sizeof(int32_t));
-      if (static_cast<size_t>(strOffset) == data_.size() && strLen == 0) {
+      memcpy(reinterpret_cast<void*>(&strOffset), &data[offset], sizeof(int32_t));
+      memcpy(reinterpret_cast<void*>(&strLen), &data[offset + sizeof(int32_t)], sizeof(int32_t));
+      if (static_cast<size_t>(strOffset) == data.size() && strLen == 0) {
         return Value::kEmpty;  // Is it ok to return Value::kEmpty?
       }
-      CHECK_LT(strOffset, data_.size());
-      auto wkb = std::string(&data_[strOffset], strLen);
+      CHECK_LT(strOffset, data.size());
+      auto wkb = std::string(&data[strOffset], strLen);
       // Parse a geography from the wkb, normalize it and then verify its validity.
       auto geogRet = Geography::fromWKB(wkb, true, true);
       if (!geogRet.ok()) {
@@ -209,7 +215,7 @@ Value RowReaderV2::getValueByIndex(const int64_t index) const {
     case PropertyType::UNKNOWN:
       break;
   }
-  LOG(FATAL) << "Should not reach here, illegal property type: " << static_cast<int>(field->type());
+  LOG(FATAL) << "Should not reach here, illegal property type: " << static_cast<int>(type);
   return Value::kNullBadType;
 }
 
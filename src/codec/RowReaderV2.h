@@ -20,6 +20,8 @@ class RowReaderWrapper;
  */
 class RowReaderV2 {
   friend class RowReaderWrapper;
+  friend class RowDecoder;
+  friend class RowReaderV3;
 
   FRIEND_TEST(RowReaderV2, encodedData);
 
@@ -50,9 +52,19 @@ class RowReaderV2 {
     return data_.toString();
   }
 
+  folly::StringPiece rowData() const noexcept {
+    return data_;
+  }
+
  private:
   bool resetImpl(meta::NebulaSchemaProvider const* schema, folly::StringPiece row);
 
+  // Decode the value of the given type at the offset of the row
+  static Value decodeField(folly::StringPiece data,
+                           nebula::cpp2::PropertyType type,
+                           size_t size,
+                           size_t offset);
+
  private:
   meta::NebulaSchemaProvider const* schema_;
   folly::StringPiece data_;
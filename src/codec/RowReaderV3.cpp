@@ -0,0 +1,151 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "codec/RowReaderV3.h"
+
+#include "codec/RowReaderV2.h"
+
+namespace nebula {
+
+using nebula::cpp2::PropertyType;
+
+bool RowReaderV3::resetImpl(meta::NebulaSchemaProvider const* schema, folly::StringPiece row) {
+  schema_ = schema;
+  data_ = row;
+
+  DCHECK(!!schema_);
+
+  size_t numVerBytes = data_[0] & 0x07;
+  headerLen_ = numVerBytes + 1;
+  offsetWidth_ = 1 << ((data_[0] >> 5) & 0x03);
+
+#ifndef NDEBUG
+  // Get the schema version
+  SchemaVer schemaVer = 0;
+  if (numVerBytes > 0) {
+    memcpy(reinterpret_cast<void*>(&schemaVer), &data_[1], numVerBytes);
+  }
+  DCHECK_EQ(schemaVer, schema_->getVersion());
+#endif
+
+  // Null flags
+  size_t numNullables = schema_->getNumNullableFields();
+  if (numNullables > 0) {
+    numNullBytes_ = ((numNullables - 1) >> 3) + 1;
+  } else {
+    numNullBytes_ = 0;
+  }
+  dataBase_ = headerLen_ + numNullBytes_ + offsetWidth_ * schema_->getNumFields();
+  if (dataBase_ + sizeof(int64_t) > data_.size()) {
+    LOG(WARNING) << "Row data is too short: " << toHexStr(row);
+    return false;
+  }
+
+  return true;
+}
+
+bool RowReaderV3::isNull(size_t pos) const {
+  size_t offset = headerLen_ + (pos >> 3);
+  return (data_[offset] & (0x80 >> (pos & 0x07))) != 0;
+}
+
+size_t RowReaderV3::endOffset(size_t index) const {
+  const char* p = data_.data() + headerLen_ + numNullBytes_ + offsetWidth_ * index;
+  switch (offsetWidth_) {
+    case sizeof(uint8_t):
+      return static_cast<uint8_t>(*p);
+    case sizeof(uint16_t): {
+      uint16_t val;
+      memcpy(reinterpret_cast<void*>(&val), p, sizeof(uint16_t));
+      return val;
+    }
+    default: {
+      uint32_t val;
+      memcpy(reinterpret_cast<void*>(&val), p, sizeof(uint32_t));
+      return val;
+    }
+  }
+}
+
+Value RowReaderV3::getValueByName(const std::string& prop) const {
+  int64_t index = schema_->getFieldIndex(prop);
+  return getValueByIndex(index);
+}
+
+Value RowReaderV3::getValueByIndex(const int64_t index) const {
+  if (index < 0 || static_cast<size_t>(index) >= schema_->getNumFields()) {
+    return Value(NullType::UNKNOWN_PROP);
+  }
+
+  auto field = schema_->field(index);
+  if (field->nullable() && isNull(field->nullFlagPos())) {
+    return NullType::__NULL__;
+  }
+
+  size_t begin = index == 0 ? 0 : endOffset(index - 1);
+  size_t end = endOffset(index);
+  CHECK_LE(begin, end);
+  CHECK_LE(dataBase_ + end, data_.size() - sizeof(int64_t));
+  size_t len = end - begin;
+  size_t offset = dataBase_ + begin;
+
+  switch (field->type()) {
+    case PropertyType::BOOL: {
+      return len > 0 && data_[offset] != 0;
+    }
+    case PropertyType::INT8:
+    case PropertyType::INT16:
+    case PropertyType::INT32:
+    case PropertyType::INT64:
+    case PropertyType::TIMESTAMP: {
+      CHECK_LE(len, sizeof(uint64_t));
+      uint64_t zigzag = 0;
+      memcpy(reinterpret_cast<void*>(&zigzag), &data_[offset], len);
+      return static_cast<int64_t>((zigzag >> 1) ^ (~(zigzag & 1) + 1));
+    }
+    case PropertyType::FIXED_STRING: {
+      // pad the trailing '\0' like version 2
+      std::string str(&data_[offset], len);
+      str.resize(field->size(), '\0');
+      return str;
+    }
+    case PropertyType::STRING: {
+      return std::string(&data_[offset], len);
+    }
+    case PropertyType::GEOGRAPHY: {
+      if (len == 0) {
+        return Value::kEmpty;
+      }
+      // Parse a geography from the wkb, normalize it and then verify its validity.
+      auto geogRet = Geography::fromWKB(std::string(&data_[offset], len), true, true);
+      if (!geogRet.ok()) {
+        LOG(WARNING) << "Geography::fromWKB failed: " << geogRet.status();
+        return Value::kNullBadData;
+      }
+      return std::move(geogRet).value();
+    }
+    case PropertyType::FLOAT:
+    case PropertyType::DOUBLE:
+    case PropertyType::VID:
+    case PropertyType::DATE:
+    case PropertyType::TIME:
+    case PropertyType::DATETIME:
+    case PropertyType::DURATION: {
+      // stored the same as version 2
+      CHECK_EQ(len, field->size());
+      return RowReaderV2::decodeField(data_, field->type(), field->size(), offset);
+    }
+    case PropertyType::UNKNOWN:
+      break;
+  }
+  LOG(FATAL) << "Should not reach here, illegal property type: " << static_cast<int>(field->type());
+  return Value::kNullBadType;
+}
+
+int64_t RowReaderV3::getTimestamp() const noexcept {
+  return *reinterpret_cast<const int64_t*>(data_.begin() + (data_.size() - sizeof(int64_t)));
+}
+
+}  // namespace nebula
@@ -0,0 +1,76 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef CODEC_ROWREADERV3_H_
+#define CODEC_ROWREADERV3_H_
+
+#include "common/base/Base.h"
+#include "common/meta/NebulaSchemaProvider.h"
+
+namespace nebula {
+
+class RowReaderWrapper;
+
+/**
+ * This class decodes the data from version 3, see RowWriterV3
+ */
+class RowReaderV3 {
+  friend class RowReaderWrapper;
+
+ public:
+  ~RowReaderV3() = default;
+
+  Value getValueByName(const std::string& prop) const;
+  Value getValueByIndex(const int64_t index) const;
+  int64_t getTimestamp() const noexcept;
+
+  size_t headerLen() const noexcept {
+    return headerLen_;
+  }
+
+  const meta::NebulaSchemaProvider* getSchema() const {
+    return schema_;
+  }
+
+  SchemaVer schemaVer() const noexcept {
+    return schema_->getVersion();
+  }
+
+  size_t numFields() const noexcept {
+    return schema_->getNumFields();
+  }
+
+  const std::string getData() const {
+    return data_.toString();
+  }
+
+  folly::StringPiece rowData() const noexcept {
+    return data_;
+  }
+
+ private:
+  bool resetImpl(meta::NebulaSchemaProvider const* schema, folly::StringPiece row);
+
+ private:
+  meta::NebulaSchemaProvider const* schema_;
+  folly::StringPiece data_;
+  size_t headerLen_;
+  size_t numNullBytes_;
+  // width of an entry of the offset table
+  size_t offsetWidth_;
+  // start of the data area
+  size_t dataBase_;
+
+  RowReaderV3() = default;
+
+  // Check whether the flag at the given position is set or not
+  bool isNull(size_t pos) const;
+
+  // The end offset of the content of the index-th field in the data area
+  size_t endOffset(size_t index) const;
+};
+
+}  // namespace nebula
+#endif  // CODEC_ROWREADERV3_H_
@@ -80,17 +80,23 @@ RowReaderWrapper RowReaderWrapper::getRowReader(
 RowReaderWrapper::RowReaderWrapper(const meta::NebulaSchemaProvider* schema,
                                    const folly::StringPiece& row,
                                    int32_t& readerVer) {
-  CHECK_EQ(readerVer, 2);
-  CHECK_NOTNULL(schema);
-  readerV2_.resetImpl(schema, row);
-  currReader_ = &readerV2_;
+  reset(schema, row, readerVer);
 }
 
 bool RowReaderWrapper::reset(meta::NebulaSchemaProvider const* schema,
                              folly::StringPiece row,
                              int32_t readerVer) {
-  CHECK_EQ(readerVer, 2);
   CHECK_NOTNULL(schema);
+  currReader_ = nullptr;
+  currReaderV3_ = nullptr;
+  if (readerVer == 3) {
+    if (!readerV3_.resetImpl(schema, row)) {
+      return false;
+    }
+    currReaderV3_ = &readerV3_;
+    return true;
+  }
+  CHECK_EQ(readerVer, 2);
   readerV2_.resetImpl(schema, row);
   currReader_ = &readerV2_;
   return true;
@@ -98,6 +104,7 @@ bool RowReaderWrapper::reset(meta::NebulaSchemaProvider const* schema,
 
 bool RowReaderWrapper::reset(meta::NebulaSchemaProvider const* schema, folly::StringPiece row) {
   currReader_ = nullptr;
+  currReaderV3_ = nullptr;
   if (schema == nullptr) {
     return false;
   }
@@ -114,6 +121,7 @@ bool RowReaderWrapper::reset(
     const std::vector<std::shared_ptr<const meta::NebulaSchemaProvider>>& schemas,
     folly::StringPiece row) {
   currReader_ = nullptr;
+  currReaderV3_ = nullptr;
   SchemaVer schemaVer;
   int32_t readerVer;
   RowReaderWrapper::getVersions(row, schemaVer, readerVer);
@@ -147,7 +155,7 @@ void RowReaderWrapper::getVersions(const folly::StringPiece& row,
     // schema version. If the number is zero, no schema version
     // presents
     verBytes = row[index++] >> 5;
-  } else if (readerVer == 2) {
+  } else if (readerVer == 2 || readerVer == 3) {
     // The last three bits indicate the number of bytes for the
     // schema version. If the number is zero, no schema version
     // presents
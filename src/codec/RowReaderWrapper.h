@@ -9,6 +9,7 @@
 #include <gtest/gtest_prod.h>
 
 #include "codec/RowReaderV2.h"
+#include "codec/RowReaderV3.h"
 #include "common/base/Base.h"
 #include "common/datatypes/Value.h"
 #include "common/meta/NebulaSchemaProvider.h"
@@ -17,7 +18,7 @@
 namespace nebula {
 
 /**
- * @brief A wrapper class to hide details of RowReaderV1 and RowReaderV2
+ * @brief A wrapper class to hide details of RowReaderV2 and RowReaderV3
  */
 class RowReaderWrapper {
   FRIEND_TEST(RowReaderV2, encodedData);
@@ -35,8 +36,7 @@ class RowReaderWrapper {
    * @param rhs
    */
   RowReaderWrapper(RowReaderWrapper&& rhs) {
-    this->readerV2_ = std::move(rhs.readerV2_);
-    this->currReader_ = &(this->readerV2_);
+    *this = std::move(rhs);
   }
 
   /**
@@ -46,8 +46,15 @@ class RowReaderWrapper {
    * @return RowReaderWrapper&
    */
   RowReaderWrapper& operator=(RowReaderWrapper&& rhs) {
-    this->readerV2_ = std::move(rhs.readerV2_);
-    this->currReader_ = &(this->readerV2_);
+    if (rhs.currReaderV3_ != nullptr) {
+      this->readerV3_ = std::move(rhs.readerV3_);
+      this->currReaderV3_ = &(this->readerV3_);
+      this->currReader_ = nullptr;
+    } else {
+      this->readerV2_ = std::move(rhs.readerV2_);
+      this->currReader_ = &(this->readerV2_);
+      this->currReaderV3_ = nullptr;
+    }
     return *this;
   }
 
@@ -144,46 +151,78 @@ class RowReaderWrapper {
              folly::StringPiece row);
 
   Value getValueByName(const std::string& prop) const {
+    if (currReaderV3_ != nullptr) {
+      return currReaderV3_->getValueByName(prop);
+    }
     DCHECK(!!currReader_);
     return currReader_->getValueByName(prop);
   }
 
   Value getValueByIndex(const int64_t index) const {
+    if (currReaderV3_ != nullptr) {
+      return currReaderV3_->getValueByIndex(index);
+    }
     DCHECK(!!currReader_);
     return currReader_->getValueByIndex(index);
   }
 
   int64_t getTimestamp() const noexcept {
+    if (currReaderV3_ != nullptr) {
+      return currReaderV3_->getTimestamp();
+    }
     DCHECK(!!currReader_);
     return currReader_->getTimestamp();
   }
 
   // Return the number of bytes used for the header info
   size_t headerLen() const noexcept {
+    if (currReaderV3_ != nullptr) {
+      return currReaderV3_->headerLen();
+    }
     DCHECK(!!currReader_);
     return currReader_->headerLen();
   }
 
   SchemaVer schemaVer() const noexcept {
+    if (currReaderV3_ != nullptr) {
+      return currReaderV3_->schemaVer();
+    }
     DCHECK(!!currReader_);
     return currReader_->schemaVer();
   }
 
   size_t numFields() const noexcept {
+    if (currReaderV3_ != nullptr) {
+      return currReaderV3_->numFields();
+    }
     DCHECK(!!currReader_);
     return currReader_->numFields();
   }
 
   const meta::NebulaSchemaProvider* getSchema() const {
+    if (currReaderV3_ != nullptr) {
+      return currReaderV3_->getSchema();
+    }
     DCHECK(!!currReader_);
     return currReader_->getSchema();
   }
 
   const std::string getData() const {
+    if (currReaderV3_ != nullptr) {
+      return currReaderV3_->getData();
+    }
     DCHECK(!!currReader_);
     return currReader_->getData();
   }
 
+  folly::StringPiece rowData() const noexcept {
+    if (currReaderV3_ != nullptr) {
+      return currReaderV3_->rowData();
+    }
+    DCHECK(!!currReader_);
+    return currReader_->rowData();
+  }
+
   /**
    * @brief Get schema version and reader version by data
    *
@@ -211,7 +250,7 @@ class RowReaderWrapper {
    * @brief Return whether wrapper points to a valid data
    */
   bool operator!=(std::nullptr_t) const noexcept {
-    return currReader_ != nullptr;
+    return currReader_ != nullptr || currReaderV3_ != nullptr;
   }
 
   /**
@@ -247,11 +286,21 @@ class RowReaderWrapper {
    */
   void reset() noexcept {
     currReader_ = nullptr;
+    currReaderV3_ = nullptr;
+  }
+
+  /**
+   * @brief Return the version of the row format, 2 or 3
+   */
+  int32_t readerVer() const noexcept {
+    return currReaderV3_ != nullptr ? 3 : 2;
   }
 
  private:
   RowReaderV2 readerV2_;
   RowReaderV2* currReader_ = nullptr;
+  RowReaderV3 readerV3_;
+  RowReaderV3* currReaderV3_ = nullptr;
 };
 
 }  // namespace nebula
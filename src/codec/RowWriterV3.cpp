@@ -0,0 +1,150 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "codec/RowWriterV3.h"
+
+namespace nebula {
+
+using nebula::cpp2::PropertyType;
+
+namespace {
+
+template <typename T>
+T load(const char* p) {
+  T val;
+  memcpy(reinterpret_cast<void*>(&val), p, sizeof(T));
+  return val;
+}
+
+// Zigzag encode the value and append its least non-zero bytes
+void appendInt(std::string& data, int64_t val) {
+  uint64_t zigzag = (static_cast<uint64_t>(val) << 1) ^ static_cast<uint64_t>(val >> 63);
+  while (zigzag != 0) {
+    data.push_back(static_cast<char>(zigzag & 0xFF));
+    zigzag >>= 8;
+  }
+}
+
+template <typename T>
+void appendOffset(std::string& buf, size_t offset) {
+  T val = static_cast<T>(offset);
+  buf.append(reinterpret_cast<const char*>(&val), sizeof(T));
+}
+
+}  // namespace
+
+// static
+std::string RowWriterV3::encode(const meta::NebulaSchemaProvider* schema,
+                                folly::StringPiece v2Row) {
+  CHECK(!!schema);
+  CHECK_GT(v2Row.size(), sizeof(int64_t));
+  CHECK_EQ(0x08, v2Row[0] & 0x18) << "Not a row of version 2";
+
+  size_t verBytes = v2Row[0] & 0x07;
+  size_t headerLen = verBytes + 1;
+  size_t numNullables = schema->getNumNullableFields();
+  size_t numNullBytes = numNullables > 0 ? ((numNullables - 1) >> 3) + 1 : 0;
+  const char* fixed = v2Row.data() + headerLen + numNullBytes;
+  auto isNull = [&v2Row, headerLen](size_t pos) {
+    return (v2Row[headerLen + (pos >> 3)] & (0x80 >> (pos & 0x07))) != 0;
+  };
+
+  auto numFields = schema->getNumFields();
+  std::string data;
+  data.reserve(v2Row.size());
+  std::vector<size_t> ends;
+  ends.reserve(numFields);
+  for (size_t i = 0; i < numFields; ++i) {
+    auto field = schema->field(i);
+    if (field->nullable() && isNull(field->nullFlagPos())) {
+      ends.emplace_back(data.size());
+      continue;
+    }
+    const char* p = fixed + field->offset();
+    switch (field->type()) {
+      case PropertyType::BOOL:
+        if (*p) {
+          data.push_back(0x01);
+        }
+        break;
+      case PropertyType::INT8:
+        appendInt(data, static_cast<int8_t>(*p));
+        break;
+      case PropertyType::INT16:
+        appendInt(data, load<int16_t>(p));
+        break;
+      case PropertyType::INT32:
+        appendInt(data, load<int32_t>(p));
+        break;
+      case PropertyType::INT64:
+      case PropertyType::TIMESTAMP:
+        appendInt(data, load<int64_t>(p));
+        break;
+      case PropertyType::FIXED_STRING: {
+        // only trim the trailing padding, a '\0' inside the value is kept
+        size_t len = field->size();
+        while (len > 0 && p[len - 1] == '\0') {
+          --len;
+        }
+        data.append(p, len);
+        break;
+      }
+      case PropertyType::STRING:
+      case PropertyType::GEOGRAPHY: {
+        auto strOffset = load<int32_t>(p);
+        auto strLen = load<int32_t>(p + sizeof(int32_t));
+        if (strLen > 0) {
+          CHECK_LE(static_cast<size_t>(strOffset + strLen), v2Row.size());
+          data.append(v2Row.data() + strOffset, strLen);
+        }
+        break;
+      }
+      case PropertyType::FLOAT:
+      case PropertyType::DOUBLE:
+      case PropertyType::VID:
+      case PropertyType::DATE:
+      case PropertyType::TIME:
+      case PropertyType::DATETIME:
+      case PropertyType::DURATION:
+        data.append(p, field->size());
+        break;
+      case PropertyType::UNKNOWN:
+        LOG(FATAL) << "Unknown property type of " << field->name();
+        break;
+    }
+    ends.emplace_back(data.size());
+  }
+
+  uint8_t widthCode = 0;
+  size_t width = sizeof(uint8_t);
+  if (data.size() > std::numeric_limits<uint16_t>::max()) {
+    widthCode = 2;
+    width = sizeof(uint32_t);
+  } else if (data.size() > std::numeric_limits<uint8_t>::max()) {
+    widthCode = 1;
+    width = sizeof(uint16_t);
+  }
+
+  std::string buf;
+  buf.reserve(headerLen + numNullBytes + width * numFields + data.size() + sizeof(int64_t));
+  buf.push_back(static_cast<char>(0x10 | (widthCode << 5) | verBytes));
+  // schema version and NULL flags are the same as version 2
+  buf.append(v2Row.data() + 1, verBytes + numNullBytes);
+  for (auto end : ends) {
+    if (widthCode == 0) {
+      appendOffset<uint8_t>(buf, end);
+    } else if (widthCode == 1) {
+      appendOffset<uint16_t>(buf, end);
+    } else {
+      appendOffset<uint32_t>(buf, end);
+    }
+  }
+  buf.append(data);
+  // timestamp
+  buf.append(v2Row.data() + v2Row.size() - sizeof(int64_t), sizeof(int64_t));
+  return buf;
+}
+
+}  // namespace nebula
@@ -0,0 +1,69 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef CODEC_ROWWRITERV3_H_
+#define CODEC_ROWWRITERV3_H_
+
+#include "common/base/Base.h"
+#include "common/meta/NebulaSchemaProvider.h"
+
+namespace nebula {
+
+/********************************************************************************
+
+  Encoder version 3
+
+  Version 3 is an optional format of a tag or an edge, selected by the
+  `row_format' of its schema. It's compact for the wide schemas with many
+  nullable or small properties, which waste the fixed width of version 2.
+
+  The header byte is
+
+                 0 w w 1 0 v v v
+
+  The middle two bits are the encoder version like version 2, the right three
+  bits indicate the number of bytes used for the schema version, and the two
+  `w' bits indicate the width of an entry of the offset table, which is 1, 2
+  or 4 bytes for 00, 01 or 10.
+
+  Every property has an entry in the offset table, which is the end offset of
+  its content in the data area. The content of the i-th property starts at
+  the end of the (i-1)-th, so any property is found in O(1) time and its
+  length is implied by the two offsets:
+
+        BOOL                          0 byte for false, 1 byte for true
+        INT8/16/32/64, TIMESTAMP      zigzag encoded, in the least bytes of
+                                      little endian, 0 byte for 0
+        FLOAT, DOUBLE, VID, DATE,     the same as version 2
+        TIME, DATETIME, DURATION
+        FIXED_STRING                  without the trailing '\0'
+        STRING, GEOGRAPHY             in place, no offset or length
+        NULL                          0 byte, with the NULL flag
+
+  The NULL flags are the same as version 2. Here is the overall byte sequence
+
+    <header> <schema version> <NULL flags> <offset table> <data> <timestamp>
+       |             |             |              |          |        |
+     1 byte     0 - 7 bytes     0+ bytes   N * width bytes  0+ bytes  8 bytes
+
+********************************************************************************/
+class RowWriterV3 final {
+ public:
+  /**
+   * @brief Transcode a row encoded by RowWriterV2 into version 3. RowWriterV2 checks and
+   * converts the values and fills the defaults, so that a row is always set by it.
+   *
+   * @param schema Schema of the row
+   * @param v2Row Finished row of version 2, with the timestamp
+   * @return std::string The row of version 3
+   */
+  static std::string encode(const meta::NebulaSchemaProvider* schema, folly::StringPiece v2Row);
+
+ private:
+  RowWriterV3() = delete;
+};
+
+}  // namespace nebula
+#endif  // CODEC_ROWWRITERV3_H_
@@ -0,0 +1,122 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "codec/RowDecoder.h"
+#include "codec/RowReaderWrapper.h"
+#include "codec/RowWriterV2.h"
+#include "common/base/Base.h"
+
+namespace nebula {
+
+using nebula::cpp2::PropertyType;
+
+TEST(RowDecoder, Projection) {
+  meta::NebulaSchemaProvider schema(3 /*Schema version*/);
+  schema.addField("bool_col", PropertyType::BOOL);
+  schema.addField("int32_col", PropertyType::INT32, 0, true);
+  schema.addField("str_col", PropertyType::STRING);
+  schema.addField("fixed_col", PropertyType::FIXED_STRING, 12);
+  schema.addField("double_col", PropertyType::DOUBLE, 0, true);
+  schema.addField("date_col", PropertyType::DATE);
+
+  RowWriterV2 writer(&schema);
+  ASSERT_EQ(WriteResult::SUCCEEDED, writer.set("bool_col", true));
+  ASSERT_EQ(WriteResult::SUCCEEDED, writer.set("int32_col", 123));
+  ASSERT_EQ(WriteResult::SUCCEEDED, writer.set("str_col", std::string("Hello world!")));
+  ASSERT_EQ(WriteResult::SUCCEEDED, writer.set("fixed_col", std::string("Nebula Graph")));
+  ASSERT_EQ(WriteResult::SUCCEEDED, writer.setNull("double_col"));
+  ASSERT_EQ(WriteResult::SUCCEEDED, writer.set("date_col", Date(2020, 2, 20)));
+  ASSERT_EQ(WriteResult::SUCCEEDED, writer.finish());
+  std::string encoded = std::move(writer).moveEncodedStr();
+
+  std::vector<std::string> props = {
+      "date_col", "", "str_col", "double_col", "no_such_col", "fixed_col", "int32_col"};
+  RowDecoder decoder(&schema, props);
+  EXPECT_FALSE(decoder.fixedOnly());
+  std::vector<Value> values;
+  ASSERT_TRUE(decoder.decode(encoded, values));
+  ASSERT_EQ(props.size(), values.size());
+
+  // The same as the values read by name
+  auto reader = RowReaderWrapper::getRowReader(&schema, encoded);
+  for (size_t i = 0; i < props.size(); ++i) {
+    if (props[i].empty()) {
+      EXPECT_TRUE(values[i].empty());
+      continue;
+    }
+    EXPECT_EQ(reader->getValueByName(props[i]), values[i]) << props[i];
+  }
+  EXPECT_EQ(Value(NullType::__NULL__), values[3]);
+  EXPECT_EQ(Value(NullType::UNKNOWN_PROP), values[4]);
+
+  // Too short for the schema
+  EXPECT_FALSE(decoder.decode(folly::StringPiece(encoded.data(), 4), values));
+}
+
+TEST(RowDecoder, FixedOnly) {
+  meta::NebulaSchemaProvider schema;
+  schema.addField("bool_col", PropertyType::BOOL);
+  schema.addField("int8_col", PropertyType::INT8);
+  schema.addField("int16_col", PropertyType::INT16);
+  schema.addField("int32_col", PropertyType::INT32);
+  schema.addField("int64_col", PropertyType::INT64);
+  schema.addField("float_col", PropertyType::FLOAT);
+  schema.addField("double_col", PropertyType::DOUBLE);
+  schema.addField("timestamp_col", PropertyType::TIMESTAMP);
+  schema.addField("str_col", PropertyType::STRING);
+
+  RowWriterV2 writer(&schema);
+  ASSERT_EQ(WriteResult::SUCCEEDED, writer.set("bool_col", false));
+  ASSERT_EQ(WriteResult::SUCCEEDED, writer.set("int8_col", -8));
+  ASSERT_EQ(WriteResult::SUCCEEDED, writer.set("int16_col", -16));
+  ASSERT_EQ(WriteResult::SUCCEEDED, writer.set("int32_col", -32));
+  ASSERT_EQ(WriteResult::SUCCEEDED, writer.set("int64_col", -64));
+  ASSERT_EQ(WriteResult::SUCCEEDED, writer.set("float_col", 3.14f));
+  ASSERT_EQ(WriteResult::SUCCEEDED, writer.set("double_col", 2.718));
+  ASSERT_EQ(WriteResult::SUCCEEDED, writer.set("timestamp_col", 1582183355));
+  ASSERT_EQ(WriteResult::SUCCEEDED, writer.set("str_col", std::string("Hello world!")));
+  ASSERT_EQ(WriteResult::SUCCEEDED, writer.finish());
+  std::string encoded = std::move(writer).moveEncodedStr();
+
+  // All but the string column
+  std::vector<std::string> props = {"timestamp_col",
+                                    "double_col",
+                                    "float_col",
+                                    "int64_col",
+                                    "int32_col",
+                                    "int16_col",
+                                    "int8_col",
+                                    "bool_col"};
+  RowDecoder decoder(&schema, props);
+  EXPECT_TRUE(decoder.fixedOnly());
+  auto reader = RowReaderWrapper::getRowReader(&schema, encoded);
+  std::vector<Value> values;
+  // decode twice to reuse the buffer
+  for (int round = 0; round < 2; ++round) {
+    ASSERT_TRUE(decoder.decode(encoded, values));
+    ASSERT_EQ(props.size(), values.size());
+    for (size_t i = 0; i < props.size(); ++i) {
+      EXPECT_EQ(reader->getValueByName(props[i]), values[i]) << props[i];
+    }
+  }
+
+  props.emplace_back("str_col");
+  RowDecoder withString(&schema, props);
+  EXPECT_FALSE(withString.fixedOnly());
+  ASSERT_TRUE(withString.decode(encoded, values));
+  EXPECT_EQ(Value("Hello world!"), values.back());
+}
+
+}  // namespace nebula
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  folly::init(&argc, &argv, true);
+  google::SetStderrLogging(google::INFO);
+
+  return RUN_ALL_TESTS();
+}
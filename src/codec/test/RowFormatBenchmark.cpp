@@ -0,0 +1,121 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include <folly/Benchmark.h>
+
+#include "codec/RowReaderWrapper.h"
+#include "codec/RowWriterV2.h"
+#include "codec/RowWriterV3.h"
+#include "common/base/Base.h"
+
+using nebula::RowReaderWrapper;
+using nebula::RowWriterV2;
+using nebula::RowWriterV3;
+using nebula::cpp2::PropertyType;
+using nebula::meta::NebulaSchemaProvider;
+
+// A wide edge schema, of which only a few nullable props are set in a row
+NebulaSchemaProvider schemaWide;
+std::string v2Row;  // NOLINT
+std::string v3Row;  // NOLINT
+
+void prepareRows(size_t numRepeats) {
+  int32_t index = 1;
+  for (size_t i = 0; i < numRepeats; i++) {
+    schemaWide.addField(folly::stringPrintf("col%03d", index++), PropertyType::BOOL, 0, true);
+    schemaWide.addField(folly::stringPrintf("col%03d", index++), PropertyType::INT64, 0, true);
+    schemaWide.addField(folly::stringPrintf("col%03d", index++), PropertyType::INT32, 0, true);
+    schemaWide.addField(folly::stringPrintf("col%03d", index++), PropertyType::DOUBLE, 0, true);
+    schemaWide.addField(folly::stringPrintf("col%03d", index++), PropertyType::STRING, 0, true);
+    schemaWide.addField(
+        folly::stringPrintf("col%03d", index++), PropertyType::FIXED_STRING, 32, true);
+  }
+
+  RowWriterV2 writer(&schemaWide);
+  for (size_t i = 0; i < schemaWide.getNumFields(); i += 6 * 4) {
+    writer.set(i, true);
+    writer.set(i + 1, static_cast<int64_t>(i));
+    writer.set(i + 4, std::string("Hello world!"));
+    writer.set(i + 5, std::string("Nebula"));
+  }
+  writer.finish();
+  v2Row = writer.moveEncodedStr();
+  v3Row = RowWriterV3::encode(&schemaWide, v2Row);
+  LOG(INFO) << "Encoded size of version 2: " << v2Row.size() << ", version 3: " << v3Row.size();
+}
+
+void readRow(const std::string& row, int32_t iters) {
+  for (int32_t i = 0; i < iters; i++) {
+    auto reader = RowReaderWrapper::getRowReader(&schemaWide, row);
+    for (size_t j = 0; j < schemaWide.getNumFields(); j++) {
+      auto v = reader->getValueByIndex(j);
+      folly::doNotOptimizeAway(v);
+    }
+  }
+}
+
+void readOneProp(const std::string& row, int32_t iters) {
+  for (int32_t i = 0; i < iters; i++) {
+    auto reader = RowReaderWrapper::getRowReader(&schemaWide, row);
+    auto v = reader->getValueByName("col050");
+    folly::doNotOptimizeAway(v);
+  }
+}
+
+/*************************
+ * Beginning of benchmarks
+ ************************/
+
+BENCHMARK(ReadWideRowV2, iters) {
+  readRow(v2Row, iters);
+}
+
+BENCHMARK_RELATIVE(ReadWideRowV3, iters) {
+  readRow(v3Row, iters);
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(ReadOnePropV2, iters) {
+  readOneProp(v2Row, iters);
+}
+
+BENCHMARK_RELATIVE(ReadOnePropV3, iters) {
+  readOneProp(v3Row, iters);
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(WriteWideRowV2, iters) {
+  for (size_t i = 0; i < iters; i++) {
+    RowWriterV2 writer(&schemaWide);
+    writer.set(1, 1);
+    writer.finish();
+    auto encoded = writer.moveEncodedStr();
+    folly::doNotOptimizeAway(encoded);
+  }
+}
+
+BENCHMARK_RELATIVE(WriteWideRowV3, iters) {
+  for (size_t i = 0; i < iters; i++) {
+    RowWriterV2 writer(&schemaWide);
+    writer.set(1, 1);
+    writer.finish();
+    auto encoded = RowWriterV3::encode(&schemaWide, writer.getEncodedStr());
+    folly::doNotOptimizeAway(encoded);
+  }
+}
+/*************************
+ * End of benchmarks
+ ************************/
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv, true);
+
+  prepareRows(40);
+
+  folly::runBenchmarks();
+  return 0;
+}
@@ -0,0 +1,124 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "codec/RowDecoder.h"
+#include "codec/RowReaderWrapper.h"
+#include "codec/RowWriterV2.h"
+#include "codec/RowWriterV3.h"
+#include "common/base/Base.h"
+
+namespace nebula {
+
+using nebula::cpp2::PropertyType;
+
+TEST(RowReaderV3, AllTypes) {
+  meta::NebulaSchemaProvider schema(7 /*Schema version*/);
+  schema.addField("bool_col", PropertyType::BOOL);
+  schema.addField("false_col", PropertyType::BOOL);
+  schema.addField("int8_col", PropertyType::INT8);
+  schema.addField("int16_col", PropertyType::INT16);
+  schema.addField("int32_col", PropertyType::INT32, 0, true);
+  schema.addField("int64_col", PropertyType::INT64);
+  schema.addField("min_col", PropertyType::INT64);
+  schema.addField("zero_col", PropertyType::INT64);
+  schema.addField("float_col", PropertyType::FLOAT);
+  schema.addField("double_col", PropertyType::DOUBLE, 0, true);
+  schema.addField("str_col", PropertyType::STRING);
+  schema.addField("empty_col", PropertyType::STRING);
+  schema.addField("fixed_col", PropertyType::FIXED_STRING, 12);
+  schema.addField("short_col", PropertyType::FIXED_STRING, 12);
+  schema.addField("nul_col", PropertyType::FIXED_STRING, 12);
+  schema.addField("timestamp_col", PropertyType::TIMESTAMP);
+  schema.addField("date_col", PropertyType::DATE);
+  schema.addField("time_col", PropertyType::TIME);
+  schema.addField("datetime_col", PropertyType::DATETIME);
+  schema.addField("geo_col", PropertyType::GEOGRAPHY);
+  schema.addField("null_col", PropertyType::STRING, 0, true);
+
+  RowWriterV2 writer(&schema);
+  ASSERT_EQ(WriteResult::SUCCEEDED, writer.set("bool_col", true));
+  ASSERT_EQ(WriteResult::SUCCEEDED, writer.set("false_col", false));
+  ASSERT_EQ(WriteResult::SUCCEEDED, writer.set("int8_col", -8));
+  ASSERT_EQ(WriteResult::SUCCEEDED, writer.set("int16_col", 1600));
+  ASSERT_EQ(WriteResult::SUCCEEDED, writer.set("int32_col", -320000));
+  ASSERT_EQ(WriteResult::SUCCEEDED, writer.set("int64_col", std::numeric_limits<int64_t>::max()));
+  ASSERT_EQ(WriteResult::SUCCEEDED, writer.set("min_col", std::numeric_limits<int64_t>::min()));
+  ASSERT_EQ(WriteResult::SUCCEEDED, writer.set("zero_col", 0));
+  ASSERT_EQ(WriteResult::SUCCEEDED, writer.set("float_col", 3.14f));
+  ASSERT_EQ(WriteResult::SUCCEEDED, writer.setNull("double_col"));
+  ASSERT_EQ(WriteResult::SUCCEEDED, writer.set("str_col", std::string("Hello world!")));
+  ASSERT_EQ(WriteResult::SUCCEEDED, writer.set("empty_col", std::string("")));
+  ASSERT_EQ(WriteResult::SUCCEEDED, writer.set("fixed_col", std::string("Nebula Graph")));
+  ASSERT_EQ(WriteResult::SUCCEEDED, writer.set("short_col", std::string("Nebula")));
+  // The '\0' inside a fixed string is kept
+  ASSERT_EQ(WriteResult::SUCCEEDED, writer.set("nul_col", std::string("Neb\0ula", 7)));
+  ASSERT_EQ(WriteResult::SUCCEEDED, writer.set("timestamp_col", 1582183355));
+  ASSERT_EQ(WriteResult::SUCCEEDED, writer.set("date_col", Date(2020, 2, 20)));
+  ASSERT_EQ(WriteResult::SUCCEEDED, writer.set("time_col", Time(10, 30, 45, 123456)));
+  ASSERT_EQ(WriteResult::SUCCEEDED,
+            writer.set("datetime_col", DateTime(2020, 2, 20, 10, 30, 45, 123456)));
+  ASSERT_EQ(WriteResult::SUCCEEDED, writer.set("geo_col", Geography(Point(Coordinate(1.5, 2.5)))));
+  ASSERT_EQ(WriteResult::SUCCEEDED, writer.setNull("null_col"));
+  ASSERT_EQ(WriteResult::SUCCEEDED, writer.finish());
+  std::string v2Row = std::move(writer).moveEncodedStr();
+
+  std::string v3Row = RowWriterV3::encode(&schema, v2Row);
+  EXPECT_LT(v3Row.size(), v2Row.size());
+
+  auto v2Reader = RowReaderWrapper::getRowReader(&schema, v2Row);
+  auto v3Reader = RowReaderWrapper::getRowReader(&schema, v3Row);
+  ASSERT_TRUE(!!v2Reader);
+  ASSERT_TRUE(!!v3Reader);
+  EXPECT_EQ(2, v2Reader->readerVer());
+  EXPECT_EQ(3, v3Reader->readerVer());
+  EXPECT_EQ(7, v3Reader->schemaVer());
+  EXPECT_EQ(v2Reader->getTimestamp(), v3Reader->getTimestamp());
+  for (size_t i = 0; i < schema.getNumFields(); ++i) {
+    EXPECT_EQ(v2Reader->getValueByIndex(i), v3Reader->getValueByIndex(i)) << schema.getFieldName(i);
+  }
+  EXPECT_EQ(Value(NullType::__NULL__), v3Reader->getValueByName("double_col"));
+  EXPECT_EQ(Value(NullType::UNKNOWN_PROP), v3Reader->getValueByName("no_such_col"));
+
+  // The compiled decoders only handle version 2
+  RowDecoder decoder(&schema, {"bool_col"});
+  std::vector<Value> values;
+  EXPECT_FALSE(decoder.decode(v3Row, values));
+}
+
+TEST(RowReaderV3, WideNullable) {
+  // A wide schema with most of the props not set
+  meta::NebulaSchemaProvider schema;
+  for (int32_t i = 0; i < 300; ++i) {
+    schema.addField(folly::stringPrintf("int_col%03d", i), PropertyType::INT64, 0, true);
+    schema.addField(folly::stringPrintf("str_col%03d", i), PropertyType::STRING, 0, true);
+  }
+
+  RowWriterV2 writer(&schema);
+  ASSERT_EQ(WriteResult::SUCCEEDED, writer.set("int_col000", 1));
+  ASSERT_EQ(WriteResult::SUCCEEDED, writer.set("str_col299", std::string(300, 'a')));
+  ASSERT_EQ(WriteResult::SUCCEEDED, writer.finish());
+  std::string v2Row = std::move(writer).moveEncodedStr();
+
+  // The data area needs 2 bytes offsets
+  std::string v3Row = RowWriterV3::encode(&schema, v2Row);
+  EXPECT_EQ(0x30, v3Row[0] & 0x78);
+  EXPECT_LT(v3Row.size() * 2, v2Row.size());
+
+  auto v2Reader = RowReaderWrapper::getRowReader(&schema, v2Row);
+  auto v3Reader = RowReaderWrapper::getRowReader(&schema, v3Row);
+  ASSERT_TRUE(!!v3Reader);
+  for (size_t i = 0; i < schema.getNumFields(); ++i) {
+    EXPECT_EQ(v2Reader->getValueByIndex(i), v3Reader->getValueByIndex(i)) << schema.getFieldName(i);
+  }
+  EXPECT_EQ(Value(1), v3Reader->getValueByName("int_col000"));
+  EXPECT_EQ(Value(NullType::__NULL__), v3Reader->getValueByName("int_col001"));
+
+  // Too short for the schema
+  EXPECT_FALSE(RowReaderWrapper::getRowReader(&schema, folly::StringPiece(v3Row.data(), 16)));
+}
+
+}  // namespace nebula
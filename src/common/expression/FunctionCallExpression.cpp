@@ -69,12 +69,39 @@ void FunctionCallExpression::resetFrom(Decoder& decoder) {
   }
 }
 
+void FunctionCallExpression::bindArgTypes(const std::vector<Value::Type>& argTypes) {
+  if (argTypes.size() != 1 || DCHECK_NOTNULL(args_)->numArgs() != 1) {
+    return;
+  }
+  auto type = argTypes.front();
+  if (type == Value::Type::__EMPTY__ || type == Value::Type::NULLVALUE) {
+    return;
+  }
+  unary_ = FunctionManager::getUnary(name_, type);
+  unaryType_ = unary_ == nullptr ? Value::Type::__EMPTY__ : type;
+  bindOnEval_ = false;
+}
+
 const Value& FunctionCallExpression::eval(ExpressionContext& ctx) {
-  std::vector<std::reference_wrapper<const Value>> parameter;
-  for (const auto& arg : DCHECK_NOTNULL(args_)->args()) {
-    parameter.emplace_back(arg->eval(ctx));
+  const auto& args = DCHECK_NOTNULL(args_)->args();
+  if (args.size() == 1) {
+    const auto& arg = args.front()->eval(ctx);
+    if (bindOnEval_) {
+      bindArgTypes({arg.type()});
+    }
+    if (unary_ != nullptr && arg.type() == unaryType_) {
+      result_ = unary_(arg);
+      return result_;
+    }
+    parameter_.clear();
+    parameter_.emplace_back(arg);
+  } else {
+    parameter_.clear();
+    for (const auto& arg : args) {
+      parameter_.emplace_back(arg->eval(ctx));
+    }
   }
-  result_ = DCHECK_NOTNULL(func_)(parameter);
+  result_ = DCHECK_NOTNULL(func_)(parameter_);
   return result_;
 }
 
@@ -96,9 +96,17 @@ class FunctionCallExpression final : public Expression {
     for (auto& arg : args_->args()) {
       arguments->addArgument(arg->clone());
     }
-    return FunctionCallExpression::make(pool_, name_, arguments);
+    auto* expr = FunctionCallExpression::make(pool_, name_, arguments);
+    expr->unaryType_ = unaryType_;
+    expr->unary_ = unary_;
+    expr->bindOnEval_ = bindOnEval_;
+    return expr;
   }
 
+  // Binds the entry point specialized for the types of the arguments, e.g. deduced by the
+  // validator. The generic function is still called for the arguments of other types.
+  void bindArgTypes(const std::vector<Value::Type>& argTypes);
+
   const std::string& name() const {
     return name_;
   }
@@ -137,6 +145,13 @@ class FunctionCallExpression final : public Expression {
   // runtime cache
   Value result_;
   FunctionManager::Function func_;
+  // the specialized entry point of a unary function, and the type of the argument it's bound for
+  Value::Type unaryType_{Value::Type::__EMPTY__};
+  FunctionManager::UnaryFunction unary_{nullptr};
+  // whether to bind the entry point by the type of the argument at the first evaluation
+  bool bindOnEval_{true};
+  // reused by each evaluation
+  std::vector<FunctionManager::ArgType> parameter_;
 };
 
 }  // namespace nebula
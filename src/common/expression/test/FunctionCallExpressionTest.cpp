@@ -129,4 +129,31 @@ TEST_F(FunctionCallExpressionTest, FunctionCallToStringTest) {
     EXPECT_EQ(ep->toString(), "now()");
   }
 }
+
+TEST_F(FunctionCallExpressionTest, BindArgTypes) {
+  {
+    // bound for int, evaluated with other types
+    auto *argList = ArgumentList::make(&pool);
+    argList->addArgument(ConstantExpression::make(&pool, -1.5));
+    auto *ep = FunctionCallExpression::make(&pool, "abs", argList);
+    ep->bindArgTypes({Value::Type::INT});
+    EXPECT_EQ(Value(1.5), Expression::eval(ep, gExpCtxt));
+    argList->setArg(0, ConstantExpression::make(&pool, -2));
+    EXPECT_EQ(Value(2), Expression::eval(ep, gExpCtxt));
+    argList->setArg(0, ConstantExpression::make(&pool, Value::kNullValue));
+    EXPECT_EQ(Value::kNullValue, Expression::eval(ep, gExpCtxt));
+    argList->setArg(0, ConstantExpression::make(&pool, "a"));
+    EXPECT_EQ(Value::kNullBadType, Expression::eval(ep, gExpCtxt));
+  }
+  {
+    // bound by the type of the argument at the first evaluation
+    auto *argList = ArgumentList::make(&pool);
+    argList->addArgument(ConstantExpression::make(&pool, "AbC"));
+    auto *ep = FunctionCallExpression::make(&pool, "toLower", argList);
+    EXPECT_EQ(Value("abc"), Expression::eval(ep, gExpCtxt));
+    EXPECT_EQ(Value("abc"), Expression::eval(ep->clone(), gExpCtxt));
+    argList->setArg(0, ConstantExpression::make(&pool, 1));
+    EXPECT_EQ(Value::kNullBadType, Expression::eval(ep, gExpCtxt));
+  }
+}
 }  // namespace nebula
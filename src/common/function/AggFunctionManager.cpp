@@ -287,8 +287,16 @@ Status AggFunctionManager::find(const std::string& func) {
   return Status::OK();
 }
 
+void AggFunctionManager::registerFunction(std::string func, AggFunction body) {
+  std::transform(func.begin(), func.end(), func.begin(), ::toupper);
+  auto& manager = instance();
+  std::unique_lock<std::shared_mutex> guard(manager.lock_);
+  manager.functions_[func] = std::move(body);
+}
+
 StatusOr<AggFunctionManager::AggFunction> AggFunctionManager::getInternal(std::string func) const {
   std::transform(func.begin(), func.end(), func.begin(), ::toupper);
+  std::shared_lock<std::shared_mutex> guard(lock_);
   // check existence
   auto iter = functions_.find(func);
   if (iter == functions_.end()) {
@@ -6,6 +6,8 @@
 #ifndef COMMON_FUNCTION_AGGFUNCTIONMANAGER_H_
 #define COMMON_FUNCTION_AGGFUNCTIONMANAGER_H_
 
+#include <shared_mutex>
+
 #include "common/base/Base.h"
 #include "common/base/Status.h"
 #include "common/base/StatusOr.h"
@@ -94,6 +96,15 @@ class AggData final {
     result_ = res;
   }
 
+  // The partial state of an aggregate UDF
+  const Value& state() const {
+    return state_;
+  }
+
+  Value& state() {
+    return state_;
+  }
+
   const Set* uniques() const {
     return uniques_.get();
   }
@@ -112,6 +123,7 @@ class AggData final {
   Value avg_;
   Value deviation_;
   Value result_;
+  Value state_;
   std::unique_ptr<Set> uniques_;
 };
 
@@ -130,6 +142,12 @@ class AggFunctionManager final {
    */
   static Status find(const std::string& func);
 
+  /**
+   * To register an aggregate function, e.g. an aggregate UDF, which replaces the one of the same
+   * name.
+   */
+  static void registerFunction(std::string func, AggFunction body);
+
   /**
    * To load a set of functions from a shared object dynamically.
    */
@@ -155,6 +173,7 @@ class AggFunctionManager final {
 
   Status unloadInternal(const std::string& soname, const std::vector<std::string>& funcs);
 
+  mutable std::shared_mutex lock_;
   std::unordered_map<std::string, AggFunction> functions_;
 };
 
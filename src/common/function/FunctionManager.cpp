@@ -41,7 +41,7 @@ namespace nebula {
 FunctionManager &FunctionManager::instance() {
   static FunctionManager instance;
   if (FLAGS_enable_udf) {
-    static FunctionUdfManager udfManager;
+    FunctionUdfManager::instance();
   }
   return instance;
 }
@@ -3000,8 +3000,103 @@ FunctionManager::FunctionManager() {
       return Value::kNullValue;
     };
   }
+  registerUnaryFunctions();
 }  // NOLINT
 
+void FunctionManager::registerUnaryFunctions() {
+  // They must return the same as the generic bodies for the arguments of the types
+  auto add = [this](std::initializer_list<const char *> names,
+                    Value::Type type,
+                    UnaryFunction func) {
+    for (auto *name : names) {
+      functions_[name].unary_.emplace_back(type, func);
+    }
+  };
+  add({"id"}, Value::Type::VERTEX, [](const Value &v) -> Value { return v.getVertex().vid; });
+  add({"src"}, Value::Type::EDGE, [](const Value &v) -> Value {
+    const auto &edge = v.getEdge();
+    return edge.type > 0 ? edge.src : edge.dst;
+  });
+  add({"dst"}, Value::Type::EDGE, [](const Value &v) -> Value {
+    const auto &edge = v.getEdge();
+    return edge.type > 0 ? edge.dst : edge.src;
+  });
+  add({"rank"}, Value::Type::EDGE, [](const Value &v) -> Value { return v.getEdge().ranking; });
+  add({"properties"}, Value::Type::VERTEX, [](const Value &v) -> Value {
+    Map props;
+    for (auto &tag : v.getVertex().tags) {
+      props.kvs.insert(tag.props.cbegin(), tag.props.cend());
+    }
+    return Value(std::move(props));
+  });
+  add({"properties"}, Value::Type::EDGE, [](const Value &v) -> Value {
+    Map props;
+    props.kvs = v.getEdge().props;
+    return Value(std::move(props));
+  });
+  add({"properties"}, Value::Type::MAP, [](const Value &v) -> Value { return v; });
+
+  add({"lower", "tolower"}, Value::Type::STRING, [](const Value &v) -> Value {
+    std::string value(v.getStr());
+    folly::toLowerAscii(value);
+    return value;
+  });
+  add({"upper", "toupper"}, Value::Type::STRING, [](const Value &v) -> Value {
+    std::string value(v.getStr());
+    std::transform(value.begin(), value.end(), value.begin(), [](unsigned char c) {
+      return std::toupper(c);
+    });
+    return value;
+  });
+  add({"length"}, Value::Type::STRING, [](const Value &v) -> Value {
+    return static_cast<int64_t>(v.getStr().length());
+  });
+  add({"trim"}, Value::Type::STRING, [](const Value &v) -> Value {
+    return folly::trimWhitespace(v.getStr()).toString();
+  });
+  add({"tostring"}, Value::Type::INT, [](const Value &v) -> Value {
+    return folly::to<std::string>(v.getInt());
+  });
+  add({"tostring"}, Value::Type::STRING, [](const Value &v) -> Value { return v.getStr(); });
+
+  add({"abs"}, Value::Type::INT, [](const Value &v) -> Value { return std::abs(v.getInt()); });
+  add({"abs"}, Value::Type::FLOAT, [](const Value &v) -> Value { return std::abs(v.getFloat()); });
+  add({"floor"}, Value::Type::INT, [](const Value &v) -> Value { return std::floor(v.getInt()); });
+  add({"floor"}, Value::Type::FLOAT, [](const Value &v) -> Value {
+    return std::floor(v.getFloat());
+  });
+  add({"ceil"}, Value::Type::INT, [](const Value &v) -> Value { return std::ceil(v.getInt()); });
+  add({"ceil"}, Value::Type::FLOAT, [](const Value &v) -> Value {
+    return std::ceil(v.getFloat());
+  });
+  add({"sqrt"}, Value::Type::INT, [](const Value &v) -> Value { return std::sqrt(v.getInt()); });
+  add({"sqrt"}, Value::Type::FLOAT, [](const Value &v) -> Value {
+    return std::sqrt(v.getFloat());
+  });
+
+  add({"date"}, Value::Type::STRING, [](const Value &v) -> Value {
+    auto result = time::TimeUtils::parseDate(v.getStr());
+    if (!result.ok()) {
+      return Value::kNullBadData;
+    }
+    return result.value();
+  });
+  add({"timestamp"}, Value::Type::STRING, [](const Value &v) -> Value {
+    auto status = time::TimeUtils::toTimestamp(v);
+    if (!status.ok()) {
+      return Value::kNullBadData;
+    }
+    return status.value();
+  });
+  add({"timestamp"}, Value::Type::INT, [](const Value &v) -> Value {
+    auto status = time::TimeUtils::toTimestamp(v);
+    if (!status.ok()) {
+      return Value::kNullBadData;
+    }
+    return status.value();
+  });
+}
+
 // static
 StatusOr<FunctionManager::Function> FunctionManager::get(const std::string &func, size_t arity) {
   auto result = instance().getInternal(func, arity);
@@ -3009,6 +3104,33 @@ StatusOr<FunctionManager::Function> FunctionManager::get(const std::string &func
   return result.value().body_;
 }
 
+// static
+FunctionManager::UnaryFunction FunctionManager::getUnary(const std::string &func,
+                                                         Value::Type argType) {
+  std::string name(func);
+  std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+  const auto &functions = instance().functions_;
+  auto iter = functions.find(name);
+  if (iter == functions.end() || iter->second.minArity_ > 1 || iter->second.maxArity_ < 1) {
+    return nullptr;
+  }
+  for (const auto &[type, unary] : iter->second.unary_) {
+    if (type == argType) {
+      return unary;
+    }
+  }
+  return nullptr;
+}
+
+// static
+FunctionManager::BatchFunction FunctionManager::getBatch(const std::string &func, size_t arity) {
+  auto result = instance().getInternal(func, arity);
+  if (!result.ok()) {
+    return BatchFunction();
+  }
+  return result.value().batchBody_;
+}
+
 // static
 Status FunctionManager::find(const std::string &func, const size_t arity) {
   auto result = instance().getInternal(func, arity);
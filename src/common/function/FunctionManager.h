@@ -33,6 +33,13 @@ class FunctionManager final {
  public:
   using ArgType = std::reference_wrapper<const Value>;
   using Function = std::function<Value(const std::vector<ArgType> &)>;
+  // Entry point of a unary function specialized for one type of its argument, which neither
+  // marshals the argument into a vector nor dispatches on its type. The caller must make sure the
+  // argument is of that type.
+  using UnaryFunction = Value (*)(const Value &);
+  // Evaluates a batch of rows, see GraphFunction::bodyBatch
+  using BatchFunction = std::function<void(
+      const std::vector<std::vector<Value>> &columns, size_t numRows, std::vector<Value> &results)>;
 
   /**
    * To obtain a function named `func', with the actual arity.
@@ -47,6 +54,18 @@ class FunctionManager final {
 
   static StatusOr<bool> getIsPure(const std::string &func, size_t arity);
 
+  /**
+   * To obtain the entry point of the unary function named `func' specialized for the argument of
+   * type `argType', nullptr if there is none.
+   */
+  static UnaryFunction getUnary(const std::string &func, Value::Type argType);
+
+  /**
+   * To obtain the batch entry point of the function named `func' with the actual arity, which is
+   * empty unless the function is vectorized, i.e. a UDF which implements bodyBatch.
+   */
+  static BatchFunction getBatch(const std::string &func, size_t arity);
+
   /**
    * To load a set of functions from a shared object dynamically.
    */
@@ -78,6 +97,10 @@ class FunctionManager final {
     // allocating huge amount of memory for these functions.
     bool isAlwaysPure_{false};
     Function body_;
+    // The entry points specialized for the type of the only argument
+    std::vector<std::pair<Value::Type, UnaryFunction>> unary_;
+    // The entry point of a batch of rows, only for the vectorized UDFs
+    BatchFunction batchBody_;
   };
 
   // Sets the function to NON-pure for all numbers of arity it take, which means the function is
@@ -99,6 +122,9 @@ class FunctionManager final {
 
   StatusOr<const FunctionAttributes> getInternal(std::string func, size_t arity) const;
 
+  // Registers the specialized entry points of the hot unary functions
+  void registerUnaryFunctions();
+
   Status loadInternal(const std::string &soname, const std::vector<std::string> &funcs);
 
   Status unloadInternal(const std::string &soname, const std::vector<std::string> &funcs);
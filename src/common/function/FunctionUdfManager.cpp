@@ -11,6 +11,7 @@
 #include <cstring>
 #include <iostream>
 
+#include "common/function/AggFunctionManager.h"
 #include "graph/service/GraphFlags.h"
 
 DEFINE_string(udf_path, "lib/udf", "path to hold the udf");
@@ -70,6 +71,49 @@ FunctionUdfManager::destroy_f *FunctionUdfManager::deleteGraphFunctionClass(void
   return destroy_func;
 }
 
+int FunctionUdfManager::getAbiVersion(void *func_handle) {
+  auto *version_func = reinterpret_cast<abi_version_f *>(dlsym(func_handle, "abiVersion"));
+  if (dlerror() != nullptr || version_func == nullptr) {
+    // built before the ABI is versioned
+    return 1;
+  }
+  return version_func();
+}
+
+FunctionUdfManager::Library::~Library() {
+  if (function != nullptr) {
+    destroy(function);
+  }
+  if (handle != nullptr) {
+    dlclose(handle);
+  }
+}
+
+std::shared_ptr<FunctionUdfManager::Library> FunctionUdfManager::openLibrary(
+    const std::string &soPath) {
+  auto library = std::make_shared<Library>();
+  library->handle = dlopen(soPath.c_str(), RTLD_LAZY);
+  if (!library->handle) {
+    LOG(ERROR) << "Cannot load udf library: " << dlerror();
+    return nullptr;
+  }
+  dlerror();
+
+  library->create = getGraphFunctionClass(library->handle);
+  library->destroy = deleteGraphFunctionClass(library->handle);
+  if (library->create == nullptr || library->destroy == nullptr) {
+    LOG(ERROR) << "GraphFunction Create Or Destroy Error: " << soPath;
+    return nullptr;
+  }
+  library->abiVersion = getAbiVersion(library->handle);
+  if (library->abiVersion > NEBULA_UDF_ABI_VERSION) {
+    LOG(ERROR) << "Unsupported udf abi version " << library->abiVersion << ": " << soPath;
+    return nullptr;
+  }
+  library->function = library->create();
+  return library;
+}
+
 FunctionUdfManager::FunctionUdfManager() {
   initAndLoadSoFunction();
   expired_ = true;
@@ -95,30 +139,22 @@ void FunctionUdfManager::initAndLoadSoFunction() {
 
   for (auto &file : files) {
     const std::string &path = udfPath;
-    std::string so_path_string = path + file;
-    const char *soPath = so_path_string.c_str();
+    std::string soPath = path + file;
     try {
-      void *func_handle = dlopen(soPath, RTLD_LAZY);
-      if (!func_handle) {
-        LOG(ERROR) << "Cannot load udf library: " << dlerror();
+      auto library = openLibrary(soPath);
+      if (library == nullptr) {
+        continue;
       }
-      dlerror();
 
-      create_f *create_func = getGraphFunctionClass(func_handle);
-      destroy_f *destroy_func = deleteGraphFunctionClass(func_handle);
-      if (create_func == nullptr || destroy_func == nullptr) {
-        LOG(ERROR) << "GraphFunction Create Or Destroy Error: " << soPath;
-        break;
-      }
-
-      GraphFunction *gf = create_func();
-      char *funName = gf->name();
+      GraphFunction *gf = library->function;
+      std::string funName = gf->name();
       udfFunInputType_.emplace(funName, gf->inputType());
       udfFunReturnType_.emplace(funName, gf->returnType());
-      addSoUdfFunction(funName, soPath, gf->minArity(), gf->maxArity(), gf->isPure());
-
-      destroy_func(gf);
-      dlclose(func_handle);
+      if (library->abiVersion >= 2 && gf->isAggregate()) {
+        addAggUdfFunction(funName, std::move(library));
+      } else {
+        addSoUdfFunction(funName, std::move(library));
+      }
     } catch (...) {
       LOG(ERROR) << "load So library Error: " << soPath;
     }
@@ -171,34 +207,62 @@ StatusOr<const FunctionManager::FunctionAttributes> nebula::FunctionUdfManager::
   return iter->second;
 }
 
-void FunctionUdfManager::addSoUdfFunction(
-    char *funName, const char *soPath, size_t minArity, size_t maxArity, bool isPure) {
+void FunctionUdfManager::addSoUdfFunction(const std::string &funName,
+                                          std::shared_ptr<Library> library) {
+  auto *gf = library->function;
   auto &attr = udfFunctions_[funName];
-  attr.minArity_ = minArity;
-  attr.maxArity_ = maxArity;
-  attr.isAlwaysPure_ = isPure;
-  std::string path = soPath;
-  attr.body_ = [path](const auto &args) -> Value {
-    try {
-      char *soPath2 = const_cast<char *>(path.c_str());
-      void *func_handle = dlopen(soPath2, RTLD_LAZY);
-      if (!func_handle) {
-        LOG(ERROR) << "Cannot load udf library: " << dlerror();
+  attr.minArity_ = gf->minArity();
+  attr.maxArity_ = gf->maxArity();
+  attr.isAlwaysPure_ = gf->isPure();
+  if (library->abiVersion >= 2) {
+    attr.body_ = [library](const auto &args) -> Value {
+      try {
+        return library->function->body(args);
+      } catch (...) {
+        return Value::kNullBadData;
       }
-      dlerror();
-
-      create_f *create_func = getGraphFunctionClass(func_handle);
-      destroy_f *destroy_func = deleteGraphFunctionClass(func_handle);
+    };
+  } else {
+    // The function of version 1 is not thread safe, an instance is created for each call
+    attr.body_ = [library](const auto &args) -> Value {
+      std::unique_ptr<GraphFunction, destroy_f *> function(library->create(), library->destroy);
+      try {
+        return function->body(args);
+      } catch (...) {
+        return Value::kNullBadData;
+      }
+    };
+  }
+  if (library->abiVersion >= 2 && gf->isVectorized()) {
+    attr.batchBody_ = [library](const auto &columns, size_t numRows, auto &results) {
+      auto size = results.size();
+      try {
+        library->function->bodyBatch(columns, numRows, results);
+      } catch (...) {
+        results.resize(size);
+      }
+      // the rows without result are bad
+      results.resize(size + numRows, Value::kNullBadData);
+    };
+  } else {
+    attr.batchBody_ = nullptr;
+  }
+}
 
-      GraphFunction *gf = create_func();
-      Value res = gf->body(args);
-      destroy_func(gf);
-      dlclose(func_handle);
-      return res;
+void FunctionUdfManager::addAggUdfFunction(const std::string &funName,
+                                           std::shared_ptr<Library> library) {
+  AggFunctionManager::registerFunction(funName, [library](AggData *aggData, const Value &val) {
+    auto &res = aggData->result();
+    if (res.isBadNull()) {
+      return;
+    }
+    try {
+      library->function->aggregate(aggData->state(), val);
+      res = library->function->result(aggData->state());
     } catch (...) {
-      return Value::kNullBadData;
+      res = Value::kNullBadData;
     }
-  };
+  });
 }
 
 }  // namespace nebula
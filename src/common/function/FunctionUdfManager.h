@@ -13,10 +13,27 @@ namespace nebula {
 
 class FunctionManager;
 
+// Loads the UDF libraries under FLAGS_udf_path. A library is kept open while the function is
+// registered. The function created by a library of ABI version 2 is called directly by all
+// queries, while a function of version 1 is created for each call.
+// The scalar UDFs are resolved by FunctionManager, the aggregate UDFs of ABI version 2 are
+// registered into AggFunctionManager.
 class FunctionUdfManager {
  public:
   typedef GraphFunction *(create_f)();
   typedef void(destroy_f)(GraphFunction *);
+  typedef int(abi_version_f)();
+
+  // An opened UDF library and the function created by it
+  struct Library {
+    ~Library();
+
+    void *handle{nullptr};
+    GraphFunction *function{nullptr};
+    create_f *create{nullptr};
+    destroy_f *destroy{nullptr};
+    int abiVersion{1};
+  };
 
   static StatusOr<Value::Type> getUdfReturnType(const std::string functionName,
                                                 const std::vector<Value::Type> &argsType);
@@ -31,8 +48,12 @@ class FunctionUdfManager {
  private:
   static create_f *getGraphFunctionClass(void *func_handle);
   static destroy_f *deleteGraphFunctionClass(void *func_handle);
+  static int getAbiVersion(void *func_handle);
+
+  static std::shared_ptr<Library> openLibrary(const std::string &soPath);
 
-  void addSoUdfFunction(char *funName, const char *soPath, size_t i, size_t i1, bool b);
+  void addSoUdfFunction(const std::string &funName, std::shared_ptr<Library> library);
+  void addAggUdfFunction(const std::string &funName, std::shared_ptr<Library> library);
   void initAndLoadSoFunction();
 };
 
@@ -10,11 +10,23 @@
 
 #include "common/datatypes/Value.h"
 
+// Version of the UDF ABI declared by this header. A UDF library exports it by `abiVersion',
+// a library without `abiVersion' is of version 1.
+//
+// Version 1: name() to body() are called, each row at a time.
+// Version 2: isVectorized(), bodyBatch() and the aggregate functions are called too.
+#define NEBULA_UDF_ABI_VERSION 2
+
 class GraphFunction;
 
 extern "C" GraphFunction *create();
 extern "C" void destroy(GraphFunction *function);
+// Since version 2, should return NEBULA_UDF_ABI_VERSION
+extern "C" int abiVersion();
 
+// A UDF of version 2 is created once when its library is loaded, and the same instance is called
+// by all queries concurrently, so all calls must be thread safe. A UDF of version 1 is created and
+// destroyed around each call of body(), as it's not supposed to be thread safe.
 class GraphFunction {
  public:
   virtual ~GraphFunction() = default;
@@ -33,6 +45,48 @@ class GraphFunction {
 
   virtual nebula::Value body(
       const std::vector<std::reference_wrapper<const nebula::Value>> &args) = 0;
+
+  // Since version 2, new virtual functions must be appended below to keep the layout of the
+  // older versions.
+
+  // Whether bodyBatch is implemented natively, it's called instead of body for a batch of rows
+  // then.
+  virtual bool isVectorized() {
+    return false;
+  }
+
+  // Evaluate numRows rows: columns[i] holds the i-th argument of all rows, the result of each row
+  // is appended to results in order.
+  virtual void bodyBatch(const std::vector<std::vector<nebula::Value>> &columns,
+                         size_t numRows,
+                         std::vector<nebula::Value> &results) {
+    std::vector<std::reference_wrapper<const nebula::Value>> args;
+    for (size_t row = 0; row < numRows; ++row) {
+      args.clear();
+      for (const auto &column : columns) {
+        args.emplace_back(column[row]);
+      }
+      results.emplace_back(body(args));
+    }
+  }
+
+  // Whether it's an aggregate function of one argument, e.g. used as `f(x)' with `GROUP BY'.
+  // It's called by aggregate and result instead of body.
+  virtual bool isAggregate() {
+    return false;
+  }
+
+  // Accumulate the argument of a row into the partial state of a group, the state is empty, i.e.
+  // Value(), at first.
+  virtual void aggregate(nebula::Value &state, const nebula::Value &arg) {
+    (void)state;
+    (void)arg;
+  }
+
+  // The result of a group from its partial state
+  virtual nebula::Value result(const nebula::Value &state) {
+    return state;
+  }
 };
 
 #endif  // COMMON_FUNCTION_GRAPHFUNCTION_H
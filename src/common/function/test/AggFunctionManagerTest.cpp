@@ -127,6 +127,28 @@ TEST_F(AggFunctionManagerTest, aggFunc) {
   }
 }
 
+TEST_F(AggFunctionManagerTest, RegisterFunction) {
+  // e.g. an aggregate UDF keeping the max in its partial state
+  AggFunctionManager::registerFunction("udf_max", [](AggData *aggData, const Value &val) {
+    auto &state = aggData->state();
+    if (!val.isInt()) {
+      return;
+    }
+    if (state.empty() || state < val) {
+      state = val;
+    }
+    aggData->setResult(state);
+  });
+  EXPECT_TRUE(AggFunctionManager::find("UDF_MAX").ok());
+  auto func = AggFunctionManager::get("udf_max");
+  ASSERT_TRUE(func.ok());
+  AggData aggData;
+  for (auto &val : testData_["int"]) {
+    func.value()(&aggData, val);
+  }
+  EXPECT_EQ(Value(3), aggData.result());
+}
+
 }  // namespace nebula
 
 int main(int argc, char **argv) {
@@ -2064,6 +2064,49 @@ TEST_F(FunctionManagerTest, Any) {
   { TEST_FUNCTION(_any, std::vector<Value>({Value(1)}), Value(1)); }
 }
 
+TEST_F(FunctionManagerTest, UnaryFunctions) {
+  Vertex vertex("v1", {Tag("t", {{"p", 1}})});
+  Edge edge("v1", "v2", -1, "e", 2, {{"p", 2}});
+  std::vector<std::pair<std::string, Value>> calls = {
+      {"id", vertex},
+      {"src", edge},
+      {"dst", edge},
+      {"rank", edge},
+      {"properties", vertex},
+      {"properties", edge},
+      {"properties", Map()},
+      {"toLower", "AbC"},
+      {"upper", "AbC"},
+      {"length", "abc"},
+      {"trim", "  a b "},
+      {"toString", 42},
+      {"toString", "a"},
+      {"abs", -1},
+      {"abs", -1.5},
+      {"floor", 1.5},
+      {"ceil", 1},
+      {"sqrt", 4.0},
+      {"date", "2022-01-02"},
+      {"date", "bad"},
+      {"timestamp", "2022-01-02T00:00:00"},
+      {"timestamp", 1},
+  };
+  for (const auto &[name, arg] : calls) {
+    auto unary = FunctionManager::getUnary(name, arg.type());
+    ASSERT_NE(nullptr, unary) << name << "(" << arg.type() << ")";
+    auto generic = FunctionManager::get(name, 1);
+    ASSERT_TRUE(generic.ok());
+    auto expect = generic.value()(genArgsRef({arg}));
+    auto result = unary(arg);
+    EXPECT_EQ(expect.type(), result.type()) << name << "(" << arg << ")";
+    EXPECT_EQ(expect, result) << name << "(" << arg << ")";
+  }
+  // no specialization
+  EXPECT_EQ(nullptr, FunctionManager::getUnary("id", Value::Type::EDGE));
+  EXPECT_EQ(nullptr, FunctionManager::getUnary("range", Value::Type::INT));
+  EXPECT_EQ(nullptr, FunctionManager::getUnary("not_exist", Value::Type::INT));
+}
+
 }  // namespace nebula
 
 int main(int argc, char **argv) {
@@ -0,0 +1,135 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include "common/function/FunctionManager.h"
+#include "common/function/GraphFunction.h"
+
+namespace nebula {
+
+// A scoring UDF like the ones of recommendation queries: score(weight, degree)
+class Score final : public GraphFunction {
+ public:
+  char *name() override {
+    return const_cast<char *>("score");
+  }
+
+  std::vector<std::vector<Value::Type>> inputType() override {
+    return {{Value::Type::FLOAT, Value::Type::INT}};
+  }
+
+  Value::Type returnType() override {
+    return Value::Type::FLOAT;
+  }
+
+  size_t minArity() override {
+    return 2;
+  }
+
+  size_t maxArity() override {
+    return 2;
+  }
+
+  bool isPure() override {
+    return true;
+  }
+
+  Value body(const std::vector<std::reference_wrapper<const Value>> &args) override {
+    if (!args[0].get().isFloat() || !args[1].get().isInt()) {
+      return Value::kNullBadType;
+    }
+    return score(args[0].get().getFloat(), args[1].get().getInt());
+  }
+
+  bool isVectorized() override {
+    return true;
+  }
+
+  void bodyBatch(const std::vector<std::vector<Value>> &columns,
+                 size_t numRows,
+                 std::vector<Value> &results) override {
+    const auto &weights = columns[0];
+    const auto &degrees = columns[1];
+    for (size_t i = 0; i < numRows; ++i) {
+      if (!weights[i].isFloat() || !degrees[i].isInt()) {
+        results.emplace_back(Value::kNullBadType);
+        continue;
+      }
+      results.emplace_back(score(weights[i].getFloat(), degrees[i].getInt()));
+    }
+  }
+
+ private:
+  static double score(double weight, int64_t degree) {
+    return weight * 0.7 + std::log1p(static_cast<double>(degree)) * 0.3;
+  }
+};
+
+static constexpr size_t kRows = 1024;
+
+static std::vector<std::vector<Value>> &columns() {
+  static std::vector<std::vector<Value>> columns = [] {
+    std::vector<std::vector<Value>> cols(2);
+    for (size_t i = 0; i < kRows; ++i) {
+      cols[0].emplace_back(static_cast<double>(i) / kRows);
+      cols[1].emplace_back(static_cast<int64_t>(i));
+    }
+    return cols;
+  }();
+  return columns;
+}
+
+// The calling convention of a UDF body, each row at a time
+BENCHMARK(PerRow, iters) {
+  Score udf;
+  FunctionManager::Function func = [&udf](const auto &args) { return udf.body(args); };
+  const auto &cols = columns();
+  std::vector<FunctionManager::ArgType> args;
+  for (size_t n = 0; n < iters; ++n) {
+    for (size_t i = 0; i < kRows; ++i) {
+      args.clear();
+      args.emplace_back(cols[0][i]);
+      args.emplace_back(cols[1][i]);
+      auto result = func(args);
+      folly::doNotOptimizeAway(result);
+    }
+  }
+}
+
+// The default bodyBatch of a UDF which is not vectorized
+BENCHMARK_RELATIVE(BatchByRow, iters) {
+  Score udf;
+  const auto &cols = columns();
+  std::vector<Value> results;
+  for (size_t n = 0; n < iters; ++n) {
+    results.clear();
+    udf.GraphFunction::bodyBatch(cols, kRows, results);
+    folly::doNotOptimizeAway(results);
+  }
+}
+
+BENCHMARK_RELATIVE(Batch, iters) {
+  Score udf;
+  FunctionManager::BatchFunction func = [&udf](const auto &cols, size_t numRows, auto &results) {
+    udf.bodyBatch(cols, numRows, results);
+  };
+  const auto &cols = columns();
+  std::vector<Value> results;
+  for (size_t n = 0; n < iters; ++n) {
+    results.clear();
+    func(cols, kRows, results);
+    folly::doNotOptimizeAway(results);
+  }
+}
+
+}  // namespace nebula
+
+int main(int argc, char **argv) {
+  folly::init(&argc, &argv, true);
+  folly::runBenchmarks();
+  return 0;
+}
@@ -0,0 +1,429 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "common/graph/JsonWriter.h"
+
+#include <folly/Conv.h>
+
+#include <cmath>
+
+#include "common/datatypes/Date.h"
+#include "common/datatypes/Duration.h"
+#include "common/datatypes/Geography.h"
+#include "common/datatypes/List.h"
+#include "common/datatypes/Map.h"
+#include "common/datatypes/Set.h"
+
+namespace nebula {
+
+// static
+std::string JsonWriter::toJson(const ExecutionResponse& resp) {
+  std::string out;
+  if (resp.data != nullptr) {
+    // A rough guess to avoid most of the reallocation
+    out.reserve(256 + resp.data->rowSize() * resp.data->colSize() * 16);
+  }
+  JsonWriter writer(&out);
+  writer.write(resp);
+  return out;
+}
+
+void JsonWriter::write(const ExecutionResponse& resp) {
+  out_->append("{\"results\":[{");
+  writeKey("latencyInUs");
+  folly::toAppend(resp.latencyInUs, out_);
+  out_->push_back(',');
+  writeKey("errors");
+  writeError(resp);
+  if (resp.data != nullptr) {
+    out_->push_back(',');
+    writeKey("columns");
+    out_->push_back('[');
+    for (size_t i = 0; i < resp.data->colNames.size(); ++i) {
+      if (i > 0) {
+        out_->push_back(',');
+      }
+      writeString(resp.data->colNames[i]);
+    }
+    out_->push_back(']');
+    out_->push_back(',');
+    writeKey("data");
+    write(*resp.data);
+  }
+  if (resp.spaceName != nullptr) {
+    out_->push_back(',');
+    writeKey("spaceName");
+    writeString(*resp.spaceName);
+  }
+  if (resp.planDesc != nullptr) {
+    // The plan is small, not worth a writer of its own
+    out_->push_back(',');
+    writeKey("planDesc");
+    out_->append(folly::json::serialize(resp.planDesc->toJson(), opts_));
+  }
+  if (resp.comment != nullptr) {
+    out_->push_back(',');
+    writeKey("comment");
+    writeString(*resp.comment);
+  }
+  out_->append("}],");
+  writeKey("errors");
+  out_->push_back('[');
+  writeError(resp);
+  out_->append("]}");
+  mayFlush();
+}
+
+void JsonWriter::write(const DataSet& ds) {
+  out_->push_back('[');
+  for (size_t i = 0; i < ds.rows.size(); ++i) {
+    if (i > 0) {
+      out_->push_back(',');
+    }
+    writeRow(ds.rows[i]);
+    mayFlush();
+  }
+  out_->push_back(']');
+}
+
+void JsonWriter::writeRow(const Row& row) {
+  out_->push_back('{');
+  writeKey("row");
+  out_->push_back('[');
+  for (size_t i = 0; i < row.values.size(); ++i) {
+    if (i > 0) {
+      out_->push_back(',');
+    }
+    write(row.values[i]);
+  }
+  out_->append("],");
+  writeKey("meta");
+  out_->push_back('[');
+  for (size_t i = 0; i < row.values.size(); ++i) {
+    if (i > 0) {
+      out_->push_back(',');
+    }
+    writeMetaData(row.values[i]);
+  }
+  out_->append("]}");
+}
+
+void JsonWriter::write(const Value& value) {
+  switch (value.type()) {
+    case Value::Type::__EMPTY__: {
+      writeString("__EMPTY__");
+      return;
+    }
+    case Value::Type::NULLVALUE: {
+      out_->append("null");
+      return;
+    }
+    case Value::Type::BOOL: {
+      out_->append(value.getBool() ? "true" : "false");
+      return;
+    }
+    case Value::Type::INT: {
+      folly::toAppend(value.getInt(), out_);
+      return;
+    }
+    case Value::Type::FLOAT: {
+      writeDouble(value.getFloat());
+      return;
+    }
+    case Value::Type::STRING: {
+      writeString(value.getStr());
+      return;
+    }
+    case Value::Type::LIST:
+    case Value::Type::SET: {
+      const auto& values = value.isList() ? value.getList().values : value.getSet().values;
+      out_->push_back('[');
+      bool first = true;
+      for (const auto& v : values) {
+        if (!first) {
+          out_->push_back(',');
+        }
+        first = false;
+        write(v);
+      }
+      out_->push_back(']');
+      return;
+    }
+    case Value::Type::MAP: {
+      out_->push_back('{');
+      bool first = true;
+      for (const auto& kv : value.getMap().kvs) {
+        if (!first) {
+          out_->push_back(',');
+        }
+        first = false;
+        writeKey(kv.first);
+        write(kv.second);
+      }
+      out_->push_back('}');
+      return;
+    }
+    case Value::Type::DATE: {
+      writeString(value.getDate().toString());
+      return;
+    }
+    case Value::Type::TIME: {
+      // 'Z' representing UTC timezone
+      writeString(value.getTime().toString() + "Z");
+      return;
+    }
+    case Value::Type::DATETIME: {
+      writeString(value.getDateTime().toString() + "Z");
+      return;
+    }
+    case Value::Type::EDGE: {
+      writeEdge(value.getEdge());
+      return;
+    }
+    case Value::Type::VERTEX: {
+      writeVertex(value.getVertex());
+      return;
+    }
+    case Value::Type::PATH: {
+      writePath(value.getPath());
+      return;
+    }
+    case Value::Type::DATASET: {
+      write(value.getDataSet());
+      return;
+    }
+    case Value::Type::GEOGRAPHY: {
+      writeString(value.getGeography().toString());
+      return;
+    }
+    case Value::Type::DURATION: {
+      writeString(value.getDuration().toString());
+      return;
+    }
+      // no default so the compiler will warning when lack
+  }
+
+  DLOG(FATAL) << "Unknown value type " << static_cast<int>(value.type());
+  out_->append("null");
+}
+
+void JsonWriter::writeMetaData(const Value& value) {
+  switch (value.type()) {
+    // Privative datatypes has no meta data
+    case Value::Type::__EMPTY__:
+    case Value::Type::BOOL:
+    case Value::Type::INT:
+    case Value::Type::FLOAT:
+    case Value::Type::STRING:
+    case Value::Type::DATASET:
+    case Value::Type::NULLVALUE: {
+      out_->append("null");
+      return;
+    }
+    // Extract the meta info of each element as the metadata of the container
+    case Value::Type::LIST:
+    case Value::Type::SET: {
+      const auto& values = value.isList() ? value.getList().values : value.getSet().values;
+      out_->push_back('[');
+      bool first = true;
+      for (const auto& v : values) {
+        if (!first) {
+          out_->push_back(',');
+        }
+        first = false;
+        writeMetaData(v);
+      }
+      out_->push_back(']');
+      return;
+    }
+    case Value::Type::MAP: {
+      out_->push_back('[');
+      bool first = true;
+      for (const auto& kv : value.getMap().kvs) {
+        if (!first) {
+          out_->push_back(',');
+        }
+        first = false;
+        writeMetaData(kv.second);
+      }
+      out_->push_back(']');
+      return;
+    }
+    case Value::Type::DURATION:
+    case Value::Type::DATE:
+    case Value::Type::TIME:
+    case Value::Type::DATETIME: {
+      out_->push_back('{');
+      writeKey("type");
+      writeString(value.typeName());
+      out_->push_back('}');
+      return;
+    }
+    case Value::Type::VERTEX: {
+      writeVertexMetaData(value.getVertex());
+      return;
+    }
+    case Value::Type::EDGE: {
+      const auto& e = value.getEdge();
+      writeEdgeMetaData(e.src, e.dst, e.name, e.type, e.ranking);
+      return;
+    }
+    case Value::Type::PATH: {
+      const auto& p = value.getPath();
+      out_->push_back('[');
+      writeVertexMetaData(p.src);
+      const auto* src = &p.src;
+      for (const auto& s : p.steps) {
+        out_->push_back(',');
+        writeEdgeMetaData(src->vid, s.dst.vid, s.name, s.type, s.ranking);
+        out_->push_back(',');
+        writeVertexMetaData(s.dst);
+        src = &s.dst;
+      }
+      out_->push_back(']');
+      return;
+    }
+    default:
+      break;
+  }
+
+  // Such as geography, the same as Value::getMetaData()
+  out_->append("null");
+}
+
+void JsonWriter::flush() {
+  if (onChunk_ && !buf_.empty()) {
+    onChunk_(std::move(buf_));
+    buf_.clear();
+  }
+}
+
+void JsonWriter::writeString(folly::StringPiece str) {
+  folly::json::escapeString(str, *out_, opts_);
+}
+
+void JsonWriter::writeKey(folly::StringPiece key) {
+  writeString(key);
+  out_->push_back(':');
+}
+
+void JsonWriter::writeDouble(double val) {
+  if (!std::isfinite(val)) {
+    // The same as folly::toJson
+    throw folly::json::print_error("folly::toJson: JSON object value was a NaN or INF");
+  }
+  folly::toAppend(val, out_, opts_.double_mode, opts_.double_num_digits);
+}
+
+void JsonWriter::writeVertex(const Vertex& v) {
+  // The props of all the tags in one object, keyed by `tag.prop'
+  out_->push_back('{');
+  bool first = true;
+  for (const auto& tag : v.tags) {
+    for (const auto& prop : tag.props) {
+      if (!first) {
+        out_->push_back(',');
+      }
+      first = false;
+      writeString(tag.name + "." + prop.first);
+      out_->push_back(':');
+      write(prop.second);
+    }
+  }
+  out_->push_back('}');
+}
+
+void JsonWriter::writeEdge(const Edge& e) {
+  out_->push_back('{');
+  bool first = true;
+  for (const auto& prop : e.props) {
+    if (!first) {
+      out_->push_back(',');
+    }
+    first = false;
+    writeKey(prop.first);
+    write(prop.second);
+  }
+  out_->push_back('}');
+}
+
+void JsonWriter::writePath(const Path& p) {
+  // [vertex, edge props, vertex, edge props, ...]
+  out_->push_back('[');
+  writeVertex(p.src);
+  for (const auto& s : p.steps) {
+    out_->append(",{");
+    bool first = true;
+    for (const auto& prop : s.props) {
+      if (!first) {
+        out_->push_back(',');
+      }
+      first = false;
+      writeKey(prop.first);
+      write(prop.second);
+    }
+    out_->append("},");
+    writeVertex(s.dst);
+  }
+  out_->push_back(']');
+}
+
+void JsonWriter::writeVertexMetaData(const Vertex& v) {
+  out_->push_back('{');
+  writeKey("id");
+  write(v.vid);
+  out_->push_back(',');
+  writeKey("type");
+  writeString("vertex");
+  out_->push_back('}');
+}
+
+void JsonWriter::writeEdgeMetaData(const Value& src,
+                                   const Value& dst,
+                                   const std::string& name,
+                                   EdgeType type,
+                                   EdgeRanking ranking) {
+  out_->push_back('{');
+  writeKey("id");
+  out_->push_back('{');
+  writeKey("name");
+  writeString(name);
+  out_->push_back(',');
+  writeKey("src");
+  write(src);
+  out_->push_back(',');
+  writeKey("dst");
+  write(dst);
+  out_->push_back(',');
+  writeKey("type");
+  folly::toAppend(type, out_);
+  out_->push_back(',');
+  writeKey("ranking");
+  folly::toAppend(ranking, out_);
+  out_->append("},");
+  writeKey("type");
+  writeString("edge");
+  out_->push_back('}');
+}
+
+void JsonWriter::writeError(const ExecutionResponse& resp) {
+  out_->push_back('{');
+  writeKey("code");
+  folly::toAppend(static_cast<int>(resp.errorCode), out_);
+  if (resp.errorMsg != nullptr) {
+    out_->push_back(',');
+    writeKey("message");
+    writeString(*resp.errorMsg);
+  }
+  out_->push_back('}');
+}
+
+void JsonWriter::mayFlush() {
+  if (onChunk_ && buf_.size() >= chunkBytes_) {
+    flush();
+  }
+}
+
+}  // namespace nebula
@@ -0,0 +1,86 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef COMMON_GRAPH_JSONWRITER_H
+#define COMMON_GRAPH_JSONWRITER_H
+
+#include <folly/json.h>
+
+#include <functional>
+#include <string>
+
+#include "common/datatypes/Edge.h"
+#include "common/datatypes/Path.h"
+#include "common/datatypes/Vertex.h"
+#include "common/graph/Response.h"
+
+namespace nebula {
+
+/**
+ * JsonWriter serializes the response of a query into JSON straight. The output is equivalent to
+ * folly::toJson(resp.toJson()), except the order of the keys of the objects, but it's written
+ * without building the folly::dynamic tree, so each cell is only formatted into the output once.
+ *
+ * The output is either appended to a string, or handed over to a callback in chunks of about the
+ * given size, so that a large result is never held in one buffer.
+ */
+class JsonWriter final {
+ public:
+  using ChunkCallback = std::function<void(std::string&&)>;
+
+  // Appends the output to out
+  explicit JsonWriter(std::string* out) : out_(DCHECK_NOTNULL(out)) {}
+
+  // Hands over the output to onChunk once it reaches chunkBytes, call flush() for the rest.
+  JsonWriter(size_t chunkBytes, ChunkCallback onChunk)
+      : out_(&buf_), chunkBytes_(chunkBytes), onChunk_(std::move(onChunk)) {}
+
+  // Equivalent to folly::toJson(resp.toJson())
+  static std::string toJson(const ExecutionResponse& resp);
+
+  // The json of the response, see ExecutionResponse::toJson()
+  void write(const ExecutionResponse& resp);
+
+  // The json of the rows, see DataSet::toJson()
+  void write(const DataSet& ds);
+
+  // The json of the row, see DataSet::rowToJson()
+  void writeRow(const Row& row);
+
+  // The json of the value, see Value::toJson()
+  void write(const Value& value);
+
+  // The json of the metadata of the value, see Value::getMetaData()
+  void writeMetaData(const Value& value);
+
+  // Hands over the rest of the output to the callback
+  void flush();
+
+ private:
+  void writeString(folly::StringPiece str);
+  void writeKey(folly::StringPiece key);
+  void writeDouble(double val);
+  void writeVertex(const Vertex& v);
+  void writeEdge(const Edge& e);
+  void writePath(const Path& p);
+  void writeVertexMetaData(const Vertex& v);
+  void writeEdgeMetaData(const Value& src,
+                         const Value& dst,
+                         const std::string& name,
+                         EdgeType type,
+                         EdgeRanking ranking);
+  void writeError(const ExecutionResponse& resp);
+  void mayFlush();
+
+  std::string* out_;
+  std::string buf_;
+  size_t chunkBytes_{0};
+  ChunkCallback onChunk_;
+  folly::json::serialization_opts opts_;
+};
+
+}  // namespace nebula
+
+#endif  // COMMON_GRAPH_JSONWRITER_H
@@ -0,0 +1,99 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include "common/datatypes/List.h"
+#include "common/graph/JsonWriter.h"
+
+using nebula::DataSet;
+using nebula::Edge;
+using nebula::ExecutionResponse;
+using nebula::JsonWriter;
+using nebula::List;
+using nebula::Row;
+using nebula::Tag;
+using nebula::Vertex;
+
+ExecutionResponse scalarResp;
+ExecutionResponse graphResp;
+
+void prepare(size_t numRows) {
+  scalarResp.latencyInUs = 1000;
+  scalarResp.spaceName = std::make_unique<std::string>("nba");
+  scalarResp.data = std::make_unique<DataSet>(std::vector<std::string>{"id", "name", "score"});
+  graphResp.latencyInUs = 1000;
+  graphResp.spaceName = std::make_unique<std::string>("nba");
+  graphResp.data = std::make_unique<DataSet>(std::vector<std::string>{"v", "e", "l"});
+  for (size_t i = 0; i < numRows; ++i) {
+    auto id = folly::to<std::string>(i);
+    scalarResp.data->emplace_back(
+        Row({static_cast<int64_t>(i), "player" + id, static_cast<double>(i) / 3}));
+
+    Vertex v(id, {Tag("player", {{"name", "player" + id}, {"age", static_cast<int64_t>(i)}})});
+    Edge e(id, "team", 1, "serve", 0, {{"start_year", 1997}, {"end_year", 2016}});
+    graphResp.data->emplace_back(Row({v, e, List({1, 2, 3})}));
+  }
+}
+
+size_t dynamicJson(const ExecutionResponse& resp, size_t iters) {
+  size_t size = 0;
+  for (size_t i = 0; i < iters; ++i) {
+    auto json = folly::toJson(resp.toJson());
+    size += json.size();
+    folly::doNotOptimizeAway(json);
+  }
+  return size;
+}
+
+size_t writerJson(const ExecutionResponse& resp, size_t iters) {
+  size_t size = 0;
+  for (size_t i = 0; i < iters; ++i) {
+    auto json = JsonWriter::toJson(resp);
+    size += json.size();
+    folly::doNotOptimizeAway(json);
+  }
+  return size;
+}
+
+size_t writerChunks(const ExecutionResponse& resp, size_t iters) {
+  size_t size = 0;
+  for (size_t i = 0; i < iters; ++i) {
+    JsonWriter writer(64 * 1024, [&size](std::string&& chunk) { size += chunk.size(); });
+    writer.write(resp);
+    writer.flush();
+  }
+  return size;
+}
+
+BENCHMARK(ScalarDynamic, iters) {
+  folly::doNotOptimizeAway(dynamicJson(scalarResp, iters));
+}
+BENCHMARK_RELATIVE(ScalarWriter, iters) {
+  folly::doNotOptimizeAway(writerJson(scalarResp, iters));
+}
+BENCHMARK_RELATIVE(ScalarWriterChunks, iters) {
+  folly::doNotOptimizeAway(writerChunks(scalarResp, iters));
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(GraphDynamic, iters) {
+  folly::doNotOptimizeAway(dynamicJson(graphResp, iters));
+}
+BENCHMARK_RELATIVE(GraphWriter, iters) {
+  folly::doNotOptimizeAway(writerJson(graphResp, iters));
+}
+BENCHMARK_RELATIVE(GraphWriterChunks, iters) {
+  folly::doNotOptimizeAway(writerChunks(graphResp, iters));
+}
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv, true);
+  prepare(10000);
+  folly::runBenchmarks();
+  return 0;
+}
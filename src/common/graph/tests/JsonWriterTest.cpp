@@ -0,0 +1,93 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "common/datatypes/Date.h"
+#include "common/datatypes/Duration.h"
+#include "common/datatypes/List.h"
+#include "common/datatypes/Map.h"
+#include "common/datatypes/Set.h"
+#include "common/graph/JsonWriter.h"
+
+namespace nebula {
+
+static ExecutionResponse makeResponse(size_t numRows) {
+  ExecutionResponse resp;
+  resp.errorCode = ErrorCode::SUCCEEDED;
+  resp.latencyInUs = 1234;
+  resp.spaceName = std::make_unique<std::string>("nba");
+  resp.comment = std::make_unique<std::string>("a \"quoted\" comment\n");
+
+  Vertex v1("Tim Duncan", {Tag("player", {{"name", "Tim Duncan"}, {"age", 42}})});
+  Vertex v2("Spurs", {Tag("team", {{"name", "Spurs"}}), Tag("bak", {{"since", 1967}})});
+  Edge e("Tim Duncan", "Spurs", 1, "serve", 0, {{"start_year", 1997}, {"end_year", 2016}});
+  Path p(v1, {Step(v2, 1, "serve", 0, {{"start_year", 1997}})});
+
+  resp.data = std::make_unique<DataSet>(std::vector<std::string>{"a", "b", "c", "d", "e", "f"});
+  for (size_t i = 0; i < numRows; ++i) {
+    resp.data->emplace_back(Row({static_cast<int64_t>(i),
+                                 3.14 * i + 0.5,
+                                 std::string("\"escaped\" \\ \t 中文"),
+                                 Value::kNullValue,
+                                 Value::kEmpty,
+                                 true}));
+    resp.data->emplace_back(Row({List({1, 2.5, "x"}),
+                                 Set(std::unordered_set<Value>{1, 2}),
+                                 Map(std::unordered_map<std::string, Value>{{"k1", 1}, {"k2", v1}}),
+                                 Date(2020, 2, 20),
+                                 Time(10, 30, 45, 123456),
+                                 DateTime(2020, 2, 20, 10, 30, 45, 123456)}));
+    resp.data->emplace_back(Row({v1,
+                                 e,
+                                 p,
+                                 std::string(""),
+                                 Duration(1, 2, 3),
+                                 DataSet({"x"})}));
+  }
+  return resp;
+}
+
+TEST(JsonWriterTest, SameAsDynamic) {
+  {
+    auto resp = makeResponse(3);
+    auto json = JsonWriter::toJson(resp);
+    EXPECT_EQ(resp.toJson(), folly::parseJson(json)) << json;
+  }
+  {
+    // error without data
+    ExecutionResponse resp;
+    resp.errorCode = ErrorCode::E_SYNTAX_ERROR;
+    resp.latencyInUs = 10;
+    resp.errorMsg = std::make_unique<std::string>("syntax error near `GO'");
+    auto json = JsonWriter::toJson(resp);
+    EXPECT_EQ(resp.toJson(), folly::parseJson(json)) << json;
+  }
+  {
+    // empty result
+    auto resp = makeResponse(0);
+    auto json = JsonWriter::toJson(resp);
+    EXPECT_EQ(resp.toJson(), folly::parseJson(json)) << json;
+  }
+}
+
+TEST(JsonWriterTest, Chunks) {
+  auto resp = makeResponse(100);
+  std::vector<std::string> chunks;
+  JsonWriter writer(1024,
+                    [&chunks](std::string&& chunk) { chunks.emplace_back(std::move(chunk)); });
+  writer.write(resp);
+  writer.flush();
+  ASSERT_GT(chunks.size(), 1);
+
+  std::string json;
+  for (auto& chunk : chunks) {
+    json.append(chunk);
+  }
+  EXPECT_EQ(JsonWriter::toJson(resp), json);
+  EXPECT_EQ(resp.toJson(), folly::parseJson(json));
+}
+
+}  // namespace nebula
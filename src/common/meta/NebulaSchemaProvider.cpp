@@ -182,6 +182,10 @@ const cpp2::SchemaProp NebulaSchemaProvider::getProp() const {
   return schemaProp_;
 }
 
+int32_t NebulaSchemaProvider::getRowFormat() const {
+  return schemaProp_.row_format_ref().value_or(2);
+}
+
 StatusOr<std::pair<std::string, int64_t>> NebulaSchemaProvider::getTTLInfo() const {
   if (!schemaProp_.ttl_col_ref().has_value()) {
     return Status::Error("TTL not set");
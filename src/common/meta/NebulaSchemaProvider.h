@@ -183,6 +183,9 @@ class NebulaSchemaProvider {
 
   StatusOr<std::pair<std::string, int64_t>> getTTLInfo() const;
 
+  // The version of row encoding to write rows in this schema
+  int32_t getRowFormat() const;
+
   bool hasNullableCol() const {
     return numNullableFields_ != 0;
   }
@@ -14,6 +14,7 @@
 #include "common/base/Base.h"
 #include "common/network/NetworkUtils.h"
 #include "common/ssl/SSLConfig.h"
+#include "common/thrift/ThriftCompression.h"
 
 DECLARE_int32(conn_timeout_ms);
 
@@ -89,6 +90,11 @@ std::shared_ptr<ClientType> ThriftClientManager<ClientType>::client(const HostAd
     clientChannel->setProtocolId(apache::thrift::protocol::T_BINARY_PROTOCOL);
     //    clientChannel->setClientType(THRIFT_UNFRAMED_DEPRECATED);
   }
+  auto compression = rpcCompressionConfig();
+  if (compression.has_value()) {
+    // The peer compresses the responses in the same way
+    clientChannel->setDesiredCompressionConfig(std::move(compression).value());
+  }
   std::shared_ptr<ClientType> client(new ClientType(std::move(clientChannel)), [evb](auto* p) {
     evb->runImmediatelyOrRunInEventBaseThreadAndWait([p] { delete p; });
   });
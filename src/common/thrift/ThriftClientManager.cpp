@@ -8,3 +8,26 @@
 #include "common/base/Base.h"
 
 DEFINE_int32(conn_timeout_ms, 1000, "Connection timeout in milliseconds");
+DEFINE_string(rpc_compression_codec,
+              "none",
+              "codec to compress the rpc payloads, which is negotiated with the peer on each "
+              "channel: none, zstd or zlib");
+DEFINE_int64(rpc_compression_min_bytes,
+             64 * 1024,
+             "a request or response is compressed only if it's larger than this");
+DEFINE_int32(rpc_compression_sample_interval,
+             1000,
+             "compress one in this many large payloads again to report the compression ratio "
+             "and cost, 0 to disable");
+
+// Sanity-checking Flag Values
+static bool ValidateRpcCompressionCodec(const char* flagname, const std::string& value) {
+  if (value == "none" || value == "zstd" || value == "zlib") {
+    return true;
+  }
+  FLOG_WARN("Invalid value for --%s: %s, it should be one of none, zstd or zlib\n",
+            flagname,
+            value.c_str());
+  return false;
+}
+DEFINE_validator(rpc_compression_codec, &ValidateRpcCompressionCodec);
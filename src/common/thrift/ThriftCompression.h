@@ -0,0 +1,96 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef COMMON_THRIFT_THRIFTCOMPRESSION_H_
+#define COMMON_THRIFT_THRIFTCOMPRESSION_H_
+
+#include <folly/Random.h>
+#include <folly/compression/Compression.h>
+#include <thrift/lib/cpp2/protocol/Serializer.h>
+#include <thrift/lib/thrift/gen-cpp2/RpcMetadata_types.h>
+
+#include <optional>
+
+#include "common/base/Base.h"
+#include "common/stats/StatsManager.h"
+#include "common/time/WallClock.h"
+
+DECLARE_string(rpc_compression_codec);
+DECLARE_int64(rpc_compression_min_bytes);
+DECLARE_int32(rpc_compression_sample_interval);
+
+namespace nebula {
+namespace thrift {
+
+/**
+ * The codec of --rpc_compression_codec, none if the compression is disabled. The flag is
+ * validated to be one of none, zstd or zlib.
+ *
+ * The rocket channels negotiate the codec with the peer when they are created, and every
+ * request or response of them is compressed if it's larger than --rpc_compression_min_bytes.
+ */
+inline std::optional<folly::io::CodecType> rpcCompressionCodec() {
+  if (FLAGS_rpc_compression_codec == "zstd") {
+    return folly::io::CodecType::ZSTD;
+  }
+  if (FLAGS_rpc_compression_codec == "zlib") {
+    return folly::io::CodecType::ZLIB;
+  }
+  return std::nullopt;
+}
+
+// The compression config to ask the peer for on a new channel
+inline std::optional<apache::thrift::CompressionConfig> rpcCompressionConfig() {
+  auto codec = rpcCompressionCodec();
+  if (!codec.has_value()) {
+    return std::nullopt;
+  }
+  apache::thrift::CodecConfig codecConfig;
+  if (*codec == folly::io::CodecType::ZSTD) {
+    codecConfig.set_zstdConfig(apache::thrift::ZstdCompressionCodecConfig());
+  } else {
+    codecConfig.set_zlibConfig(apache::thrift::ZlibCompressionCodecConfig());
+  }
+  apache::thrift::CompressionConfig config;
+  config.codecConfig_ref() = std::move(codecConfig);
+  config.compressionSizeLimit_ref() = FLAGS_rpc_compression_min_bytes;
+  return config;
+}
+
+/**
+ * @brief The transport compresses the payloads out of sight, so one in
+ * --rpc_compression_sample_interval of the large ones is compressed again by the same codec, to
+ * report the percent of its compressed size and the CPU time spent.
+ *
+ * @param payload Request or response of the rpc
+ * @param compressedPercent Histogram of the compressed size in percent of the payload
+ * @param compressionUs Histogram of the time to compress the payload
+ */
+template <class T>
+void sampleCompression(const T& payload,
+                       const stats::CounterId& compressedPercent,
+                       const stats::CounterId& compressionUs) {
+  if (FLAGS_rpc_compression_sample_interval <= 0 ||
+      folly::Random::rand32(FLAGS_rpc_compression_sample_interval) != 0) {
+    return;
+  }
+  auto codecType = rpcCompressionCodec();
+  if (!codecType.has_value()) {
+    return;
+  }
+  auto data = apache::thrift::CompactSerializer::serialize<std::string>(payload);
+  if (data.empty() || static_cast<int64_t>(data.size()) < FLAGS_rpc_compression_min_bytes) {
+    return;
+  }
+  auto codec = folly::io::getCodec(*codecType);
+  auto start = time::WallClock::fastNowInMicroSec();
+  auto compressed = codec->compress(data);
+  stats::StatsManager::addValue(compressionUs, time::WallClock::fastNowInMicroSec() - start);
+  stats::StatsManager::addValue(compressedPercent, compressed.size() * 100 / data.size());
+}
+
+}  // namespace thrift
+}  // namespace nebula
+#endif  // COMMON_THRIFT_THRIFTCOMPRESSION_H_
@@ -36,6 +36,13 @@ class LocalClientManager final {
     VLOG(3) << "LocalClientManager";
   }
 };
+
+// Whether the clients of the manager call the service in process
+template <class ClientManagerType>
+struct IsLocalClientManager : std::false_type {};
+
+template <class ClientType>
+struct IsLocalClientManager<LocalClientManager<ClientType>> : std::true_type {};
 }  // namespace thrift
 }  // namespace nebula
 #endif
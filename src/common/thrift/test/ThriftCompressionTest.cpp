@@ -0,0 +1,55 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include <folly/ScopeGuard.h>
+#include <gtest/gtest.h>
+
+#include "common/base/Base.h"
+#include "common/thrift/ThriftCompression.h"
+
+namespace nebula {
+namespace thrift {
+
+TEST(ThriftCompressionTest, Codec) {
+  auto codec = FLAGS_rpc_compression_codec;
+  SCOPE_EXIT {
+    FLAGS_rpc_compression_codec = codec;
+  };
+  FLAGS_rpc_compression_codec = "none";
+  EXPECT_FALSE(rpcCompressionCodec().has_value());
+  EXPECT_FALSE(rpcCompressionConfig().has_value());
+
+  FLAGS_rpc_compression_codec = "zstd";
+  EXPECT_EQ(folly::io::CodecType::ZSTD, rpcCompressionCodec());
+  auto config = rpcCompressionConfig();
+  ASSERT_TRUE(config.has_value());
+  EXPECT_EQ(apache::thrift::CodecConfig::Type::zstdConfig, config->codecConfig_ref()->getType());
+  EXPECT_EQ(FLAGS_rpc_compression_min_bytes, *config->compressionSizeLimit_ref());
+
+  FLAGS_rpc_compression_codec = "zlib";
+  EXPECT_EQ(folly::io::CodecType::ZLIB, rpcCompressionCodec());
+  config = rpcCompressionConfig();
+  ASSERT_TRUE(config.has_value());
+  EXPECT_EQ(apache::thrift::CodecConfig::Type::zlibConfig, config->codecConfig_ref()->getType());
+}
+
+TEST(ThriftCompressionTest, Validator) {
+  auto codec = FLAGS_rpc_compression_codec;
+  SCOPE_EXIT {
+    FLAGS_rpc_compression_codec = codec;
+  };
+  FLAGS_rpc_compression_codec = "none";
+  for (const auto& value : {"lz4", "ZSTD", ""}) {
+    EXPECT_TRUE(gflags::SetCommandLineOption("rpc_compression_codec", value).empty()) << value;
+    EXPECT_EQ("none", FLAGS_rpc_compression_codec);
+  }
+  for (const auto& value : {"zstd", "zlib", "none"}) {
+    EXPECT_FALSE(gflags::SetCommandLineOption("rpc_compression_codec", value).empty()) << value;
+    EXPECT_EQ(value, FLAGS_rpc_compression_codec);
+  }
+}
+
+}  // namespace thrift
+}  // namespace nebula
@@ -0,0 +1,246 @@
+// Copyright (c) 2022 vesoft inc. All rights reserved.
+//
+// This source code is licensed under Apache 2.0 License.
+
+#include "graph/context/NeighborCache.h"
+
+#include "common/expression/Expression.h"
+#include "common/memory/MemoryTracker.h"
+#include "graph/util/Utils.h"
+
+DEFINE_uint64(max_neighbor_cache_bytes_per_query,
+              0,
+              "max bytes of the GetNeighbors rows cached by each query, 0 means disable the cache");
+
+namespace nebula {
+namespace graph {
+
+folly::dynamic NeighborCache::Hits::toJson() const {
+  folly::dynamic obj = folly::dynamic::object();
+  obj.insert("hits", hits);
+  obj.insert("misses", misses);
+  return obj;
+}
+
+folly::SemiFuture<NeighborCache::RpcResponse> NeighborCache::getNeighbors(
+    storage::StorageClient* client,
+    Hits* hits,
+    const storage::StorageClient::CommonRequestParam& param,
+    std::vector<std::string> colNames,
+    const std::vector<Value>& vids,
+    const std::vector<EdgeType>& edgeTypes,
+    storage::cpp2::EdgeDirection edgeDirection,
+    const std::vector<storage::cpp2::StatProp>* statProps,
+    const std::vector<storage::cpp2::VertexProp>* vertexProps,
+    const std::vector<storage::cpp2::EdgeProp>* edgeProps,
+    const std::vector<storage::cpp2::Expr>* expressions,
+    bool dedup,
+    bool random,
+    const std::vector<storage::cpp2::OrderBy>& orderBy,
+    int64_t limit,
+    const Expression* filter,
+    const Expression* tagFilter) {
+  bool noLimit = limit < 0 || limit == std::numeric_limits<int64_t>::max();
+  bool cacheable = FLAGS_max_neighbor_cache_bytes_per_query > 0 && statProps == nullptr &&
+                   !random && orderBy.empty() && noLimit;
+  if (!cacheable) {
+    hits->misses = vids.size();
+    misses_.fetch_add(vids.size(), std::memory_order_relaxed);
+    return client->getNeighbors(param,
+                                std::move(colNames),
+                                vids,
+                                edgeTypes,
+                                edgeDirection,
+                                statProps,
+                                vertexProps,
+                                edgeProps,
+                                expressions,
+                                dedup,
+                                random,
+                                orderBy,
+                                limit,
+                                filter,
+                                tagFilter);
+  }
+
+  auto key = signature(param.space,
+                       colNames,
+                       edgeTypes,
+                       edgeDirection,
+                       vertexProps,
+                       edgeProps,
+                       expressions,
+                       dedup,
+                       filter,
+                       tagFilter);
+  // rows fetched before a mutation are not cached
+  auto epoch = epoch_.load(std::memory_order_acquire);
+  std::vector<Value> misses;
+  auto cached = lookup(key, vids, &misses);
+  hits->hits = vids.size() - misses.size();
+  hits->misses = misses.size();
+  hits_.fetch_add(hits->hits, std::memory_order_relaxed);
+  misses_.fetch_add(hits->misses, std::memory_order_relaxed);
+
+  auto appendCached = [cached = std::move(cached)](RpcResponse& resps) mutable {
+    if (!cached.has_value()) {
+      return;
+    }
+    storage::cpp2::GetNeighborsResponse resp;
+    resp.result_ref()->latency_in_us_ref() = 0;
+    resp.vertices_ref() = std::move(cached).value();
+    resps.responses().emplace_back(std::move(resp));
+  };
+  if (misses.empty()) {
+    RpcResponse resps(1);
+    appendCached(resps);
+    return folly::makeSemiFuture<RpcResponse>(std::move(resps));
+  }
+  return client
+      ->getNeighbors(param,
+                     std::move(colNames),
+                     misses,
+                     edgeTypes,
+                     edgeDirection,
+                     statProps,
+                     vertexProps,
+                     edgeProps,
+                     expressions,
+                     dedup,
+                     random,
+                     orderBy,
+                     limit,
+                     filter,
+                     tagFilter)
+      .deferValue([this, epoch, key = std::move(key), appendCached = std::move(appendCached)](
+                      RpcResponse&& resps) mutable {
+        insert(key, resps, epoch);
+        appendCached(resps);
+        return std::move(resps);
+      });
+}
+
+std::string NeighborCache::signature(GraphSpaceID space,
+                                     const std::vector<std::string>& colNames,
+                                     const std::vector<EdgeType>& edgeTypes,
+                                     storage::cpp2::EdgeDirection edgeDirection,
+                                     const std::vector<storage::cpp2::VertexProp>* vertexProps,
+                                     const std::vector<storage::cpp2::EdgeProp>* edgeProps,
+                                     const std::vector<storage::cpp2::Expr>* expressions,
+                                     bool dedup,
+                                     const Expression* filter,
+                                     const Expression* tagFilter) {
+  std::string key;
+  key.append(folly::sformat("{}|{}|{}|", space, static_cast<int32_t>(edgeDirection), dedup));
+  key.append(folly::join(",", colNames)).append("|");
+  key.append(folly::join(",", edgeTypes)).append("|");
+  if (vertexProps != nullptr) {
+    for (const auto& prop : *vertexProps) {
+      key.append(folly::sformat("{}:{};", prop.get_tag(), folly::join(",", prop.get_props())));
+    }
+  }
+  key.append("|");
+  if (edgeProps != nullptr) {
+    for (const auto& prop : *edgeProps) {
+      key.append(folly::sformat("{}:{};", prop.get_type(), folly::join(",", prop.get_props())));
+    }
+  }
+  key.append("|");
+  if (expressions != nullptr) {
+    for (const auto& expr : *expressions) {
+      key.append(expr.get_alias()).append(":").append(expr.get_expr()).append(";");
+    }
+  }
+  key.append("|");
+  if (filter != nullptr) {
+    key.append(filter->encode());
+  }
+  key.append("|");
+  if (tagFilter != nullptr) {
+    key.append(tagFilter->encode());
+  }
+  return key;
+}
+
+std::optional<DataSet> NeighborCache::lookup(const std::string& key,
+                                             const std::vector<Value>& vids,
+                                             std::vector<Value>* misses) {
+  std::lock_guard<std::mutex> guard(lock_);
+  auto entry = entries_.find(key);
+  if (entry == entries_.end()) {
+    *misses = vids;
+    return std::nullopt;
+  }
+  DataSet ds;
+  ds.colNames = entry->second.colNames;
+  auto& rows = entry->second.rows;
+  for (const auto& vid : vids) {
+    auto row = rows.find(vid);
+    if (row == rows.end()) {
+      misses->emplace_back(vid);
+    } else {
+      ds.rows.emplace_back(row->second);
+    }
+  }
+  if (ds.rows.empty()) {
+    return std::nullopt;
+  }
+  return ds;
+}
+
+void NeighborCache::clear() {
+  std::lock_guard<std::mutex> guard(lock_);
+  epoch_.fetch_add(1, std::memory_order_release);
+  entries_.clear();
+  bytes_.store(0, std::memory_order_relaxed);
+  full_.store(false, std::memory_order_relaxed);
+}
+
+void NeighborCache::insert(const std::string& key, const RpcResponse& resps, size_t epoch) {
+  if (full_.load(std::memory_order_relaxed)) {
+    return;
+  }
+  auto maxBytes = FLAGS_max_neighbor_cache_bytes_per_query;
+  auto& memoryStats = memory::MemoryStats::instance();
+  std::lock_guard<std::mutex> guard(lock_);
+  if (epoch != epoch_.load(std::memory_order_relaxed)) {
+    return;
+  }
+  auto& entry = entries_[key];
+  for (const auto& resp : resps.responses()) {
+    auto* dataset = resp.get_vertices();
+    if (dataset == nullptr) {
+      continue;
+    }
+    if (entry.colNames.empty()) {
+      entry.colNames = dataset->colNames;
+    } else if (entry.colNames != dataset->colNames) {
+      continue;
+    }
+    for (const auto& row : dataset->rows) {
+      if (row.values.empty()) {
+        continue;
+      }
+      auto size = util::estimateSize(row);
+      auto total = bytes_.load(std::memory_order_relaxed) + size;
+      if (total > maxBytes || memoryStats.used() + size > memoryStats.getLimit()) {
+        full_.store(true, std::memory_order_relaxed);
+        return;
+      }
+      if (entry.rows.emplace(row.values.front(), row).second) {
+        bytes_.fetch_add(size, std::memory_order_relaxed);
+      }
+    }
+  }
+}
+
+folly::dynamic NeighborCache::toJson() const {
+  folly::dynamic obj = folly::dynamic::object();
+  obj.insert("hits", hits_.load(std::memory_order_relaxed));
+  obj.insert("misses", misses_.load(std::memory_order_relaxed));
+  obj.insert("bytes", bytes());
+  return obj;
+}
+
+}  // namespace graph
+}  // namespace nebula
@@ -0,0 +1,121 @@
+// Copyright (c) 2022 vesoft inc. All rights reserved.
+//
+// This source code is licensed under Apache 2.0 License.
+
+#ifndef GRAPH_CONTEXT_NEIGHBORCACHE_H_
+#define GRAPH_CONTEXT_NEIGHBORCACHE_H_
+
+#include <folly/dynamic.h>
+#include <gtest/gtest_prod.h>
+
+#include "clients/storage/StorageClient.h"
+#include "common/base/Base.h"
+#include "common/datatypes/DataSet.h"
+
+namespace nebula {
+namespace graph {
+
+// Query-scoped cache of the rows returned by GetNeighbors, which is shared by all traversal
+// executors of a query. A vertex met in several steps, or in both directions of a path finding,
+// is fetched only once for the same request.
+//
+// Rows are cached per request signature, i.e. the space, direction, edge types, props, exprs and
+// filters of the request, since all of them affect the row of a vertex. Requests with limit,
+// random, order by or stats are not cached, their rows depend on the other vertices.
+// The total size is bounded by FLAGS_max_neighbor_cache_bytes_per_query and by the memory
+// tracker, new rows are not cached once either is exceeded. It is disabled by default, since a
+// hit copies the cached rows.
+//
+// The mutating executors clear the cache once their writes are done, so a traversal after a
+// mutation in the same query does not read the rows cached before it. Rows fetched by requests
+// sent before a clear are not cached either.
+//
+// It is thread safe.
+class NeighborCache final {
+  FRIEND_TEST(NeighborCacheTest, LookupAndInsert);
+  FRIEND_TEST(NeighborCacheTest, Bound);
+  FRIEND_TEST(NeighborCacheTest, ClearOnMutation);
+
+ public:
+  using RpcResponse = storage::StorageRpcResponse<storage::cpp2::GetNeighborsResponse>;
+
+  // Lookup result of one request
+  struct Hits {
+    size_t hits{0};
+    size_t misses{0};
+
+    folly::dynamic toJson() const;
+  };
+
+  // Same as StorageClient::getNeighbors, except that only the vids which are not cached are
+  // fetched. The cached rows are appended to the responses as one more response. hits is filled
+  // before returning.
+  folly::SemiFuture<RpcResponse> getNeighbors(
+      storage::StorageClient* client,
+      Hits* hits,
+      const storage::StorageClient::CommonRequestParam& param,
+      std::vector<std::string> colNames,
+      const std::vector<Value>& vids,
+      const std::vector<EdgeType>& edgeTypes,
+      storage::cpp2::EdgeDirection edgeDirection,
+      const std::vector<storage::cpp2::StatProp>* statProps,
+      const std::vector<storage::cpp2::VertexProp>* vertexProps,
+      const std::vector<storage::cpp2::EdgeProp>* edgeProps,
+      const std::vector<storage::cpp2::Expr>* expressions,
+      bool dedup = false,
+      bool random = false,
+      const std::vector<storage::cpp2::OrderBy>& orderBy = std::vector<storage::cpp2::OrderBy>(),
+      int64_t limit = std::numeric_limits<int64_t>::max(),
+      const Expression* filter = nullptr,
+      const Expression* tagFilter = nullptr);
+
+  // Drop all cached rows, called after the vertices or edges are mutated.
+  void clear();
+
+  size_t bytes() const {
+    return bytes_.load(std::memory_order_relaxed);
+  }
+
+  // Total hits and misses of the query
+  folly::dynamic toJson() const;
+
+ private:
+  struct Entry {
+    std::vector<std::string> colNames;
+    std::unordered_map<Value, Row> rows;
+  };
+
+  static std::string signature(GraphSpaceID space,
+                               const std::vector<std::string>& colNames,
+                               const std::vector<EdgeType>& edgeTypes,
+                               storage::cpp2::EdgeDirection edgeDirection,
+                               const std::vector<storage::cpp2::VertexProp>* vertexProps,
+                               const std::vector<storage::cpp2::EdgeProp>* edgeProps,
+                               const std::vector<storage::cpp2::Expr>* expressions,
+                               bool dedup,
+                               const Expression* filter,
+                               const Expression* tagFilter);
+
+  // Split vids into the cached rows and the vids to fetch
+  std::optional<DataSet> lookup(const std::string& key,
+                                const std::vector<Value>& vids,
+                                std::vector<Value>* misses);
+
+  // Cache the rows of a request sent in epoch, unless the cache is cleared since then
+  void insert(const std::string& key, const RpcResponse& resps, size_t epoch);
+
+ private:
+  mutable std::mutex lock_;
+  std::unordered_map<std::string, Entry> entries_;
+  // bumped by each clear
+  std::atomic<size_t> epoch_{0};
+  std::atomic<size_t> bytes_{0};
+  std::atomic<size_t> hits_{0};
+  std::atomic<size_t> misses_{0};
+  // no more rows are cached once the bound is reached
+  std::atomic<bool> full_{false};
+};
+
+}  // namespace graph
+}  // namespace nebula
+#endif  // GRAPH_CONTEXT_NEIGHBORCACHE_H_
@@ -39,6 +39,7 @@ void QueryContext::init() {
   }
   idGen_ = std::make_unique<IdGenerator>(0);
   symTable_ = std::make_unique<SymbolTable>(objPool_.get(), ectx_.get());
+  neighborCache_ = std::make_unique<NeighborCache>();
   vctx_ = std::make_unique<ValidateContext>(std::make_unique<AnonVarGenerator>(symTable_.get()));
 }
 
@@ -15,6 +15,7 @@
 #include "common/meta/IndexManager.h"
 #include "common/meta/SchemaManager.h"
 #include "graph/context/ExecutionContext.h"
+#include "graph/context/NeighborCache.h"
 #include "graph/context/Symbols.h"
 #include "graph/context/ValidateContext.h"
 #include "graph/service/RequestContext.h"
@@ -123,6 +124,10 @@ class QueryContext {
     return symTable_.get();
   }
 
+  NeighborCache* neighborCache() const {
+    return neighborCache_.get();
+  }
+
   void setPartialSuccess() {
     DCHECK(rctx_ != nullptr);
     rctx_->resp().errorCode = ErrorCode::E_PARTIAL_SUCCEEDED;
@@ -132,8 +137,9 @@ class QueryContext {
     killed_.exchange(true);
   }
 
+  // Killed by the user, or the client cancelled the request
   bool isKilled() const {
-    return killed_.load();
+    return killed_.load() || (rctx_ != nullptr && rctx_->isCancelled());
   }
 
   // This is only valid in building stage!
@@ -160,6 +166,8 @@ class QueryContext {
   std::unique_ptr<ObjectPool> objPool_;
   std::unique_ptr<IdGenerator> idGen_;
   std::unique_ptr<SymbolTable> symTable_;
+  // GetNeighbors rows shared by the traversal executors of the query
+  std::unique_ptr<NeighborCache> neighborCache_;
 
   std::atomic<bool> killed_{false};
 };
@@ -0,0 +1,111 @@
+// Copyright (c) 2022 vesoft inc. All rights reserved.
+//
+// This source code is licensed under Apache 2.0 License.
+
+#include <folly/ScopeGuard.h>
+#include <gtest/gtest.h>
+
+#include "common/base/Base.h"
+#include "graph/gc/GC.h"
+#include "graph/service/GraphFlags.h"
+
+namespace nebula {
+namespace graph {
+
+static void waitForDrained(const GC& gc) {
+  for (int i = 0; i < 1000 && gc.pendingBytes() != 0; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+}
+
+TEST(GCTest, ChunkRowsValidator) {
+  auto chunkRows = FLAGS_gc_chunk_rows;
+  EXPECT_TRUE(gflags::SetCommandLineOption("gc_chunk_rows", "0").empty());
+  EXPECT_EQ(chunkRows, FLAGS_gc_chunk_rows);
+  EXPECT_FALSE(gflags::SetCommandLineOption("gc_chunk_rows", "10").empty());
+  EXPECT_EQ(10, FLAGS_gc_chunk_rows);
+  FLAGS_gc_chunk_rows = chunkRows;
+}
+
+TEST(GCTest, ChunkedRelease) {
+  auto chunkRows = FLAGS_gc_chunk_rows;
+  SCOPE_EXIT {
+    FLAGS_gc_chunk_rows = chunkRows;
+  };
+  FLAGS_gc_chunk_rows = 7;
+  auto& gc = GC::instance();
+  waitForDrained(gc);
+  ASSERT_EQ(0, gc.pendingBytes());
+
+  std::vector<Result> garbage;
+  for (size_t numRows : {1000, 7, 8, 1}) {
+    DataSet ds({"a", "b"});
+    for (size_t i = 0; i < numRows; ++i) {
+      ds.rows.emplace_back(Row({Value(static_cast<int64_t>(i)), Value(std::string(100, 'x'))}));
+    }
+    garbage.emplace_back(ResultBuilder().value(Value(std::move(ds))).build());
+  }
+  gc.clear(std::move(garbage));
+  // the bytes of all chunks add up to the bytes of the dataset
+  waitForDrained(gc);
+  EXPECT_EQ(0, gc.pendingBytes());
+}
+
+TEST(GCTest, WaitForRelease) {
+  auto maxPendingBytes = FLAGS_gc_max_pending_bytes;
+  SCOPE_EXIT {
+    FLAGS_gc_max_pending_bytes = maxPendingBytes;
+  };
+  FLAGS_gc_max_pending_bytes = 100;
+  auto& gc = GC::instance();
+  waitForDrained(gc);
+  EXPECT_TRUE(gc.waitForRelease(std::chrono::milliseconds(10)).isReady());
+
+  // hold the bytes of a garbage
+  GC::Garbage garbage;
+  garbage.bytes = 200;
+  gc.pendingBytes_ += garbage.bytes;
+  EXPECT_TRUE(gc.overloaded());
+  auto future = gc.waitForRelease(std::chrono::seconds(60));
+  EXPECT_FALSE(future.isReady());
+
+  gc.released(garbage);
+  EXPECT_FALSE(gc.overloaded());
+  auto result = std::move(future).getTry();
+  EXPECT_TRUE(result.hasValue());
+  std::lock_guard<std::mutex> l(gc.lock_);
+  EXPECT_TRUE(gc.waiters_.empty());
+}
+
+TEST(GCTest, WaitTimeout) {
+  auto maxPendingBytes = FLAGS_gc_max_pending_bytes;
+  SCOPE_EXIT {
+    FLAGS_gc_max_pending_bytes = maxPendingBytes;
+  };
+  FLAGS_gc_max_pending_bytes = 100;
+  auto& gc = GC::instance();
+  waitForDrained(gc);
+
+  GC::Garbage garbage;
+  garbage.bytes = 200;
+  gc.pendingBytes_ += garbage.bytes;
+  std::vector<folly::SemiFuture<folly::Unit>> futures;
+  for (int i = 0; i < 10; ++i) {
+    futures.emplace_back(gc.waitForRelease(std::chrono::milliseconds(10)));
+  }
+  for (auto& future : futures) {
+    auto result = std::move(future).getTry();
+    ASSERT_TRUE(result.hasException());
+    EXPECT_TRUE(result.exception().is_compatible_with<folly::FutureTimeout>());
+  }
+  // the waiters which time out are dropped
+  {
+    std::lock_guard<std::mutex> l(gc.lock_);
+    EXPECT_TRUE(gc.waiters_.empty());
+  }
+  gc.released(garbage);
+  EXPECT_EQ(0, gc.pendingBytes());
+}
+
+}  // namespace graph
+}  // namespace nebula
@@ -0,0 +1,101 @@
+// Copyright (c) 2022 vesoft inc. All rights reserved.
+//
+// This source code is licensed under Apache 2.0 License.
+
+#include <gtest/gtest.h>
+
+#include "common/base/Base.h"
+#include "graph/context/NeighborCache.h"
+
+DECLARE_uint64(max_neighbor_cache_bytes_per_query);
+
+namespace nebula {
+namespace graph {
+
+static NeighborCache::RpcResponse makeResponse(const std::vector<std::string>& vids,
+                                               const std::string& dstSuffix = "_dst") {
+  DataSet ds({"_vid", "_stats", "_edge:+like:_dst", "_expr"});
+  for (const auto& vid : vids) {
+    List edges;
+    edges.values.emplace_back(List({Value(vid + dstSuffix)}));
+    ds.rows.emplace_back(Row({Value(vid), Value(), Value(std::move(edges)), Value()}));
+  }
+  storage::cpp2::GetNeighborsResponse resp;
+  resp.vertices_ref() = std::move(ds);
+  NeighborCache::RpcResponse resps(1);
+  resps.addResponse(std::move(resp));
+  return resps;
+}
+
+TEST(NeighborCacheTest, LookupAndInsert) {
+  auto maxBytes = FLAGS_max_neighbor_cache_bytes_per_query;
+  FLAGS_max_neighbor_cache_bytes_per_query = 64UL * 1024 * 1024;
+  NeighborCache cache;
+  std::vector<Value> misses;
+  EXPECT_FALSE(cache.lookup("k", {Value("a"), Value("b")}, &misses).has_value());
+  EXPECT_EQ(2, misses.size());
+
+  cache.insert("k", makeResponse({"a", "b"}), cache.epoch_);
+  EXPECT_GT(cache.bytes(), 0);
+  misses.clear();
+  auto ds = cache.lookup("k", {Value("a"), Value("c"), Value("b")}, &misses);
+  ASSERT_TRUE(ds.has_value());
+  EXPECT_EQ(std::vector<std::string>({"_vid", "_stats", "_edge:+like:_dst", "_expr"}),
+            ds->colNames);
+  ASSERT_EQ(2, ds->rows.size());
+  EXPECT_EQ(Value("a"), ds->rows[0].values[0]);
+  EXPECT_EQ(Value("b"), ds->rows[1].values[0]);
+  EXPECT_EQ(std::vector<Value>({Value("c")}), misses);
+
+  // rows are cached per request signature
+  misses.clear();
+  EXPECT_FALSE(cache.lookup("other", {Value("a")}, &misses).has_value());
+  EXPECT_EQ(1, misses.size());
+  FLAGS_max_neighbor_cache_bytes_per_query = maxBytes;
+}
+
+TEST(NeighborCacheTest, Bound) {
+  auto maxBytes = FLAGS_max_neighbor_cache_bytes_per_query;
+  FLAGS_max_neighbor_cache_bytes_per_query = 1;
+  NeighborCache cache;
+  cache.insert("k", makeResponse({"a"}), cache.epoch_);
+  EXPECT_EQ(0, cache.bytes());
+  std::vector<Value> misses;
+  EXPECT_FALSE(cache.lookup("k", {Value("a")}, &misses).has_value());
+  FLAGS_max_neighbor_cache_bytes_per_query = maxBytes;
+}
+
+TEST(NeighborCacheTest, ClearOnMutation) {
+  auto maxBytes = FLAGS_max_neighbor_cache_bytes_per_query;
+  FLAGS_max_neighbor_cache_bytes_per_query = 64UL * 1024 * 1024;
+  NeighborCache cache;
+  // the first traversal fetches and caches the rows
+  std::vector<Value> misses;
+  EXPECT_FALSE(cache.lookup("k", {Value("a")}, &misses).has_value());
+  cache.insert("k", makeResponse({"a"}), cache.epoch_);
+  misses.clear();
+  ASSERT_TRUE(cache.lookup("k", {Value("a")}, &misses).has_value());
+
+  // a request sent before the mutation arrives after it
+  auto staleEpoch = cache.epoch_.load();
+  // an edge of a is inserted, the mutating executor clears the cache
+  cache.clear();
+  EXPECT_EQ(0, cache.bytes());
+  cache.insert("k", makeResponse({"b"}), staleEpoch);
+  EXPECT_EQ(0, cache.bytes());
+
+  // the traversal after the mutation fetches the new rows instead of the cached ones
+  misses.clear();
+  EXPECT_FALSE(cache.lookup("k", {Value("a"), Value("b")}, &misses).has_value());
+  EXPECT_EQ(std::vector<Value>({Value("a"), Value("b")}), misses);
+  cache.insert("k", makeResponse({"a"}, "_new_dst"), cache.epoch_);
+  misses.clear();
+  auto ds = cache.lookup("k", {Value("a")}, &misses);
+  ASSERT_TRUE(ds.has_value());
+  ASSERT_EQ(1, ds->rows.size());
+  EXPECT_EQ(Value(List({Value(List({Value("a_new_dst")}))})), ds->rows[0].values[2]);
+  FLAGS_max_neighbor_cache_bytes_per_query = maxBytes;
+}
+
+}  // namespace graph
+}  // namespace nebula
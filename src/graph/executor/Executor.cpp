@@ -103,6 +103,7 @@
 #include "graph/planner/plan/Query.h"
 #include "graph/service/GraphFlags.h"
 #include "graph/stats/GraphStats.h"
+#include "graph/util/Utils.h"
 #include "interface/gen-cpp2/graph_types.h"
 
 using folly::stringPrintf;
@@ -113,6 +114,8 @@ DECLARE_double(system_memory_high_watermark_ratio);
 namespace nebula {
 namespace graph {
 
+static constexpr size_t kProfileSampleRows = 64;
+
 // static
 Executor *Executor::create(const PlanNode *node, QueryContext *qctx) {
   std::unordered_map<int64_t, Executor *> visited;
@@ -614,6 +617,11 @@ Status Executor::close() {
   stats.totalDurationInUs = totalDuration_.elapsedInUSec();
   stats.rows = numRows_;
   stats.execDurationInUs = execTime_;
+  if (qctx()->plan()->isProfileEnabled() && ectx_->exist(node_->outputVar())) {
+    // The memory held by the operator after it's done, sampled like the GC does
+    auto bytes = util::estimateSize(ectx_->getValue(node_->outputVar()), kProfileSampleRows);
+    addState("output_bytes", folly::dynamic(bytes));
+  }
   if (!otherStats_.empty()) {
     stats.otherStats =
         std::make_unique<std::unordered_map<std::string, std::string>>(std::move(otherStats_));
@@ -220,7 +220,8 @@ void StorageAccessExecutor::addGetNeighborStats(RpcResponse &resp, size_t stepNu
     if (result.vertices_ref().has_value()) {
       size = (*result.vertices_ref()).size();
     }
-    auto info = util::collectRespProfileData(result.result, hostLatency[i], size);
+    auto info =
+        util::collectRespProfileData(result.result, hostLatency[i], size, respBytes(result));
     stats.push_back(std::move(info));
   }
 
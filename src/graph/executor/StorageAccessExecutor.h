@@ -6,6 +6,7 @@
 #define GRAPH_EXECUTOR_STORAGEACCESSEXECUTOR_H_
 
 #include <thrift/lib/cpp/util/EnumUtils.h>
+#include <thrift/lib/cpp2/protocol/CompactProtocol.h>
 
 #include "clients/storage/StorageClientBase.h"
 #include "graph/executor/Executor.h"
@@ -158,11 +159,24 @@ class StorageAccessExecutor : public Executor {
   void addStats(storage::StorageRpcResponse<RESP> &resp) {
     auto &hostLatency = resp.hostLatency();
     for (size_t i = 0; i < hostLatency.size(); ++i) {
-      auto info = util::collectRespProfileData(resp.responses()[i].get_result(), hostLatency[i]);
+      auto &result = resp.responses()[i];
+      auto info =
+          util::collectRespProfileData(result.get_result(), hostLatency[i], 0, respBytes(result));
       addState(folly::sformat("resp[{}]", i), std::move(info));
     }
   }
 
+  // Size of the response in the compact protocol. It walks the whole response, so it's only
+  // measured when the query is profiled, otherwise returns 0.
+  template <typename RESP>
+  size_t respBytes(const RESP &resp) const {
+    if (!qctx()->plan()->isProfileEnabled()) {
+      return 0;
+    }
+    apache::thrift::CompactProtocolWriter writer;
+    return resp.serializedSize(&writer);
+  }
+
   bool isIntVidType(const SpaceInfo &space) const;
 
   StatusOr<DataSet> buildRequestDataSetByVidType(Iterator *iter,
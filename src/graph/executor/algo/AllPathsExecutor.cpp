@@ -7,11 +7,6 @@
 #include "graph/planner/plan/Algo.h"
 #include "graph/service/GraphFlags.h"
 
-DEFINE_uint32(
-    path_threshold_size,
-    100,
-    "the number of vids to expand, when this threshold is exceeded, use heuristic expansion");
-DEFINE_uint32(path_threshold_ratio, 2, "threshold for heuristics expansion");
 DEFINE_uint32(path_batch_size, 10000, "number of paths constructed by each thread");
 
 namespace nebula {
@@ -21,6 +16,7 @@ folly::Future<Status> AllPathsExecutor::execute() {
   pathNode_ = asNode<AllPaths>(node());
   noLoop_ = pathNode_->noLoop();
   maxStep_ = pathNode_->steps();
+  driver_ = std::make_unique<ExpansionDriver>(maxStep_);
   withProp_ = pathNode_->withProp();
   if (pathNode_->limit() != -1) {
     limit_ = pathNode_->limit();
@@ -58,36 +54,33 @@ void AllPathsExecutor::buildRequestVids(bool reverse) {
   }
 }
 
-AllPathsExecutor::Direction AllPathsExecutor::direction() {
-  auto leftSize = leftNextStepVids_.size();
-  auto rightSize = rightNextStepVids_.size();
-  if (leftSteps_ + rightSteps_ + 1 == maxStep_) {
-    if (leftSize > rightSize) {
-      ++rightSteps_;
-      return Direction::kRight;
-    } else {
-      ++leftSteps_;
-      return Direction::kLeft;
-    }
-  }
-  if (leftSize > FLAGS_path_threshold_size && rightSize > FLAGS_path_threshold_size) {
-    if (leftSize > rightSize && leftSize / rightSize > FLAGS_path_threshold_ratio) {
-      ++rightSteps_;
-      return Direction::kRight;
-    }
-    if (rightSize > leftSize && rightSize / leftSize > FLAGS_path_threshold_ratio) {
-      ++leftSteps_;
-      return Direction::kLeft;
-    }
-  }
-  ++leftSteps_;
-  ++rightSteps_;
-  return Direction::kBoth;
+folly::Future<Status> AllPathsExecutor::sampleDegrees() {
+  storage::StorageClient::CommonRequestParam param(pathNode_->space(),
+                                                   qctx_->rctx()->session()->id(),
+                                                   qctx_->plan()->id(),
+                                                   qctx_->plan()->isProfileEnabled());
+  time::Duration sampleTime;
+  return driver_
+      ->sample(qctx_,
+               param,
+               storage::cpp2::EdgeDirection::OUT_EDGE,
+               pathNode_->edgeProps(),
+               pathNode_->reverseEdgeProps(),
+               leftNextStepVids_,
+               rightNextStepVids_,
+               runner())
+      .ensure([this, sampleTime]() { addState("sample_degree_time", sampleTime); });
 }
 
 folly::Future<Status> AllPathsExecutor::doAllPaths() {
+  if (driver_->needSample()) {
+    return sampleDegrees().thenValue([this](auto&& status) -> folly::Future<Status> {
+      NG_RETURN_IF_ERROR(status);
+      return doAllPaths();
+    });
+  }
   std::vector<folly::Future<Status>> futures;
-  switch (direction()) {
+  switch (driver_->next(leftNextStepVids_.size(), rightNextStepVids_.size())) {
     case Direction::kRight: {
       futures.emplace_back(getNeighbors(true));
       break;
@@ -109,8 +102,8 @@ folly::Future<Status> AllPathsExecutor::doAllPaths() {
         return folly::makeFuture<Status>(std::move(resp));
       }
     }
-    if (leftSteps_ + rightSteps_ >= maxStep_ || leftNextStepVids_.empty() ||
-        rightNextStepVids_.empty()) {
+    if (driver_->exhausted() || leftNextStepVids_.empty() || rightNextStepVids_.empty()) {
+      addState("expansion", driver_->toJson());
       return buildResult();
     }
     return doAllPaths();
@@ -125,8 +118,11 @@ folly::Future<Status> AllPathsExecutor::getNeighbors(bool reverse) {
                                                    qctx_->plan()->isProfileEnabled());
   auto& vids = reverse ? rightNextStepVids_ : leftNextStepVids_;
   auto filter = pathNode_->filter() ? pathNode_->filter()->clone() : nullptr;
-  return storageClient
-      ->getNeighbors(param,
+  NeighborCache::Hits hits;
+  return qctx_->neighborCache()
+      ->getNeighbors(storageClient,
+                     &hits,
+                     param,
                      {nebula::kVid},
                      std::move(vids),
                      {},
@@ -142,10 +138,12 @@ folly::Future<Status> AllPathsExecutor::getNeighbors(bool reverse) {
                      filter,
                      nullptr)
       .via(runner())
-      .thenValue([this, reverse](auto&& resps) {
+      .thenValue([this, reverse, hits](auto&& resps) {
         memory::MemoryCheckGuard guard;
-        auto step = reverse ? rightSteps_ : leftSteps_;
+        auto step = driver_->steps(reverse);
         addGetNeighborStats(resps, step, reverse);
+        addState(folly::sformat("neighbor_cache {}step[{}]", reverse ? "reverse " : "", step),
+                 hits.toJson());
         auto result = handleCompleteness(resps, FLAGS_accept_partial_success);
         NG_RETURN_IF_ERROR(result);
         auto& responses = std::move(resps).responses();
@@ -172,15 +170,18 @@ void AllPathsExecutor::expand(GetNeighborsIter* iter, bool reverse) {
   if (iter->numRows() == 0) {
     return;
   }
+  driver_->expanded(reverse, iter->numRows(), iter->size());
   auto& adjList = reverse ? rightAdjList_ : leftAdjList_;
+  auto& dict = adjList.dict;
   auto& nextStepVids = reverse ? rightNextStepVids_ : leftNextStepVids_;
   nextStepVids.clear();
   auto* stepFilter = pathNode_->stepFilter();
   QueryExpressionContext ctx(ectx_);
 
-  std::unordered_set<Value> uniqueVids;
-  Value curVertex;
-  std::vector<Value> adjEdges;
+  DenseBitset uniqueVids;
+  Value curVid;
+  // skip the edges of a vertex which has been expanded
+  bool skip = false;
   for (; iter->valid(); iter->next()) {
     if (stepFilter != nullptr) {
       const auto& stepFilterVal = stepFilter->eval(ctx(iter));
@@ -188,24 +189,34 @@ void AllPathsExecutor::expand(GetNeighborsIter* iter, bool reverse) {
         continue;
       }
     }
-    const auto& edge = iter->getEdge();
-    if (edge.empty()) {
+    auto edgeVal = iter->getEdge();
+    if (!edgeVal.isEdge()) {
       continue;
     }
-    const auto& dst = edge.getEdge().dst;
-    if (adjList.find(dst) == adjList.end() && uniqueVids.emplace(dst).second) {
-      nextStepVids.emplace_back(dst);
+    const auto& edge = edgeVal.getEdge();
+    if (curVid.empty() || curVid != edge.src) {
+      curVid = edge.src;
+      auto srcId = dict.getOrAdd(curVid);
+      skip = adjList.edges.contains(srcId);
+      if (!skip) {
+        adjList.edges.addVertex(srcId);
+        adjList.vertices.resize(dict.size());
+        adjList.vertices[srcId] = iter->getVertex();
+        if (noLoop_) {
+          adjList.vertexBits.resize(dict.size());
+          adjList.vertexBits[srcId] = vidBloomBit(curVid);
+        }
+      }
     }
-    const auto& vertex = iter->getVertex();
-    curVertex = curVertex.empty() ? vertex : curVertex;
-    if (curVertex != vertex) {
-      adjList.emplace(curVertex, std::move(adjEdges));
-      curVertex = vertex;
+    if (skip) {
+      continue;
     }
-    adjEdges.emplace_back(edge);
-  }
-  if (!curVertex.empty()) {
-    adjList.emplace(curVertex, std::move(adjEdges));
+    auto dstId = dict.getOrAdd(edge.dst);
+    if (!adjList.edges.contains(dstId) && uniqueVids.set(dstId)) {
+      nextStepVids.emplace_back(edge.dst);
+    }
+    auto bloomBit = noLoop_ ? 0 : edgeBloomBit(edge);
+    adjList.edges.addNeighbor(dstId, AdjEdge{std::move(edgeVal), bloomBit});
   }
 }
 
@@ -260,11 +271,11 @@ folly::Future<Status> AllPathsExecutor::buildPathMultiJobs() {
         auto leftPaths = std::move(leftPathsValues).value();
         auto rightPaths = std::move(rightPathsValues).value();
 
-        if (leftSteps_ == 0) {
+        if (driver_->steps(false) == 0) {
           buildOneWayPath(rightPaths, false);
           return folly::makeFuture<Status>(Status::OK());
         }
-        if (rightSteps_ == 0) {
+        if (driver_->steps(true) == 0) {
           buildOneWayPath(leftPaths, true);
           return folly::makeFuture<Status>(Status::OK());
         }
@@ -285,7 +296,7 @@ folly::Future<std::vector<AllPathsExecutor::NPath*>> AllPathsExecutor::doBuildPa
     std::shared_ptr<std::vector<NPath*>> pathsPtr,
     bool reverse) {
   memory::MemoryCheckGuard guard;
-  auto maxStep = reverse ? rightSteps_ : leftSteps_;
+  auto maxStep = driver_->steps(reverse);
   if (step > maxStep) {
     return folly::makeFuture<std::vector<NPath*>>(std::vector<NPath*>());
   }
@@ -301,17 +312,14 @@ folly::Future<std::vector<AllPathsExecutor::NPath*>> AllPathsExecutor::doBuildPa
       if (memoryExceeded_.load(std::memory_order_acquire) == true) {
         return folly::makeFuture<std::vector<NPath*>>(std::vector<NPath*>());
       }
-      auto vidIter = adjList.find(vid);
-      if (vidIter == adjList.end()) {
+      auto srcId = adjList.dict.find(vid);
+      if (!adjList.edges.contains(srcId)) {
         continue;
       }
-      auto& src = vidIter->first;
-      auto& adjEdges = vidIter->second;
-      if (adjEdges.empty()) {
-        continue;
-      }
-      for (auto& edge : adjEdges) {
-        threadLocalPtr_->emplace_back(NPath(src, edge));
+      auto& src = adjList.vertices[srcId];
+      for (auto& neighbor : adjList.edges.neighbors(srcId)) {
+        auto bit = noLoop_ ? adjList.vertexBits[srcId] : neighbor.edge.bloomBit;
+        threadLocalPtr_->emplace_back(NPath(srcId, src, neighbor.dst, neighbor.edge.value, bit));
         newPathsPtr->emplace_back(&threadLocalPtr_->back());
       }
     }
@@ -321,25 +329,27 @@ folly::Future<std::vector<AllPathsExecutor::NPath*>> AllPathsExecutor::doBuildPa
         return folly::makeFuture<std::vector<NPath*>>(std::vector<NPath*>());
       }
       auto path = (*pathsPtr)[i];
-      auto& edgeValue = path->edge;
-      DCHECK(edgeValue.isEdge());
-      auto& dst = edgeValue.getEdge().dst;
-      auto adjIter = adjList.find(dst);
-      if (adjIter == adjList.end()) {
+      auto srcId = path->dstId;
+      if (!adjList.edges.contains(srcId)) {
         continue;
       }
-      auto& adjEdges = adjIter->second;
-      for (auto& edge : adjEdges) {
+      auto& src = adjList.vertices[srcId];
+      for (auto& neighbor : adjList.edges.neighbors(srcId)) {
         if (noLoop_) {
-          if (hasSameVertices(path, edge.getEdge())) {
+          // a vertex which is not expanded is not in any path
+          auto dstBit =
+              adjList.edges.contains(neighbor.dst) ? adjList.vertexBits[neighbor.dst] : 0;
+          if (hasSameVertices(path, srcId, neighbor.dst, dstBit)) {
             continue;
           }
         } else {
-          if (hasSameEdge(path, edge.getEdge())) {
+          if (hasSameEdge(path, neighbor.edge)) {
             continue;
           }
         }
-        threadLocalPtr_->emplace_back(NPath(path, adjIter->first, edge));
+        auto bit = noLoop_ ? adjList.vertexBits[srcId] : neighbor.edge.bloomBit;
+        threadLocalPtr_->emplace_back(
+            NPath(path, srcId, src, neighbor.dst, neighbor.edge.value, bit));
         newPathsPtr->emplace_back(&threadLocalPtr_->back());
       }
     }
@@ -473,13 +483,13 @@ std::vector<Row> AllPathsExecutor::buildOneWayPathFromHashTable(bool reverse) {
         if (cnt_.load(std::memory_order_relaxed) > limit_) {
           break;
         }
+        auto valueList = convertNPath2List(path, !reverse);
         Row row;
         row.values.emplace_back(emptyPropVertex);
-        auto& dstVertex = path.back();
-        std::vector<Value> tmp(path.begin(), path.end() - 1);
-        List edgeList(std::move(tmp));
-        row.values.emplace_back(std::move(edgeList));
-        row.values.emplace_back(dstVertex);
+        auto dstVertex = std::move(valueList.back());
+        valueList.pop_back();
+        row.values.emplace_back(List(std::move(valueList)));
+        row.values.emplace_back(std::move(dstVertex));
         result.emplace_back(std::move(row));
       }
     } else {
@@ -488,11 +498,12 @@ std::vector<Row> AllPathsExecutor::buildOneWayPathFromHashTable(bool reverse) {
         if (cnt_.load(std::memory_order_relaxed) > limit_) {
           break;
         }
+        auto valueList = convertNPath2List(path, !reverse);
         Row row;
-        row.values.emplace_back(path.front());
-        std::vector<Value> tmp(path.begin() + 1, path.end());
-        List edgeList(std::move(tmp));
-        row.values.emplace_back(std::move(edgeList));
+        row.values.emplace_back(valueList.front());
+        std::vector<Value> tmp(std::make_move_iterator(valueList.begin() + 1),
+                               std::make_move_iterator(valueList.end()));
+        row.values.emplace_back(List(std::move(tmp)));
         row.values.emplace_back(emptyPropVertex);
         result.emplace_back(std::move(row));
       }
@@ -513,11 +524,11 @@ folly::Future<Status> AllPathsExecutor::conjunctPath(std::vector<NPath*>& leftPa
   }
   bool reverse = false;
   if (leftPaths.size() < rightPaths.size()) {
-    buildHashTable(leftPaths, reverse);
+    buildHashTable(leftPaths);
     probePaths_ = std::move(rightPaths);
   } else {
     reverse = true;
-    buildHashTable(rightPaths, reverse);
+    buildHashTable(rightPaths);
     probePaths_ = std::move(leftPaths);
   }
   auto oneWayPath = buildOneWayPathFromHashTable(!reverse);
@@ -575,17 +586,9 @@ folly::Future<Status> AllPathsExecutor::conjunctPath(std::vector<NPath*>& leftPa
       });
 }
 
-void AllPathsExecutor::buildHashTable(std::vector<NPath*>& paths, bool reverse) {
+void AllPathsExecutor::buildHashTable(std::vector<NPath*>& paths) {
   for (auto& path : paths) {
-    auto& edgeVal = path->edge;
-    const auto& edge = edgeVal.getEdge();
-    auto findDst = hashTable_.find(edge.dst);
-    if (findDst == hashTable_.end()) {
-      std::vector<std::vector<Value>> tmp({convertNPath2List(path, reverse)});
-      hashTable_.emplace(edge.dst, std::move(tmp));
-    } else {
-      findDst->second.emplace_back(convertNPath2List(path, reverse));
-    }
+    hashTable_[path->edge.getEdge().dst].emplace_back(path);
   }
 }
 
@@ -604,7 +607,7 @@ std::vector<Row> AllPathsExecutor::probe(size_t start, size_t end, bool reverse)
     return row;
   };
 
-  size_t minLength = reverse ? rightSteps_ * 2 : leftSteps_ * 2;
+  size_t length = driver_->steps(reverse);
   std::vector<Row> result;
   Row emptyPropVerticesRow;
   for (size_t i = start; i < end; ++i) {
@@ -619,14 +622,15 @@ std::vector<Row> AllPathsExecutor::probe(size_t start, size_t end, bool reverse)
     if (findDst == hashTable_.end()) {
       continue;
     }
-    auto valueList = convertNPath2List(probePath, !reverse);
+    // converted when the first path is joined
+    std::vector<Value> valueList;
 
-    for (auto& path : findDst->second) {
-      if (path.size() != minLength) {
+    for (auto* path : findDst->second) {
+      if (path->length != length) {
         continue;
       }
-      auto& leftPath = reverse ? valueList : path;
-      auto& rightPath = reverse ? path : valueList;
+      auto* leftPath = reverse ? probePath : path;
+      auto* rightPath = reverse ? path : probePath;
       if (noLoop_) {
         if (hasSameVertices(leftPath, intersectVid, rightPath)) {
           continue;
@@ -640,7 +644,13 @@ std::vector<Row> AllPathsExecutor::probe(size_t start, size_t end, bool reverse)
       if (cnt_.load(std::memory_order_relaxed) > limit_) {
         break;
       }
-      result.emplace_back(buildPath(leftPath, intersectVertex, rightPath));
+      if (valueList.empty()) {
+        valueList = convertNPath2List(probePath, !reverse);
+      }
+      auto hashList = convertNPath2List(path, reverse);
+      auto& leftList = reverse ? valueList : hashList;
+      auto& rightList = reverse ? hashList : valueList;
+      result.emplace_back(buildPath(leftList, intersectVertex, rightList));
     }
     emptyPropVerticesRow.values.emplace_back(intersectVertex);
   }
@@ -667,10 +677,14 @@ folly::Future<Status> AllPathsExecutor::getPathProps() {
   });
 }
 
-bool AllPathsExecutor::hasSameEdge(NPath* path, const Edge& edge) {
+bool AllPathsExecutor::hasSameEdge(NPath* path, const AdjEdge& edge) {
+  if ((path->bloom & edge.bloomBit) == 0) {
+    return false;
+  }
+  const auto& e = edge.value.getEdge();
   NPath* head = path;
   while (head != nullptr) {
-    if (edge == head->edge) {
+    if (head->edge.getEdge().keyEqual(e)) {
       return true;
     }
     head = head->p;
@@ -678,15 +692,16 @@ bool AllPathsExecutor::hasSameEdge(NPath* path, const Edge& edge) {
   return false;
 }
 
-bool AllPathsExecutor::hasSameVertices(NPath* path, const Edge& edge) {
-  if (edge.src == edge.dst) {
+bool AllPathsExecutor::hasSameVertices(NPath* path, uint32_t src, uint32_t dst, uint64_t dstBit) {
+  if (src == dst) {
     return true;
   }
-  auto& vid = edge.dst;
+  if ((path->bloom & dstBit) == 0) {
+    return false;
+  }
   NPath* head = path;
   while (head != nullptr) {
-    auto& vertex = head->vertex;
-    if (vertex.getVertex().vid == vid) {
+    if (head->vertexId == dst) {
       return true;
     }
     head = head->p;
@@ -694,13 +709,14 @@ bool AllPathsExecutor::hasSameVertices(NPath* path, const Edge& edge) {
   return false;
 }
 
-bool AllPathsExecutor::hasSameEdge(std::vector<Value>& leftPaths, std::vector<Value>& rightPaths) {
-  for (auto& leftEdge : leftPaths) {
-    if (!leftEdge.isEdge()) {
-      continue;
-    }
-    for (auto& rightEdge : rightPaths) {
-      if (rightEdge.isEdge() && rightEdge.getEdge().keyEqual(leftEdge.getEdge())) {
+bool AllPathsExecutor::hasSameEdge(NPath* leftPath, NPath* rightPath) {
+  if ((leftPath->bloom & rightPath->bloom) == 0) {
+    return false;
+  }
+  for (NPath* left = leftPath; left != nullptr; left = left->p) {
+    const auto& leftEdge = left->edge.getEdge();
+    for (NPath* right = rightPath; right != nullptr; right = right->p) {
+      if (right->edge.getEdge().keyEqual(leftEdge)) {
         return true;
       }
     }
@@ -708,22 +724,29 @@ bool AllPathsExecutor::hasSameEdge(std::vector<Value>& leftPaths, std::vector<Va
   return false;
 }
 
-bool AllPathsExecutor::hasSameVertices(const std::vector<Value>& leftPaths,
-                                       const Value& intersectVertex,
-                                       const std::vector<Value>& rightPaths) {
-  bool flag = leftPaths.size() > rightPaths.size();
-  const auto& hashPath = flag ? rightPaths : leftPaths;
-  const auto& probePath = flag ? leftPaths : rightPaths;
-  VidHashSet hashTable;
-  for (const auto& v : hashPath) {
-    if (v.isVertex()) {
-      hashTable.emplace(v);
-    }
-  }
-  hashTable.emplace(intersectVertex);
-  for (const auto& v : probePath) {
-    if (v.isVertex()) {
-      if (hashTable.find(v) != hashTable.end()) {
+bool AllPathsExecutor::hasSameVertices(NPath* leftPath,
+                                       const Value& intersectVid,
+                                       NPath* rightPath) {
+  // ids of the two directions come from different dicts, so vids are compared
+  auto intersectBit = vidBloomBit(intersectVid);
+  if ((leftPath->bloom & rightPath->bloom) == 0 &&
+      ((leftPath->bloom | rightPath->bloom) & intersectBit) == 0) {
+    return false;
+  }
+  auto& leftDict = leftAdjList_.dict;
+  auto& rightDict = rightAdjList_.dict;
+  for (NPath* right = rightPath; right != nullptr; right = right->p) {
+    if (rightDict.vid(right->vertexId) == intersectVid) {
+      return true;
+    }
+  }
+  for (NPath* left = leftPath; left != nullptr; left = left->p) {
+    const auto& leftVid = leftDict.vid(left->vertexId);
+    if (leftVid == intersectVid) {
+      return true;
+    }
+    for (NPath* right = rightPath; right != nullptr; right = right->p) {
+      if (rightDict.vid(right->vertexId) == leftVid) {
         return true;
       }
     }
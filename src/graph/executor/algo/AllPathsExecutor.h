@@ -7,18 +7,14 @@
 
 #include "folly/ThreadLocal.h"
 #include "graph/executor/StorageAccessExecutor.h"
-
-// Using the two-way BFS algorithm, a heuristic algorithm is used in the expansion process
-// when the number of vid to be expanded on the left and right
-// exceeds the threshold(FLAGS_path_threshold_size)
-
-// if size(leftVids) / size(rightVids) >= FLAGS_path_threshold_ratio(default 2)
-//    expandFromRight
-// else if size(rightVids) / size(leftVids) >= FLAGS_path_threshold_ratio(default 2)
-//    expandFromLeft
-// else
-//    expandFromLeft
-//    expandFromRight
+#include "graph/executor/algo/ExpansionDriver.h"
+#include "graph/util/PathTree.h"
+#include "graph/util/VertexDict.h"
+
+// Using the two-way BFS algorithm, the side(s) to expand in each round are chosen by
+// ExpansionDriver from the estimated number of edges of both frontiers, that is, the size of
+// the frontier multiplied by the degree sampled before the first round or observed in the last
+// expansion of that side.
 // this way can avoid uneven calculation distribution due to data skew
 // finally the path is constructed using an asynchronous process in the adjacency list
 
@@ -27,6 +23,10 @@
 // when expanding, if the vid has already been visited, do not visit again
 // leftAdjList_ save result of forward expansion
 // rightAdjList_ save result of backward expansion
+// vids are mapped to dense ids when they are first seen, the adjacency list is stored in CSR
+// layout and paths are built by ids, Values are only referenced when building the output
+// paths are NPath trees sharing their prefixes, duplicate edges or vertices are checked with the
+// bloom bits of paths first, and paths are converted to lists only when they are in the result
 namespace nebula {
 namespace graph {
 class AllPaths;
@@ -38,30 +38,73 @@ class AllPathsExecutor final : public StorageAccessExecutor {
 
   folly::Future<Status> execute() override;
 
-  enum class Direction : uint8_t {
-    kLeft,
-    kRight,
-    kBoth,
-  };
+  using Direction = ExpansionDriver::Direction;
 
   template <typename T = Value>
   using VertexMap = std::unordered_map<Value, std::vector<T>, VertexHash, VertexEqual>;
 
+  // A path is a node pointing to the path it extends, so paths share their prefixes.
   struct NPath {
     NPath* p{nullptr};
+    // dense id of vertex and the dst of edge
+    uint32_t vertexId;
+    uint32_t dstId;
+    // number of edges
+    uint32_t length{1};
+    // bloom bits of all edges, or of all vertices when noLoop_
+    uint64_t bloom;
     const Value& vertex;
     const Value& edge;
-    NPath(const Value& v, const Value& e) : vertex(v), edge(e) {}
-    NPath(NPath* path, const Value& v, const Value& e) : p(path), vertex(v), edge(e) {}
-    NPath(NPath&& v) noexcept : p(v.p), vertex(std::move(v.vertex)), edge(std::move(v.edge)) {}
-    NPath(const NPath& v) : p(v.p), vertex(v.vertex), edge(v.edge) {}
+    NPath(uint32_t vId, const Value& v, uint32_t dId, const Value& e, uint64_t bit)
+        : vertexId(vId), dstId(dId), bloom(bit), vertex(v), edge(e) {}
+    NPath(NPath* path, uint32_t vId, const Value& v, uint32_t dId, const Value& e, uint64_t bit)
+        : p(path),
+          vertexId(vId),
+          dstId(dId),
+          length(path->length + 1),
+          bloom(path->bloom | bit),
+          vertex(v),
+          edge(e) {}
+    NPath(NPath&& v) noexcept
+        : p(v.p),
+          vertexId(v.vertexId),
+          dstId(v.dstId),
+          length(v.length),
+          bloom(v.bloom),
+          vertex(std::move(v.vertex)),
+          edge(std::move(v.edge)) {}
+    NPath(const NPath& v)
+        : p(v.p),
+          vertexId(v.vertexId),
+          dstId(v.dstId),
+          length(v.length),
+          bloom(v.bloom),
+          vertex(v.vertex),
+          edge(v.edge) {}
     ~NPath() {}
   };
 
+  struct AdjEdge {
+    Value value;
+    // bloom bit of the edge, only set when loops are allowed
+    uint64_t bloomBit{0};
+  };
+
+  // Adjacency list of one direction. Each direction has its own dict, since both directions may
+  // be expanded at the same time.
+  struct AdjList {
+    VertexDict dict;
+    // vertex with props of each expanded id
+    std::vector<Value> vertices;
+    // bloom bit of the vid of each expanded id, only set when noLoop_
+    std::vector<uint64_t> vertexBits;
+    CsrAdjList<AdjEdge> edges;
+  };
+
  private:
   void buildRequestVids(bool reverse);
 
-  Direction direction();
+  folly::Future<Status> sampleDegrees();
 
   folly::Future<Status> doAllPaths();
 
@@ -83,22 +126,21 @@ class AllPathsExecutor final : public StorageAccessExecutor {
 
   folly::Future<Status> buildResult();
 
-  void buildHashTable(std::vector<NPath*>& paths, bool reverse);
+  void buildHashTable(std::vector<NPath*>& paths);
 
   std::vector<Row> probe(size_t start, size_t end, bool reverse);
 
   folly::Future<Status> conjunctPath(std::vector<NPath*>& leftPaths,
                                      std::vector<NPath*>& rightPaths);
 
-  bool hasSameEdge(NPath* path, const Edge& edge);
+  bool hasSameEdge(NPath* path, const AdjEdge& edge);
 
-  bool hasSameVertices(NPath* path, const Edge& edge);
+  // dstBit is the bloom bit of dst, or 0 if dst has not been expanded
+  bool hasSameVertices(NPath* path, uint32_t src, uint32_t dst, uint64_t dstBit);
 
-  bool hasSameEdge(std::vector<Value>& leftPaths, std::vector<Value>& rightPaths);
+  bool hasSameEdge(NPath* leftPath, NPath* rightPath);
 
-  bool hasSameVertices(const std::vector<Value>& leftPaths,
-                       const Value& intersectVertex,
-                       const std::vector<Value>& rightPaths);
+  bool hasSameVertices(NPath* leftPath, const Value& intersectVid, NPath* rightPath);
 
   void buildOneWayPath(std::vector<NPath*>& paths, bool reverse);
 
@@ -114,16 +156,15 @@ class AllPathsExecutor final : public StorageAccessExecutor {
   std::atomic<bool> memoryExceeded_{false};
   size_t maxStep_{0};
 
-  size_t leftSteps_{0};
-  size_t rightSteps_{0};
+  std::unique_ptr<ExpansionDriver> driver_;
 
   std::vector<Value> leftNextStepVids_;
   std::vector<Value> rightNextStepVids_;
   VidHashSet leftInitVids_;
   VidHashSet rightInitVids_;
 
-  VertexMap<Value> leftAdjList_;
-  VertexMap<Value> rightAdjList_;
+  AdjList leftAdjList_;
+  AdjList rightAdjList_;
 
   DataSet result_;
   std::vector<Value> emptyPropVids_;
@@ -131,7 +172,8 @@ class AllPathsExecutor final : public StorageAccessExecutor {
   class NewTag {};
   folly::ThreadLocalPtr<std::deque<NPath>, NewTag> threadLocalPtr_;
 
-  std::unordered_map<Value, std::vector<std::vector<Value>>> hashTable_;
+  // paths of the build side grouped by their dst, converted to lists only when joined
+  std::unordered_map<Value, std::vector<NPath*>> hashTable_;
   std::vector<NPath*> probePaths_;
 };
 }  // namespace graph
@@ -21,24 +21,33 @@ folly::Future<Status> BatchShortestPath::execute(const HashSet& startVids,
   }
   // MemoryTrackerVerified
   size_t rowSize = init(startVids, endVids);
-  std::vector<folly::Future<Status>> futures;
-  futures.reserve(rowSize);
-  for (size_t rowNum = 0; rowNum < rowSize; ++rowNum) {
-    resultDs_[rowNum].colNames = pathNode_->colNames();
-    futures.emplace_back(shortestPath(rowNum, 1));
-  }
-  return folly::collect(futures).via(runner()).thenValue([this, result](auto&& resps) {
-    // MemoryTrackerVerified
-    memory::MemoryCheckGuard guard;
-    for (auto& resp : resps) {
-      NG_RETURN_IF_ERROR(resp);
-    }
-    result->colNames = pathNode_->colNames();
-    for (auto& ds : resultDs_) {
-      result->append(std::move(ds));
-    }
-    return Status::OK();
-  });
+  return sampleDegrees(startVids, endVids)
+      .via(runner())
+      .thenValue([this, rowSize](auto&& status) -> folly::Future<std::vector<Status>> {
+        if (!status.ok()) {
+          return folly::makeFuture(std::vector<Status>{std::move(status)});
+        }
+        std::vector<folly::Future<Status>> futures;
+        futures.reserve(rowSize);
+        for (size_t rowNum = 0; rowNum < rowSize; ++rowNum) {
+          resultDs_[rowNum].colNames = pathNode_->colNames();
+          futures.emplace_back(shortestPath(rowNum));
+        }
+        return folly::collect(futures).via(runner());
+      })
+      .thenValue([this, result](auto&& resps) {
+        // MemoryTrackerVerified
+        memory::MemoryCheckGuard guard;
+        for (auto& resp : resps) {
+          NG_RETURN_IF_ERROR(resp);
+        }
+        addExpansionStats();
+        result->colNames = pathNode_->colNames();
+        for (auto& ds : resultDs_) {
+          result->append(std::move(ds));
+        }
+        return Status::OK();
+      });
 }
 
 size_t BatchShortestPath::init(const HashSet& startVids, const HashSet& endVids) {
@@ -53,6 +62,7 @@ size_t BatchShortestPath::init(const HashSet& startVids, const HashSet& endVids)
   preRightPathMaps_.reserve(rowSize);
 
   terminationMaps_.reserve(rowSize);
+  drivers_.reserve(rowSize);
   resultDs_.resize(rowSize);
 
   for (auto& _startVids : batchStartVids_) {
@@ -93,18 +103,27 @@ size_t BatchShortestPath::init(const HashSet& startVids, const HashSet& endVids)
         }
       }
       terminationMaps_.emplace_back(std::move(terminationMap));
+      drivers_.emplace_back(maxStep_);
     }
   }
   return rowSize;
 }
 
-folly::Future<Status> BatchShortestPath::shortestPath(size_t rowNum, size_t stepNum) {
+folly::Future<Status> BatchShortestPath::shortestPath(size_t rowNum) {
+  auto& driver = drivers_[rowNum];
+  auto direction = driver.next(leftVids_[rowNum].size(), rightVids_[rowNum].size());
   std::vector<folly::Future<Status>> futures;
-  futures.emplace_back(getNeighbors(rowNum, stepNum, false));
-  futures.emplace_back(getNeighbors(rowNum, stepNum, true));
+  if (direction != Direction::kRight) {
+    newStep(rowNum, false, direction);
+    futures.emplace_back(getNeighbors(rowNum, driver.steps(false), false));
+  }
+  if (direction != Direction::kLeft) {
+    newStep(rowNum, true, direction);
+    futures.emplace_back(getNeighbors(rowNum, driver.steps(true), true));
+  }
   return folly::collect(futures)
       .via(runner())
-      .thenValue([this, rowNum, stepNum](auto&& resps) {
+      .thenValue([this, rowNum, direction](auto&& resps) {
         // MemoryTrackerVerified
         memory::MemoryCheckGuard guard;
         for (auto& resp : resps) {
@@ -112,7 +131,7 @@ folly::Future<Status> BatchShortestPath::shortestPath(size_t rowNum, size_t step
             return folly::makeFuture<Status>(std::move(resp));
           }
         }
-        return handleResponse(rowNum, stepNum);
+        return handleResponse(rowNum, direction);
       })
       // This thenError is necessary to catch bad_alloc, seems the returned future
       // is related to two routines: getNeighbors, handleResponse, each of them launch some task in
@@ -137,8 +156,11 @@ folly::Future<Status> BatchShortestPath::getNeighbors(size_t rowNum, size_t step
   auto& inputVids = reverse ? rightVids_[rowNum] : leftVids_[rowNum];
   std::vector<Value> vids(inputVids.begin(), inputVids.end());
   inputVids.clear();
-  return storageClient
-      ->getNeighbors(param,
+  NeighborCache::Hits hits;
+  return qctx_->neighborCache()
+      ->getNeighbors(storageClient,
+                     &hits,
+                     param,
                      {nebula::kVid},
                      std::move(vids),
                      {},
@@ -154,10 +176,10 @@ folly::Future<Status> BatchShortestPath::getNeighbors(size_t rowNum, size_t step
                      nullptr,
                      nullptr)
       .via(runner())
-      .thenValue([this, rowNum, reverse, stepNum, getNbrTime](auto&& resp) {
+      .thenValue([this, rowNum, reverse, stepNum, getNbrTime, hits](auto&& resp) {
         // MemoryTrackerVerified
         memory::MemoryCheckGuard guard;
-        addStats(resp, stepNum, getNbrTime.elapsedInUSec(), reverse);
+        addStats(resp, stepNum, getNbrTime.elapsedInUSec(), reverse, hits);
         return buildPath(rowNum, std::move(resp), reverse);
       });
 }
@@ -180,7 +202,26 @@ Status BatchShortestPath::buildPath(size_t rowNum, RpcResponse&& resps, bool rev
   return doBuildPath(rowNum, iter.get(), reverse);
 }
 
+void BatchShortestPath::newStep(size_t rowNum, bool reverse, Direction direction) {
+  if (drivers_[rowNum].steps(reverse) == 1) {
+    // the first step is built on the start or end vertices in the current path map
+    return;
+  }
+  auto& currentPathMap = reverse ? currentRightPathMaps_[rowNum] : currentLeftPathMaps_[rowNum];
+  auto& historyPathMap = reverse ? allRightPathMaps_[rowNum] : allLeftPathMaps_[rowNum];
+  if (reverse && direction == Direction::kBoth) {
+    // keep the last step of right side to conjunct the paths of odd length
+    preRightPathMaps_[rowNum] = currentPathMap;
+  }
+  for (auto& iter : currentPathMap) {
+    historyPathMap[iter.first].insert(std::make_move_iterator(iter.second.begin()),
+                                      std::make_move_iterator(iter.second.end()));
+  }
+  currentPathMap.clear();
+}
+
 Status BatchShortestPath::doBuildPath(size_t rowNum, GetNeighborsIter* iter, bool reverse) {
+  drivers_[rowNum].expanded(reverse, iter->numRows(), iter->size());
   auto& historyPathMap = reverse ? allRightPathMaps_[rowNum] : allLeftPathMaps_[rowNum];
   auto& currentPathMap = reverse ? currentRightPathMaps_[rowNum] : currentLeftPathMaps_[rowNum];
 
@@ -275,57 +316,85 @@ Status BatchShortestPath::doBuildPath(size_t rowNum, GetNeighborsIter* iter, boo
   return Status::OK();
 }
 
-folly::Future<Status> BatchShortestPath::handleResponse(size_t rowNum, size_t stepNum) {
+folly::Future<Status> BatchShortestPath::handleResponse(size_t rowNum, Direction direction) {
+  auto pendingPairs = terminationMaps_[rowNum].size();
   return folly::makeFuture(Status::OK())
       .via(runner())
-      .thenValue([this, rowNum](auto&& status) {
+      .thenValue([this, rowNum, direction](auto&& status) {
         // MemoryTrackerVerified
         memory::MemoryCheckGuard guard;
 
-        // odd step
+        // paths which pass through the last step of left side and the previous step of right
+        // side, only when both sides have been expanded in this round
         UNUSED(status);
+        if (direction != Direction::kBoth) {
+          return folly::makeFuture<bool>(false);
+        }
         return conjunctPath(rowNum, true);
       })
-      .thenValue([this, rowNum, stepNum](auto&& terminate) {
+      .thenValue([this, rowNum](auto&& terminate) {
         // MemoryTrackerVerified
         memory::MemoryCheckGuard guard;
 
-        // even Step
-        if (terminate || stepNum * 2 > maxStep_) {
+        // paths which pass through the last steps of both sides
+        if (terminate) {
           return folly::makeFuture<bool>(true);
         }
         return conjunctPath(rowNum, false);
       })
-      .thenValue([this, rowNum, stepNum](auto&& result) {
+      .thenValue([this, rowNum, pendingPairs](auto&& result) {
         // MemoryTrackerVerified
         memory::MemoryCheckGuard guard;
 
-        if (result || stepNum * 2 >= maxStep_) {
+        if (result || drivers_[rowNum].exhausted()) {
           return folly::makeFuture<Status>(Status::OK());
         }
+        if (terminationMaps_[rowNum].size() < pendingPairs) {
+          prunePaths(rowNum);
+        }
         auto& leftVids = leftVids_[rowNum];
         auto& rightVids = rightVids_[rowNum];
         if (leftVids.empty() || rightVids.empty()) {
           return folly::makeFuture<Status>(Status::OK());
         }
-        // update allPathMap
-        auto& leftPathMap = currentLeftPathMaps_[rowNum];
-        auto& rightPathMap = currentRightPathMaps_[rowNum];
-        preRightPathMaps_[rowNum] = rightPathMap;
-        for (auto& iter : leftPathMap) {
-          allLeftPathMaps_[rowNum][iter.first].insert(std::make_move_iterator(iter.second.begin()),
-                                                      std::make_move_iterator(iter.second.end()));
-        }
-        for (auto& iter : rightPathMap) {
-          allRightPathMaps_[rowNum][iter.first].insert(std::make_move_iterator(iter.second.begin()),
-                                                       std::make_move_iterator(iter.second.end()));
-        }
-        leftPathMap.clear();
-        rightPathMap.clear();
-        return shortestPath(rowNum, stepNum + 1);
+        return shortestPath(rowNum);
       });
 }
 
+void BatchShortestPath::prunePaths(size_t rowNum) {
+  std::unordered_set<Value> pendingStartVids;
+  std::unordered_set<Value> pendingEndVids;
+  for (const auto& pair : terminationMaps_[rowNum]) {
+    pendingStartVids.emplace(pair.first);
+    pendingEndVids.emplace(pair.second.first);
+  }
+  auto prune = [](PathMap& pathMap, const std::unordered_set<Value>& pendingVids) {
+    for (auto dstIter = pathMap.begin(); dstIter != pathMap.end();) {
+      auto& paths = dstIter->second;
+      for (auto iter = paths.begin(); iter != paths.end();) {
+        if (pendingVids.find(iter->first) == pendingVids.end()) {
+          iter = paths.erase(iter);
+        } else {
+          ++iter;
+        }
+      }
+      if (paths.empty()) {
+        dstIter = pathMap.erase(dstIter);
+      } else {
+        ++dstIter;
+      }
+    }
+  };
+  auto& leftPathMap = currentLeftPathMaps_[rowNum];
+  auto& rightPathMap = currentRightPathMaps_[rowNum];
+  prune(leftPathMap, pendingStartVids);
+  prune(rightPathMap, pendingEndVids);
+  leftVids_[rowNum].clear();
+  rightVids_[rowNum].clear();
+  setNextStepVid(leftPathMap, rowNum, false);
+  setNextStepVid(rightPathMap, rowNum, true);
+}
+
 folly::Future<std::vector<Value>> BatchShortestPath::getMeetVids(size_t rowNum,
                                                                  bool oddStep,
                                                                  std::vector<Value>& meetVids) {
@@ -438,6 +507,24 @@ void BatchShortestPath::doConjunctPath(const std::vector<CustomPath>& leftPaths,
                                        const Value& commonVertex,
                                        size_t rowNum) {
   auto& resultDs = resultDs_[rowNum];
+  if (leftPaths.empty()) {
+    // the left side has not been expanded, the paths start from the common vertex
+    for (const auto& rightPath : rightPaths) {
+      auto backwardPath = rightPath.values;
+      std::reverse(backwardPath.begin(), backwardPath.end());
+      auto dst = backwardPath.back();
+      backwardPath.pop_back();
+      Row row;
+      row.emplace_back(commonVertex);
+      row.emplace_back(List(std::move(backwardPath)));
+      row.emplace_back(std::move(dst));
+      resultDs.rows.emplace_back(std::move(row));
+      if (singleShortest_) {
+        return;
+      }
+    }
+    return;
+  }
   if (rightPaths.empty()) {
     for (const auto& leftPath : leftPaths) {
       auto forwardPath = leftPath.values;
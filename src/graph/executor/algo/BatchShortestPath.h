@@ -34,9 +34,16 @@ class BatchShortestPath final : public ShortestPathBase {
 
   folly::Future<Status> getNeighbors(size_t rowNum, size_t stepNum, bool reverse);
 
-  folly::Future<Status> shortestPath(size_t rowNum, size_t stepNum);
+  folly::Future<Status> shortestPath(size_t rowNum);
 
-  folly::Future<Status> handleResponse(size_t rowNum, size_t stepNum);
+  // Move the last step of one side into its history before it is expanded.
+  void newStep(size_t rowNum, bool reverse, Direction direction);
+
+  folly::Future<Status> handleResponse(size_t rowNum, Direction direction);
+
+  // Remove the paths of start and end vertices whose pairs have all been found, so that
+  // they are not expanded any more.
+  void prunePaths(size_t rowNum);
 
   Status buildPath(size_t rowNum, RpcResponse&& resp, bool reverse);
 
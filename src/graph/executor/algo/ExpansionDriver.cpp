@@ -0,0 +1,177 @@
+// Copyright (c) 2022 vesoft inc. All rights reserved.
+//
+// This source code is licensed under Apache 2.0 License.
+#include "graph/executor/algo/ExpansionDriver.h"
+
+#include "common/memory/MemoryTracker.h"
+#include "graph/context/QueryContext.h"
+#include "graph/context/iterator/GetNeighborsIter.h"
+
+DEFINE_uint32(
+    path_threshold_size,
+    100,
+    "the number of edges to expand, when this threshold is exceeded, use heuristic expansion");
+DEFINE_uint32(path_threshold_ratio, 2, "threshold for heuristics expansion");
+DEFINE_uint32(path_degree_sample_size,
+              0,
+              "number of vertices of each side to sample degrees once per query before the first "
+              "expansion of path finding, 0 means to estimate the degrees by the sizes of "
+              "frontiers");
+DEFINE_uint32(path_degree_sample_limit,
+              1000,
+              "max number of edges of each vertex fetched when sampling degrees");
+
+namespace nebula {
+namespace graph {
+
+ExpansionDriver::Direction ExpansionDriver::next(size_t leftSize, size_t rightSize) {
+  DCHECK(!exhausted());
+  auto leftFanOut = fanOut(false, leftSize);
+  auto rightFanOut = fanOut(true, rightSize);
+  auto smaller = leftFanOut <= rightFanOut ? Direction::kLeft : Direction::kRight;
+  auto direction = Direction::kBoth;
+  if (steps() + 1 == maxSteps_) {
+    direction = smaller;
+  } else {
+    auto larger = std::max(leftFanOut, rightFanOut);
+    auto ratio = larger / std::max(std::min(leftFanOut, rightFanOut), 1.0);
+    if (larger > FLAGS_path_threshold_size && ratio > FLAGS_path_threshold_ratio) {
+      direction = smaller;
+    }
+  }
+  if (direction != Direction::kRight) {
+    ++left_.steps;
+  }
+  if (direction != Direction::kLeft) {
+    ++right_.steps;
+  }
+  return direction;
+}
+
+void ExpansionDriver::expanded(bool reverse, size_t numVertices, size_t numEdges) {
+  if (numVertices == 0) {
+    return;
+  }
+  side(reverse).degree = static_cast<double>(numEdges) / numVertices;
+}
+
+double ExpansionDriver::fanOut(bool reverse, size_t frontierSize) const {
+  auto degree = side(reverse).degree;
+  if (degree < 0) {
+    // take the degree of the other side as a guess
+    degree = side(!reverse).degree;
+  }
+  if (degree < 0) {
+    degree = 1;
+  }
+  return frontierSize * degree;
+}
+
+bool ExpansionDriver::needSample() const {
+  if (FLAGS_path_degree_sample_size == 0) {
+    return false;
+  }
+  return (left_.degree < 0 && !left_.sampled) || (right_.degree < 0 && !right_.sampled);
+}
+
+void ExpansionDriver::copyDegrees(const ExpansionDriver& other) {
+  left_.degree = other.left_.degree;
+  left_.sampled = other.left_.sampled;
+  right_.degree = other.right_.degree;
+  right_.sampled = other.right_.sampled;
+}
+
+folly::Future<Status> ExpansionDriver::sample(
+    QueryContext* qctx,
+    const storage::StorageClient::CommonRequestParam& param,
+    storage::cpp2::EdgeDirection edgeDirection,
+    const std::vector<storage::cpp2::EdgeProp>* edgeProps,
+    const std::vector<storage::cpp2::EdgeProp>* reverseEdgeProps,
+    const std::vector<Value>& leftVids,
+    const std::vector<Value>& rightVids,
+    folly::Executor* runner) {
+  std::vector<folly::Future<Status>> futures;
+  if (left_.degree < 0 && !left_.sampled) {
+    futures.emplace_back(sample(qctx, param, edgeDirection, edgeProps, leftVids, false, runner));
+  }
+  if (right_.degree < 0 && !right_.sampled) {
+    futures.emplace_back(
+        sample(qctx, param, edgeDirection, reverseEdgeProps, rightVids, true, runner));
+  }
+  return folly::collect(futures).via(runner).thenValue(
+      [](auto&&) { return folly::makeFuture<Status>(Status::OK()); });
+}
+
+folly::Future<Status> ExpansionDriver::sample(
+    QueryContext* qctx,
+    const storage::StorageClient::CommonRequestParam& param,
+    storage::cpp2::EdgeDirection edgeDirection,
+    const std::vector<storage::cpp2::EdgeProp>* edgeProps,
+    const std::vector<Value>& vids,
+    bool reverse,
+    folly::Executor* runner) {
+  side(reverse).sampled = true;
+  if (vids.empty() || edgeProps == nullptr) {
+    return Status::OK();
+  }
+  auto sampleSize = std::min<size_t>(vids.size(), FLAGS_path_degree_sample_size);
+  std::vector<Value> sampleVids(vids.begin(), vids.begin() + sampleSize);
+  // only the dst is needed to count the edges
+  std::vector<storage::cpp2::EdgeProp> props;
+  props.reserve(edgeProps->size());
+  for (const auto& edgeProp : *edgeProps) {
+    storage::cpp2::EdgeProp prop;
+    prop.type_ref() = edgeProp.get_type();
+    prop.props_ref() = {kDst};
+    props.emplace_back(std::move(prop));
+  }
+  return qctx->getStorageClient()
+      ->getNeighbors(param,
+                     {nebula::kVid},
+                     std::move(sampleVids),
+                     {},
+                     edgeDirection,
+                     nullptr,
+                     nullptr,
+                     &props,
+                     nullptr,
+                     false,
+                     false,
+                     {},
+                     FLAGS_path_degree_sample_limit,
+                     nullptr,
+                     nullptr)
+      .via(runner)
+      .thenValue([this, reverse](auto&& resps) {
+        memory::MemoryCheckGuard guard;
+        if (resps.completeness() != 100) {
+          return Status::OK();
+        }
+        List list;
+        for (auto& resp : std::move(resps).responses()) {
+          auto dataset = resp.get_vertices();
+          if (dataset != nullptr) {
+            list.values.emplace_back(std::move(*dataset));
+          }
+        }
+        GetNeighborsIter iter(std::make_shared<Value>(std::move(list)));
+        expanded(reverse, iter.numRows(), iter.size());
+        return Status::OK();
+      })
+      .thenError(folly::tag_t<std::exception>{}, [](const std::exception& e) {
+        LOG(WARNING) << "Sample degrees failed: " << e.what();
+        return Status::OK();
+      });
+}
+
+folly::dynamic ExpansionDriver::toJson() const {
+  folly::dynamic obj = folly::dynamic::object();
+  obj.insert("left steps", left_.steps);
+  obj.insert("right steps", right_.steps);
+  obj.insert("left degree", left_.degree);
+  obj.insert("right degree", right_.degree);
+  return obj;
+}
+
+}  // namespace graph
+}  // namespace nebula
@@ -0,0 +1,122 @@
+// Copyright (c) 2022 vesoft inc. All rights reserved.
+//
+// This source code is licensed under Apache 2.0 License.
+
+#ifndef GRAPH_EXECUTOR_ALGO_EXPANSIONDRIVER_H_
+#define GRAPH_EXECUTOR_ALGO_EXPANSIONDRIVER_H_
+
+#include <folly/dynamic.h>
+#include <folly/futures/Future.h>
+
+#include "clients/storage/StorageClient.h"
+#include "common/base/Status.h"
+#include "common/datatypes/Value.h"
+
+namespace nebula {
+namespace graph {
+
+class QueryContext;
+
+// Decides which side of a two-way BFS is expanded in each round.
+//
+// The cost of expanding a side is the number of edges it returns, which is estimated as
+// size(frontier) * degree, where degree is the average out degree observed in the last expansion
+// of that side. A side which has not been expanded yet uses the degree sampled by sample(), so a
+// hub vertex is not expanded only to meet a long-tail vertex in the next step. Sampling costs a
+// GetNeighbors request of each side, so it is off by default and done once per query.
+//
+// if fanOut(larger) > FLAGS_path_threshold_size and
+//    fanOut(larger) / fanOut(smaller) > FLAGS_path_threshold_ratio
+//    expand the smaller side
+// else
+//    expand both sides
+// When only one step is left, only the smaller side is expanded.
+//
+// It is not thread safe, except that the two sides could be recorded concurrently.
+class ExpansionDriver final {
+ public:
+  enum class Direction : uint8_t {
+    kLeft,
+    kRight,
+    kBoth,
+  };
+
+  explicit ExpansionDriver(size_t maxSteps) : maxSteps_(maxSteps) {}
+
+  // Choose the sides to expand in the next round by the sizes of both frontiers, and count the
+  // steps of them.
+  Direction next(size_t leftSize, size_t rightSize);
+
+  // Record the vertices and edges returned by the expansion of one side.
+  void expanded(bool reverse, size_t numVertices, size_t numEdges);
+
+  // Estimated number of edges returned by expanding the frontier of one side.
+  double fanOut(bool reverse, size_t frontierSize) const;
+
+  // Whether the degree of some side is unknown and sampling is enabled.
+  bool needSample() const;
+
+  // Fetch at most FLAGS_path_degree_sample_limit edges of at most FLAGS_path_degree_sample_size
+  // vertices of each frontier, to estimate the degree of the sides which have not been expanded.
+  // Edges are fetched as the expansion does, with edgeProps for the left side and reverseEdgeProps
+  // for the right side. A failed sampling is ignored.
+  folly::Future<Status> sample(QueryContext* qctx,
+                               const storage::StorageClient::CommonRequestParam& param,
+                               storage::cpp2::EdgeDirection edgeDirection,
+                               const std::vector<storage::cpp2::EdgeProp>* edgeProps,
+                               const std::vector<storage::cpp2::EdgeProp>* reverseEdgeProps,
+                               const std::vector<Value>& leftVids,
+                               const std::vector<Value>& rightVids,
+                               folly::Executor* runner);
+
+  // Take the degrees sampled by another driver, e.g. the one sampled for all rows of a query.
+  void copyDegrees(const ExpansionDriver& other);
+
+  size_t steps(bool reverse) const {
+    return reverse ? right_.steps : left_.steps;
+  }
+
+  size_t steps() const {
+    return left_.steps + right_.steps;
+  }
+
+  // Whether the paths have reached the max steps
+  bool exhausted() const {
+    return steps() >= maxSteps_;
+  }
+
+  folly::dynamic toJson() const;
+
+ private:
+  struct Side {
+    size_t steps{0};
+    // average out degree, negative if unknown
+    double degree{-1};
+    bool sampled{false};
+  };
+
+  folly::Future<Status> sample(QueryContext* qctx,
+                               const storage::StorageClient::CommonRequestParam& param,
+                               storage::cpp2::EdgeDirection edgeDirection,
+                               const std::vector<storage::cpp2::EdgeProp>* edgeProps,
+                               const std::vector<Value>& vids,
+                               bool reverse,
+                               folly::Executor* runner);
+
+  Side& side(bool reverse) {
+    return reverse ? right_ : left_;
+  }
+
+  const Side& side(bool reverse) const {
+    return reverse ? right_ : left_;
+  }
+
+ private:
+  size_t maxSteps_{0};
+  Side left_;
+  Side right_;
+};
+
+}  // namespace graph
+}  // namespace nebula
+#endif  // GRAPH_EXECUTOR_ALGO_EXPANSIONDRIVER_H_
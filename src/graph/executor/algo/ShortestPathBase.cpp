@@ -161,10 +161,57 @@ Status ShortestPathBase::handleErrorCode(nebula::cpp2::ErrorCode code, Partition
   return Status::OK();
 }
 
+folly::Future<Status> ShortestPathBase::sampleDegrees(const HashSet& startVids,
+                                                      const HashSet& endVids) {
+  auto sampler = std::make_shared<ExpansionDriver>(maxStep_);
+  if (!sampler->needSample()) {
+    return Status::OK();
+  }
+  time::Duration sampleTime;
+  StorageClient::CommonRequestParam param(pathNode_->space(),
+                                          qctx_->rctx()->session()->id(),
+                                          qctx_->plan()->id(),
+                                          qctx_->plan()->isProfileEnabled());
+  std::vector<Value> leftVids(startVids.begin(), startVids.end());
+  std::vector<Value> rightVids(endVids.begin(), endVids.end());
+  return sampler
+      ->sample(qctx_,
+               param,
+               pathNode_->edgeDirection(),
+               pathNode_->edgeProps(),
+               pathNode_->reverseEdgeProps(),
+               leftVids,
+               rightVids,
+               runner())
+      .thenValue([this, sampler](auto&& status) {
+        NG_RETURN_IF_ERROR(status);
+        for (auto& driver : drivers_) {
+          driver.copyDegrees(*sampler);
+        }
+        return Status::OK();
+      })
+      .ensure([this, sampleTime]() {
+        statsLock_.lock();
+        stats_->emplace("sample_degree_time", folly::sformat("{}(us)", sampleTime.elapsedInUSec()));
+        statsLock_.unlock();
+      });
+}
+
+void ShortestPathBase::addExpansionStats() {
+  folly::dynamic expansion = folly::dynamic::array();
+  for (const auto& driver : drivers_) {
+    expansion.push_back(driver.toJson());
+  }
+  statsLock_.lock();
+  stats_->emplace("expansion", folly::toPrettyJson(expansion));
+  statsLock_.unlock();
+}
+
 void ShortestPathBase::addStats(RpcResponse& resp,
                                 size_t stepNum,
                                 int64_t timeInUSec,
-                                bool reverse) const {
+                                bool reverse,
+                                const NeighborCache::Hits& hits) const {
   folly::dynamic stats = folly::dynamic::array();
   auto& hostLatency = resp.hostLatency();
   for (size_t i = 0; i < hostLatency.size(); ++i) {
@@ -180,6 +227,7 @@ void ShortestPathBase::addStats(RpcResponse& resp,
   folly::dynamic stepObj = folly::dynamic::object();
   stepObj.insert("total_rpc_time", folly::sformat("{}(us)", timeInUSec));
   stepObj.insert("storage", stats);
+  stepObj.insert("neighbor_cache", hits.toJson());
 
   auto key = folly::sformat("{}step[{}]", reverse ? "reverse " : "", stepNum);
   statsLock_.lock();
@@ -7,6 +7,7 @@
 #include <robin_hood.h>
 
 #include "graph/executor/Executor.h"
+#include "graph/executor/algo/ExpansionDriver.h"
 #include "graph/planner/plan/Algo.h"
 
 using nebula::storage::StorageRpcResponse;
@@ -41,15 +42,27 @@ class ShortestPathBase {
   using EndVid = Value;
   // save the starting vertex and the corresponding edge. eg [vertex(a), edge(a->b)]
   using CustomStep = Row;
+  using Direction = ExpansionDriver::Direction;
 
  protected:
+  // Sample the degrees from the start and end vertices once before the first round, and hand
+  // them to the driver of every row.
+  folly::Future<Status> sampleDegrees(const HashSet& startVids, const HashSet& endVids);
+
+  // Add the steps and degrees of the expansion of every row.
+  void addExpansionStats();
+
   folly::Future<std::vector<Value>> getMeetVidsProps(const std::vector<Value>& meetVids);
 
   std::vector<Value> handlePropResp(PropRpcResponse&& resps);
 
   Status handleErrorCode(nebula::cpp2::ErrorCode code, PartitionID partId) const;
 
-  void addStats(RpcResponse& resp, size_t stepNum, int64_t timeInUSec, bool reverse) const;
+  void addStats(RpcResponse& resp,
+                size_t stepNum,
+                int64_t timeInUSec,
+                bool reverse,
+                const NeighborCache::Hits& hits) const;
 
   void addStats(PropRpcResponse& resp, int64_t timeInUSec) const;
 
@@ -90,6 +103,8 @@ class ShortestPathBase {
   std::vector<DataSet> resultDs_;
   std::vector<HashSet> leftVids_;
   std::vector<HashSet> rightVids_;
+  // choose the sides to expand of each row
+  std::vector<ExpansionDriver> drivers_;
 };
 
 }  // namespace graph
@@ -19,23 +19,32 @@ folly::Future<Status> SingleShortestPath::execute(const HashSet& startVids,
   }
   size_t rowSize = startVids.size() * endVids.size();
   init(startVids, endVids, rowSize);
-  std::vector<folly::Future<Status>> futures;
-  futures.reserve(rowSize);
-  for (size_t rowNum = 0; rowNum < rowSize; ++rowNum) {
-    resultDs_[rowNum].colNames = pathNode_->colNames();
-    futures.emplace_back(shortestPath(rowNum, 1));
-  }
-  return folly::collect(futures).via(runner()).thenValue([this, result](auto&& resps) {
-    memory::MemoryCheckGuard guard;
-    for (auto& resp : resps) {
-      NG_RETURN_IF_ERROR(resp);
-    }
-    result->colNames = pathNode_->colNames();
-    for (auto& ds : resultDs_) {
-      result->append(std::move(ds));
-    }
-    return Status::OK();
-  });
+  return sampleDegrees(startVids, endVids)
+      .via(runner())
+      .thenValue([this, rowSize](auto&& status) -> folly::Future<std::vector<Status>> {
+        if (!status.ok()) {
+          return folly::makeFuture(std::vector<Status>{std::move(status)});
+        }
+        std::vector<folly::Future<Status>> futures;
+        futures.reserve(rowSize);
+        for (size_t rowNum = 0; rowNum < rowSize; ++rowNum) {
+          resultDs_[rowNum].colNames = pathNode_->colNames();
+          futures.emplace_back(shortestPath(rowNum));
+        }
+        return folly::collect(futures).via(runner());
+      })
+      .thenValue([this, result](auto&& resps) {
+        memory::MemoryCheckGuard guard;
+        for (auto& resp : resps) {
+          NG_RETURN_IF_ERROR(resp);
+        }
+        addExpansionStats();
+        result->colNames = pathNode_->colNames();
+        for (auto& ds : resultDs_) {
+          result->append(std::move(ds));
+        }
+        return Status::OK();
+      });
 }
 
 void SingleShortestPath::init(const HashSet& startVids, const HashSet& endVids, size_t rowSize) {
@@ -45,12 +54,19 @@ void SingleShortestPath::init(const HashSet& startVids, const HashSet& endVids,
   leftVisitedVids_.resize(rowSize);
   rightVisitedVids_.resize(rowSize);
 
-  allLeftPaths_.resize(rowSize);
+  allLeftPaths_.reserve(rowSize);
   allRightPaths_.reserve(rowSize);
+  drivers_.reserve(rowSize);
   resultDs_.resize(rowSize);
   for (const auto& startVid : startVids) {
     HashSet srcVid({startVid});
     for (const auto& endVid : endVids) {
+      // the first step of each side is the start or end vertex itself
+      robin_hood::unordered_flat_map<Value, std::vector<Row>, std::hash<Value>> leftSteps;
+      leftSteps.emplace(startVid, std::vector<Row>());
+      HalfPath originLeftPath({std::move(leftSteps)});
+      allLeftPaths_.emplace_back(std::move(originLeftPath));
+
       robin_hood::unordered_flat_map<Value, std::vector<Row>, std::hash<Value>> steps;
       std::vector<Row> dummy;
       steps.emplace(endVid, std::move(dummy));
@@ -60,25 +76,32 @@ void SingleShortestPath::init(const HashSet& startVids, const HashSet& endVids,
       HashSet dstVid({endVid});
       leftVids_.emplace_back(srcVid);
       rightVids_.emplace_back(std::move(dstVid));
+      drivers_.emplace_back(maxStep_);
     }
   }
 }
 
-folly::Future<Status> SingleShortestPath::shortestPath(size_t rowNum, size_t stepNum) {
+folly::Future<Status> SingleShortestPath::shortestPath(size_t rowNum) {
+  auto& driver = drivers_[rowNum];
+  auto direction = driver.next(leftVids_[rowNum].size(), rightVids_[rowNum].size());
   std::vector<folly::Future<Status>> futures;
   futures.reserve(2);
-  futures.emplace_back(getNeighbors(rowNum, stepNum, false));
-  futures.emplace_back(getNeighbors(rowNum, stepNum, true));
+  if (direction != Direction::kRight) {
+    futures.emplace_back(getNeighbors(rowNum, driver.steps(false), false));
+  }
+  if (direction != Direction::kLeft) {
+    futures.emplace_back(getNeighbors(rowNum, driver.steps(true), true));
+  }
   return folly::collect(futures)
       .via(runner())
-      .thenValue([this, rowNum, stepNum](auto&& resps) {
+      .thenValue([this, rowNum, direction](auto&& resps) {
         memory::MemoryCheckGuard guard;
         for (auto& resp : resps) {
           if (!resp.ok()) {
             return folly::makeFuture<Status>(std::move(resp));
           }
         }
-        return handleResponse(rowNum, stepNum);
+        return handleResponse(rowNum, direction);
       })
       .thenError(folly::tag_t<std::bad_alloc>{},
                  [](const std::bad_alloc&) {
@@ -101,8 +124,11 @@ folly::Future<Status> SingleShortestPath::getNeighbors(size_t rowNum,
   auto& inputVids = reverse ? rightVids_[rowNum] : leftVids_[rowNum];
   std::vector<Value> vids(inputVids.begin(), inputVids.end());
   inputVids.clear();
-  return storageClient
-      ->getNeighbors(param,
+  NeighborCache::Hits hits;
+  return qctx_->neighborCache()
+      ->getNeighbors(storageClient,
+                     &hits,
+                     param,
                      {nebula::kVid},
                      std::move(vids),
                      {},
@@ -118,9 +144,9 @@ folly::Future<Status> SingleShortestPath::getNeighbors(size_t rowNum,
                      nullptr,
                      nullptr)
       .via(runner())
-      .thenValue([this, rowNum, stepNum, getNbrTime, reverse](auto&& resp) {
+      .thenValue([this, rowNum, stepNum, getNbrTime, reverse, hits](auto&& resp) {
         memory::MemoryCheckGuard guard;
-        addStats(resp, stepNum, getNbrTime.elapsedInUSec(), reverse);
+        addStats(resp, stepNum, getNbrTime.elapsedInUSec(), reverse, hits);
         return buildPath(rowNum, std::move(resp), reverse);
       });
 }
@@ -145,6 +171,7 @@ Status SingleShortestPath::buildPath(size_t rowNum, RpcResponse&& resps, bool re
 
 Status SingleShortestPath::doBuildPath(size_t rowNum, GetNeighborsIter* iter, bool reverse) {
   auto iterSize = iter->size();
+  drivers_[rowNum].expanded(reverse, iter->numRows(), iterSize);
   auto& visitedVids = reverse ? rightVisitedVids_[rowNum] : leftVisitedVids_[rowNum];
   visitedVids.reserve(visitedVids.size() + iterSize);
   auto& allSteps = reverse ? allRightPaths_[rowNum] : allLeftPaths_[rowNum];
@@ -184,19 +211,19 @@ Status SingleShortestPath::doBuildPath(size_t rowNum, GetNeighborsIter* iter, bo
   return Status::OK();
 }
 
-folly::Future<Status> SingleShortestPath::handleResponse(size_t rowNum, size_t stepNum) {
+folly::Future<Status> SingleShortestPath::handleResponse(size_t rowNum, Direction direction) {
   return folly::makeFuture<Status>(Status::OK())
       .via(runner())
-      .thenValue([this, rowNum, stepNum](auto&& status) {
+      .thenValue([this, rowNum, direction](auto&& status) {
         // MemoryTrackerVerified
         memory::MemoryCheckGuard guard;
 
         UNUSED(status);
-        return conjunctPath(rowNum, stepNum);
+        return conjunctPath(rowNum, direction);
       })
-      .thenValue([this, rowNum, stepNum](auto&& result) {
+      .thenValue([this, rowNum](auto&& result) {
         memory::MemoryCheckGuard guard;
-        if (result || stepNum * 2 >= maxStep_) {
+        if (result || drivers_[rowNum].exhausted()) {
           return folly::makeFuture<Status>(Status::OK());
         }
         auto& leftVids = leftVids_[rowNum];
@@ -204,31 +231,33 @@ folly::Future<Status> SingleShortestPath::handleResponse(size_t rowNum, size_t s
         if (leftVids.empty() || rightVids.empty()) {
           return folly::makeFuture<Status>(Status::OK());
         }
-        return shortestPath(rowNum, stepNum + 1);
+        return shortestPath(rowNum);
       });
 }
 
-folly::Future<bool> SingleShortestPath::conjunctPath(size_t rowNum, size_t stepNum) {
+folly::Future<bool> SingleShortestPath::conjunctPath(size_t rowNum, Direction direction) {
   const auto& leftStep = allLeftPaths_[rowNum].back();
-  const auto& prevRightStep = allRightPaths_[rowNum][stepNum - 1];
+  const auto& rightSteps = allRightPaths_[rowNum];
   std::vector<Value> meetVids;
-  for (const auto& step : leftStep) {
-    if (prevRightStep.find(step.first) != prevRightStep.end()) {
-      meetVids.push_back(step.first);
-      if (singleShortest_) {
-        break;
+  if (direction == Direction::kBoth) {
+    // both sides have been expanded in this round, the shorter paths pass through the last
+    // step of the left side and the previous step of the right side
+    const auto& prevRightStep = rightSteps[rightSteps.size() - 2];
+    for (const auto& step : leftStep) {
+      if (prevRightStep.find(step.first) != prevRightStep.end()) {
+        meetVids.push_back(step.first);
+        if (singleShortest_) {
+          break;
+        }
       }
     }
-  }
-  if (!meetVids.empty()) {
-    buildOddPath(rowNum, meetVids);
-    return folly::makeFuture<bool>(true);
-  }
-  if (stepNum * 2 > maxStep_) {
-    return folly::makeFuture<bool>(false);
+    if (!meetVids.empty()) {
+      buildOddPath(rowNum, meetVids);
+      return folly::makeFuture<bool>(true);
+    }
   }
 
-  const auto& rightStep = allRightPaths_[rowNum].back();
+  const auto& rightStep = rightSteps.back();
   for (const auto& step : leftStep) {
     if (rightStep.find(step.first) != rightStep.end()) {
       meetVids.push_back(step.first);
@@ -277,13 +306,20 @@ folly::Future<bool> SingleShortestPath::buildEvenPath(size_t rowNum,
         continue;
       }
       auto meetVid = meetVertex.getVertex().vid;
-      auto leftPaths = createLeftPath(rowNum, meetVid);
-      auto rightPaths = createRightPath(rowNum, meetVid, false);
+      // a side which has not been expanded meets the other side at its start or end vertex
+      bool leftExpanded = allLeftPaths_[rowNum].size() > 1;
+      bool rightExpanded = allRightPaths_[rowNum].size() > 1;
+      auto leftPaths = leftExpanded ? createLeftPath(rowNum, meetVid)
+                                    : std::vector<Row>({Row({meetVertex, List()})});
+      auto rightPaths = rightExpanded ? createRightPath(rowNum, meetVid, false)
+                                      : std::vector<Row>({Row({meetVertex})});
       for (auto& leftPath : leftPaths) {
         for (auto& rightPath : rightPaths) {
           Row path = leftPath;
           auto& steps = path.values.back().mutableList().values;
-          steps.emplace_back(meetVertex);
+          if (leftExpanded && rightExpanded) {
+            steps.emplace_back(meetVertex);
+          }
           steps.insert(steps.end(), rightPath.values.begin(), rightPath.values.end() - 1);
           path.emplace_back(rightPath.values.back());
           resultDs_[rowNum].rows.emplace_back(std::move(path));
@@ -302,7 +338,7 @@ std::vector<Row> SingleShortestPath::createLeftPath(size_t rowNum, const Value&
   auto& lastSteps = allSteps.back();
   auto findMeetVid = lastSteps.find(meetVid);
   std::vector<Row> leftPaths(findMeetVid->second);
-  for (auto stepIter = allSteps.rbegin() + 1; stepIter != allSteps.rend(); ++stepIter) {
+  for (auto stepIter = allSteps.rbegin() + 1; stepIter != allSteps.rend() - 1; ++stepIter) {
     std::vector<Row> temp;
     for (auto& leftPath : leftPaths) {
       Value id = leftPath.values.front().getVertex().vid;
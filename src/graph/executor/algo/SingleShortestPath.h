@@ -28,7 +28,7 @@ class SingleShortestPath final : public ShortestPathBase {
  private:
   void init(const HashSet& startVids, const HashSet& endVids, size_t rowSize);
 
-  folly::Future<Status> shortestPath(size_t rowNum, size_t stepNum);
+  folly::Future<Status> shortestPath(size_t rowNum);
 
   folly::Future<Status> getNeighbors(size_t rowNum, size_t stepNum, bool reverse);
 
@@ -36,9 +36,9 @@ class SingleShortestPath final : public ShortestPathBase {
 
   Status doBuildPath(size_t rowNum, GetNeighborsIter* iter, bool reverse);
 
-  folly::Future<Status> handleResponse(size_t rowNum, size_t stepNum);
+  folly::Future<Status> handleResponse(size_t rowNum, Direction direction);
 
-  folly::Future<bool> conjunctPath(size_t rowNum, size_t stepNum);
+  folly::Future<bool> conjunctPath(size_t rowNum, Direction direction);
 
   folly::Future<bool> buildEvenPath(size_t rowNum, const std::vector<Value>& meetVids);
 
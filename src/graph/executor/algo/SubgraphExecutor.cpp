@@ -35,8 +35,11 @@ folly::Future<Status> SubgraphExecutor::getNeighbors() {
                                           qctx_->plan()->isProfileEnabled());
 
   storage::cpp2::EdgeDirection edgeDirection{Direction::OUT_EDGE};
-  return storageClient
-      ->getNeighbors(param,
+  NeighborCache::Hits hits;
+  return qctx_->neighborCache()
+      ->getNeighbors(storageClient,
+                     &hits,
+                     param,
                      {nebula::kVid},
                      std::move(vids_),
                      {},
@@ -52,10 +55,11 @@ folly::Future<Status> SubgraphExecutor::getNeighbors() {
                      currentStep_ == 1 ? subgraph_->edgeFilter() : subgraph_->filter(),
                      currentStep_ == 1 ? nullptr : subgraph_->tagFilter())
       .via(runner())
-      .thenValue([this, getNbrTime](RpcResponse&& resp) mutable {
+      .thenValue([this, getNbrTime, hits](RpcResponse&& resp) mutable {
         // MemoryTrackerVerified
         memory::MemoryCheckGuard guard;
         addState("total_rpc_time", getNbrTime);
+        addState(folly::sformat("neighbor_cache step[{}]", currentStep_), hits.toJson());
         auto& hostLatency = resp.hostLatency();
         for (size_t i = 0; i < hostLatency.size(); ++i) {
           size_t size = 0u;
@@ -105,8 +109,8 @@ void SubgraphExecutor::filterEdges(int version) {
     auto* gnIter = static_cast<GetNeighborsIter*>(iterPtr);
     while (gnIter->valid()) {
       const auto& dst = gnIter->getEdgeProp("*", nebula::kDst);
-      if (validVids_.find(dst) == validVids_.end()) {
-        auto edge = gnIter->getEdge();
+      auto id = dict_.find(dst);
+      if (id == VertexDict::kInvalidId || !validVids_.test(id)) {
         gnIter->erase();
       } else {
         gnIter->next();
@@ -128,17 +132,18 @@ bool SubgraphExecutor::process(std::unique_ptr<GetNeighborsIter> iter) {
   ResultBuilder builder;
   builder.value(iter->valuePtr());
 
-  HashMap currentVids;
+  // the vertices visited in this step, by id
+  std::vector<std::pair<uint32_t, size_t>> currentVids;
   currentVids.reserve(gnSize);
-  historyVids_.reserve(historyVids_.size() + gnSize);
+  DenseBitset currentSet;
   auto startVids = iter->vids();
-  if (currentStep_ == 1) {
-    for (auto& startVid : startVids) {
-      currentVids.emplace(startVid, 0);
+  for (auto& startVid : startVids) {
+    auto id = dict_.getOrAdd(startVid);
+    if (currentStep_ == 1 && currentSet.set(id)) {
+      currentVids.emplace_back(id, 0);
     }
+    validVids_.set(id);
   }
-  validVids_.insert(std::make_move_iterator(startVids.begin()),
-                    std::make_move_iterator(startVids.end()));
   auto& biDirectEdgeTypes = subgraph_->biDirectEdgeTypes();
   while (iter->valid()) {
     const auto& dst = iter->getEdgeProp("*", nebula::kDst);
@@ -147,8 +152,9 @@ bool SubgraphExecutor::process(std::unique_ptr<GetNeighborsIter> iter) {
       iter->next();
       continue;
     }
-    auto findIter = historyVids_.find(dst);
-    if (findIter != historyVids_.end()) {
+    auto id = dict_.getOrAdd(dst);
+    auto step = historyStep(id);
+    if (step != kNotVisited) {
       if (biDirectEdgeTypes.empty()) {
         iter->next();
       } else {
@@ -159,7 +165,7 @@ bool SubgraphExecutor::process(std::unique_ptr<GetNeighborsIter> iter) {
         }
         auto type = typeVal.getInt();
         if (biDirectEdgeTypes.find(type) != biDirectEdgeTypes.end()) {
-          if (type < 0 || findIter->second + 2 == currentStep_) {
+          if (type < 0 || step + 2 == currentStep_) {
             iter->erase();
           } else {
             iter->next();
@@ -173,9 +179,10 @@ bool SubgraphExecutor::process(std::unique_ptr<GetNeighborsIter> iter) {
         iter->erase();
         continue;
       }
-      if (currentVids.emplace(dst, currentStep_).second) {
+      if (currentSet.set(id)) {
+        currentVids.emplace_back(id, currentStep_);
         // next vids for getNeighbor
-        vids_.emplace_back(std::move(dst));
+        vids_.emplace_back(dst);
       }
       iter->next();
     }
@@ -183,9 +190,13 @@ bool SubgraphExecutor::process(std::unique_ptr<GetNeighborsIter> iter) {
   iter->reset();
   builder.iter(std::move(iter));
   finish(builder.build());
-  // update historyVids
-  historyVids_.insert(std::make_move_iterator(currentVids.begin()),
-                      std::make_move_iterator(currentVids.end()));
+  // update historySteps, the steps of the visited vertices are kept
+  historySteps_.resize(dict_.size(), kNotVisited);
+  for (auto& [id, step] : currentVids) {
+    if (historySteps_[id] == kNotVisited) {
+      historySteps_[id] = step;
+    }
+  }
   if (currentStep_ != 1 && subgraph_->tagFilter()) {
     filterEdges(-1);
   }
@@ -9,6 +9,7 @@
 
 #include "graph/executor/StorageAccessExecutor.h"
 #include "graph/planner/plan/Algo.h"
+#include "graph/util/VertexDict.h"
 
 // Subgraph receive result from GetNeighbors
 // There are two Main functions
@@ -16,9 +17,10 @@
 // Second: Delete previously visited edges and save the result(iter) to the variable `resultVar`
 //
 // Member:
-// `historyVids_` : is hash table
-//    KEY   : the VID of the visited destination Vertex
-//    VALUE : the number of steps to visit the KEY (starting vertex is 0)
+// `dict_` : maps the vids seen to dense ids
+// `historySteps_` : indexed by the id of the visited destination Vertex
+//    VALUE : the number of steps to visit the vertex (starting vertex is 0), kNotVisited if the
+//    vertex is seen but not visited yet
 // since each vertex will only be visited once, if it is a one-way edge expansion, there will be no
 // duplicate edges. we only need to focus on the case of two-way expansion
 //
@@ -44,9 +46,6 @@ using RpcResponse = storage::StorageRpcResponse<storage::cpp2::GetNeighborsRespo
 
 class SubgraphExecutor : public StorageAccessExecutor {
  public:
-  using HashMap = robin_hood::unordered_flat_map<Value, size_t, std::hash<Value>>;
-  using HashSet = robin_hood::unordered_flat_set<Value, std::hash<Value>>;
-
   SubgraphExecutor(const PlanNode* node, QueryContext* qctx)
       : StorageAccessExecutor("SubgraphExecutor", node, qctx) {
     subgraph_ = asNode<Subgraph>(node);
@@ -64,13 +63,21 @@ class SubgraphExecutor : public StorageAccessExecutor {
   folly::Future<Status> handleResponse(RpcResponse&& resps);
 
  private:
-  HashMap historyVids_;
+  static constexpr size_t kNotVisited = std::numeric_limits<size_t>::max();
+
+  // the step of the vertex, or kNotVisited
+  size_t historyStep(uint32_t id) const {
+    return id < historySteps_.size() ? historySteps_[id] : kNotVisited;
+  }
+
+  VertexDict dict_;
+  std::vector<size_t> historySteps_;
   const Subgraph* subgraph_{nullptr};
   size_t currentStep_{1};
   size_t totalSteps_{1};
   std::vector<Value> vids_;
-  // save vids already visited
-  HashSet validVids_;
+  // save vids already visited, by id
+  DenseBitset validVids_;
 };
 
 }  // namespace graph
@@ -65,7 +65,8 @@ folly::Future<Status> DeleteVerticesExecutor::deleteVertices() {
       ->getStorageClient()
       ->deleteVertices(param, std::move(vertices))
       .via(runner())
-      .ensure([deleteVertTime]() {
+      .ensure([this, deleteVertTime]() {
+        qctx()->neighborCache()->clear();
         VLOG(1) << "Delete vertices time: " << deleteVertTime.elapsedInUSec() << "us";
       })
       .thenValue([this](storage::StorageRpcResponse<storage::cpp2::ExecResponse> resp) {
@@ -121,7 +122,8 @@ folly::Future<Status> DeleteTagsExecutor::deleteTags() {
       ->getStorageClient()
       ->deleteTags(param, std::move(delTags))
       .via(runner())
-      .ensure([deleteTagTime]() {
+      .ensure([this, deleteTagTime]() {
+        qctx()->neighborCache()->clear();
         VLOG(1) << "Delete vertices time: " << deleteTagTime.elapsedInUSec() << "us";
       })
       .thenValue([this](storage::StorageRpcResponse<storage::cpp2::ExecResponse> resp) {
@@ -208,7 +210,8 @@ folly::Future<Status> DeleteEdgesExecutor::deleteEdges() {
       ->getStorageClient()
       ->deleteEdges(param, std::move(edgeKeys))
       .via(runner())
-      .ensure([deleteEdgeTime]() {
+      .ensure([this, deleteEdgeTime]() {
+        qctx()->neighborCache()->clear();
         VLOG(1) << "Delete edge time: " << deleteEdgeTime.elapsedInUSec() << "us";
       })
       .thenValue([this](storage::StorageRpcResponse<storage::cpp2::ExecResponse> resp) {
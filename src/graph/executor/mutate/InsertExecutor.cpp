@@ -32,7 +32,8 @@ folly::Future<Status> InsertVerticesExecutor::insertVertices() {
                     ivNode->getIfNotExists(),
                     ivNode->getIgnoreExistedIndex())
       .via(runner())
-      .ensure([addVertTime]() {
+      .ensure([this, addVertTime]() {
+        qctx()->neighborCache()->clear();
         VLOG(1) << "Add vertices time: " << addVertTime.elapsedInUSec() << "us";
       })
       .thenValue([this](storage::StorageRpcResponse<storage::cpp2::ExecResponse> resp) {
@@ -64,8 +65,10 @@ folly::Future<Status> InsertEdgesExecutor::insertEdges() {
                  ieNode->getIfNotExists(),
                  ieNode->getIgnoreExistedIndex())
       .via(runner())
-      .ensure(
-          [addEdgeTime]() { VLOG(1) << "Add edge time: " << addEdgeTime.elapsedInUSec() << "us"; })
+      .ensure([this, addEdgeTime]() {
+        qctx()->neighborCache()->clear();
+        VLOG(1) << "Add edge time: " << addEdgeTime.elapsedInUSec() << "us";
+      })
       .thenValue([this](storage::StorageRpcResponse<storage::cpp2::ExecResponse> resp) {
         memory::MemoryCheckGuard guard;
         SCOPED_TIMER(&execTime_);
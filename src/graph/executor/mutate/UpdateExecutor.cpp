@@ -57,7 +57,8 @@ folly::Future<Status> UpdateVertexExecutor::execute() {
                      uvNode->getReturnProps(),
                      uvNode->getCondition())
       .via(runner())
-      .ensure([updateVertTime]() {
+      .ensure([this, updateVertTime]() {
+        qctx()->neighborCache()->clear();
         VLOG(1) << "Update vertice time: " << updateVertTime.elapsedInUSec() << "us";
       })
       .thenValue([this](StatusOr<storage::cpp2::UpdateResponse> resp) {
@@ -109,7 +110,8 @@ folly::Future<Status> UpdateEdgeExecutor::execute() {
                    ueNode->getReturnProps(),
                    ueNode->getCondition())
       .via(runner())
-      .ensure([updateEdgeTime]() {
+      .ensure([this, updateEdgeTime]() {
+        qctx()->neighborCache()->clear();
         VLOG(1) << "Update edge time: " << updateEdgeTime.elapsedInUSec() << "us";
       })
       .thenValue([this](StatusOr<storage::cpp2::UpdateResponse> resp) {
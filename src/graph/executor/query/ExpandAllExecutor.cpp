@@ -94,7 +94,8 @@ folly::Future<Status> ExpandAllExecutor::GetDstBySrc() {
           if (result.dsts_ref().has_value()) {
             size = (*result.dsts_ref()).size();
           }
-          auto info = util::collectRespProfileData(result.result, hostLatency[i], size);
+          auto info = util::collectRespProfileData(
+              result.result, hostLatency[i], size, respBytes(result));
           addState(folly::sformat("step{} resp [{}]", currentStep_, i), info);
         }
         auto result = handleCompleteness(resps, FLAGS_accept_partial_success);
@@ -142,8 +143,11 @@ folly::Future<Status> ExpandAllExecutor::getNeighbors() {
   std::vector<Value> vids(nextStepVids_.size());
   std::move(nextStepVids_.begin(), nextStepVids_.end(), vids.begin());
   QueryExpressionContext qec(qctx()->ectx());
-  return storageClient
-      ->getNeighbors(param,
+  NeighborCache::Hits hits;
+  return qctx_->neighborCache()
+      ->getNeighbors(storageClient,
+                     &hits,
+                     param,
                      {nebula::kVid},
                      std::move(vids),
                      {},
@@ -159,12 +163,13 @@ folly::Future<Status> ExpandAllExecutor::getNeighbors() {
                      expand_->filter(),
                      nullptr)
       .via(runner())
-      .thenValue([this](RpcResponse&& resp) mutable {
+      .thenValue([this, hits](RpcResponse&& resp) mutable {
         // MemoryTrackerVerified
         memory::MemoryCheckGuard guard;
         nextStepVids_.clear();
         SCOPED_TIMER(&execTime_);
         addStats(resp);
+        addState(folly::sformat("neighbor_cache step[{}]", currentStep_), hits.toJson());
         time::Duration expandTime;
         curLimit_ = 0;
         curMaxLimit_ = stepLimits_.empty() ? std::numeric_limits<int64_t>::max()
@@ -93,7 +93,8 @@ folly::Future<Status> ExpandExecutor::GetDstBySrc() {
           if (result.dsts_ref().has_value()) {
             size = (*result.dsts_ref()).size();
           }
-          auto info = util::collectRespProfileData(result.result, hostLatency[i], size);
+          auto info = util::collectRespProfileData(
+              result.result, hostLatency[i], size, respBytes(result));
           addState(folly::sformat("step{} resp [{}]", currentStep_, i), info);
         }
         auto result = handleCompleteness(resps, FLAGS_accept_partial_success);
@@ -199,14 +200,14 @@ folly::Future<Status> ExpandExecutor::expandFromCache() {
     curLimit_ = 0;
     curMaxLimit_ =
         stepLimits_.empty() ? std::numeric_limits<int64_t>::max() : stepLimits_[currentStep_ - 1];
-    std::unordered_map<Value, std::unordered_set<Value>> dst2VidsMap;
-    std::unordered_set<Value> visitedVids;
+    Dst2VidsMap dst2VidsMap;
+    std::unordered_set<uint32_t> visitedVids;
 
     std::vector<int64_t> samples;
     if (sample_) {
       int64_t size = 0;
-      for (auto& vid : preVisitedVids_) {
-        size += adjDsts_[vid].size();
+      for (auto vid : preVisitedVids_) {
+        size += adjDsts_.neighbors(vid).size();
       }
       algorithm::ReservoirSampling<int64_t> sampler(curMaxLimit_, size);
       samples = sampler.samples();
@@ -225,18 +226,12 @@ folly::Future<Status> ExpandExecutor::expandFromCache() {
   return buildResult();
 }
 
-void ExpandExecutor::getNeighborsFromCache(
-    std::unordered_map<Value, std::unordered_set<Value>>& dst2VidsMap,
-    std::unordered_set<Value>& visitedVids,
-    std::vector<int64_t>& samples) {
-  for (const auto& vid : preVisitedVids_) {
-    auto findVid = adjDsts_.find(vid);
-    if (findVid == adjDsts_.end()) {
-      continue;
-    }
-    auto& dsts = findVid->second;
-
-    for (const auto& dst : dsts) {
+void ExpandExecutor::getNeighborsFromCache(Dst2VidsMap& dst2VidsMap,
+                                           std::unordered_set<uint32_t>& visitedVids,
+                                           std::vector<int64_t>& samples) {
+  for (auto vid : preVisitedVids_) {
+    for (const auto& neighbor : adjDsts_.neighbors(vid)) {
+      auto dst = neighbor.dst;
       if (sample_) {
         if (samples.empty()) {
           break;
@@ -255,8 +250,8 @@ void ExpandExecutor::getNeighborsFromCache(
       if (currentStep_ >= maxSteps_) {
         continue;
       }
-      if (adjDsts_.find(dst) == adjDsts_.end()) {
-        nextStepVids_.emplace(dst);
+      if (!adjDsts_.contains(dst)) {
+        nextStepVids_.emplace(dict_.vid(dst));
       } else {
         visitedVids.emplace(dst);
       }
@@ -271,8 +266,9 @@ void ExpandExecutor::getNeighborsFromCache(
 // 5、 get the dsts corresponding to the vid that has been visited in the previous step by adjDsts_
 folly::Future<Status> ExpandExecutor::handleResponse(RpcResponse&& resps) {
   NG_RETURN_IF_ERROR(handleCompleteness(resps, FLAGS_accept_partial_success));
-  std::unordered_map<Value, std::unordered_set<Value>> dst2VidsMap;
-  std::unordered_set<Value> visitedVids;
+  Dst2VidsMap dst2VidsMap;
+  std::unordered_set<uint32_t> visitedVids;
+  std::vector<uint32_t> dstIds;
   std::vector<int64_t> samples;
   if (sample_) {
     size_t size = 0;
@@ -297,13 +293,20 @@ folly::Future<Status> ExpandExecutor::handleResponse(RpcResponse&& resps) {
       if (dsts.empty()) {
         continue;
       }
-      const auto& src = iter.getVid();
+      auto src = dict_.getOrAdd(iter.getVid());
+      dstIds.clear();
+      for (const auto& dst : dsts) {
+        dstIds.emplace_back(dict_.getOrAdd(dst));
+      }
       // do not cache in the last step
-      if (currentStep_ < maxSteps_) {
-        adjDsts_.emplace(src, dsts);
+      if (currentStep_ < maxSteps_ && !adjDsts_.contains(src)) {
+        adjDsts_.addVertex(src);
+        for (auto dst : dstIds) {
+          adjDsts_.addNeighbor(dst, folly::unit);
+        }
       }
 
-      for (const auto& dst : dsts) {
+      for (auto dst : dstIds) {
         if (sample_) {
           if (samples.empty()) {
             break;
@@ -323,8 +326,8 @@ folly::Future<Status> ExpandExecutor::handleResponse(RpcResponse&& resps) {
         if (currentStep_ >= maxSteps_) {
           continue;
         }
-        if (adjDsts_.find(dst) == adjDsts_.end()) {
-          nextStepVids_.emplace(dst);
+        if (!adjDsts_.contains(dst)) {
+          nextStepVids_.emplace(dict_.vid(dst));
         } else {
           visitedVids.emplace(dst);
         }
@@ -339,15 +342,12 @@ folly::Future<Status> ExpandExecutor::handleResponse(RpcResponse&& resps) {
   return Status::OK();
 }
 
-void ExpandExecutor::updateDst2VidsMap(
-    std::unordered_map<Value, std::unordered_set<Value>>& dst2VidsMap,
-    const Value& src,
-    const Value& dst) {
+void ExpandExecutor::updateDst2VidsMap(Dst2VidsMap& dst2VidsMap, uint32_t src, uint32_t dst) {
   auto findSrc = preDst2VidsMap_.find(src);
   if (findSrc == preDst2VidsMap_.end()) {
     auto findDst = dst2VidsMap.find(dst);
     if (findDst == dst2VidsMap.end()) {
-      std::unordered_set<Value> tmp({src});
+      std::unordered_set<uint32_t> tmp({src});
       dst2VidsMap.emplace(dst, std::move(tmp));
     } else {
       findDst->second.emplace(src);
@@ -365,11 +365,11 @@ void ExpandExecutor::updateDst2VidsMap(
 folly::Future<Status> ExpandExecutor::buildResult() {
   DataSet ds;
   ds.colNames = expand_->colNames();
-  for (auto pair : preDst2VidsMap_) {
-    auto& dst = pair.first;
+  for (auto& pair : preDst2VidsMap_) {
+    auto& dst = dict_.vid(pair.first);
     for (auto src : pair.second) {
       Row row;
-      row.values.emplace_back(src);
+      row.values.emplace_back(dict_.vid(src));
       row.values.emplace_back(dst);
       ds.rows.emplace_back(std::move(row));
     }
@@ -7,6 +7,7 @@
 
 #include "graph/executor/StorageAccessExecutor.h"
 #include "graph/planner/plan/Query.h"
+#include "graph/util/VertexDict.h"
 
 // The go statement is divided into two operators, expand operator and expandAll operator.
 // expand is responsible for expansion and does not take attributes.
@@ -25,6 +26,8 @@
 // which saves the vids and all destination vids that expand one step
 // when expanding, if the vid has already been visited, do not need to go through RPC
 // just get the result directly through adjList_
+// vids are mapped to dense ids when they are first seen, so the adjList and the mapping between
+// init vids and dst vids are kept by ids, and converted back to Values in the result
 
 namespace nebula {
 namespace graph {
@@ -43,15 +46,15 @@ class ExpandExecutor final : public StorageAccessExecutor {
 
   folly::Future<Status> GetDstBySrc();
 
-  void getNeighborsFromCache(std::unordered_map<Value, std::unordered_set<Value>>& dst2VidMap,
-                             std::unordered_set<Value>& visitedVids,
+  using Dst2VidsMap = std::unordered_map<uint32_t, std::unordered_set<uint32_t>>;
+
+  void getNeighborsFromCache(Dst2VidsMap& dst2VidMap,
+                             std::unordered_set<uint32_t>& visitedVids,
                              std::vector<int64_t>& samples);
 
   folly::Future<Status> expandFromCache();
 
-  void updateDst2VidsMap(std::unordered_map<Value, std::unordered_set<Value>>& dst2VidMap,
-                         const Value& src,
-                         const Value& dst);
+  void updateDst2VidsMap(Dst2VidsMap& dst2VidMap, uint32_t src, uint32_t dst);
 
   folly::Future<Status> buildResult();
 
@@ -69,13 +72,14 @@ class ExpandExecutor final : public StorageAccessExecutor {
   std::vector<int64_t> stepLimits_;
 
   std::unordered_set<Value> nextStepVids_;
-  std::unordered_set<Value> preVisitedVids_;
-  std::unordered_map<Value, std::unordered_set<Value>> adjDsts_;
+  VertexDict dict_;
+  std::unordered_set<uint32_t> preVisitedVids_;
+  CsrAdjList<folly::Unit> adjDsts_;
 
   // keep the mapping relationship between the init vid and the destination vid
   // during the expansion.  KEY : edge's dst, VALUE : init vids
   // then we can know which init vids can reach the current destination point
-  std::unordered_map<Value, std::unordered_set<Value>> preDst2VidsMap_;
+  Dst2VidsMap preDst2VidsMap_;
 };
 
 }  // namespace graph
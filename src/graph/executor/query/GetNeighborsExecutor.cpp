@@ -71,7 +71,8 @@ folly::Future<Status> GetNeighborsExecutor::execute() {
           if (result.vertices_ref().has_value()) {
             size = (*result.vertices_ref()).size();
           }
-          auto info = util::collectRespProfileData(result.result, hostLatency[i], size);
+          auto info = util::collectRespProfileData(
+              result.result, hostLatency[i], size, respBytes(result));
           addState(folly::sformat("resp[{}]", i), info);
         }
         return handleResponse(resp);
@@ -55,6 +55,9 @@ folly::Future<Status> ProjectExecutor::execute() {
   }
 }
 
+// rows evaluated by each call of a vectorized function
+static constexpr size_t kBatchRows = 1024;
+
 DataSet ProjectExecutor::handleJob(size_t begin, size_t end, Iterator *iter) {
   auto *project = asNode<Project>(node());
   auto columns = project->columns()->clone();
@@ -62,16 +65,73 @@ DataSet ProjectExecutor::handleJob(size_t begin, size_t end, Iterator *iter) {
   ds.colNames = project->colNames();
   QueryExpressionContext ctx(qctx()->ectx());
   ds.rows.reserve(end - begin);
+
+  // The columns calling vectorized functions are evaluated by batches: the arguments are
+  // evaluated row by row, then the function is called once for the whole batch.
+  std::vector<BatchColumn> batchColumns;
+  std::vector<BatchColumn *> batchOf(columns->size(), nullptr);
+  for (size_t i = 0; i < columns->size(); ++i) {
+    auto *expr = columns->columns()[i]->expr();
+    if (expr->kind() != Expression::Kind::kFunctionCall) {
+      continue;
+    }
+    auto *call = static_cast<FunctionCallExpression *>(expr);
+    auto func = FunctionManager::getBatch(call->name(), call->args()->numArgs());
+    if (func) {
+      batchColumns.emplace_back(BatchColumn{i, call, std::move(func), {}});
+      batchColumns.back().args.resize(call->args()->numArgs());
+    }
+  }
+  for (auto &batch : batchColumns) {
+    batchOf[batch.index] = &batch;
+  }
+
+  size_t batchBegin = 0;
   for (; iter->valid() && begin++ < end; iter->next()) {
     Row row;
-    for (auto &col : columns->columns()) {
-      Value val = col->expr()->eval(ctx(iter));
+    for (size_t i = 0; i < columns->size(); ++i) {
+      auto *batch = batchOf[i];
+      if (batch != nullptr) {
+        auto &args = batch->call->args()->args();
+        for (size_t j = 0; j < args.size(); ++j) {
+          batch->args[j].emplace_back(args[j]->eval(ctx(iter)));
+        }
+        // filled by the batch
+        row.values.emplace_back();
+        continue;
+      }
+      Value val = columns->columns()[i]->expr()->eval(ctx(iter));
       row.values.emplace_back(std::move(val));
     }
     ds.rows.emplace_back(std::move(row));
+    if (!batchColumns.empty() && ds.rows.size() - batchBegin == kBatchRows) {
+      evalBatch(batchColumns, batchBegin, &ds);
+      batchBegin = ds.rows.size();
+    }
+  }
+  if (!batchColumns.empty() && ds.rows.size() > batchBegin) {
+    evalBatch(batchColumns, batchBegin, &ds);
   }
   return ds;
 }
 
+void ProjectExecutor::evalBatch(std::vector<BatchColumn> &batchColumns,
+                                size_t batchBegin,
+                                DataSet *ds) {
+  auto numRows = ds->rows.size() - batchBegin;
+  std::vector<Value> results;
+  results.reserve(numRows);
+  for (auto &batch : batchColumns) {
+    results.clear();
+    batch.func(batch.args, numRows, results);
+    for (size_t i = 0; i < numRows; ++i) {
+      ds->rows[batchBegin + i].values[batch.index] = std::move(results[i]);
+    }
+    for (auto &arg : batch.args) {
+      arg.clear();
+    }
+  }
+}
+
 }  // namespace graph
 }  // namespace nebula
@@ -5,6 +5,7 @@
 #ifndef GRAPH_EXECUTOR_QUERY_PROJECTEXECUTOR_H_
 #define GRAPH_EXECUTOR_QUERY_PROJECTEXECUTOR_H_
 
+#include "common/expression/FunctionCallExpression.h"
 #include "graph/executor/Executor.h"
 // select user-specified columns from a table
 namespace nebula {
@@ -18,6 +19,18 @@ class ProjectExecutor final : public Executor {
   folly::Future<Status> execute() override;
 
   DataSet handleJob(size_t begin, size_t end, Iterator *iter);
+
+ private:
+  // A column calling a vectorized function, and the arguments of the rows of the batch
+  struct BatchColumn {
+    size_t index;
+    FunctionCallExpression *call;
+    FunctionManager::BatchFunction func;
+    std::vector<std::vector<Value>> args;
+  };
+
+  // Call the vectorized functions for the rows from batchBegin
+  void evalBatch(std::vector<BatchColumn> &batchColumns, size_t batchBegin, DataSet *ds);
 };
 
 }  // namespace graph
@@ -8,12 +8,16 @@
 #include "common/memory/MemoryTracker.h"
 #include "graph/context/iterator/GetNbrsRespDataSetIter.h"
 #include "graph/service/GraphFlags.h"
+#include "graph/util/PathTree.h"
 #include "graph/util/SchemaUtil.h"
 #include "graph/util/Utils.h"
 
 DEFINE_uint64(traverse_parallel_threshold_rows,
               150000,
               "threshold row number of traverse executor in parallel");
+DEFINE_bool(traverse_expand_on_arrival,
+            true,
+            "expand the first step of traverse from the response of each storaged as it arrives");
 
 using nebula::storage::StorageClient;
 using nebula::storage::StorageRpcResponse;
@@ -85,10 +89,21 @@ folly::Future<Status> TraverseExecutor::getNeighbors() {
                                           qctx()->rctx()->session()->id(),
                                           qctx()->plan()->id(),
                                           qctx()->plan()->isProfileEnabled());
+  std::shared_ptr<ArrivedExpansions> arrived;
+  if (FLAGS_traverse_expand_on_arrival && isPlainFirstStep()) {
+    arrived = std::make_shared<ArrivedExpansions>();
+    param.onNeighborsArrival = [this, arrived](const HostAddr& host,
+                                               const GetNeighborsResponse& resp) {
+      return expandOnArrival(arrived, host, resp);
+    };
+  }
   std::vector<Value> vids(vids_.size());
   std::move(vids_.begin(), vids_.end(), vids.begin());
-  return storageClient
-      ->getNeighbors(param,
+  NeighborCache::Hits hits;
+  return qctx_->neighborCache()
+      ->getNeighbors(storageClient,
+                     &hits,
+                     param,
                      {nebula::kVid},
                      std::move(vids),
                      traverse_->edgeTypes(),
@@ -104,16 +119,17 @@ folly::Future<Status> TraverseExecutor::getNeighbors() {
                      selectFilter(),
                      currentStep_ == 1 ? traverse_->tagFilter() : nullptr)
       .via(runner())
-      .thenValue([this, getNbrTime](StorageRpcResponse<GetNeighborsResponse>&& resp) mutable {
+      .thenValue([this, getNbrTime, hits, arrived](
+                     StorageRpcResponse<GetNeighborsResponse>&& resp) mutable {
         // MemoryTrackerVerified
         memory::MemoryCheckGuard guard;
         vids_.clear();
         SCOPED_TIMER(&execTime_);
         addStats(resp, getNbrTime.elapsedInUSec());
+        addState(folly::sformat("neighbor_cache step[{}]", currentStep_), hits.toJson());
         time::Duration expandTime;
-        return handleResponse(std::move(resp)).ensure([this, expandTime]() {
-          addState("expandTime", expandTime);
-        });
+        return handleResponse(std::move(resp), std::move(arrived))
+            .ensure([this, expandTime]() { addState("expandTime", expandTime); });
       })
       .thenValue([this](Status s) -> folly::Future<Status> {
         NG_RETURN_IF_ERROR(s);
@@ -148,7 +164,8 @@ void TraverseExecutor::addStats(RpcResponse& resp, int64_t getNbrTimeInUSec) {
     if (result.vertices_ref().has_value()) {
       size = (*result.vertices_ref()).size();
     }
-    auto info = util::collectRespProfileData(result.result, hostLatency[i], size);
+    auto info =
+        util::collectRespProfileData(result.result, hostLatency[i], size, respBytes(result));
     stepInfo.push_back(std::move(info));
   }
   folly::dynamic stepObj = folly::dynamic::object();
@@ -177,7 +194,7 @@ size_t sizeOf(const std::vector<T>& v) {
   return sz;
 }
 
-void TraverseExecutor::buildAdjList(DataSet& dataset,
+void TraverseExecutor::buildAdjList(const DataSet& dataset,
                                     std::vector<Value>& initVertices,
                                     VidHashSet& vids,
                                     VertexMap<Value>& adjList) const {
@@ -199,10 +216,7 @@ void TraverseExecutor::buildAdjList(DataSet& dataset,
 
 folly::Future<Status> TraverseExecutor::asyncExpandOneStep(RpcResponse&& resps) {
   size_t numResps = resps.responses().size();
-  auto initVerticesList = std::make_shared<std::vector<std::vector<Value>>>(numResps);
-  auto vidsList = std::make_shared<std::vector<VidHashSet>>(numResps);
-  auto adjLists = std::make_shared<std::vector<VertexMap<Value>>>(numResps);
-  auto taskRunTime = std::make_shared<std::vector<size_t>>(numResps, 0u);
+  auto expansions = std::make_shared<std::vector<Expansion>>(numResps);
 
   std::vector<folly::Future<folly::Unit>> futures;
   futures.reserve(numResps);
@@ -210,50 +224,103 @@ folly::Future<Status> TraverseExecutor::asyncExpandOneStep(RpcResponse&& resps)
   for (size_t i = 0; i < numResps; i++) {
     auto dataset = resps.responses()[i].get_vertices();
     if (!dataset) continue;
-    auto func = [this,
-                 dataset = std::move(*dataset),
-                 i,
-                 initVerticesList,
-                 vidsList,
-                 adjLists,
-                 taskRunTime]() mutable {
-      SCOPED_TIMER(&((*taskRunTime)[i]));
-      buildAdjList(dataset, (*initVerticesList)[i], (*vidsList)[i], (*adjLists)[i]);
+    auto func = [this, dataset = std::move(*dataset), i, expansions]() mutable {
+      auto& expansion = (*expansions)[i];
+      SCOPED_TIMER(&expansion.runTime);
+      buildAdjList(dataset, expansion.initVertices, expansion.vids, expansion.adjList);
     };
     futures.emplace_back(folly::via(runner(), std::move(func)));
   }
 
   return folly::collect(futures).via(runner()).thenValue(
-      [this, initVerticesList, vidsList, adjLists, taskRunTime](std::vector<folly::Unit>&&) {
-        time::Duration postTaskTime;
-        initVertices_.reserve(sizeOf(*initVerticesList));
-        for (auto& initVertices : *initVerticesList) {
-          std::move(initVertices.begin(), initVertices.end(), std::back_inserter(initVertices_));
-        }
+      [this, expansions](std::vector<folly::Unit>&&) {
+        mergeExpansions(*expansions);
+        return Status::OK();
+      });
+}
 
-        vids_.reserve(sizeOf(*vidsList));
-        for (auto& vids : *vidsList) {
-          for (auto& v : vids) {
-            vids_.emplace(std::move(v));
-          }
-        }
+folly::Future<folly::Unit> TraverseExecutor::expandOnArrival(
+    std::shared_ptr<ArrivedExpansions> arrived,
+    const HostAddr& host,
+    const GetNeighborsResponse& resp) {
+  auto dataset = resp.get_vertices();
+  if (dataset == nullptr) {
+    // Still recorded, so the response of the host is not expanded again
+    std::lock_guard<std::mutex> g(arrived->lock);
+    arrived->expansions.emplace(host, Expansion());
+    return folly::makeFuture();
+  }
+  // The response is kept alive by the storage client until the future is done
+  return folly::via(runner(), [this, arrived, host, dataset]() {
+    // MemoryTrackerVerified
+    memory::MemoryCheckGuard guard;
+    Expansion expansion;
+    {
+      SCOPED_TIMER(&expansion.runTime);
+      buildAdjList(*dataset, expansion.initVertices, expansion.vids, expansion.adjList);
+    }
+    std::lock_guard<std::mutex> g(arrived->lock);
+    arrived->expansions.emplace(host, std::move(expansion));
+  });
+}
 
-        adjList_.reserve(adjList_.size() + sizeOf(*adjLists));
-        for (auto& adjList : *adjLists) {
-          for (auto& p : adjList) {
-            adjList_.emplace(std::move(p.first), std::move(p.second));
-          }
-        }
+Status TraverseExecutor::expandArrived(RpcResponse&& resps, ArrivedExpansions& arrived) {
+  // Match the responses to the expansions by their hosts. The hosts which failed have neither, and
+  // the responses without a host, such as the rows from the neighbor cache, are expanded here.
+  auto& responses = resps.responses();
+  auto& hostLatency = resps.hostLatency();
+  std::vector<Expansion> expansions;
+  expansions.reserve(responses.size() + 1);
+  Expansion rest;
+  for (size_t i = 0; i < responses.size(); ++i) {
+    if (i < hostLatency.size()) {
+      auto found = arrived.expansions.find(std::get<0>(hostLatency[i]));
+      if (found != arrived.expansions.end()) {
+        expansions.emplace_back(std::move(found->second));
+        continue;
+      }
+    }
+    auto dataset = responses[i].get_vertices();
+    if (dataset != nullptr) {
+      SCOPED_TIMER(&rest.runTime);
+      buildAdjList(*dataset, rest.initVertices, rest.vids, rest.adjList);
+    }
+  }
+  expansions.emplace_back(std::move(rest));
+  mergeExpansions(expansions);
+  return Status::OK();
+}
 
-        addState("expandPostTaskTime", postTaskTime);
-        folly::dynamic taskRunTimeArray = folly::dynamic::array();
-        for (auto time : *taskRunTime) {
-          taskRunTimeArray.push_back(time);
-        }
-        addState("expandTaskRunTime", std::move(taskRunTimeArray));
+void TraverseExecutor::mergeExpansions(std::vector<Expansion>& expansions) {
+  time::Duration postTaskTime;
+  size_t numInitVertices = 0;
+  size_t numVids = 0;
+  size_t numAdjLists = 0;
+  for (const auto& expansion : expansions) {
+    numInitVertices += expansion.initVertices.size();
+    numVids += expansion.vids.size();
+    numAdjLists += expansion.adjList.size();
+  }
+
+  initVertices_.reserve(numInitVertices);
+  vids_.reserve(numVids);
+  adjList_.reserve(adjList_.size() + numAdjLists);
+  folly::dynamic taskRunTimeArray = folly::dynamic::array();
+  for (auto& expansion : expansions) {
+    std::move(expansion.initVertices.begin(),
+              expansion.initVertices.end(),
+              std::back_inserter(initVertices_));
+    for (auto& v : expansion.vids) {
+      vids_.emplace(std::move(v));
+    }
+    for (auto& p : expansion.adjList) {
+      adjList_.emplace(std::move(p.first), std::move(p.second));
+    }
+    taskRunTimeArray.push_back(expansion.runTime);
+  }
 
-        return Status::OK();
-      });
+  addState("expandPostTaskTime", postTaskTime);
+  addState("expandTaskRunTime", std::move(taskRunTimeArray));
 }
 
 folly::Future<Status> TraverseExecutor::expandOneStep(RpcResponse&& resps) {
@@ -273,11 +340,15 @@ folly::Future<Status> TraverseExecutor::expandOneStep(RpcResponse&& resps) {
   return Status::OK();
 }
 
-folly::Future<Status> TraverseExecutor::handleResponse(RpcResponse&& resps) {
+folly::Future<Status> TraverseExecutor::handleResponse(
+    RpcResponse&& resps, std::shared_ptr<ArrivedExpansions> arrived) {
   NG_RETURN_IF_ERROR(handleCompleteness(resps, FLAGS_accept_partial_success));
 
-  if (currentStep_ == 1 && !traverse_->eFilter() && !traverse_->vFilter()) {
-    return expandOneStep(std::move(resps)).thenValue([this](Status s) {
+  if (isPlainFirstStep()) {
+    auto expanded = arrived != nullptr
+                        ? folly::makeFuture<Status>(expandArrived(std::move(resps), *arrived))
+                        : expandOneStep(std::move(resps));
+    return std::move(expanded).thenValue([this](Status s) {
       NG_RETURN_IF_ERROR(s);
       if (range_.min() == 0) {
         result_.rows = buildZeroStepPath();
@@ -521,81 +592,42 @@ std::vector<Row> TraverseExecutor::buildPath(const Value& initVertex,
     return oneStepPath;
   }
 
-  size_t step = 2;
-  std::vector<Row> newResult;
-  std::queue<std::vector<Value>*> queue;
-  std::queue<std::vector<Value>*> edgeListQueue;
-  std::list<std::unique_ptr<std::vector<Value>>> holder;
+  // paths are extended step by step, each path is a node of the tree which refers to the
+  // edges in adjList_, only the paths in the result are converted to lists
+  PathTree tree;
+  std::vector<uint32_t> frontier;
+  frontier.reserve(adjEdges.size());
   for (auto& edge : adjEdges) {
-    auto ptr = std::make_unique<std::vector<Value>>(std::vector<Value>({edge}));
-    queue.emplace(ptr.get());
-    edgeListQueue.emplace(ptr.get());
-    holder.emplace_back(std::move(ptr));
+    frontier.emplace_back(tree.add(PathTree::kRoot, nullptr, &edge));
   }
-
-  size_t adjSize = edgeListQueue.size();
-  while (!edgeListQueue.empty()) {
-    auto edgeListPtr = edgeListQueue.front();
-    auto& dst = edgeListPtr->back().getEdge().dst;
-    edgeListQueue.pop();
-
-    std::vector<Value>* vertexEdgeListPtr = nullptr;
-    if (genPath_) {
-      vertexEdgeListPtr = queue.front();
-      queue.pop();
-    }
-
-    --adjSize;
-    auto dstIter = adjList_.find(dst);
-    if (dstIter == adjList_.end()) {
-      if (adjSize == 0) {
-        if (++step > maxStep) {
-          break;
-        }
-        adjSize = edgeListQueue.size();
-      }
-      continue;
-    }
-
-    auto& adjedges = dstIter->second;
-    for (auto& edge : adjedges) {
-      if (hasSameEdge(*edgeListPtr, edge.getEdge())) {
+  std::vector<Row> newResult;
+  for (size_t step = 2; step <= maxStep && !frontier.empty(); ++step) {
+    std::vector<uint32_t> nextFrontier;
+    for (auto path : frontier) {
+      auto dstIter = adjList_.find(tree.edge(path).getEdge().dst);
+      if (dstIter == adjList_.end()) {
         continue;
       }
-      auto newEdgeListPtr = std::make_unique<std::vector<Value>>(*edgeListPtr);
-      newEdgeListPtr->emplace_back(edge);
-
-      std::unique_ptr<std::vector<Value>> newVertexEdgeListPtr = nullptr;
-      if (genPath_) {
-        newVertexEdgeListPtr = std::make_unique<std::vector<Value>>(*vertexEdgeListPtr);
-        newVertexEdgeListPtr->emplace_back(dstIter->first);
-        newVertexEdgeListPtr->emplace_back(edge);
-      }
-
-      if (step >= minStep) {
-        Row row;
-        row.values.emplace_back(src);
-        // only contain edges
-        row.values.emplace_back(List(*newEdgeListPtr));
-        if (genPath_) {
-          // contain nodes & edges
-          row.values.emplace_back(List(*newVertexEdgeListPtr));
+      for (auto& edge : dstIter->second) {
+        if (tree.hasEdge(path, edge.getEdge())) {
+          continue;
         }
-        newResult.emplace_back(std::move(row));
-      }
-      edgeListQueue.emplace(newEdgeListPtr.get());
-      holder.emplace_back(std::move(newEdgeListPtr));
-      if (genPath_ && newVertexEdgeListPtr != nullptr) {
-        queue.emplace(newVertexEdgeListPtr.get());
-        holder.emplace_back(std::move(newVertexEdgeListPtr));
-      }
-    }
-    if (adjSize == 0) {
-      if (++step > maxStep) {
-        break;
+        auto newPath = tree.add(path, &dstIter->first, &edge);
+        if (step >= minStep) {
+          Row row;
+          row.values.emplace_back(src);
+          // only contain edges
+          row.values.emplace_back(List(tree.edges(newPath)));
+          if (genPath_) {
+            // contain nodes & edges
+            row.values.emplace_back(List(tree.steps(newPath)));
+          }
+          newResult.emplace_back(std::move(row));
+        }
+        nextFrontier.emplace_back(newPath);
       }
-      adjSize = edgeListQueue.size();
     }
+    frontier.swap(nextFrontier);
   }
   if (minStep <= 1) {
     newResult.insert(newResult.begin(),
@@ -615,10 +647,18 @@ std::vector<Row> TraverseExecutor::joinPrevPath(const Value& initVertex,
     return std::vector<Row>();
   }
 
+  // only the paths whose bloom bits of edges intersect are checked edge by edge
+  std::vector<uint64_t> newBlooms;
+  newBlooms.reserve(newResult.size());
+  for (auto& p : newResult) {
+    newBlooms.emplace_back(edgeBloom(p));
+  }
   std::vector<Row> newPaths;
   for (auto& prevPath : dstIter->second) {
-    for (auto& p : newResult) {
-      if (!hasSameEdgeInPath(prevPath, p)) {
+    auto prevBloom = edgeBloom(prevPath);
+    for (size_t i = 0; i < newResult.size(); ++i) {
+      auto& p = newResult[i];
+      if ((prevBloom & newBlooms[i]) == 0 || !hasSameEdgeInPath(prevPath, p)) {
         // copy
         Row row = prevPath;
         row.values.insert(row.values.end(), p.values.begin(), p.values.end());
@@ -638,6 +678,20 @@ bool TraverseExecutor::hasSameEdge(const std::vector<Value>& edgeList, const Edg
   return false;
 }
 
+uint64_t TraverseExecutor::edgeBloom(const Row& path) const {
+  uint64_t bloom = 0;
+  for (const auto& listVal : path.values) {
+    if (listVal.isList()) {
+      for (auto& edgeVal : listVal.getList().values) {
+        if (edgeVal.isEdge()) {
+          bloom |= edgeBloomBit(edgeVal.getEdge());
+        }
+      }
+    }
+  }
+  return bloom;
+}
+
 bool TraverseExecutor::hasSameEdgeInPath(const Row& lhs, const Row& rhs) const {
   for (const auto& leftListVal : lhs.values) {
     if (leftListVal.isList()) {
@@ -5,6 +5,7 @@
 #ifndef EXECUTOR_QUERY_TRAVERSEEXECUTOR_H_
 #define EXECUTOR_QUERY_TRAVERSEEXECUTOR_H_
 
+#include <gtest/gtest_prod.h>
 #include <robin_hood.h>
 
 #include "graph/executor/StorageAccessExecutor.h"
@@ -35,7 +36,11 @@
 // `buildInterimPath` : construct collection of paths after expanded and put it into the paths_
 // `getNeighbors` : invoke the getNeightbors interface
 // `releasePrevPaths` : deleted The path whose length does not meet the user-defined length
+// `buildPath` : extend the paths from a vertex as a PathTree, paths share their prefixes
 // `hasSameEdge` : check if there are duplicate edges in path
+// `edgeBloom` : bloom bits of the edges in path, to skip checking the disjoint paths
+// `expandOnArrival` : build the adjacency list of the first step from the response of each host
+//  as it arrives, instead of after the responses of all hosts are collected
 
 namespace nebula {
 namespace graph {
@@ -43,6 +48,8 @@ namespace graph {
 using RpcResponse = storage::StorageRpcResponse<storage::cpp2::GetNeighborsResponse>;
 
 class TraverseExecutor final : public StorageAccessExecutor {
+  FRIEND_TEST(TraverseTest, ExpandArrivedPartialFailure);
+
  public:
   TraverseExecutor(const PlanNode* node, QueryContext* qctx)
       : StorageAccessExecutor("Traverse", node, qctx) {
@@ -64,13 +71,38 @@ class TraverseExecutor final : public StorageAccessExecutor {
   size_t numRowsOfRpcResp(const RpcResponse& resps) const;
 
   void expand(GetNeighborsIter* iter);
-  void buildAdjList(DataSet& dataset,
+  // The adjacency list built from the response of one host
+  struct Expansion {
+    std::vector<Value> initVertices;
+    VidHashSet vids;
+    VertexMap<Value> adjList;
+    size_t runTime{0};
+  };
+
+  // The expansions built by expandOnArrival, by the host
+  struct ArrivedExpansions {
+    std::mutex lock;
+    std::unordered_map<HostAddr, Expansion> expansions;
+  };
+
+  void buildAdjList(const DataSet& dataset,
                     std::vector<Value>& initVertices,
                     VidHashSet& vids,
                     VertexMap<Value>& adjList) const;
   folly::Future<Status> expandOneStep(RpcResponse&& resps);
   folly::Future<Status> asyncExpandOneStep(RpcResponse&& resps);
-  folly::Future<Status> handleResponse(RpcResponse&& resps);
+  folly::Future<folly::Unit> expandOnArrival(std::shared_ptr<ArrivedExpansions> arrived,
+                                             const HostAddr& host,
+                                             const storage::cpp2::GetNeighborsResponse& resp);
+  Status expandArrived(RpcResponse&& resps, ArrivedExpansions& arrived);
+  void mergeExpansions(std::vector<Expansion>& expansions);
+  folly::Future<Status> handleResponse(RpcResponse&& resps,
+                                       std::shared_ptr<ArrivedExpansions> arrived);
+
+  // Whether the step expands without filters, which is done from the response of each host
+  bool isPlainFirstStep() const {
+    return currentStep_ == 1 && !traverse_->eFilter() && !traverse_->vFilter();
+  }
 
   folly::Future<Status> buildResult();
 
@@ -83,6 +115,7 @@ class TraverseExecutor final : public StorageAccessExecutor {
   }
 
   bool hasSameEdge(const std::vector<Value>& edgeList, const Edge& edge) const;
+  uint64_t edgeBloom(const Row& path) const;
   bool hasSameEdgeInPath(const Row& lhs, const Row& rhs) const;
   bool hasSameEdgeInSet(const Row& rhs, const std::unordered_set<Value>& uniqueEdge) const;
 
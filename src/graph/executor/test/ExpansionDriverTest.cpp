@@ -0,0 +1,116 @@
+// Copyright (c) 2022 vesoft inc. All rights reserved.
+//
+// This source code is licensed under Apache 2.0 License.
+
+#include <gtest/gtest.h>
+
+#include "graph/executor/algo/ExpansionDriver.h"
+
+DECLARE_uint32(path_threshold_size);
+DECLARE_uint32(path_threshold_ratio);
+DECLARE_uint32(path_degree_sample_size);
+
+namespace nebula {
+namespace graph {
+
+using Direction = ExpansionDriver::Direction;
+
+TEST(ExpansionDriverTest, FrontierSize) {
+  // without degrees, the fan-out is the size of frontier
+  ExpansionDriver driver(10);
+  EXPECT_EQ(Direction::kBoth, driver.next(1, 1));
+  EXPECT_EQ(Direction::kBoth, driver.next(100, 200));
+  EXPECT_EQ(Direction::kLeft, driver.next(50, 201));
+  EXPECT_EQ(Direction::kRight, driver.next(1000, 1));
+  EXPECT_EQ(3, driver.steps(false));
+  EXPECT_EQ(3, driver.steps(true));
+  EXPECT_EQ(6, driver.steps());
+  EXPECT_FALSE(driver.exhausted());
+}
+
+TEST(ExpansionDriverTest, Degree) {
+  ExpansionDriver driver(10);
+  // a hub on the left side and a long-tail vertex on the right side
+  driver.expanded(false, 1, 5000);
+  driver.expanded(true, 1, 2);
+  EXPECT_EQ(5000, driver.fanOut(false, 1));
+  EXPECT_EQ(2, driver.fanOut(true, 1));
+  EXPECT_EQ(Direction::kRight, driver.next(1, 1));
+  EXPECT_EQ(0, driver.steps(false));
+  EXPECT_EQ(1, driver.steps(true));
+
+  // keep expanding the long-tail side until its fan-out catches up
+  driver.expanded(true, 2, 6);
+  EXPECT_EQ(Direction::kRight, driver.next(1, 6));
+  driver.expanded(true, 6, 60);
+  EXPECT_EQ(Direction::kBoth, driver.next(1, 1000));
+  EXPECT_EQ(1, driver.steps(false));
+  EXPECT_EQ(3, driver.steps(true));
+}
+
+TEST(ExpansionDriverTest, UnknownDegree) {
+  ExpansionDriver driver(10);
+  driver.expanded(true, 10, 100);
+  // the unknown degree of left side takes the degree of right side
+  EXPECT_EQ(50, driver.fanOut(false, 5));
+  EXPECT_EQ(100, driver.fanOut(true, 10));
+  // no edges of the expanded vertices
+  driver.expanded(false, 5, 0);
+  EXPECT_EQ(0, driver.fanOut(false, 5));
+  // nothing is returned, the degree is not changed
+  driver.expanded(true, 0, 0);
+  EXPECT_EQ(100, driver.fanOut(true, 10));
+}
+
+TEST(ExpansionDriverTest, LastStep) {
+  ExpansionDriver driver(3);
+  EXPECT_EQ(Direction::kBoth, driver.next(1, 1));
+  EXPECT_FALSE(driver.exhausted());
+  // only one step is left, expand the smaller side
+  EXPECT_EQ(Direction::kRight, driver.next(3, 2));
+  EXPECT_TRUE(driver.exhausted());
+  EXPECT_EQ(1, driver.steps(false));
+  EXPECT_EQ(2, driver.steps(true));
+
+  ExpansionDriver single(1);
+  EXPECT_EQ(Direction::kLeft, single.next(1, 1));
+  EXPECT_TRUE(single.exhausted());
+}
+
+TEST(ExpansionDriverTest, Threshold) {
+  auto thresholdSize = FLAGS_path_threshold_size;
+  auto thresholdRatio = FLAGS_path_threshold_ratio;
+  FLAGS_path_threshold_size = 10;
+  FLAGS_path_threshold_ratio = 4;
+  ExpansionDriver driver(10);
+  EXPECT_EQ(Direction::kBoth, driver.next(3, 12));
+  EXPECT_EQ(Direction::kLeft, driver.next(3, 13));
+  EXPECT_EQ(Direction::kBoth, driver.next(9, 1));
+  EXPECT_EQ(Direction::kRight, driver.next(11, 1));
+  FLAGS_path_threshold_size = thresholdSize;
+  FLAGS_path_threshold_ratio = thresholdRatio;
+}
+
+TEST(ExpansionDriverTest, CopyDegrees) {
+  // sampling is off by default
+  ExpansionDriver sampler(10);
+  EXPECT_FALSE(sampler.needSample());
+  auto sampleSize = FLAGS_path_degree_sample_size;
+  FLAGS_path_degree_sample_size = 10;
+  EXPECT_TRUE(sampler.needSample());
+  sampler.expanded(false, 1, 5000);
+  sampler.expanded(true, 1, 2);
+
+  // the degrees sampled once are taken by the driver of each row
+  ExpansionDriver driver(10);
+  EXPECT_TRUE(driver.needSample());
+  driver.copyDegrees(sampler);
+  EXPECT_FALSE(driver.needSample());
+  EXPECT_EQ(5000, driver.fanOut(false, 1));
+  EXPECT_EQ(2, driver.fanOut(true, 1));
+  EXPECT_EQ(Direction::kRight, driver.next(1, 1));
+  FLAGS_path_degree_sample_size = sampleSize;
+}
+
+}  // namespace graph
+}  // namespace nebula
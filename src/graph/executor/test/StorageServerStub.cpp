@@ -136,4 +136,9 @@ folly::Future<cpp2::ExecResponse> GraphStorageLocalServer::future_remove(
   LOCAL_RETURN_FUTURE(threadManager_, cpp2::ExecResponse, future_remove);
 }
 
+folly::Future<cpp2::ExecResponse> GraphStorageLocalServer::future_releaseReadSnapshots(
+    const cpp2::ReleaseReadSnapshotsRequest& request) {
+  LOCAL_RETURN_FUTURE(threadManager_, cpp2::ExecResponse, future_releaseReadSnapshots);
+}
+
 }  // namespace nebula::storage
@@ -0,0 +1,83 @@
+// Copyright (c) 2023 vesoft inc. All rights reserved.
+//
+// This source code is licensed under Apache 2.0 License.
+
+#include <gtest/gtest.h>
+
+#include "graph/context/QueryContext.h"
+#include "graph/executor/query/TraverseExecutor.h"
+#include "graph/planner/plan/Logic.h"
+#include "graph/planner/plan/Query.h"
+
+namespace nebula {
+namespace graph {
+
+static storage::cpp2::GetNeighborsResponse makeResp(
+    const std::vector<std::pair<std::string, std::vector<std::string>>>& adjList) {
+  DataSet ds;
+  ds.colNames = {kVid, "_stats", "_edge:+like:_type:_dst:_rank", "_expr"};
+  for (const auto& [src, dsts] : adjList) {
+    Row row;
+    row.values.emplace_back(src);
+    row.values.emplace_back(Value());
+    List edges;
+    for (const auto& dst : dsts) {
+      List edge;
+      edge.values.emplace_back(1);
+      edge.values.emplace_back(dst);
+      edge.values.emplace_back(0);
+      edges.values.emplace_back(std::move(edge));
+    }
+    row.values.emplace_back(std::move(edges));
+    row.values.emplace_back(Value());
+    ds.rows.emplace_back(std::move(row));
+  }
+  storage::cpp2::GetNeighborsResponse resp;
+  resp.vertices_ref() = std::move(ds);
+  return resp;
+}
+
+TEST(TraverseTest, ExpandArrivedPartialFailure) {
+  auto qctx = std::make_unique<QueryContext>();
+  auto* traverse = Traverse::make(qctx.get(), StartNode::make(qctx.get()), 1);
+  TraverseExecutor exe(traverse, qctx.get());
+
+  HostAddr h1("h1", 9779), h2("h2", 9779), h3("h3", 9779);
+  auto resp1 = makeResp({{"a", {"b", "c"}}});
+  auto resp2 = makeResp({{"b", {"a"}}});
+  auto resp3 = makeResp({{"c", {"e"}}});
+
+  // All three hosts arrive, but the response of h2 is dropped after its hook, e.g. by an error
+  // raised later, so the responses no longer line up with the arrived expansions.
+  auto arrived = std::make_shared<TraverseExecutor::ArrivedExpansions>();
+  exe.expandOnArrival(arrived, h1, resp1).get();
+  exe.expandOnArrival(arrived, h2, resp2).get();
+  exe.expandOnArrival(arrived, h3, resp3).get();
+  ASSERT_EQ(arrived->expansions.size(), 3);
+
+  RpcResponse resps(3);
+  resps.markFailure();
+  resps.emplaceFailedPart(2, nebula::cpp2::ErrorCode::E_RPC_FAILURE);
+  resps.setLatency(h3, 10, 20);
+  resps.addResponse(std::move(resp3));
+  resps.setLatency(h1, 10, 20);
+  resps.addResponse(std::move(resp1));
+  // The rows from the neighbor cache have no host
+  resps.responses().emplace_back(makeResp({{"d", {"a", "e"}}}));
+
+  ASSERT_TRUE(exe.expandArrived(std::move(resps), *arrived).ok());
+
+  EXPECT_EQ(exe.initVertices_.size(), 3);
+  EXPECT_EQ(exe.adjList_.size(), 3);
+  for (const auto& vid : {"a", "c", "d"}) {
+    EXPECT_EQ(exe.adjList_.count(Value(Vertex(vid, {}))), 1) << vid;
+  }
+  EXPECT_EQ(exe.adjList_.count(Value(Vertex("b", {}))), 0);
+  EXPECT_EQ(exe.adjList_.at(Value(Vertex("d", {}))).size(), 2);
+
+  VidHashSet expectedVids = {"a", "b", "c", "e"};
+  EXPECT_EQ(exe.vids_, expectedVids);
+}
+
+}  // namespace graph
+}  // namespace nebula
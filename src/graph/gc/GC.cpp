@@ -6,10 +6,15 @@
 
 #include "common/memory/MemoryTracker.h"
 #include "graph/service/GraphFlags.h"
+#include "graph/stats/GraphStats.h"
+#include "graph/util/Utils.h"
 
 namespace nebula {
 namespace graph {
 
+// rows walked to estimate the size of a result
+static constexpr size_t kSampleRows = 64;
+
 GC& GC::instance() {
   static GC gc;
   return gc;
@@ -26,13 +31,113 @@ GC::GC() {
 
 void GC::clear(std::vector<Result>&& garbage) {
   memory::MemoryCheckOffGuard guard;
+  for (auto& result : garbage) {
+    Garbage item;
+    item.bytes = util::estimateSize(result.value(), kSampleRows);
+    item.result.emplace(std::move(result));
+    enqueue(std::move(item));
+  }
+  garbage.clear();
+}
+
+void GC::enqueue(Garbage&& garbage) {
+  pendingBytes_.fetch_add(garbage.bytes, std::memory_order_relaxed);
+  stats::StatsManager::addValue(kGCQueueDepth);
+  stats::StatsManager::addValue(kGCPendingBytes, garbage.bytes);
   // do not bother folly
   queue_.enqueue(std::move(garbage));
 }
 
+bool GC::overloaded() const {
+  return FLAGS_gc_max_pending_bytes > 0 && pendingBytes() > FLAGS_gc_max_pending_bytes;
+}
+
+folly::SemiFuture<folly::Unit> GC::waitForRelease(std::chrono::milliseconds timeout) {
+  uint64_t id = 0;
+  folly::SemiFuture<folly::Unit> future = folly::makeSemiFuture();
+  {
+    std::lock_guard<std::mutex> l(lock_);
+    if (!overloaded()) {
+      return future;
+    }
+    id = nextWaiterId_++;
+    future = waiters_[id].getSemiFuture();
+  }
+  return std::move(future).within(timeout).defer([this, id](folly::Try<folly::Unit>&& t) {
+    if (t.hasException()) {
+      std::lock_guard<std::mutex> l(lock_);
+      waiters_.erase(id);
+    }
+    return std::move(t).value();
+  });
+}
+
 void GC::periodicTask() {
-  while (!queue_.empty()) {
-    queue_.try_dequeue();
+  memory::MemoryCheckOffGuard guard;
+  while (auto garbage = queue_.try_dequeue()) {
+    stats::StatsManager::decValue(kGCQueueDepth);
+    release(std::move(garbage).value());
+  }
+}
+
+void GC::release(Garbage&& garbage) {
+  DCHECK_GT(FLAGS_gc_chunk_rows, 0);
+  if (garbage.result.has_value()) {
+    auto value = garbage.result->valuePtr();
+    garbage.result.reset();
+    // only split the dataset which is not referenced by others
+    if (value != nullptr && value.use_count() == 1 && value->isDataSet() &&
+        value->getDataSet().rows.size() > FLAGS_gc_chunk_rows) {
+      split(std::move(garbage), std::move(value->mutableDataSet().rows));
+      return;
+    }
+    // free the result before it's accounted as released
+    value.reset();
+  }
+  garbage.rows.clear();
+  garbage.rows.shrink_to_fit();
+  released(garbage);
+}
+
+void GC::split(Garbage&& garbage, std::vector<Row>&& rows) {
+  size_t numRows = rows.size();
+  size_t bytesLeft = garbage.bytes;
+  std::vector<Garbage> chunks;
+  for (size_t start = 0; start < numRows; start += FLAGS_gc_chunk_rows) {
+    size_t end = std::min<size_t>(start + FLAGS_gc_chunk_rows, numRows);
+    Garbage chunk;
+    chunk.duration = garbage.duration;
+    chunk.bytes = end == numRows ? bytesLeft : garbage.bytes / numRows * (end - start);
+    bytesLeft -= chunk.bytes;
+    chunk.rows.reserve(end - start);
+    chunk.rows.insert(chunk.rows.end(),
+                      std::make_move_iterator(rows.begin() + start),
+                      std::make_move_iterator(rows.begin() + end));
+    chunks.emplace_back(std::move(chunk));
+  }
+  // free the emptied rows before any chunk is accounted as released by other workers
+  rows.clear();
+  rows.shrink_to_fit();
+  for (auto& chunk : chunks) {
+    // the chunks are accounted already, just hand them to other workers
+    stats::StatsManager::addValue(kGCQueueDepth);
+    queue_.enqueue(std::move(chunk));
+  }
+}
+
+void GC::released(const Garbage& garbage) {
+  pendingBytes_.fetch_sub(garbage.bytes, std::memory_order_relaxed);
+  stats::StatsManager::decValue(kGCPendingBytes, garbage.bytes);
+  stats::StatsManager::addValue(kGCReleaseLatencyUs, garbage.duration.elapsedInUSec());
+  std::unordered_map<uint64_t, folly::Promise<folly::Unit>> waiters;
+  {
+    std::lock_guard<std::mutex> l(lock_);
+    if (!waiters_.empty() && !overloaded()) {
+      waiters.swap(waiters_);
+    }
+  }
+  for (auto& waiter : waiters) {
+    waiter.second.setValue();
   }
 }
 
@@ -5,8 +5,12 @@
 #ifndef GRAPH_GC_H_
 #define GRAPH_GC_H_
 
+#include <folly/futures/Future.h>
+#include <gtest/gtest_prod.h>
+
 #include "common/base/Base.h"
 #include "common/thread/GenericThreadPool.h"
+#include "common/time/Duration.h"
 #include "graph/context/Result.h"
 
 namespace nebula {
@@ -15,7 +19,15 @@ namespace graph {
 // Clean the unused memory on background threads, this is helpful
 // for big queries since the memory release of interim results may
 // cost too much time.
+//
+// The size of each result is estimated when it is queued, so the bytes pending release are known
+// in total. A dataset with more than FLAGS_gc_chunk_rows rows is split into chunks which are
+// released by several workers in parallel. When the pending bytes exceed
+// FLAGS_gc_max_pending_bytes, new queries wait for the release before they start.
 class GC {
+  FRIEND_TEST(GCTest, WaitForRelease);
+  FRIEND_TEST(GCTest, WaitTimeout);
+
  public:
   static GC& instance();
 
@@ -25,11 +37,41 @@ class GC {
 
   void clear(std::vector<Result>&& garbage);
 
+  size_t pendingBytes() const {
+    return pendingBytes_.load(std::memory_order_relaxed);
+  }
+
+  // Whether the pending bytes exceed FLAGS_gc_max_pending_bytes
+  bool overloaded() const;
+
+  // Fulfilled when the GC is not overloaded, or with FutureTimeout after timeout. A waiter which
+  // times out is dropped.
+  folly::SemiFuture<folly::Unit> waitForRelease(std::chrono::milliseconds timeout);
+
  private:
+  struct Garbage {
+    size_t bytes{0};
+    // since the garbage is queued
+    time::Duration duration;
+    std::optional<Result> result;
+    // a chunk of the rows of a large dataset
+    std::vector<Row> rows;
+  };
+
   GC();
   void periodicTask();
-  folly::UMPMCQueue<std::vector<Result>, false> queue_;
+  void enqueue(Garbage&& garbage);
+  void release(Garbage&& garbage);
+  void split(Garbage&& garbage, std::vector<Row>&& rows);
+  void released(const Garbage& garbage);
+
+  folly::UMPMCQueue<Garbage, false> queue_;
   thread::GenericThreadPool workers_;
+
+  std::atomic<size_t> pendingBytes_{0};
+  std::mutex lock_;
+  uint64_t nextWaiterId_{0};
+  std::unordered_map<uint64_t, folly::Promise<folly::Unit>> waiters_;
 };
 }  // namespace graph
 }  // namespace nebula
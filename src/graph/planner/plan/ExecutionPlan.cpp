@@ -9,6 +9,7 @@
 #include "graph/planner/plan/Logic.h"
 #include "graph/planner/plan/PlanNode.h"
 #include "graph/planner/plan/Query.h"
+#include "graph/util/ExpressionUtils.h"
 #include "graph/util/IdGenerator.h"
 #include "interface/gen-cpp2/graph_types.h"
 
@@ -40,6 +41,10 @@ uint64_t ExecutionPlan::makePlanNodeDesc(const PlanNode* node) {
   planDescription_->planNodeDescs.emplace_back(std::move(*node->explain()));
   auto& planNodeDesc = planDescription_->planNodeDescs.back();
   planNodeDesc.profiles = std::make_unique<std::vector<ProfilingStats>>();
+  auto rows = estimateRows(node);
+  if (rows.has_value()) {
+    PlanNode::addDescription("estimatedRows", folly::to<std::string>(*rows), &planNodeDesc);
+  }
 
   if (node->kind() == PlanNode::Kind::kSelect) {
     auto select = static_cast<const Select*>(node);
@@ -75,6 +80,98 @@ void ExecutionPlan::setPlanNodeDeps(const PlanNode* node, PlanNodeDescription* p
   planNodeDesc->dependencies = std::move(deps);
 }
 
+std::optional<int64_t> ExecutionPlan::estimateRows(const PlanNode* node) {
+  auto found = estimatedRows_.find(node->id());
+  if (found != estimatedRows_.end()) {
+    return found->second;
+  }
+
+  auto input = [this, node](size_t i) -> std::optional<int64_t> {
+    return node->numDeps() > i ? estimateRows(node->dep(i)) : std::nullopt;
+  };
+  // The constant count of the node if it's given, which is not negative
+  auto constant = [](const Expression* expr, auto getCount) -> std::optional<int64_t> {
+    if (expr == nullptr || !ExpressionUtils::isEvaluableExpr(expr)) {
+      return std::nullopt;
+    }
+    auto count = getCount();
+    return count < 0 ? std::nullopt : std::make_optional<int64_t>(count);
+  };
+  auto min = [](std::optional<int64_t> a, std::optional<int64_t> b) -> std::optional<int64_t> {
+    if (a.has_value() && b.has_value()) {
+      return std::min(*a, *b);
+    }
+    return a.has_value() ? a : b;
+  };
+
+  // There are no statistics of the data, so only the bounds known from the plan itself are given,
+  // e.g. the limits, and the nodes which don't output more rows than their input.
+  std::optional<int64_t> rows;
+  switch (node->kind()) {
+    case PlanNode::Kind::kLimit: {
+      auto limit = static_cast<const Limit*>(node);
+      rows = min(constant(limit->countExpr(), [limit]() { return limit->count(); }), input(0));
+      break;
+    }
+    case PlanNode::Kind::kTopN:
+      rows = min(static_cast<const TopN*>(node)->count(), input(0));
+      break;
+    case PlanNode::Kind::kSample: {
+      auto sample = static_cast<const Sample*>(node);
+      rows = min(constant(sample->countExpr(), [sample]() { return sample->count(); }), input(0));
+      break;
+    }
+    case PlanNode::Kind::kProject:
+    case PlanNode::Kind::kSort:
+    case PlanNode::Kind::kFilter:
+    case PlanNode::Kind::kDedup:
+    case PlanNode::Kind::kIntersect:
+    case PlanNode::Kind::kMinus:
+      rows = input(0);
+      break;
+    case PlanNode::Kind::kAggregate:
+      rows = static_cast<const Aggregate*>(node)->groupKeys().empty() ? 1 : input(0);
+      break;
+    case PlanNode::Kind::kUnion: {
+      auto left = input(0), right = input(1);
+      if (left.has_value() && right.has_value()) {
+        rows = *left + *right;
+      }
+      break;
+    }
+    case PlanNode::Kind::kGetVertices:
+    case PlanNode::Kind::kGetEdges:
+    case PlanNode::Kind::kAppendVertices: {
+      // One row for each input row at most
+      auto explore = static_cast<const Explore*>(node);
+      auto limit = constant(explore->limitExpr(), [explore]() { return explore->limit(); });
+      rows = min(limit, input(0));
+      break;
+    }
+    case PlanNode::Kind::kIndexScan:
+    case PlanNode::Kind::kTagIndexFullScan:
+    case PlanNode::Kind::kTagIndexPrefixScan:
+    case PlanNode::Kind::kTagIndexRangeScan:
+    case PlanNode::Kind::kEdgeIndexFullScan:
+    case PlanNode::Kind::kEdgeIndexPrefixScan:
+    case PlanNode::Kind::kEdgeIndexRangeScan:
+    case PlanNode::Kind::kScanVertices:
+    case PlanNode::Kind::kScanEdges: {
+      auto explore = static_cast<const Explore*>(node);
+      rows = constant(explore->limitExpr(), [explore]() { return explore->limit(); });
+      break;
+    }
+    default:
+      break;
+  }
+  // The explore nodes take the max int64 as no limit
+  if (rows.has_value() && *rows == std::numeric_limits<int64_t>::max()) {
+    rows = std::nullopt;
+  }
+  estimatedRows_.emplace(node->id(), rows);
+  return rows;
+}
+
 void ExecutionPlan::describe(PlanDescription* planDesc) {
   planDescription_ = DCHECK_NOTNULL(planDesc);
   planDescription_->optimize_time_in_us = optimizeTimeInUs_;
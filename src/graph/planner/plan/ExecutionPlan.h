@@ -6,7 +6,9 @@
 #ifndef GRAPH_PLANNER_PLAN_EXECUTIONPLAN_H_
 #define GRAPH_PLANNER_PLAN_EXECUTIONPLAN_H_
 
+#include <optional>
 #include <string>
+#include <unordered_map>
 
 namespace nebula {
 
@@ -65,6 +67,8 @@ class ExecutionPlan final {
   uint64_t makePlanNodeDesc(const PlanNode* node);
   void descBranchInfo(const PlanNode* node, bool isDoBranch, int64_t id);
   void setPlanNodeDeps(const PlanNode* dep, PlanNodeDescription* planNodeDesc) const;
+  // Upper bound of the rows output by the node, estimated from the constant limits of the plan
+  std::optional<int64_t> estimateRows(const PlanNode* node);
 
   int32_t optimizeTimeInUs_{0};
   int64_t id_{-1};
@@ -72,6 +76,8 @@ class ExecutionPlan final {
   // plan description for explain and profile query
   PlanDescription* planDescription_{nullptr};
   std::string explainFormat_;
+  // plan node id -> estimated rows
+  std::unordered_map<int64_t, std::optional<int64_t>> estimatedRows_;
 };
 
 }  // namespace graph
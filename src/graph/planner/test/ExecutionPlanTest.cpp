@@ -7,6 +7,7 @@
 #include <folly/stop_watch.h>
 #include <gtest/gtest.h>
 
+#include "common/graph/Response.h"
 #include "graph/context/QueryContext.h"
 #include "graph/executor/ExecutionError.h"
 #include "graph/executor/Executor.h"
@@ -44,7 +45,30 @@ class ExecutionPlanTest : public ::testing::Test {
         });
   }
 
+  // The estimated rows of the node in the description of the plan, empty if it's not estimated
+  std::string estimatedRows(const PlanNode* node) {
+    if (desc_ == nullptr) {
+      desc_ = std::make_unique<PlanDescription>();
+      plan_->describe(desc_.get());
+    }
+    const auto& nodeDesc = desc_->planNodeDescs[desc_->nodeIndexMap.at(node->id())];
+    if (nodeDesc.description != nullptr) {
+      for (const auto& pair : *nodeDesc.description) {
+        if (pair.key == "estimatedRows") {
+          return pair.value;
+        }
+      }
+    }
+    return "";
+  }
+
+  ScanVertices* scan(int64_t limit) {
+    auto start = StartNode::make(qctx_.get());
+    return ScanVertices::make(qctx_.get(), start, 1, nullptr, nullptr, false, {}, limit);
+  }
+
  protected:
+  std::unique_ptr<PlanDescription> desc_;
   folly::stop_watch<> watch_;
   ExecutionPlan* plan_;
   std::unique_ptr<QueryContext> qctx_;
@@ -118,6 +142,52 @@ TEST_F(ExecutionPlanTest, TestMultiOutputsInLoop) {
   run();
 }
 
+TEST_F(ExecutionPlanTest, TestEstimateRowsOfScan) {
+  auto limited = scan(100);
+  auto unlimited = scan(-1);
+  plan_->setRoot(Union::make(qctx_.get(), limited, unlimited));
+
+  EXPECT_EQ("100", estimatedRows(limited));
+  // Nothing is known of the data without the limit
+  EXPECT_EQ("", estimatedRows(unlimited));
+  EXPECT_EQ("", estimatedRows(plan_->root()));
+}
+
+TEST_F(ExecutionPlanTest, TestEstimateRowsOfFilter) {
+  auto input = scan(100);
+  auto filter = Filter::make(qctx_.get(), input, nullptr);
+  auto project = Project::make(qctx_.get(), filter, nullptr);
+  plan_->setRoot(project);
+
+  // No more rows than the input
+  EXPECT_EQ("100", estimatedRows(filter));
+  EXPECT_EQ("100", estimatedRows(project));
+}
+
+TEST_F(ExecutionPlanTest, TestEstimateRowsOfLimit) {
+  auto smaller = Limit::make(qctx_.get(), scan(100), 0, 10);
+  auto larger = Limit::make(qctx_.get(), scan(100), 0, 1000);
+  auto unlimited = Limit::make(qctx_.get(), scan(-1), 0, 10);
+  auto left = Union::make(qctx_.get(), smaller, larger);
+  plan_->setRoot(Union::make(qctx_.get(), left, unlimited));
+
+  EXPECT_EQ("10", estimatedRows(smaller));
+  EXPECT_EQ("100", estimatedRows(larger));
+  EXPECT_EQ("10", estimatedRows(unlimited));
+  EXPECT_EQ("110", estimatedRows(left));
+  EXPECT_EQ("120", estimatedRows(plan_->root()));
+}
+
+TEST_F(ExecutionPlanTest, TestEstimateRowsOfJoin) {
+  auto join = HashInnerJoin::make(qctx_.get(), scan(100), scan(10));
+  auto limit = Limit::make(qctx_.get(), join, 0, 5);
+  plan_->setRoot(limit);
+
+  // The rows of a join depend on the data even if its inputs are limited
+  EXPECT_EQ("", estimatedRows(join));
+  EXPECT_EQ("5", estimatedRows(limit));
+}
+
 }  // namespace graph
 }  // namespace nebula
 
@@ -0,0 +1,236 @@
+// Copyright (c) 2022 vesoft inc. All rights reserved.
+//
+// This source code is licensed under Apache 2.0 License.
+
+#include "graph/service/AdmissionController.h"
+
+#include "common/memory/MemoryTracker.h"
+#include "common/memory/MemoryUtils.h"
+#include "common/stats/StatsManager.h"
+#include "graph/context/QueryContext.h"
+#include "graph/planner/plan/Algo.h"
+#include "graph/planner/plan/ExecutionPlan.h"
+#include "graph/planner/plan/Logic.h"
+#include "graph/planner/plan/Query.h"
+#include "graph/stats/GraphStats.h"
+
+DEFINE_uint32(max_running_queries_per_space,
+              0,
+              "Max queries running in a space at the same time, 0 means unlimited.");
+DEFINE_uint32(max_running_queries_per_user,
+              0,
+              "Max queries running of a user at the same time, 0 means unlimited.");
+DEFINE_uint32(max_queued_queries,
+              1000,
+              "Max queries waiting for admission, new queries are rejected when it's reached.");
+DEFINE_uint32(admission_queue_timeout_ms,
+              10000,
+              "Max milliseconds a query waits for admission, it fails after that.");
+DEFINE_double(admission_memory_ratio,
+              0.8,
+              "Heavy queries run one by one when the memory used ratio reaches it.");
+DEFINE_double(admission_heavy_query_cost,
+              1e6,
+              "Queries whose estimated fan-out reaches it are heavy.");
+DEFINE_uint32(admission_default_degree,
+              10,
+              "The degree of a vertex assumed when estimating the fan-out of a query.");
+
+namespace nebula {
+namespace graph {
+
+// steps of a variable length expansion without upper bound
+static constexpr size_t kMaxEstimatedSteps = 16;
+static constexpr double kMaxCost = 1e18;
+static constexpr size_t kCheckQueueIntervalMs = 100;
+
+AdmissionController::~AdmissionController() {
+  if (worker_ != nullptr) {
+    worker_->stop();
+    worker_->wait();
+  }
+}
+
+Status AdmissionController::init() {
+  worker_ = std::make_unique<thread::GenericWorker>();
+  if (!worker_->start("graph-admission")) {
+    return Status::Error("Fail to start the admission worker.");
+  }
+  worker_->addRepeatTask(kCheckQueueIntervalMs, &AdmissionController::checkQueue, this);
+  return Status::OK();
+}
+
+double AdmissionController::estimateCost(const ExecutionPlan* plan) {
+  double degree = FLAGS_admission_default_degree;
+  auto fanOut = [degree](size_t steps) {
+    return std::pow(degree, std::min(steps, kMaxEstimatedSteps));
+  };
+
+  double cost = 0;
+  std::unordered_set<const PlanNode*> visited;
+  std::vector<const PlanNode*> stack{plan->root()};
+  while (!stack.empty()) {
+    auto* node = stack.back();
+    stack.pop_back();
+    if (node == nullptr || !visited.emplace(node).second) {
+      continue;
+    }
+    switch (node->kind()) {
+      case PlanNode::Kind::kGetNeighbors:
+        cost += fanOut(1);
+        break;
+      case PlanNode::Kind::kTraverse:
+        cost += fanOut(static_cast<const Traverse*>(node)->stepRange().max());
+        break;
+      case PlanNode::Kind::kExpand:
+      case PlanNode::Kind::kExpandAll:
+        cost += fanOut(static_cast<const Expand*>(node)->maxSteps());
+        break;
+      case PlanNode::Kind::kShortestPath:
+        cost += fanOut(static_cast<const ShortestPath*>(node)->stepRange().max());
+        break;
+      case PlanNode::Kind::kAllPaths:
+        cost += fanOut(static_cast<const AllPaths*>(node)->steps());
+        break;
+      case PlanNode::Kind::kBFSShortest:
+        cost += fanOut(static_cast<const BFSShortestPath*>(node)->steps());
+        break;
+      case PlanNode::Kind::kMultiShortestPath:
+        cost += fanOut(static_cast<const MultiShortestPath*>(node)->steps());
+        break;
+      case PlanNode::Kind::kSubgraph:
+        cost += fanOut(static_cast<const Subgraph*>(node)->steps());
+        break;
+      case PlanNode::Kind::kLoop:
+        stack.emplace_back(static_cast<const Loop*>(node)->body());
+        break;
+      case PlanNode::Kind::kSelect:
+        stack.emplace_back(static_cast<const Select*>(node)->then());
+        stack.emplace_back(static_cast<const Select*>(node)->otherwise());
+        break;
+      default:
+        break;
+    }
+    for (auto* dep : node->dependencies()) {
+      stack.emplace_back(dep);
+    }
+  }
+  return std::min(cost, kMaxCost);
+}
+
+bool AdmissionController::isHeavy(double cost) {
+  return cost >= FLAGS_admission_heavy_query_cost;
+}
+
+folly::SemiFuture<Status> AdmissionController::admit(const Ticket& ticket) {
+  std::lock_guard<std::mutex> l(lock_);
+  if (canRunLocked(ticket, memoryPressure())) {
+    runLocked(ticket);
+    return folly::makeSemiFuture<Status>(Status::OK());
+  }
+  if (queue_.size() >= FLAGS_max_queued_queries) {
+    stats::StatsManager::addValue(kNumRejectedQueries);
+    return folly::makeSemiFuture<Status>(
+        Status::Error("Too many queries waiting for admission: %zu", queue_.size()));
+  }
+  stats::StatsManager::addValue(kNumQueuedQueries);
+  queue_.emplace_back(Waiter{ticket, time::Duration(), folly::Promise<Status>()});
+  return queue_.back().promise.getSemiFuture();
+}
+
+void AdmissionController::release(const Ticket& ticket) {
+  {
+    std::lock_guard<std::mutex> l(lock_);
+    running_--;
+    if (ticket.heavy) {
+      heavyRunning_--;
+    }
+    if (--spaceRunning_[ticket.space] == 0) {
+      spaceRunning_.erase(ticket.space);
+    }
+    if (--userRunning_[ticket.user] == 0) {
+      userRunning_.erase(ticket.user);
+    }
+  }
+  checkQueue();
+}
+
+size_t AdmissionController::numRunning() const {
+  std::lock_guard<std::mutex> l(lock_);
+  return running_;
+}
+
+size_t AdmissionController::numQueued() const {
+  std::lock_guard<std::mutex> l(lock_);
+  return queue_.size();
+}
+
+bool AdmissionController::memoryPressure() {
+  auto& memoryStats = memory::MemoryStats::instance();
+  return memory::MemoryUtils::kHitMemoryHighWatermark.load() ||
+         (memoryStats.getLimit() > 0 && memoryStats.usedRatio() >= FLAGS_admission_memory_ratio);
+}
+
+bool AdmissionController::canRunLocked(const Ticket& ticket, bool pressure) const {
+  auto running = [](const auto& map, const std::string& key) -> size_t {
+    auto iter = map.find(key);
+    return iter == map.end() ? 0 : iter->second;
+  };
+  if (FLAGS_max_running_queries_per_space > 0 &&
+      running(spaceRunning_, ticket.space) >= FLAGS_max_running_queries_per_space) {
+    return false;
+  }
+  if (FLAGS_max_running_queries_per_user > 0 &&
+      running(userRunning_, ticket.user) >= FLAGS_max_running_queries_per_user) {
+    return false;
+  }
+  return !(ticket.heavy && pressure && heavyRunning_ > 0);
+}
+
+void AdmissionController::runLocked(const Ticket& ticket) {
+  running_++;
+  if (ticket.heavy) {
+    heavyRunning_++;
+  }
+  spaceRunning_[ticket.space]++;
+  userRunning_[ticket.user]++;
+}
+
+void AdmissionController::checkQueue() {
+  std::vector<std::pair<folly::Promise<Status>, Status>> done;
+  {
+    std::lock_guard<std::mutex> l(lock_);
+    if (queue_.empty()) {
+      return;
+    }
+    auto pressure = memoryPressure();
+    for (auto iter = queue_.begin(); iter != queue_.end();) {
+      auto& waiter = *iter;
+      auto waitMs = waiter.duration.elapsedInMSec();
+      if (waiter.ticket.qctx != nullptr && waiter.ticket.qctx->isKilled()) {
+        done.emplace_back(std::move(waiter.promise), Status::Error("Execution had been killed"));
+      } else if (canRunLocked(waiter.ticket, pressure)) {
+        runLocked(waiter.ticket);
+        done.emplace_back(std::move(waiter.promise), Status::OK());
+      } else if (waitMs >= FLAGS_admission_queue_timeout_ms) {
+        stats::StatsManager::addValue(kNumRejectedQueries);
+        done.emplace_back(std::move(waiter.promise),
+                          Status::Error("Query waited for admission more than %ums",
+                                        FLAGS_admission_queue_timeout_ms));
+      } else {
+        ++iter;
+        continue;
+      }
+      stats::StatsManager::decValue(kNumQueuedQueries);
+      stats::StatsManager::addValue(kAdmissionWaitLatencyUs, waiter.duration.elapsedInUSec());
+      iter = queue_.erase(iter);
+    }
+  }
+  // fulfill out of the lock, the query may start on this thread
+  for (auto& [promise, status] : done) {
+    promise.setValue(std::move(status));
+  }
+}
+
+}  // namespace graph
+}  // namespace nebula
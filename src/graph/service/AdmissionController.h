@@ -0,0 +1,99 @@
+// Copyright (c) 2022 vesoft inc. All rights reserved.
+//
+// This source code is licensed under Apache 2.0 License.
+
+#ifndef GRAPH_SERVICE_ADMISSIONCONTROLLER_H_
+#define GRAPH_SERVICE_ADMISSIONCONTROLLER_H_
+
+#include <folly/futures/Future.h>
+#include <gtest/gtest_prod.h>
+
+#include <boost/core/noncopyable.hpp>
+
+#include "common/base/Base.h"
+#include "common/base/Status.h"
+#include "common/thread/GenericWorker.h"
+#include "common/time/Duration.h"
+
+namespace nebula {
+namespace graph {
+
+class ExecutionPlan;
+class QueryContext;
+
+// Admits queries to run by the concurrency slots of their space and user, and by the memory
+// pressure. A query which could not run now waits in the queue until a slot is released or the
+// pressure is gone. It fails when it has waited for FLAGS_admission_queue_timeout_ms, or at once
+// when FLAGS_max_queued_queries queries are waiting already.
+//
+// The cost of a query is the expected fan-out of its expansions estimated from the plan, i.e.
+// FLAGS_admission_default_degree ^ steps of each expansion. A query is heavy when its cost
+// reaches FLAGS_admission_heavy_query_cost. Under memory pressure, i.e. the memory tracker used
+// ratio reaches FLAGS_admission_memory_ratio or the system memory hits the high watermark, only
+// one heavy query runs at a time, so that heavy queries of a burst finish one after another
+// instead of failing together. Light queries are not held by the memory pressure.
+//
+// It is thread safe.
+class AdmissionController final : public boost::noncopyable {
+  FRIEND_TEST(AdmissionControllerTest, Slots);
+  FRIEND_TEST(AdmissionControllerTest, MemoryPressure);
+  FRIEND_TEST(AdmissionControllerTest, Timeout);
+
+ public:
+  struct Ticket {
+    std::string space;
+    std::string user;
+    bool heavy{false};
+    // The queued query is dropped once it's killed, could be null
+    const QueryContext* qctx{nullptr};
+  };
+
+  AdmissionController() = default;
+  ~AdmissionController();
+
+  // Start the background worker which expires the queued queries
+  Status init();
+
+  // Expected fan-out of the plan
+  static double estimateCost(const ExecutionPlan* plan);
+
+  static bool isHeavy(double cost);
+
+  // Fulfilled with OK once the query is admitted, then the ticket must be released when the query
+  // finishes. Fulfilled with an error when the query is rejected, killed or times out.
+  folly::SemiFuture<Status> admit(const Ticket& ticket);
+
+  void release(const Ticket& ticket);
+
+  size_t numRunning() const;
+
+  size_t numQueued() const;
+
+ private:
+  struct Waiter {
+    Ticket ticket;
+    time::Duration duration;
+    folly::Promise<Status> promise;
+  };
+
+  static bool memoryPressure();
+
+  bool canRunLocked(const Ticket& ticket, bool pressure) const;
+
+  void runLocked(const Ticket& ticket);
+
+  // Admit the queued queries which could run now, and fail the expired ones
+  void checkQueue();
+
+  mutable std::mutex lock_;
+  std::unordered_map<std::string, size_t> spaceRunning_;
+  std::unordered_map<std::string, size_t> userRunning_;
+  size_t running_{0};
+  size_t heavyRunning_{0};
+  std::list<Waiter> queue_;
+  std::unique_ptr<thread::GenericWorker> worker_;
+};
+
+}  // namespace graph
+}  // namespace nebula
+#endif  // GRAPH_SERVICE_ADMISSIONCONTROLLER_H_
@@ -50,6 +50,9 @@ DEFINE_string(auth_type,
 DEFINE_string(cloud_http_url, "", "cloud http url including ip, port, url path");
 DEFINE_uint32(max_allowed_statements, 512, "Max allowed sequential statements");
 DEFINE_uint32(max_allowed_query_size, 4194304, "Max allowed sequential query size");
+DEFINE_uint32(stream_chunk_rows,
+              10000,
+              "Max rows of a chunk of the result streamed by executeStream, 0 means no limit");
 
 DEFINE_int64(max_allowed_connections,
              std::numeric_limits<int64_t>::max(),
@@ -110,5 +113,23 @@ DEFINE_uint32(
     gc_worker_size,
     0,
     "Background garbage clean workers, default number is 0 which means using hardware core size.");
+DEFINE_uint64(gc_max_pending_bytes,
+              8UL * 1024 * 1024 * 1024,
+              "New queries wait for the async gc when the bytes pending release exceed it, 0 means "
+              "never wait.");
+DEFINE_uint32(gc_admission_max_wait_ms,
+              1000,
+              "Max milliseconds a new query waits for the async gc, it starts anyway after that.");
+DEFINE_uint32(gc_chunk_rows,
+              100000,
+              "Datasets with more rows are split into chunks which are released in parallel.");
+static bool ValidateGCChunkRows(const char* flagname, uint32_t value) {
+  if (value > 0) {
+    return true;
+  }
+  FLOG_WARN("Invalid value for --%s: %u, it should be greater than 0\n", flagname, value);
+  return false;
+}
+DEFINE_validator(gc_chunk_rows, &ValidateGCChunkRows);
 
 DEFINE_bool(graph_use_vertex_key, false, "whether allow insert or query the vertex key");
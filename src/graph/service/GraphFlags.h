@@ -27,6 +27,7 @@ DECLARE_string(udf_path);
 DECLARE_bool(local_config);
 DECLARE_bool(accept_partial_success);
 DECLARE_bool(disable_octal_escape_char);
+DECLARE_uint32(stream_chunk_rows);
 
 DECLARE_bool(redirect_stdout);
 DECLARE_string(stdout_log_file);
@@ -70,6 +71,9 @@ DECLARE_int32(max_job_size);
 
 DECLARE_bool(enable_async_gc);
 DECLARE_uint32(gc_worker_size);
+DECLARE_uint64(gc_max_pending_bytes);
+DECLARE_uint32(gc_admission_max_wait_ms);
+DECLARE_uint32(gc_chunk_rows);
 
 DECLARE_bool(graph_use_vertex_key);
 
@@ -11,6 +11,7 @@
 
 #include "clients/storage/StorageClient.h"
 #include "common/base/Base.h"
+#include "common/graph/JsonWriter.h"
 #include "common/memory/MemoryTracker.h"
 #include "common/stats/StatsManager.h"
 #include "common/time/Duration.h"
@@ -19,6 +20,7 @@
 #include "graph/service/GraphFlags.h"
 #include "graph/service/PasswordAuthenticator.h"
 #include "graph/service/RequestContext.h"
+#include "graph/service/ResultStreamer.h"
 #include "graph/stats/GraphStats.h"
 #include "version/Version.h"
 
@@ -147,8 +149,17 @@ folly::Future<ExecutionResponse> GraphService::future_executeWithParameter(
     int64_t sessionId,
     const std::string& query,
     const std::unordered_map<std::string, Value>& parameterMap) {
+  return executeImpl(sessionId, query, parameterMap);
+}
+
+folly::Future<ExecutionResponse> GraphService::executeImpl(
+    int64_t sessionId,
+    const std::string& query,
+    const std::unordered_map<std::string, Value>& parameterMap,
+    folly::CancellationToken cancelToken) {
   auto ctx = std::make_unique<RequestContext<ExecutionResponse>>();
   ctx->setQuery(query);
+  ctx->setCancelToken(std::move(cancelToken));
   ctx->setRunner(getThreadManager());
   ctx->setSessionMgr(sessionManager_.get());
   auto future = ctx->future();
@@ -214,10 +225,26 @@ folly::Future<std::string> GraphService::future_executeJsonWithParameter(
     const std::string& query,
     const std::unordered_map<std::string, Value>& parameterMap) {
   return future_executeWithParameter(sessionId, query, parameterMap).thenValue([](auto&& resp) {
-    return folly::toJson(resp.toJson());
+    return JsonWriter::toJson(resp);
   });
 }
 
+apache::thrift::ServerStream<ExecutionResponse> GraphService::executeStream(
+    int64_t sessionId,
+    const std::string& query,
+    const std::unordered_map<std::string, Value>& parameterMap) {
+  auto streamAndStreamer = ResultStreamer::create();
+  auto streamer = std::move(streamAndStreamer.second);
+  auto cancelToken = streamer->cancelToken();
+  executeImpl(sessionId, query, parameterMap, std::move(cancelToken))
+      .thenValue([streamer](ExecutionResponse&& resp) { streamer->publish(std::move(resp)); })
+      .thenError([streamer](folly::exception_wrapper&& ew) {
+        LOG(ERROR) << "Execute streaming query failed: " << ew.what();
+        streamer->publishError(ew.what().toStdString());
+      });
+  return std::move(streamAndStreamer.first);
+}
+
 Status GraphService::auth(const std::string& username, const std::string& password) {
   auto metaClient = queryEngine_->metaClient();
 
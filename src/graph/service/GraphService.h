@@ -48,6 +48,11 @@ class GraphService final : public cpp2::GraphServiceSvIf {
   folly::Future<std::string> future_executeJson(int64_t sessionId,
                                                 const std::string& stmt) override;
 
+  apache::thrift::ServerStream<ExecutionResponse> executeStream(
+      int64_t sessionId,
+      const std::string& stmt,
+      const std::unordered_map<std::string, Value>& parameterMap) override;
+
   folly::Future<cpp2::VerifyClientVersionResp> future_verifyClientVersion(
       const cpp2::VerifyClientVersionReq& req) override;
 
@@ -56,6 +61,13 @@ class GraphService final : public cpp2::GraphServiceSvIf {
  private:
   Status auth(const std::string& username, const std::string& password);
 
+  // Executes the query, which is killed once the cancelToken is requested.
+  folly::Future<ExecutionResponse> executeImpl(
+      int64_t sessionId,
+      const std::string& stmt,
+      const std::unordered_map<std::string, Value>& parameterMap,
+      folly::CancellationToken cancelToken = folly::CancellationToken());
+
   std::unique_ptr<GraphSessionManager> sessionManager_;
   std::unique_ptr<QueryEngine> queryEngine_;
 };
@@ -6,14 +6,17 @@
 #include "graph/service/QueryEngine.h"
 
 #include "common/base/Base.h"
+#include "common/function/FunctionUdfManager.h"
 #include "common/memory/MemoryUtils.h"
 #include "common/meta/ServerBasedIndexManager.h"
 #include "common/meta/ServerBasedSchemaManager.h"
 #include "graph/context/QueryContext.h"
+#include "graph/gc/GC.h"
 #include "graph/optimizer/OptRule.h"
 #include "graph/planner/PlannersRegister.h"
 #include "graph/service/GraphFlags.h"
 #include "graph/service/QueryInstance.h"
+#include "graph/stats/GraphStats.h"
 #include "version/Version.h"
 
 DECLARE_bool(local_config);
@@ -26,6 +29,7 @@ namespace graph {
 
 Status QueryEngine::init(std::shared_ptr<folly::IOThreadPoolExecutor> ioExecutor,
                          meta::MetaClient* metaClient) {
+  ioExecutor_ = ioExecutor;
   metaClient_ = metaClient;
   schemaManager_ = meta::ServerBasedSchemaManager::create(metaClient_);
   indexManager_ = meta::ServerBasedIndexManager::create(metaClient_);
@@ -34,6 +38,11 @@ Status QueryEngine::init(std::shared_ptr<folly::IOThreadPoolExecutor> ioExecutor
 
   PlannersRegister::registerPlanners();
 
+  // Load the UDFs before any query, since the aggregate ones are resolved by the parser
+  if (FLAGS_enable_udf) {
+    FunctionUdfManager::instance();
+  }
+
   // Set default optimizer rules
   std::vector<const opt::RuleSet*> rulesets{&opt::RuleSet::DefaultRules()};
   if (FLAGS_enable_optimizer) {
@@ -42,6 +51,9 @@ Status QueryEngine::init(std::shared_ptr<folly::IOThreadPoolExecutor> ioExecutor
   }
   optimizer_ = std::make_unique<opt::Optimizer>(rulesets);
 
+  admission_ = std::make_unique<AdmissionController>();
+  NG_RETURN_IF_ERROR(admission_->init());
+
   return setupMemoryMonitorThread();
 }
 
@@ -53,7 +65,16 @@ void QueryEngine::execute(RequestContextPtr rctx) {
                                              storage_.get(),
                                              metaClient_,
                                              charsetInfo_);
-  auto* instance = new QueryInstance(std::move(qctx), optimizer_.get());
+  auto* instance = new QueryInstance(std::move(qctx), optimizer_.get(), admission_.get());
+  if (FLAGS_enable_async_gc && GC::instance().overloaded()) {
+    // backpressure, wait for the memory of finished queries to be released
+    stats::StatsManager::addValue(kNumGCAdmissionWaits);
+    GC::instance()
+        .waitForRelease(std::chrono::milliseconds(FLAGS_gc_admission_max_wait_ms))
+        .via(ioExecutor_.get())
+        .thenTry([instance](auto&&) { instance->execute(); });
+    return;
+  }
   instance->execute();
 }
 
@@ -18,6 +18,7 @@
 #include "common/meta/SchemaManager.h"
 #include "common/network/NetworkUtils.h"
 #include "graph/optimizer/Optimizer.h"
+#include "graph/service/AdmissionController.h"
 #include "graph/service/RequestContext.h"
 #include "interface/gen-cpp2/GraphService.h"
 
@@ -52,6 +53,8 @@ class QueryEngine final : public boost::noncopyable, public cpp::NonMovable {
   std::unique_ptr<storage::StorageClient> storage_;
   std::unique_ptr<opt::Optimizer> optimizer_;
   std::unique_ptr<thread::GenericWorker> memoryMonitorThread_;
+  std::unique_ptr<AdmissionController> admission_;
+  std::shared_ptr<folly::IOThreadPoolExecutor> ioExecutor_;
   meta::MetaClient* metaClient_{nullptr};
   CharsetInfo* charsetInfo_{nullptr};
 };
@@ -5,6 +5,8 @@
 
 #include "graph/service/QueryInstance.h"
 
+#include <folly/executors/InlineExecutor.h>
+
 #include "common/base/Base.h"
 #include "common/stats/StatsManager.h"
 #include "common/time/ScopedTimer.h"
@@ -29,9 +31,12 @@ using nebula::opt::RuleSet;
 namespace nebula {
 namespace graph {
 
-QueryInstance::QueryInstance(std::unique_ptr<QueryContext> qctx, Optimizer *optimizer) {
+QueryInstance::QueryInstance(std::unique_ptr<QueryContext> qctx,
+                             Optimizer *optimizer,
+                             AdmissionController *admission) {
   qctx_ = std::move(qctx);
   optimizer_ = DCHECK_NOTNULL(optimizer);
+  admission_ = admission;
   scheduler_ = std::make_unique<AsyncMsgNotifyBasedScheduler>(qctx_.get());
   qctx_->rctx()->session()->addQuery(qctx_.get());
 }
@@ -50,20 +55,11 @@ void QueryInstance::execute() {
       return;
     }
 
-    // The execution engine converts the physical execution plan generated by the Planner into a
-    // series of Executors through the Scheduler to drive the execution of the Executors.
-    scheduler_->schedule()
-        .thenValue([this](Status s) {
-          if (s.ok()) {
-            this->onFinish();
-          } else {
-            this->onError(std::move(s));
-          }
-        })
-        .thenError(folly::tag_t<ExecutionError>{},
-                   [this](const ExecutionError &e) { onError(e.status()); })
-        .thenError(folly::tag_t<std::exception>{},
-                   [this](const std::exception &e) { onError(Status::Error("%s", e.what())); });
+    if (admission_ == nullptr) {
+      schedule();
+    } else {
+      admitAndSchedule();
+    }
   } catch (std::bad_alloc &e) {
     onError(Status::GraphMemoryExceeded(
         "(%d)", static_cast<int32_t>(nebula::cpp2::ErrorCode::E_GRAPH_MEMORY_EXCEEDED)));
@@ -74,6 +70,59 @@ void QueryInstance::execute() {
   }
 }
 
+void QueryInstance::admitAndSchedule() {
+  auto *rctx = qctx()->rctx();
+  auto cost = AdmissionController::estimateCost(qctx_->plan());
+  ticket_.space = rctx->session()->space().name;
+  ticket_.user = rctx->session()->user();
+  ticket_.heavy = AdmissionController::isHeavy(cost);
+  ticket_.qctx = qctx_.get();
+  VLOG(1) << "Estimated cost: " << cost << ", query: " << rctx->query();
+
+  auto epId = qctx_->plan()->id();
+  auto future = admission_->admit(ticket_);
+  if (!future.isReady()) {
+    rctx->session()->setQueryStatus(epId, meta::cpp2::QueryStatus::QUEUED);
+  }
+  auto *runner = rctx->runner() != nullptr ? rctx->runner() : &folly::InlineExecutor::instance();
+  std::move(future)
+      .via(runner)
+      .thenValue([this, epId](Status s) {
+        if (!s.ok()) {
+          onError(std::move(s));
+          return;
+        }
+        admitted_ = true;
+        qctx_->rctx()->session()->setQueryStatus(epId, meta::cpp2::QueryStatus::RUNNING);
+        schedule();
+      })
+      .thenError(folly::tag_t<std::bad_alloc>{},
+                 [this](const std::bad_alloc &) {
+                   onError(Status::GraphMemoryExceeded(
+                       "(%d)",
+                       static_cast<int32_t>(nebula::cpp2::ErrorCode::E_GRAPH_MEMORY_EXCEEDED)));
+                 })
+      .thenError(folly::tag_t<std::exception>{},
+                 [this](const std::exception &e) { onError(Status::Error("%s", e.what())); });
+}
+
+void QueryInstance::schedule() {
+  // The execution engine converts the physical execution plan generated by the Planner into a
+  // series of Executors through the Scheduler to drive the execution of the Executors.
+  scheduler_->schedule()
+      .thenValue([this](Status s) {
+        if (s.ok()) {
+          this->onFinish();
+        } else {
+          this->onError(std::move(s));
+        }
+      })
+      .thenError(folly::tag_t<ExecutionError>{},
+                 [this](const ExecutionError &e) { onError(e.status()); })
+      .thenError(folly::tag_t<std::exception>{},
+                 [this](const std::exception &e) { onError(Status::Error("%s", e.what())); });
+}
+
 Status QueryInstance::validateAndOptimize() {
   auto *rctx = qctx()->rctx();
   auto &spaceName = rctx->session()->space().name;
@@ -130,6 +179,7 @@ void QueryInstance::onFinish() {
   rctx->resp().spaceName = std::make_unique<std::string>(spaceName);
 
   fillRespData(&rctx->resp());
+  fillJsonPlan(&rctx->resp());
 
   auto latency = rctx->duration().elapsedInUSec();
   rctx->resp().latencyInUs = latency;
@@ -138,6 +188,10 @@ void QueryInstance::onFinish() {
 
   rctx->session()->deleteQuery(qctx_.get());
   scheduler_->waitFinish();
+  releaseReadSnapshots();
+  if (admitted_) {
+    admission_->release(ticket_);
+  }
   // The `QueryInstance' is the root node holding all resources during the
   // execution. When the whole query process is done, it's safe to release this
   // object, as long as no other contexts have chances to access these resources
@@ -208,6 +262,10 @@ void QueryInstance::onError(Status status) {
   addSlowQueryStats(latency, spaceName);
   rctx->session()->deleteQuery(qctx_.get());
   rctx->finish();
+  releaseReadSnapshots();
+  if (admitted_) {
+    admission_->release(ticket_);
+  }
   delete this;
 }
 
@@ -230,6 +288,22 @@ void QueryInstance::addSlowQueryStats(uint64_t latency, const std::string &space
   }
 }
 
+void QueryInstance::releaseReadSnapshots() {
+  auto *storage = qctx_->getStorageClient();
+  if (storage == nullptr || qctx_->plan() == nullptr) return;
+  auto sessionId = qctx_->rctx()->session()->id();
+  auto planId = qctx_->plan()->id();
+  // Not waited for, the snapshots left behind are released by the storaged once expired
+  storage->releaseReadSnapshots(sessionId, planId)
+      .via(&folly::InlineExecutor::instance())
+      .thenValue([sessionId, planId](auto &&resp) {
+        if (!resp.succeeded()) {
+          LOG(WARNING) << "Failed to release the read snapshots of the plan " << planId
+                       << " of the session " << sessionId;
+        }
+      });
+}
+
 // Get result from query context and fill the response
 void QueryInstance::fillRespData(ExecutionResponse *resp) {
   auto ectx = DCHECK_NOTNULL(qctx_->ectx());
@@ -251,6 +325,15 @@ void QueryInstance::fillRespData(ExecutionResponse *resp) {
   }
 }
 
+void QueryInstance::fillJsonPlan(ExecutionResponse *resp) {
+  if (resp->planDesc == nullptr || resp->planDesc->format != "json") return;
+  // The plan with the estimated rows and the profiling stats of each node, for the tools which
+  // compare the estimations against the actual rows
+  DataSet ds({"plan"});
+  ds.emplace_back(Row({folly::toJson(resp->planDesc->toJson())}));
+  resp->data = std::make_unique<DataSet>(std::move(ds));
+}
+
 // The entry point of the optimizer
 Status QueryInstance::findBestPlan() {
   auto plan = qctx_->plan();
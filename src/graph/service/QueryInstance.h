@@ -12,6 +12,7 @@
 #include "common/cpp/helpers.h"
 #include "graph/context/QueryContext.h"
 #include "graph/optimizer/Optimizer.h"
+#include "graph/service/AdmissionController.h"
 #include "graph/scheduler/Scheduler.h"
 #include "parser/GQLParser.h"
 
@@ -26,7 +27,9 @@ namespace graph {
 
 class QueryInstance final : public boost::noncopyable, public cpp::NonMovable {
  public:
-  QueryInstance(std::unique_ptr<QueryContext> qctx, opt::Optimizer* optimizer);
+  QueryInstance(std::unique_ptr<QueryContext> qctx,
+                opt::Optimizer* optimizer,
+                AdmissionController* admission = nullptr);
   ~QueryInstance() = default;
 
   // Entrance of the Validate, Optimize, Schedule, Execute process
@@ -51,17 +54,28 @@ class QueryInstance final : public boost::noncopyable, public cpp::NonMovable {
    */
   void onError(Status);
 
+  // Wait for the admission, then schedule the executors
+  void admitAndSchedule();
+  void schedule();
+
   Status validateAndOptimize();
   // Return true if continue to execute
   bool explainOrContinue();
   void addSlowQueryStats(uint64_t latency, const std::string& spaceName) const;
+  // Ask the storaged to release the snapshots taken for the snapshot reads of the plan
+  void releaseReadSnapshots();
   void fillRespData(ExecutionResponse* resp);
+  // Replace the data by the plan description in json if it is asked by FORMAT="json"
+  void fillJsonPlan(ExecutionResponse* resp);
   Status findBestPlan();
 
   std::unique_ptr<Sentence> sentence_;
   std::unique_ptr<QueryContext> qctx_;
   std::unique_ptr<Scheduler> scheduler_;
   opt::Optimizer* optimizer_{nullptr};
+  AdmissionController* admission_{nullptr};
+  AdmissionController::Ticket ticket_;
+  bool admitted_{false};
 };
 
 }  // namespace graph
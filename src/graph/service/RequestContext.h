@@ -5,6 +5,8 @@
 
 #ifndef GRAPH_REQUESTCONTEXT_H_
 #define GRAPH_REQUESTCONTEXT_H_
+#include <folly/CancellationToken.h>
+
 #include <boost/core/noncopyable.hpp>
 
 #include "common/base/Base.h"
@@ -98,6 +100,15 @@ class RequestContext final : public boost::noncopyable, public cpp::NonMovable {
     return parameterMap_;
   }
 
+  void setCancelToken(folly::CancellationToken token) {
+    cancelToken_ = std::move(token);
+  }
+
+  // Whether the client has given up the response, e.g. cancelled the result stream
+  bool isCancelled() const {
+    return cancelToken_.isCancellationRequested();
+  }
+
  private:
   time::Duration duration_;
   std::string query_;
@@ -107,6 +118,7 @@ class RequestContext final : public boost::noncopyable, public cpp::NonMovable {
   folly::Executor* runner_{nullptr};
   GraphSessionManager* sessionMgr_{nullptr};
   std::unordered_map<std::string, Value> parameterMap_;
+  folly::CancellationToken cancelToken_;
 };
 
 }  // namespace graph
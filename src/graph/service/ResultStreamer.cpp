@@ -0,0 +1,98 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "graph/service/ResultStreamer.h"
+
+#include "graph/service/GraphFlags.h"
+
+namespace nebula {
+namespace graph {
+
+// static
+std::pair<ResultStreamer::Stream, std::shared_ptr<ResultStreamer>> ResultStreamer::create() {
+  folly::CancellationSource cancelSource;
+  auto completed = std::make_shared<std::atomic<bool>>(false);
+  // Called when the stream is completed by the streamer or cancelled by the client
+  auto streamAndPublisher = Stream::createPublisher([cancelSource, completed]() {
+    if (!completed->load()) {
+      VLOG(1) << "Result stream cancelled by the client, kill the query";
+      cancelSource.requestCancellation();
+    }
+  });
+  std::shared_ptr<ResultStreamer> streamer(new ResultStreamer(
+      std::move(streamAndPublisher.second), std::move(cancelSource), std::move(completed)));
+  return std::make_pair(std::move(streamAndPublisher.first), std::move(streamer));
+}
+
+ResultStreamer::~ResultStreamer() {
+  if (!completed_->load()) {
+    LOG(WARNING) << "Result stream is completed without any response";
+    complete();
+  }
+}
+
+void ResultStreamer::publish(ExecutionResponse&& resp) {
+  if (completed_->load()) {
+    return;
+  }
+  auto chunks = split(std::move(resp), FLAGS_stream_chunk_rows);
+  for (auto& chunk : chunks) {
+    if (cancelSource_.isCancellationRequested()) {
+      break;
+    }
+    publisher_.next(std::move(chunk));
+  }
+  complete();
+}
+
+void ResultStreamer::publishError(const std::string& errorMsg) {
+  if (completed_->load()) {
+    return;
+  }
+  ExecutionResponse resp;
+  resp.errorCode = ErrorCode::E_EXECUTION_ERROR;
+  resp.errorMsg = std::make_unique<std::string>(errorMsg);
+  publisher_.next(std::move(resp));
+  complete();
+}
+
+void ResultStreamer::complete() {
+  if (!completed_->exchange(true)) {
+    std::move(publisher_).complete();
+  }
+}
+
+// static
+std::vector<ExecutionResponse> ResultStreamer::split(ExecutionResponse&& resp, size_t chunkRows) {
+  std::vector<ExecutionResponse> chunks;
+  if (resp.data == nullptr || chunkRows == 0 || resp.data->rows.size() <= chunkRows) {
+    chunks.emplace_back(std::move(resp));
+    return chunks;
+  }
+
+  auto data = std::move(resp.data);
+  auto& rows = data->rows;
+  chunks.reserve((rows.size() - 1) / chunkRows + 1);
+  for (size_t begin = 0; begin < rows.size(); begin += chunkRows) {
+    auto end = std::min(begin + chunkRows, rows.size());
+    auto chunkData = std::make_unique<DataSet>(data->colNames);
+    chunkData->rows.reserve(end - begin);
+    std::move(rows.begin() + begin, rows.begin() + end, std::back_inserter(chunkData->rows));
+    if (begin == 0) {
+      resp.data = std::move(chunkData);
+      chunks.emplace_back(std::move(resp));
+    } else {
+      ExecutionResponse chunk;
+      chunk.errorCode = chunks.front().errorCode;
+      chunk.latencyInUs = chunks.front().latencyInUs;
+      chunk.data = std::move(chunkData);
+      chunks.emplace_back(std::move(chunk));
+    }
+  }
+  return chunks;
+}
+
+}  // namespace graph
+}  // namespace nebula
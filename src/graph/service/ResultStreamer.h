@@ -0,0 +1,73 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef GRAPH_SERVICE_RESULTSTREAMER_H_
+#define GRAPH_SERVICE_RESULTSTREAMER_H_
+
+#include <folly/CancellationToken.h>
+#include <thrift/lib/cpp2/async/ServerStream.h>
+
+#include "common/base/Base.h"
+#include "common/graph/Response.h"
+
+namespace nebula {
+namespace graph {
+
+/**
+ * ResultStreamer delivers the response of a query to the client by a server stream of chunks.
+ *
+ * The first chunk carries everything of the response, e.g. the error code, the space name and the
+ * plan description, and the following chunks only carry the rows with the column names. Each
+ * chunk has at most FLAGS_stream_chunk_rows rows moved out of the result, and it's serialized
+ * when the client requests it by the credits of the stream, so that the result is never
+ * serialized into one buffer. A result fitting in one chunk is the same as the one of execute.
+ *
+ * The query is killed if the client cancels the stream before it's completed.
+ */
+class ResultStreamer final {
+ public:
+  using Stream = apache::thrift::ServerStream<ExecutionResponse>;
+  using Publisher = apache::thrift::ServerStreamPublisher<ExecutionResponse>;
+
+  // Creates the stream returned to the client, and the streamer publishing to it.
+  static std::pair<Stream, std::shared_ptr<ResultStreamer>> create();
+
+  // The token checked by the query, it's requested when the client cancels the stream.
+  folly::CancellationToken cancelToken() const {
+    return cancelSource_.getToken();
+  }
+
+  // Completes the stream if nothing is published, a stream left uncompleted aborts the process.
+  ~ResultStreamer();
+
+  // Publishes the response in chunks, then completes the stream.
+  void publish(ExecutionResponse&& resp);
+
+  // Publishes an error response of the failed query, then completes the stream.
+  void publishError(const std::string& errorMsg);
+
+  // Splits the response into chunks of at most chunkRows rows.
+  static std::vector<ExecutionResponse> split(ExecutionResponse&& resp, size_t chunkRows);
+
+ private:
+  ResultStreamer(Publisher&& publisher,
+                 folly::CancellationSource cancelSource,
+                 std::shared_ptr<std::atomic<bool>> completed)
+      : publisher_(std::move(publisher)),
+        cancelSource_(std::move(cancelSource)),
+        completed_(std::move(completed)) {}
+
+  // Completes the stream, only the first call takes effect
+  void complete();
+
+  Publisher publisher_;
+  folly::CancellationSource cancelSource_;
+  // Shared with the callback of the stream, to tell a cancel from the completion
+  std::shared_ptr<std::atomic<bool>> completed_;
+};
+
+}  // namespace graph
+}  // namespace nebula
+#endif  // GRAPH_SERVICE_RESULTSTREAMER_H_
@@ -0,0 +1,105 @@
+// Copyright (c) 2022 vesoft inc. All rights reserved.
+//
+// This source code is licensed under Apache 2.0 License.
+
+#include <gtest/gtest.h>
+
+#include "common/memory/MemoryUtils.h"
+#include "graph/context/QueryContext.h"
+#include "graph/planner/plan/ExecutionPlan.h"
+#include "graph/planner/plan/Logic.h"
+#include "graph/planner/plan/Query.h"
+#include "graph/service/AdmissionController.h"
+
+DECLARE_uint32(max_running_queries_per_user);
+DECLARE_uint32(admission_queue_timeout_ms);
+DECLARE_uint32(admission_default_degree);
+
+namespace nebula {
+namespace graph {
+
+TEST(AdmissionControllerTest, EstimateCost) {
+  FLAGS_admission_default_degree = 10;
+  QueryContext qctx;
+  auto* start = StartNode::make(&qctx);
+  auto* expand = Expand::make(&qctx, start, 1, false, 3);
+  auto* body = GetNeighbors::make(&qctx, StartNode::make(&qctx), 1);
+  auto* loop = Loop::make(&qctx, expand, body);
+  qctx.plan()->setRoot(loop);
+  // 10^3 of the expand and 10 of the get neighbors in the loop body
+  EXPECT_DOUBLE_EQ(1010, AdmissionController::estimateCost(qctx.plan()));
+}
+
+TEST(AdmissionControllerTest, Slots) {
+  FLAGS_max_running_queries_per_user = 1;
+  AdmissionController admission;
+  AdmissionController::Ticket a{"nba", "root", false, nullptr};
+  AdmissionController::Ticket b{"nba", "root", false, nullptr};
+  AdmissionController::Ticket c{"nba", "user", false, nullptr};
+
+  auto fa = admission.admit(a);
+  ASSERT_TRUE(fa.isReady());
+  EXPECT_TRUE(std::move(fa).get().ok());
+  auto fb = admission.admit(b);
+  EXPECT_FALSE(fb.isReady());
+  auto fc = admission.admit(c);
+  ASSERT_TRUE(fc.isReady());
+  EXPECT_EQ(2, admission.numRunning());
+  EXPECT_EQ(1, admission.numQueued());
+
+  admission.release(a);
+  ASSERT_TRUE(fb.isReady());
+  EXPECT_TRUE(std::move(fb).get().ok());
+  EXPECT_EQ(2, admission.numRunning());
+  EXPECT_EQ(0, admission.numQueued());
+  admission.release(b);
+  admission.release(c);
+  EXPECT_EQ(0, admission.numRunning());
+  FLAGS_max_running_queries_per_user = 0;
+}
+
+TEST(AdmissionControllerTest, MemoryPressure) {
+  memory::MemoryUtils::kHitMemoryHighWatermark.store(true);
+  AdmissionController admission;
+  AdmissionController::Ticket heavy1{"nba", "root", true, nullptr};
+  AdmissionController::Ticket heavy2{"nba", "root", true, nullptr};
+  AdmissionController::Ticket light{"nba", "root", false, nullptr};
+
+  auto f1 = admission.admit(heavy1);
+  ASSERT_TRUE(f1.isReady());
+  // heavy queries run one by one
+  auto f2 = admission.admit(heavy2);
+  EXPECT_FALSE(f2.isReady());
+  auto f3 = admission.admit(light);
+  ASSERT_TRUE(f3.isReady());
+
+  admission.release(heavy1);
+  ASSERT_TRUE(f2.isReady());
+  EXPECT_TRUE(std::move(f2).get().ok());
+  admission.release(heavy2);
+  admission.release(light);
+  memory::MemoryUtils::kHitMemoryHighWatermark.store(false);
+}
+
+TEST(AdmissionControllerTest, Timeout) {
+  FLAGS_max_running_queries_per_user = 1;
+  FLAGS_admission_queue_timeout_ms = 0;
+  AdmissionController admission;
+  AdmissionController::Ticket a{"nba", "root", false, nullptr};
+  AdmissionController::Ticket b{"nba", "root", false, nullptr};
+
+  auto fa = admission.admit(a);
+  ASSERT_TRUE(fa.isReady());
+  auto fb = admission.admit(b);
+  EXPECT_FALSE(fb.isReady());
+  admission.checkQueue();
+  ASSERT_TRUE(fb.isReady());
+  EXPECT_FALSE(std::move(fb).get().ok());
+  EXPECT_EQ(0, admission.numQueued());
+  admission.release(a);
+  FLAGS_max_running_queries_per_user = 0;
+  FLAGS_admission_queue_timeout_ms = 10000;
+}
+
+}  // namespace graph
+}  // namespace nebula
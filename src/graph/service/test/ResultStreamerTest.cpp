@@ -0,0 +1,66 @@
+// Copyright (c) 2022 vesoft inc. All rights reserved.
+//
+// This source code is licensed under Apache 2.0 License.
+
+#include <gtest/gtest.h>
+
+#include "graph/service/ResultStreamer.h"
+
+namespace nebula {
+namespace graph {
+
+static ExecutionResponse makeResponse(size_t numRows) {
+  ExecutionResponse resp;
+  resp.errorCode = ErrorCode::SUCCEEDED;
+  resp.latencyInUs = 100;
+  resp.spaceName = std::make_unique<std::string>("nba");
+  resp.data = std::make_unique<DataSet>(std::vector<std::string>{"id", "name"});
+  for (size_t i = 0; i < numRows; ++i) {
+    resp.data->emplace_back(Row({static_cast<int64_t>(i), std::string("Tim Duncan")}));
+  }
+  return resp;
+}
+
+TEST(ResultStreamerTest, OneChunk) {
+  auto expected = makeResponse(10);
+  auto chunks = ResultStreamer::split(makeResponse(10), 10);
+  ASSERT_EQ(1, chunks.size());
+  EXPECT_EQ(expected, chunks[0]);
+
+  chunks = ResultStreamer::split(makeResponse(10), 0);
+  ASSERT_EQ(1, chunks.size());
+  EXPECT_EQ(expected, chunks[0]);
+
+  // Without data
+  ExecutionResponse resp;
+  resp.errorCode = ErrorCode::E_SYNTAX_ERROR;
+  resp.errorMsg = std::make_unique<std::string>("syntax error");
+  chunks = ResultStreamer::split(std::move(resp), 10);
+  ASSERT_EQ(1, chunks.size());
+  EXPECT_EQ(ErrorCode::E_SYNTAX_ERROR, chunks[0].errorCode);
+  EXPECT_EQ(nullptr, chunks[0].data);
+}
+
+TEST(ResultStreamerTest, Chunks) {
+  auto expected = makeResponse(25);
+  auto chunks = ResultStreamer::split(makeResponse(25), 10);
+  ASSERT_EQ(3, chunks.size());
+
+  // Only the first chunk has the space name
+  ASSERT_NE(nullptr, chunks[0].spaceName);
+  EXPECT_EQ("nba", *chunks[0].spaceName);
+  EXPECT_EQ(nullptr, chunks[1].spaceName);
+
+  DataSet rows;
+  for (auto& chunk : chunks) {
+    EXPECT_EQ(ErrorCode::SUCCEEDED, chunk.errorCode);
+    ASSERT_NE(nullptr, chunk.data);
+    EXPECT_EQ(expected.data->colNames, chunk.data->colNames);
+    EXPECT_LE(chunk.data->rowSize(), 10);
+    ASSERT_TRUE(rows.append(std::move(*chunk.data)));
+  }
+  EXPECT_EQ(*expected.data, rows);
+}
+
+}  // namespace graph
+}  // namespace nebula
@@ -69,6 +69,17 @@ bool ClientSession::findQuery(nebula::ExecutionPlanID epId) const {
   return false;
 }
 
+void ClientSession::setQueryStatus(nebula::ExecutionPlanID epId,
+                                   meta::cpp2::QueryStatus status) {
+  folly::RWSpinLock::WriteHolder wHolder(rwSpinLock_);
+  auto query = session_.queries_ref()->find(epId);
+  if (query == session_.queries_ref()->end() ||
+      query->second.get_status() == meta::cpp2::QueryStatus::KILLING) {
+    return;
+  }
+  query->second.status_ref() = status;
+}
+
 void ClientSession::markQueryKilled(nebula::ExecutionPlanID epId) {
   folly::RWSpinLock::WriteHolder wHolder(rwSpinLock_);
   auto context = contexts_.find(epId);
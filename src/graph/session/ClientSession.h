@@ -153,6 +153,10 @@ class ClientSession final {
   // epId: represents a query.
   bool findQuery(nebula::ExecutionPlanID epId) const;
 
+  // Sets the status of a query, e.g. queued for admission, a killed query keeps KILLING.
+  // epId: represents a query.
+  void setQueryStatus(nebula::ExecutionPlanID epId, meta::cpp2::QueryStatus status);
+
   // Marks a query as killed.
   // epId: represents a query.
   void markQueryKilled(nebula::ExecutionPlanID epId);
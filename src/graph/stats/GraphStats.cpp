@@ -30,6 +30,15 @@ stats::CounterId kNumQueriesHitMemoryWatermark;
 
 stats::CounterId kOptimizerLatencyUs;
 
+stats::CounterId kGCQueueDepth;
+stats::CounterId kGCPendingBytes;
+stats::CounterId kGCReleaseLatencyUs;
+stats::CounterId kNumGCAdmissionWaits;
+
+stats::CounterId kNumQueuedQueries;
+stats::CounterId kNumRejectedQueries;
+stats::CounterId kAdmissionWaitLatencyUs;
+
 stats::CounterId kNumAggregateExecutors;
 stats::CounterId kNumSortExecutors;
 stats::CounterId kNumIndexScanExecutors;
@@ -60,6 +69,18 @@ void initGraphStats() {
   kOptimizerLatencyUs = stats::StatsManager::registerHisto(
       "optimizer_latency_us", 1000, 0, 2000, "avg, p75, p95, p99, p999");
 
+  kGCQueueDepth = stats::StatsManager::registerStats("gc_queue_depth", "sum");
+  kGCPendingBytes = stats::StatsManager::registerStats("gc_pending_bytes", "sum");
+  kGCReleaseLatencyUs = stats::StatsManager::registerHisto(
+      "gc_release_latency_us", 1000, 0, 2000000, "avg, p75, p95, p99, p999");
+  kNumGCAdmissionWaits =
+      stats::StatsManager::registerStats("num_gc_admission_waits", "rate, sum");
+
+  kNumQueuedQueries = stats::StatsManager::registerStats("num_queued_queries", "sum");
+  kNumRejectedQueries = stats::StatsManager::registerStats("num_rejected_queries", "rate, sum");
+  kAdmissionWaitLatencyUs = stats::StatsManager::registerHisto(
+      "admission_wait_latency_us", 1000, 0, 2000000, "avg, p75, p95, p99, p999");
+
   kNumAggregateExecutors =
       stats::StatsManager::registerStats("num_aggregate_executors", "rate, sum");
   kNumSortExecutors = stats::StatsManager::registerStats("num_sort_executors", "rate, sum");
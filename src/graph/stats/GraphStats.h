@@ -30,6 +30,17 @@ extern stats::CounterId kNumQueriesHitMemoryWatermark;
 
 extern stats::CounterId kOptimizerLatencyUs;
 
+// Async GC
+extern stats::CounterId kGCQueueDepth;
+extern stats::CounterId kGCPendingBytes;
+extern stats::CounterId kGCReleaseLatencyUs;
+extern stats::CounterId kNumGCAdmissionWaits;
+
+// Admission control
+extern stats::CounterId kNumQueuedQueries;
+extern stats::CounterId kNumRejectedQueries;
+extern stats::CounterId kAdmissionWaitLatencyUs;
+
 // Executor
 extern stats::CounterId kNumAggregateExecutors;
 extern stats::CounterId kNumSortExecutors;
@@ -0,0 +1,118 @@
+// Copyright (c) 2022 vesoft inc. All rights reserved.
+//
+// This source code is licensed under Apache 2.0 License.
+
+#ifndef GRAPH_UTIL_PATHTREE_H_
+#define GRAPH_UTIL_PATHTREE_H_
+
+#include <folly/hash/Hash.h>
+
+#include "common/base/Base.h"
+#include "common/datatypes/Edge.h"
+#include "common/datatypes/Value.h"
+
+namespace nebula {
+namespace graph {
+
+// Bloom bit of an edge, an edge and its reverse edge have the same bit, like Edge::keyEqual.
+inline uint64_t edgeBloomBit(const Edge& edge) {
+  bool forward = edge.type > 0;
+  auto hash = folly::hash::hash_combine(std::hash<Value>()(forward ? edge.src : edge.dst),
+                                        std::hash<Value>()(forward ? edge.dst : edge.src),
+                                        forward ? edge.type : -edge.type,
+                                        edge.ranking);
+  return 1UL << (hash & 63);
+}
+
+// Bloom bit of a vid.
+inline uint64_t vidBloomBit(const Value& vid) {
+  return 1UL << (std::hash<Value>()(vid) & 63);
+}
+
+// Paths starting from the same vertex stored as a prefix tree: a path is a node pointing to the
+// path it extends, so paths share their prefixes instead of copying them in each step, and only
+// the paths in the output are converted to lists of values. Each node keeps the bloom bits of all
+// edges of its path, so that most edges could be found not in a path without walking it.
+// The values are referenced, they must outlive the tree.
+class PathTree final {
+ public:
+  static constexpr uint32_t kRoot = std::numeric_limits<uint32_t>::max();
+
+  // Extend path parent by an edge whose src is vertex, return the new path. The src vertex of the
+  // first edge is not kept.
+  uint32_t add(uint32_t parent, const Value* vertex, const Value* edge) {
+    auto bloom = edgeBloomBit(edge->getEdge());
+    uint32_t length = 1;
+    if (parent != kRoot) {
+      bloom |= nodes_[parent].bloom;
+      length += nodes_[parent].length;
+    }
+    nodes_.emplace_back(Node{parent, length, bloom, vertex, edge});
+    return static_cast<uint32_t>(nodes_.size() - 1);
+  }
+
+  // The last edge of path
+  const Value& edge(uint32_t path) const {
+    return *nodes_[path].edge;
+  }
+
+  // Number of edges of path
+  size_t length(uint32_t path) const {
+    return nodes_[path].length;
+  }
+
+  // Whether edge or its reverse edge is in path
+  bool hasEdge(uint32_t path, const Edge& edge) const {
+    if ((nodes_[path].bloom & edgeBloomBit(edge)) == 0) {
+      return false;
+    }
+    for (auto id = path; id != kRoot; id = nodes_[id].parent) {
+      if (nodes_[id].edge->getEdge().keyEqual(edge)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Edges of path from the first one, e.g. [e1, e2, e3]
+  std::vector<Value> edges(uint32_t path) const {
+    std::vector<Value> result(nodes_[path].length);
+    auto iter = result.rbegin();
+    for (auto id = path; id != kRoot; id = nodes_[id].parent) {
+      *iter++ = *nodes_[id].edge;
+    }
+    return result;
+  }
+
+  // Edges and vertices of path from the first edge, e.g. [e1, v1, e2, v2, e3]
+  std::vector<Value> steps(uint32_t path) const {
+    std::vector<Value> result(nodes_[path].length * 2 - 1);
+    auto iter = result.rbegin();
+    for (auto id = path; id != kRoot; id = nodes_[id].parent) {
+      *iter++ = *nodes_[id].edge;
+      if (nodes_[id].parent != kRoot) {
+        *iter++ = *nodes_[id].vertex;
+      }
+    }
+    return result;
+  }
+
+  size_t size() const {
+    return nodes_.size();
+  }
+
+ private:
+  struct Node {
+    uint32_t parent;
+    uint32_t length;
+    uint64_t bloom;
+    const Value* vertex;
+    const Value* edge;
+  };
+
+  std::vector<Node> nodes_;
+};
+
+}  // namespace graph
+}  // namespace nebula
+#endif  // GRAPH_UTIL_PATHTREE_H_
@@ -38,6 +38,10 @@ Status SchemaUtil::validateProps(const std::vector<SchemaPropItem *> &schemaProp
           status = setComment(schemaProp, schema);
           NG_RETURN_IF_ERROR(status);
           break;
+        case SchemaPropItem::ROW_FORMAT:
+          status = setRowFormat(schemaProp, schema);
+          NG_RETURN_IF_ERROR(status);
+          break;
       }
     }
 
@@ -122,6 +126,18 @@ Status SchemaUtil::setComment(SchemaPropItem *schemaProp, meta::cpp2::Schema &sc
   return Status::OK();
 }
 
+// static
+Status SchemaUtil::setRowFormat(SchemaPropItem *schemaProp, meta::cpp2::Schema &schema) {
+  auto ret = schemaProp->getRowFormat();
+  NG_RETURN_IF_ERROR(ret);
+  auto rowFormat = ret.value();
+  if (rowFormat != 2 && rowFormat != 3) {
+    return Status::Error("Row format `%ld' not supported, only 2 or 3", rowFormat);
+  }
+  schema.schema_prop_ref()->row_format_ref() = static_cast<int32_t>(rowFormat);
+  return Status::OK();
+}
+
 // static
 StatusOr<Value> SchemaUtil::toVertexID(Expression *expr, Value::Type vidType) {
   QueryExpressionContext ctx;
@@ -246,6 +262,10 @@ StatusOr<DataSet> SchemaUtil::toShowCreateSchema(bool isTag,
   } else {
     createStr += "\"\"";
   }
+  if (prop.row_format_ref().has_value()) {
+    createStr += ", row_format = ";
+    createStr += folly::to<std::string>(*prop.row_format_ref());
+  }
   if (prop.comment_ref().has_value()) {
     createStr += ", comment = \"";
     createStr += *prop.comment_ref();
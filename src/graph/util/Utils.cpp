@@ -4,6 +4,11 @@
 
 #include "graph/util/Utils.h"
 
+#include "common/datatypes/Edge.h"
+#include "common/datatypes/List.h"
+#include "common/datatypes/Map.h"
+#include "common/datatypes/Set.h"
+#include "common/datatypes/Vertex.h"
 #include "interface/gen-cpp2/storage_types.h"
 
 namespace nebula::graph::util {
@@ -18,7 +23,8 @@ folly::dynamic getStorageDetail(const std::map<std::string, int32_t>& profileDet
 
 folly::dynamic collectRespProfileData(const storage::cpp2::ResponseCommon& resp,
                                       const std::tuple<HostAddr, int32_t, int32_t>& info,
-                                      size_t numVertices) {
+                                      size_t numVertices,
+                                      size_t respBytes) {
   folly::dynamic stat = folly::dynamic::object();
   stat.insert("host", std::get<0>(info).toRawString());
   stat.insert("exec", folly::sformat("{}(us)", std::get<1>(info)));
@@ -26,10 +32,100 @@ folly::dynamic collectRespProfileData(const storage::cpp2::ResponseCommon& resp,
   if (numVertices > 0) {
     stat.insert("vertices", numVertices);
   }
+  if (respBytes > 0) {
+    stat.insert("bytes", respBytes);
+  }
   if (resp.latency_detail_us_ref().has_value()) {
     stat.insert("storage_detail", getStorageDetail(*resp.get_latency_detail_us()));
   }
+  if (resp.profile_counters_ref().has_value()) {
+    folly::dynamic counters = folly::dynamic::object();
+    for (auto& p : *resp.profile_counters_ref()) {
+      counters.insert(p.first, p.second);
+    }
+    stat.insert("storage_counters", std::move(counters));
+  }
   return stat;
 }
 
+namespace {
+
+// Estimate the first maxSamples elements, and scale by the number of elements
+template <typename Container, typename Fn>
+size_t estimateElements(const Container& container, size_t maxSamples, Fn fn) {
+  size_t size = 0;
+  size_t n = 0;
+  for (const auto& elem : container) {
+    if (n == maxSamples) {
+      return n == 0 ? 0 : size / n * container.size();
+    }
+    size += fn(elem);
+    ++n;
+  }
+  return size;
+}
+
+size_t estimateProps(const std::unordered_map<std::string, Value>& props, size_t maxSamples) {
+  return estimateElements(props, maxSamples, [maxSamples](const auto& kv) {
+    return sizeof(kv) + kv.first.size() + estimateSize(kv.second, maxSamples);
+  });
+}
+
+}  // namespace
+
+size_t estimateSize(const Value& value, size_t maxSamples) {
+  size_t size = sizeof(Value);
+  switch (value.type()) {
+    case Value::Type::STRING:
+      size += value.getStr().size();
+      break;
+    case Value::Type::LIST:
+      size += estimateElements(value.getList().values, maxSamples, [maxSamples](const Value& v) {
+        return estimateSize(v, maxSamples);
+      });
+      break;
+    case Value::Type::SET:
+      size += estimateElements(value.getSet().values, maxSamples, [maxSamples](const Value& v) {
+        return estimateSize(v, maxSamples);
+      });
+      break;
+    case Value::Type::MAP:
+      size += estimateProps(value.getMap().kvs, maxSamples);
+      break;
+    case Value::Type::VERTEX: {
+      const auto& vertex = value.getVertex();
+      size += estimateSize(vertex.vid, maxSamples);
+      for (const auto& tag : vertex.tags) {
+        size += sizeof(tag) + tag.name.size() + estimateProps(tag.props, maxSamples);
+      }
+      break;
+    }
+    case Value::Type::EDGE: {
+      const auto& edge = value.getEdge();
+      size += estimateSize(edge.src, maxSamples) + estimateSize(edge.dst, maxSamples) +
+              edge.name.size() + estimateProps(edge.props, maxSamples);
+      break;
+    }
+    case Value::Type::DATASET: {
+      const auto& ds = value.getDataSet();
+      for (const auto& colName : ds.colNames) {
+        size += sizeof(colName) + colName.size();
+      }
+      size += estimateElements(ds.rows, maxSamples, [maxSamples](const Row& row) {
+        return estimateSize(row, maxSamples);
+      });
+      break;
+    }
+    default:
+      break;
+  }
+  return size;
+}
+
+size_t estimateSize(const Row& row, size_t maxSamples) {
+  return sizeof(Row) + estimateElements(row.values, maxSamples, [maxSamples](const Value& v) {
+           return estimateSize(v, maxSamples);
+         });
+}
+
 }  // namespace nebula::graph::util
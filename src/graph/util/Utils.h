@@ -12,7 +12,9 @@
 #include <string>
 #include <vector>
 
+#include "common/datatypes/DataSet.h"
 #include "common/datatypes/HostAddr.h"
+#include "common/datatypes/Value.h"
 
 namespace nebula::storage::cpp2 {
 class ResponseCommon;
@@ -33,9 +35,19 @@ std::string join(const Container& container, Fn fn, const std::string& delimiter
 
 folly::dynamic getStorageDetail(const std::map<std::string, int32_t>& profileDetail);
 
+// Profile of the response of a storage host, respBytes is the size of the response on the wire, 0
+// if it's not measured
 folly::dynamic collectRespProfileData(const storage::cpp2::ResponseCommon& resp,
                                       const std::tuple<HostAddr, int32_t, int32_t>& info,
-                                      size_t numVertices = 0UL);
+                                      size_t numVertices = 0UL,
+                                      size_t respBytes = 0UL);
+
+// Rough number of bytes held by a value. For a dataset or a container with more than maxSamples
+// elements, only the first maxSamples of them are walked and the rest are assumed to be alike.
+size_t estimateSize(const Value& value,
+                    size_t maxSamples = std::numeric_limits<size_t>::max());
+
+size_t estimateSize(const Row& row, size_t maxSamples = std::numeric_limits<size_t>::max());
 
 }  // namespace nebula::graph::util
 
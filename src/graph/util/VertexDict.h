@@ -0,0 +1,141 @@
+// Copyright (c) 2022 vesoft inc. All rights reserved.
+//
+// This source code is licensed under Apache 2.0 License.
+
+#ifndef GRAPH_UTIL_VERTEXDICT_H_
+#define GRAPH_UTIL_VERTEXDICT_H_
+
+#include <folly/Range.h>
+
+#include "common/base/Base.h"
+#include "common/datatypes/Value.h"
+
+namespace nebula {
+namespace graph {
+
+// Per-query dictionary which maps vids to dense ids in the order they are first seen, so that
+// traversal state could be kept in arrays indexed by id instead of hash tables keyed by Value.
+// A vid is hashed once when it comes from storage, and converted back only when building output.
+// It is not thread safe.
+class VertexDict final {
+ public:
+  static constexpr uint32_t kInvalidId = std::numeric_limits<uint32_t>::max();
+
+  // Return the id of vid, assign a new one if it has not been seen.
+  uint32_t getOrAdd(const Value& vid) {
+    auto ret = ids_.emplace(vid, static_cast<uint32_t>(vids_.size()));
+    if (ret.second) {
+      vids_.emplace_back(&ret.first->first);
+    }
+    return ret.first->second;
+  }
+
+  // Return the id of vid, or kInvalidId if it has not been seen.
+  uint32_t find(const Value& vid) const {
+    auto iter = ids_.find(vid);
+    return iter == ids_.end() ? kInvalidId : iter->second;
+  }
+
+  const Value& vid(uint32_t id) const {
+    DCHECK_LT(id, vids_.size());
+    return *vids_[id];
+  }
+
+  size_t size() const {
+    return vids_.size();
+  }
+
+ private:
+  std::unordered_map<Value, uint32_t> ids_;
+  // point to the keys of ids_, which are stable since it is node based
+  std::vector<const Value*> vids_;
+};
+
+// Set of dense ids, e.g. the visited vertices.
+class DenseBitset final {
+ public:
+  bool test(uint32_t id) const {
+    auto word = id >> 6;
+    return word < words_.size() && (words_[word] & (1UL << (id & 63)));
+  }
+
+  // Return true if the id was not in the set.
+  bool set(uint32_t id) {
+    auto word = id >> 6;
+    if (word >= words_.size()) {
+      words_.resize(word + 1, 0);
+    }
+    auto mask = 1UL << (id & 63);
+    if (words_[word] & mask) {
+      return false;
+    }
+    words_[word] |= mask;
+    return true;
+  }
+
+  void clear() {
+    words_.clear();
+  }
+
+ private:
+  std::vector<uint64_t> words_;
+};
+
+// Append-only adjacency list in CSR layout. Neighbors of a vertex come together in a GetNeighbors
+// response, so each expanded vertex takes a contiguous range of one neighbor array, instead of a
+// hash table node and a vector of its own.
+template <typename T>
+class CsrAdjList final {
+ public:
+  struct Neighbor {
+    uint32_t dst;
+    T edge;
+  };
+
+  // Start the neighbors of src, a vertex could only be added once.
+  void addVertex(uint32_t src) {
+    if (src >= ranges_.size()) {
+      ranges_.resize(src + 1, {VertexDict::kInvalidId, VertexDict::kInvalidId});
+    }
+    DCHECK(!contains(src));
+    auto offset = static_cast<uint32_t>(neighbors_.size());
+    ranges_[src] = {offset, offset};
+    last_ = src;
+  }
+
+  // Append a neighbor to the vertex added last.
+  void addNeighbor(uint32_t dst, T edge) {
+    DCHECK_NE(last_, VertexDict::kInvalidId);
+    neighbors_.emplace_back(Neighbor{dst, std::move(edge)});
+    ranges_[last_].second = static_cast<uint32_t>(neighbors_.size());
+  }
+
+  bool contains(uint32_t src) const {
+    return src < ranges_.size() && ranges_[src].first != VertexDict::kInvalidId;
+  }
+
+  // Neighbors of src, the range is invalidated when other vertices are added.
+  folly::Range<const Neighbor*> neighbors(uint32_t src) const {
+    if (!contains(src)) {
+      return {};
+    }
+    auto& range = ranges_[src];
+    return {neighbors_.data() + range.first, neighbors_.data() + range.second};
+  }
+
+  size_t numVertices() const {
+    return std::count_if(ranges_.begin(), ranges_.end(), [](const auto& range) {
+      return range.first != VertexDict::kInvalidId;
+    });
+  }
+
+ private:
+  std::vector<Neighbor> neighbors_;
+  // [begin, end) in neighbors_ of each vertex
+  std::vector<std::pair<uint32_t, uint32_t>> ranges_;
+  uint32_t last_{VertexDict::kInvalidId};
+};
+
+}  // namespace graph
+}  // namespace nebula
+#endif  // GRAPH_UTIL_VERTEXDICT_H_
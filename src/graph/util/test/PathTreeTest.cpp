@@ -0,0 +1,55 @@
+// Copyright (c) 2022 vesoft inc. All rights reserved.
+//
+// This source code is licensed under Apache 2.0 License.
+
+#include <gtest/gtest.h>
+
+#include "common/base/Base.h"
+#include "graph/util/PathTree.h"
+
+namespace nebula {
+namespace graph {
+
+TEST(PathTreeTest, BloomBit) {
+  Edge edge("a", "b", 1, "like", 0, {});
+  Edge reverseEdge("b", "a", -1, "like", 0, {});
+  Edge otherRank("a", "b", 1, "like", 1, {});
+  EXPECT_EQ(edgeBloomBit(edge), edgeBloomBit(reverseEdge));
+  EXPECT_EQ(1, __builtin_popcountll(edgeBloomBit(edge)));
+  EXPECT_EQ(1, __builtin_popcountll(edgeBloomBit(otherRank)));
+  EXPECT_EQ(vidBloomBit(Value("a")), vidBloomBit(Value("a")));
+}
+
+TEST(PathTreeTest, Paths) {
+  // a->b->c->a, a->b->d
+  std::vector<Value> vertices = {Value("a"), Value("b"), Value("c"), Value("d")};
+  std::vector<Value> edges = {Value(Edge("a", "b", 1, "like", 0, {})),
+                              Value(Edge("b", "c", 1, "like", 0, {})),
+                              Value(Edge("c", "a", 1, "like", 0, {})),
+                              Value(Edge("b", "d", 1, "like", 0, {}))};
+  PathTree tree;
+  auto ab = tree.add(PathTree::kRoot, nullptr, &edges[0]);
+  auto abc = tree.add(ab, &vertices[1], &edges[1]);
+  auto abca = tree.add(abc, &vertices[2], &edges[2]);
+  auto abd = tree.add(ab, &vertices[1], &edges[3]);
+  EXPECT_EQ(4, tree.size());
+  EXPECT_EQ(1, tree.length(ab));
+  EXPECT_EQ(3, tree.length(abca));
+  EXPECT_EQ(edges[3], tree.edge(abd));
+
+  EXPECT_EQ(std::vector<Value>({edges[0], edges[1], edges[2]}), tree.edges(abca));
+  EXPECT_EQ(std::vector<Value>({edges[0], vertices[1], edges[1], vertices[2], edges[2]}),
+            tree.steps(abca));
+  EXPECT_EQ(std::vector<Value>({edges[0], vertices[1], edges[3]}), tree.steps(abd));
+  EXPECT_EQ(std::vector<Value>({edges[0]}), tree.steps(ab));
+
+  EXPECT_TRUE(tree.hasEdge(abca, edges[0].getEdge()));
+  EXPECT_TRUE(tree.hasEdge(abca, Edge("b", "a", -1, "like", 0, {})));
+  EXPECT_FALSE(tree.hasEdge(abca, edges[3].getEdge()));
+  // the sibling is not in the path
+  EXPECT_FALSE(tree.hasEdge(abd, edges[1].getEdge()));
+  EXPECT_TRUE(tree.hasEdge(abd, edges[3].getEdge()));
+}
+
+}  // namespace graph
+}  // namespace nebula
@@ -0,0 +1,79 @@
+// Copyright (c) 2022 vesoft inc. All rights reserved.
+//
+// This source code is licensed under Apache 2.0 License.
+
+#include <gtest/gtest.h>
+
+#include "common/base/Base.h"
+#include "graph/util/VertexDict.h"
+
+namespace nebula {
+namespace graph {
+
+TEST(VertexDictTest, Dict) {
+  VertexDict dict;
+  EXPECT_EQ(0, dict.getOrAdd(Value("a")));
+  EXPECT_EQ(1, dict.getOrAdd(Value(1)));
+  EXPECT_EQ(0, dict.getOrAdd(Value("a")));
+  EXPECT_EQ(2, dict.size());
+  EXPECT_EQ(1, dict.find(Value(1)));
+  EXPECT_EQ(VertexDict::kInvalidId, dict.find(Value("b")));
+  EXPECT_EQ(Value("a"), dict.vid(0));
+  EXPECT_EQ(Value(1), dict.vid(1));
+
+  // ids are stable when the dict grows
+  for (int64_t i = 100; i < 1100; i++) {
+    dict.getOrAdd(Value(i));
+  }
+  EXPECT_EQ(Value("a"), dict.vid(0));
+  EXPECT_EQ(Value(1099), dict.vid(1001));
+}
+
+TEST(VertexDictTest, Bitset) {
+  DenseBitset bitset;
+  EXPECT_FALSE(bitset.test(0));
+  EXPECT_TRUE(bitset.set(0));
+  EXPECT_FALSE(bitset.set(0));
+  EXPECT_TRUE(bitset.test(0));
+  EXPECT_FALSE(bitset.test(1000));
+  EXPECT_TRUE(bitset.set(1000));
+  EXPECT_TRUE(bitset.test(1000));
+  EXPECT_FALSE(bitset.test(999));
+  bitset.clear();
+  EXPECT_FALSE(bitset.test(0));
+  EXPECT_FALSE(bitset.test(1000));
+}
+
+TEST(VertexDictTest, CsrAdjList) {
+  CsrAdjList<Value> adjList;
+  EXPECT_FALSE(adjList.contains(0));
+  EXPECT_TRUE(adjList.neighbors(VertexDict::kInvalidId).empty());
+
+  adjList.addVertex(2);
+  adjList.addNeighbor(0, Value("2->0"));
+  adjList.addNeighbor(1, Value("2->1"));
+  // a vertex without neighbors is expanded as well
+  adjList.addVertex(5);
+  adjList.addVertex(0);
+  adjList.addNeighbor(2, Value("0->2"));
+
+  EXPECT_EQ(3, adjList.numVertices());
+  EXPECT_TRUE(adjList.contains(0));
+  EXPECT_FALSE(adjList.contains(1));
+  EXPECT_TRUE(adjList.contains(5));
+  EXPECT_TRUE(adjList.neighbors(5).empty());
+
+  auto neighbors = adjList.neighbors(2);
+  ASSERT_EQ(2, neighbors.size());
+  EXPECT_EQ(0, neighbors[0].dst);
+  EXPECT_EQ(Value("2->0"), neighbors[0].edge);
+  EXPECT_EQ(1, neighbors[1].dst);
+  EXPECT_EQ(Value("2->1"), neighbors[1].edge);
+
+  neighbors = adjList.neighbors(0);
+  ASSERT_EQ(1, neighbors.size());
+  EXPECT_EQ(2, neighbors[0].dst);
+}
+
+}  // namespace graph
+}  // namespace nebula
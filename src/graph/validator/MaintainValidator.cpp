@@ -135,6 +135,16 @@ static StatusOr<meta::cpp2::SchemaProp> validateSchemaProps(
         schemaProp.comment_ref() = comment.value();
         break;
       }
+      case SchemaPropItem::ROW_FORMAT: {
+        auto rowFormat = prop->getRowFormat();
+        NG_RETURN_IF_ERROR(rowFormat);
+        if (rowFormat.value() != 2 && rowFormat.value() != 3) {
+          return Status::SemanticError("Row format `%ld' not supported, only 2 or 3",
+                                       rowFormat.value());
+        }
+        schemaProp.row_format_ref() = static_cast<int32_t>(rowFormat.value());
+        break;
+      }
       default: {
         return Status::SemanticError("Property type not support");
       }
@@ -471,6 +471,9 @@ void DeduceTypeVisitor::visit(FunctionCallExpression *expr) {
     argsTypeList.push_back(type_);
   }
 
+  // resolve the entry point specialized for the deduced types of the arguments
+  expr->bindArgTypes(argsTypeList);
+
   auto funName = expr->name();
   if (funName == "id" || funName == "src" || funName == "dst" || funName == "none_direct_src" ||
       funName == "none_direct_dst") {
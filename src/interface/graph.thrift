@@ -119,6 +119,10 @@ service GraphService {
     // Same as execute(), but response will be a json string
     binary executeJson(1: i64 sessionId, 2: binary stmt)
     binary executeJsonWithParameter(1: i64 sessionId, 2: binary stmt, 3: map<binary, common.Value>(cpp.template = "std::unordered_map") parameterMap)
+    // Same as executeWithParameter(), but the response is streamed in chunks. The first chunk is
+    // the response with the first rows, and each of the following ones only has the data with the
+    // next rows. Cancelling the stream kills the query.
+    stream<ExecutionResponse> executeStream(1: i64 sessionId, 2: binary stmt, 3: map<binary, common.Value>(cpp.template = "std::unordered_map") parameterMap)
     
     VerifyClientVersionResp verifyClientVersion(1: VerifyClientVersionReq req)
 }
@@ -88,6 +88,8 @@ struct SchemaProp {
     1: optional i64      ttl_duration,
     2: optional binary   ttl_col,
     3: optional binary   comment,
+    // Encoding of the rows, 2 if not set, see RowWriterV2 and RowWriterV3
+    4: optional i32      row_format,
 }
 
 struct Schema {
@@ -1070,6 +1072,7 @@ struct ListFTIndexesResp {
 enum QueryStatus {
     RUNNING         = 0x01,
     KILLING         = 0x02,
+    QUEUED          = 0x03,
 } (cpp.enum_strict)
 
 struct QueryDesc {
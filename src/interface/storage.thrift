@@ -25,6 +25,8 @@ struct RequestCommon {
     1: optional common.SessionID session_id,
     2: optional common.ExecutionPlanID plan_id,
     3: optional bool profile_detail,
+    // Serve all reads of the plan on a storaged from the snapshots taken at its first read
+    4: optional bool snapshot_read,
 }
 
 struct PartitionResult {
@@ -41,6 +43,9 @@ struct ResponseCommon {
     // Query latency from storage service
     2: required i64                     latency_in_us,
     3: optional map<string,i32>         latency_detail_us,
+    // Counters of the profiled request, e.g. the inputs and rows of each node of the plan,
+    // and the blocks, cache hits and bytes read from rocksdb
+    4: optional map<string,i64>         profile_counters,
 }
 
 
@@ -680,6 +685,14 @@ struct KVRemoveRequest {
         cpp.template = "std::unordered_map") parts,
 }
 
+// Release the snapshots taken for the snapshot reads of a plan, sent when the query ends
+struct ReleaseReadSnapshotsRequest {
+    // the space read by the plan, all the snapshots of the plan are released regardless of it
+    1: common.GraphSpaceID    space_id,
+    2: common.SessionID       session_id,
+    3: common.ExecutionPlanID plan_id,
+}
+
 service GraphStorageService {
     GetNeighborsResponse getNeighbors(1: GetNeighborsRequest req);
     GetDstBySrcResponse getDstBySrc(1: GetDstBySrcRequest req);
@@ -714,6 +727,8 @@ service GraphStorageService {
     KVGetResponse   get(1: KVGetRequest req);
     ExecResponse    put(1: KVPutRequest req);
     ExecResponse    remove(1: KVRemoveRequest req);
+
+    ExecResponse releaseReadSnapshots(1: ReleaseReadSnapshotsRequest req);
 }
 
 
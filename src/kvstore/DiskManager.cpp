@@ -5,22 +5,32 @@
 
 #include "kvstore/DiskManager.h"
 
+#include "kvstore/stats/KVStats.h"
+
 DEFINE_int32(disk_check_interval_secs, 10, "interval to check free space of data path");
 DEFINE_uint64(minimum_reserved_bytes, 1UL << 30, "minimum reserved bytes of each data path");
+DEFINE_string(cold_data_path,
+              "",
+              "Paths of the cold tier, multi paths should be split by comma. Lower levels of "
+              "rocksdb in data_path are placed here, see rocksdb_hot_tier_levels. Once set, it "
+              "can't be removed or reordered, otherwise rocksdb could not find its sst files. "
+              "Snapshots and backups are refused with it, since rocksdb checkpoints don't "
+              "support more than one path.");
 
 namespace nebula {
 namespace kvstore {
 
 DiskManager::DiskManager(const std::vector<std::string>& dataPaths,
-                         std::shared_ptr<thread::GenericWorker> bgThread)
+                         std::shared_ptr<thread::GenericWorker> bgThread,
+                         const std::vector<std::string>& coldDataPaths)
     : bgThread_(bgThread) {
   try {
     // atomic is not copy-constructible
-    std::vector<std::atomic_uint64_t> freeBytes(dataPaths.size() + 1);
+    std::vector<std::atomic_uint64_t> freeBytes(dataPaths.size() + coldDataPaths.size() + 1);
     Paths* paths = new Paths();
     paths_.store(paths);
     size_t index = 0;
-    for (const auto& path : dataPaths) {
+    auto addPath = [&](const std::string& path, std::vector<boost::filesystem::path>& result) {
       auto absolute = boost::filesystem::absolute(path);
       if (!boost::filesystem::exists(absolute)) {
         if (!boost::filesystem::create_directories(absolute)) {
@@ -31,8 +41,15 @@ DiskManager::DiskManager(const std::vector<std::string>& dataPaths,
       }
       auto canonical = boost::filesystem::canonical(path);
       auto info = boost::filesystem::space(canonical);
-      paths->dataPaths_.emplace_back(std::move(canonical));
+      result.emplace_back(std::move(canonical));
       freeBytes[index++] = info.available;
+    };
+    for (const auto& path : dataPaths) {
+      addPath(path, paths->dataPaths_);
+    }
+    for (const auto& path : coldDataPaths) {
+      addPath(path, paths->coldPaths_);
+      LOG(INFO) << "Cold data path " << paths->coldPaths_.back();
     }
     freeBytes_ = std::move(freeBytes);
   } catch (boost::filesystem::filesystem_error& e) {
@@ -147,21 +164,67 @@ bool DiskManager::hasEnoughSpace(GraphSpaceID spaceId, PartitionID partId) const
   if (partIt == spaceIt->second.end()) {
     return false;
   }
-  return freeBytes_[partIt->second].load(std::memory_order_relaxed) >= FLAGS_minimum_reserved_bytes;
+  if (freeBytes_[partIt->second].load(std::memory_order_relaxed) < FLAGS_minimum_reserved_bytes) {
+    return false;
+  }
+  // compaction would fail when the cold path is full, so reject writes in advance as well
+  if (!paths->coldPaths_.empty()) {
+    auto coldIndex = paths->dataPaths_.size() + partIt->second % paths->coldPaths_.size();
+    return freeBytes_[coldIndex].load(std::memory_order_relaxed) >= FLAGS_minimum_reserved_bytes;
+  }
+  return true;
+}
+
+StatusOr<std::string> DiskManager::coldPath(const std::string& dataPath) const {
+  folly::rcu_reader guard;
+  Paths* paths = paths_.load(std::memory_order_acquire);
+  if (paths->coldPaths_.empty()) {
+    return Status::Error("No cold path");
+  }
+  boost::system::error_code ec;
+  auto canonical = boost::filesystem::canonical(dataPath, ec);
+  if (ec) {
+    return Status::Error("Invalid data path %s", dataPath.c_str());
+  }
+  auto iter = std::find(paths->dataPaths_.begin(), paths->dataPaths_.end(), canonical);
+  if (iter == paths->dataPaths_.end()) {
+    return Status::Error("Data path %s not found", dataPath.c_str());
+  }
+  auto index = iter - paths->dataPaths_.begin();
+  return paths->coldPaths_[index % paths->coldPaths_.size()].string();
 }
 
 void DiskManager::refresh() {
   // refresh the available bytes of each data path, skip the dummy path
   folly::rcu_reader guard;
   Paths* paths = paths_.load(std::memory_order_acquire);
-  for (size_t i = 0; i < paths->dataPaths_.size(); i++) {
+  // free and total bytes of each tier
+  std::map<std::string, std::pair<uint64_t, uint64_t>> tiers;
+  auto refreshPath = [&](const boost::filesystem::path& path, size_t index, const char* tier) {
     boost::system::error_code ec;
-    auto info = boost::filesystem::space(paths->dataPaths_[i], ec);
+    auto info = boost::filesystem::space(path, ec);
     if (!ec) {
-      VLOG(2) << "Refresh filesystem info of " << paths->dataPaths_[i];
-      freeBytes_[i] = info.available;
+      VLOG(2) << "Refresh filesystem info of " << path;
+      freeBytes_[index] = info.available;
+      tiers[tier].first += info.available;
+      tiers[tier].second += info.capacity;
     } else {
-      LOG(WARNING) << "Get filesystem info of " << paths->dataPaths_[i] << " failed";
+      LOG(WARNING) << "Get filesystem info of " << path << " failed";
+    }
+  };
+  for (size_t i = 0; i < paths->dataPaths_.size(); i++) {
+    refreshPath(paths->dataPaths_[i], i, "hot");
+  }
+  for (size_t i = 0; i < paths->coldPaths_.size(); i++) {
+    refreshPath(paths->coldPaths_[i], paths->dataPaths_.size() + i, "cold");
+  }
+  if (kDiskFreeBytes.valid()) {
+    for (const auto& [tier, bytes] : tiers) {
+      stats::StatsManager::addValue(
+          stats::StatsManager::counterWithLabels(kDiskFreeBytes, {{"tier", tier}}), bytes.first);
+      stats::StatsManager::addValue(
+          stats::StatsManager::counterWithLabels(kDiskCapacityBytes, {{"tier", tier}}),
+          bytes.second);
     }
   }
 }
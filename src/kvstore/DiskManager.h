@@ -27,10 +27,15 @@ using SpaceDiskPartsMap =
 
 /**
  * @brief Monitor remaining spaces of each disk
+ *
+ * Data paths are the hot tier, which hold the wal and the upper levels of rocksdb. Paths in
+ * `cold_data_path` are the cold tier, which hold the lower levels of the rocksdb instances in the
+ * data paths. Parts are always placed by data path, each data path is paired with a cold path.
  */
 class DiskManager {
   FRIEND_TEST(DiskManagerTest, AvailableTest);
   FRIEND_TEST(DiskManagerTest, WalNoSpaceTest);
+  FRIEND_TEST(DiskManagerTest, TieredPathTest);
 
  public:
   /**
@@ -38,9 +43,11 @@ class DiskManager {
    *
    * @param dataPaths `data_path` in configuration
    * @param bgThread Background thread to refresh remaining spaces of each data path
+   * @param coldDataPaths `cold_data_path` in configuration, could be empty
    */
   DiskManager(const std::vector<std::string>& dataPaths,
-              std::shared_ptr<thread::GenericWorker> bgThread = nullptr);
+              std::shared_ptr<thread::GenericWorker> bgThread = nullptr,
+              const std::vector<std::string>& coldDataPaths = {});
 
   ~DiskManager();
 
@@ -102,6 +109,16 @@ class DiskManager {
    */
   void getDiskParts(SpaceDiskPartsMap& diskParts) const;
 
+  /**
+   * @brief Canonical cold path paired with the given data path, the i-th data path is paired with
+   * the (i % number of cold paths)-th cold path, so the pair is stable as long as the
+   * configuration is not changed.
+   *
+   * @param dataPath One of `data_path` in configuration
+   * @return StatusOr<std::string> Cold path, or error status if there is no cold path
+   */
+  StatusOr<std::string> coldPath(const std::string& dataPath) const;
+
  private:
   /**
    * @brief Refresh free bytes of data path periodically
@@ -111,6 +128,8 @@ class DiskManager {
   struct Paths {
     // canonical path of data_path flag
     std::vector<boost::filesystem::path> dataPaths_;
+    // canonical path of cold_data_path flag
+    std::vector<boost::filesystem::path> coldPaths_;
     // given a space and data path, return all parts in the path
     std::unordered_map<GraphSpaceID, PartDiskMap> partPath_;
     // the index in dataPaths_ for a given space + part
@@ -121,7 +140,8 @@ class DiskManager {
   std::shared_ptr<thread::GenericWorker> bgThread_;
 
   std::atomic<Paths*> paths_;
-  // free space available to a non-privileged process, in bytes
+  // free space available to a non-privileged process, in bytes, data paths come first and then
+  // cold paths, the last one is a dummy path
   std::vector<std::atomic_uint64_t> freeBytes_;
 
   // lock used to protect partPath_ and partIndex_
@@ -138,11 +138,13 @@ class KVEngine {
    * @param start Start key, inclusive
    * @param end End key, exclusive
    * @param iter Iterator in range [start, end), returns by kv engine
+   * @param snapshot Snapshot from kv engine. nullptr means no snapshot.
    * @return nebula::cpp2::ErrorCode
    */
   virtual nebula::cpp2::ErrorCode range(const std::string& start,
                                         const std::string& end,
-                                        std::unique_ptr<KVIterator>* iter) = 0;
+                                        std::unique_ptr<KVIterator>* iter,
+                                        const void* snapshot = nullptr) = 0;
 
   /**
    * @brief Get all results with 'prefix' str as prefix.
@@ -162,11 +164,13 @@ class KVEngine {
    * @param start Start key, inclusive
    * @param prefix The prefix of keys to iterate
    * @param iter Iterator of keys starts with 'prefix' beginning from 'start', returns by kv engine
+   * @param snapshot Snapshot from kv engine. nullptr means no snapshot.
    * @return nebula::cpp2::ErrorCode
    */
   virtual nebula::cpp2::ErrorCode rangeWithPrefix(const std::string& start,
                                                   const std::string& prefix,
-                                                  std::unique_ptr<KVIterator>* iter) = 0;
+                                                  std::unique_ptr<KVIterator>* iter,
+                                                  const void* snapshot = nullptr) = 0;
 
   /**
    * @brief Scan all keys in kv engine
@@ -162,6 +162,7 @@ class KVStore {
    * @param end End key, exclusive
    * @param iter Iterator in range [start, end), returns by kv engine
    * @param canReadFromFollower
+   * @param snapshot If set, read from snapshot.
    * @return nebula::cpp2::ErrorCode
    */
   virtual nebula::cpp2::ErrorCode range(GraphSpaceID spaceId,
@@ -169,7 +170,8 @@ class KVStore {
                                         const std::string& start,
                                         const std::string& end,
                                         std::unique_ptr<KVIterator>* iter,
-                                        bool canReadFromFollower = false) = 0;
+                                        bool canReadFromFollower = false,
+                                        const void* snapshot = nullptr) = 0;
 
   /**
    * @brief To forbid to pass rvalue via the 'range' parameter.
@@ -179,7 +181,8 @@ class KVStore {
                                         std::string&& start,
                                         std::string&& end,
                                         std::unique_ptr<KVIterator>* iter,
-                                        bool canReadFromFollower = false) = delete;
+                                        bool canReadFromFollower = false,
+                                        const void* snapshot = nullptr) = delete;
 
   /**
    * @brief Get all results with 'prefix' str as prefix.
@@ -218,6 +221,7 @@ class KVStore {
    * @param prefix The prefix of keys to iterate
    * @param iter Iterator of keys starts with 'prefix' beginning from 'start', returns by kv engine
    * @param canReadFromFollower
+   * @param snapshot If set, read from snapshot.
    * @return nebula::cpp2::ErrorCode
    */
   virtual nebula::cpp2::ErrorCode rangeWithPrefix(GraphSpaceID spaceId,
@@ -225,7 +229,8 @@ class KVStore {
                                                   const std::string& start,
                                                   const std::string& prefix,
                                                   std::unique_ptr<KVIterator>* iter,
-                                                  bool canReadFromFollower = false) = 0;
+                                                  bool canReadFromFollower = false,
+                                                  const void* snapshot = nullptr) = 0;
 
   /**
    * @brief To forbid to pass rvalue via the 'rangeWithPrefix' parameter.
@@ -235,7 +240,8 @@ class KVStore {
                                                   std::string&& start,
                                                   std::string&& prefix,
                                                   std::unique_ptr<KVIterator>* iter,
-                                                  bool canReadFromFollower = false) = delete;
+                                                  bool canReadFromFollower = false,
+                                                  const void* snapshot = nullptr) = delete;
 
   /**
    * @brief Synchronize the kvstore across multiple replica
@@ -14,6 +14,7 @@
 #include "common/fs/FileUtils.h"
 #include "common/network/NetworkUtils.h"
 #include "common/time/WallClock.h"
+#include "common/utils/MetaKeyUtils.h"
 #include "common/utils/NebulaKeyUtils.h"
 #include "kvstore/NebulaSnapshotManager.h"
 #include "kvstore/RocksEngine.h"
@@ -27,6 +28,7 @@ DEFINE_bool(auto_remove_invalid_space, true, "whether remove data of invalid spa
 DECLARE_bool(rocksdb_disable_wal);
 DECLARE_int32(rocksdb_backup_interval_secs);
 DECLARE_int32(wal_ttl);
+DECLARE_string(cold_data_path);
 
 namespace nebula {
 namespace kvstore {
@@ -56,7 +58,12 @@ bool NebulaStore::init() {
     LOG(ERROR) << "Start the raft service failed";
     return false;
   }
-  diskMan_.reset(new DiskManager(options_.dataPaths_, storeWorker_));
+  std::vector<std::string> coldPaths;
+  folly::split(",", FLAGS_cold_data_path, coldPaths, true);
+  for (auto& path : coldPaths) {
+    path = folly::trimWhitespace(path).str();
+  }
+  diskMan_.reset(new DiskManager(options_.dataPaths_, storeWorker_, coldPaths));
   // todo(doodle): we could support listener and normal storage start at same
   // instance
   if (!isListener()) {
@@ -361,8 +368,15 @@ folly::Future<std::pair<GraphSpaceID, std::unique_ptr<KVEngine>>> NebulaStore::n
         cfFactory = options_.cffBuilder_->buildCfFactory(spaceId);
       }
       auto vIdLen = getSpaceVidLen(spaceId);
+      std::string coldPath;
+      if (spaceId != kDefaultSpaceId) {
+        auto ret = diskMan_->coldPath(dataPath);
+        if (ret.ok()) {
+          coldPath = std::move(ret).value();
+        }
+      }
       engine = std::make_unique<RocksEngine>(
-          spaceId, vIdLen, dataPath, walPath, options_.mergeOp_, cfFactory);
+          spaceId, vIdLen, dataPath, walPath, options_.mergeOp_, cfFactory, false, coldPath);
     } else {
       LOG(FATAL) << "Unknown engine type " << FLAGS_engine_type;
     }
@@ -517,8 +531,8 @@ std::shared_ptr<Part> NebulaStore::newPart(GraphSpaceID spaceId,
 
 void NebulaStore::removeSpace(GraphSpaceID spaceId) {
   folly::RWSpinLock::WriteHolder wh(&lock_);
-  if (beforeRemoveSpace_) {
-    beforeRemoveSpace_(spaceId);
+  for (auto& func : beforeRemoveSpace_) {
+    func.second(spaceId);
   }
 
   auto spaceIt = this->spaces_.find(spaceId);
@@ -733,13 +747,23 @@ void NebulaStore::updateSpaceOption(GraphSpaceID spaceId,
 }
 
 void NebulaStore::removeSpaceDir(const std::string& dir) {
-  try {
-    LOG(INFO) << "Try to remove space directory: " << dir;
-    boost::filesystem::remove_all(dir);
-    LOG(INFO) << "Space directory removed: " << dir;
-  } catch (const boost::filesystem::filesystem_error& e) {
-    LOG(WARNING) << "Exception caught while remove directory, please delete it by manual: "
-                 << e.what();
+  std::vector<std::string> dirs = {dir};
+  // the space dir is "dataPath/nebula/spaceId", sst files may be in the paired cold path as well
+  auto spaceDir = boost::filesystem::path(dir);
+  auto coldPath = diskMan_->coldPath(spaceDir.parent_path().parent_path().string());
+  if (coldPath.ok()) {
+    dirs.emplace_back(folly::stringPrintf(
+        "%s/nebula/%s", coldPath.value().c_str(), spaceDir.filename().string().c_str()));
+  }
+  for (const auto& d : dirs) {
+    try {
+      LOG(INFO) << "Try to remove space directory: " << d;
+      boost::filesystem::remove_all(d);
+      LOG(INFO) << "Space directory removed: " << d;
+    } catch (const boost::filesystem::filesystem_error& e) {
+      LOG(WARNING) << "Exception caught while remove directory, please delete it by manual: "
+                   << e.what();
+    }
   }
 }
 
@@ -810,7 +834,8 @@ nebula::cpp2::ErrorCode NebulaStore::range(GraphSpaceID spaceId,
                                            const std::string& start,
                                            const std::string& end,
                                            std::unique_ptr<KVIterator>* iter,
-                                           bool canReadFromFollower) {
+                                           bool canReadFromFollower,
+                                           const void* snapshot) {
   auto ret = part(spaceId, partId);
   if (!ok(ret)) {
     return error(ret);
@@ -819,7 +844,7 @@ nebula::cpp2::ErrorCode NebulaStore::range(GraphSpaceID spaceId,
   if (!checkLeader(part, canReadFromFollower)) {
     return nebula::cpp2::ErrorCode::E_LEADER_CHANGED;
   }
-  return part->engine()->range(start, end, iter);
+  return part->engine()->range(start, end, iter, snapshot);
 }
 
 nebula::cpp2::ErrorCode NebulaStore::prefix(GraphSpaceID spaceId,
@@ -844,7 +869,8 @@ nebula::cpp2::ErrorCode NebulaStore::rangeWithPrefix(GraphSpaceID spaceId,
                                                      const std::string& start,
                                                      const std::string& prefix,
                                                      std::unique_ptr<KVIterator>* iter,
-                                                     bool canReadFromFollower) {
+                                                     bool canReadFromFollower,
+                                                     const void* snapshot) {
   auto ret = part(spaceId, partId);
   if (!ok(ret)) {
     return error(ret);
@@ -853,7 +879,7 @@ nebula::cpp2::ErrorCode NebulaStore::rangeWithPrefix(GraphSpaceID spaceId,
   if (!checkLeader(part, canReadFromFollower)) {
     return nebula::cpp2::ErrorCode::E_LEADER_CHANGED;
   }
-  return part->engine()->rangeWithPrefix(start, prefix, iter);
+  return part->engine()->rangeWithPrefix(start, prefix, iter, snapshot);
 }
 
 nebula::cpp2::ErrorCode NebulaStore::sync(GraphSpaceID spaceId, PartitionID partId) {
@@ -249,6 +249,7 @@ class NebulaStore : public KVStore, public Handler {
    * @param end End key, exclusive
    * @param iter Iterator in range [start, end), returns by kv engine
    * @param canReadFromFollower Whether check if current kvstore is leader of given partition
+   * @param snapshot If set, read from snapshot.
    * @return nebula::cpp2::ErrorCode
    */
   nebula::cpp2::ErrorCode range(GraphSpaceID spaceId,
@@ -256,7 +257,8 @@ class NebulaStore : public KVStore, public Handler {
                                 const std::string& start,
                                 const std::string& end,
                                 std::unique_ptr<KVIterator>* iter,
-                                bool canReadFromFollower = false) override;
+                                bool canReadFromFollower = false,
+                                const void* snapshot = nullptr) override;
 
   /**
    * @brief To forbid to pass rvalue via the 'range' parameter.
@@ -266,7 +268,8 @@ class NebulaStore : public KVStore, public Handler {
                                 std::string&& start,
                                 std::string&& end,
                                 std::unique_ptr<KVIterator>* iter,
-                                bool canReadFromFollower = false) override = delete;
+                                bool canReadFromFollower = false,
+                                const void* snapshot = nullptr) override = delete;
 
   /**
    * @brief Get all results with 'prefix' str as prefix.
@@ -304,6 +307,7 @@ class NebulaStore : public KVStore, public Handler {
    * @param prefix The prefix of keys to iterate
    * @param iter Iterator of keys starts with 'prefix' beginning from 'start', returns by kv engine
    * @param canReadFromFollower Whether check if current kvstore is leader of given partition
+   * @param snapshot If set, read from snapshot.
    * @return nebula::cpp2::ErrorCode
    */
   nebula::cpp2::ErrorCode rangeWithPrefix(GraphSpaceID spaceId,
@@ -311,7 +315,8 @@ class NebulaStore : public KVStore, public Handler {
                                           const std::string& start,
                                           const std::string& prefix,
                                           std::unique_ptr<KVIterator>* iter,
-                                          bool canReadFromFollower = false) override;
+                                          bool canReadFromFollower = false,
+                                          const void* snapshot = nullptr) override;
 
   /**
    * @brief To forbid to pass rvalue via the 'rangeWithPrefix' parameter.
@@ -321,7 +326,8 @@ class NebulaStore : public KVStore, public Handler {
                                           std::string&& start,
                                           std::string&& prefix,
                                           std::unique_ptr<KVIterator>* iter,
-                                          bool canReadFromFollower = false) override = delete;
+                                          bool canReadFromFollower = false,
+                                          const void* snapshot = nullptr) override = delete;
 
   /**
    * @brief Synchronize the kvstore across multiple replica by add a empty log
@@ -728,18 +734,21 @@ class NebulaStore : public KVStore, public Handler {
   /**
    * @brief Register callback to cleanup before a space is removed
    *
+   * @param funcName Modulename
    * @param func Callback to cleanup
    */
-  void registerBeforeRemoveSpace(std::function<void(GraphSpaceID)> func) {
-    beforeRemoveSpace_ = func;
+  void registerBeforeRemoveSpace(const std::string& funcName,
+                                 std::function<void(GraphSpaceID)> func) {
+    beforeRemoveSpace_.insert_or_assign(funcName, std::move(func));
   }
 
   /**
    * @brief Unregister the callback to cleanup before a space is removed
    *
+   * @param funcName Modulename
    */
-  void unregisterBeforeRemoveSpace() {
-    beforeRemoveSpace_ = nullptr;
+  void unregisterBeforeRemoveSpace(const std::string& funcName) {
+    beforeRemoveSpace_.erase(funcName);
   }
 
  private:
@@ -884,7 +893,7 @@ class NebulaStore : public KVStore, public Handler {
   std::shared_ptr<DiskManager> diskMan_;
   folly::ConcurrentHashMap<std::string, std::function<void(std::shared_ptr<Part>&)>>
       onNewPartAdded_;
-  std::function<void(GraphSpaceID)> beforeRemoveSpace_{nullptr};
+  folly::ConcurrentHashMap<std::string, std::function<void(GraphSpaceID)>> beforeRemoveSpace_;
 };
 
 }  // namespace kvstore
@@ -0,0 +1,78 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "kvstore/ReadPerfContext.h"
+
+namespace nebula {
+namespace kvstore {
+
+namespace {
+
+using Counter = uint64_t rocksdb::PerfContext::*;
+
+// The name of each counter, and the counters of the perf context added up to it
+const std::vector<std::pair<std::string, std::vector<Counter>>>& perfCounters() {
+  static const std::vector<std::pair<std::string, std::vector<Counter>>> kCounters = {
+      {"block_read_count", {&rocksdb::PerfContext::block_read_count}},
+      {"block_read_bytes", {&rocksdb::PerfContext::block_read_byte}},
+      {"block_cache_hit_count", {&rocksdb::PerfContext::block_cache_hit_count}},
+      {"read_bytes",
+       {&rocksdb::PerfContext::get_read_bytes,
+        &rocksdb::PerfContext::multiget_read_bytes,
+        &rocksdb::PerfContext::iter_read_bytes}},
+      {"bloom_sst_filtered", {&rocksdb::PerfContext::bloom_sst_miss_count}},
+      {"bloom_sst_passed", {&rocksdb::PerfContext::bloom_sst_hit_count}},
+      {"keys_skipped",
+       {&rocksdb::PerfContext::internal_key_skipped_count,
+        &rocksdb::PerfContext::internal_delete_skipped_count}},
+  };
+  return kCounters;
+}
+
+uint64_t sum(const rocksdb::PerfContext* ctx, const std::vector<Counter>& counters) {
+  uint64_t value = 0;
+  for (auto counter : counters) {
+    value += ctx->*counter;
+  }
+  return value;
+}
+
+}  // namespace
+
+ReadPerfContext::ReadPerfContext(bool enabled) : enabled_(enabled) {
+  if (!enabled_) {
+    return;
+  }
+  level_ = rocksdb::GetPerfLevel();
+  if (level_ < rocksdb::PerfLevel::kEnableCount) {
+    rocksdb::SetPerfLevel(rocksdb::PerfLevel::kEnableCount);
+  }
+  auto* ctx = rocksdb::get_perf_context();
+  for (const auto& counter : perfCounters()) {
+    base_.emplace_back(sum(ctx, counter.second));
+  }
+}
+
+ReadPerfContext::~ReadPerfContext() {
+  if (enabled_ && level_ < rocksdb::PerfLevel::kEnableCount) {
+    rocksdb::SetPerfLevel(level_);
+  }
+}
+
+std::map<std::string, int64_t> ReadPerfContext::counters() const {
+  std::map<std::string, int64_t> result;
+  if (!enabled_) {
+    return result;
+  }
+  auto* ctx = rocksdb::get_perf_context();
+  const auto& counters = perfCounters();
+  for (size_t i = 0; i < counters.size(); ++i) {
+    result.emplace(counters[i].first, sum(ctx, counters[i].second) - base_[i]);
+  }
+  return result;
+}
+
+}  // namespace kvstore
+}  // namespace nebula
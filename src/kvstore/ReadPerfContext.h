@@ -0,0 +1,56 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef KVSTORE_READPERFCONTEXT_H_
+#define KVSTORE_READPERFCONTEXT_H_
+
+#include <rocksdb/perf_context.h>
+#include <rocksdb/perf_level.h>
+
+#include "common/base/Base.h"
+
+namespace nebula {
+namespace kvstore {
+
+/**
+ * @brief ReadPerfContext counts the work of rocksdb for the reads on the calling thread, from its
+ * construction to its destruction, by the thread local perf context of rocksdb.
+ *
+ * Only the counters are enabled, not the timers, which take the time of the clock on every block.
+ * They tell where the time of a read goes: the blocks read from the files and the ones hit in the
+ * block cache, the bytes of the keys and values returned to be decoded, the sst files skipped by
+ * the bloom filters and the ones the filters let pass, the deleted or old versions of the keys
+ * skipped by the iterators.
+ */
+class ReadPerfContext final {
+ public:
+  explicit ReadPerfContext(bool enabled);
+
+  ~ReadPerfContext();
+
+  ReadPerfContext(const ReadPerfContext&) = delete;
+  ReadPerfContext& operator=(const ReadPerfContext&) = delete;
+
+  bool enabled() const {
+    return enabled_;
+  }
+
+  /**
+   * @brief The counters of the reads since the construction, keyed by their names, e.g.
+   * block_read_count, block_cache_hit_count, read_bytes, bloom_sst_filtered, bloom_sst_passed and
+   * keys_skipped.
+   */
+  std::map<std::string, int64_t> counters() const;
+
+ private:
+  bool enabled_;
+  rocksdb::PerfLevel level_{rocksdb::PerfLevel::kDisable};
+  // The counters when it's constructed, the perf context may be used by an outer one
+  std::vector<uint64_t> base_;
+};
+
+}  // namespace kvstore
+}  // namespace nebula
+#endif  // KVSTORE_READPERFCONTEXT_H_
@@ -7,6 +7,7 @@
 
 #include <folly/String.h>
 #include <rocksdb/convenience.h>
+#include <rocksdb/sst_file_reader.h>
 
 #include "common/base/Base.h"
 #include "common/fs/FileUtils.h"
@@ -36,7 +37,8 @@ RocksEngine::RocksEngine(GraphSpaceID spaceId,
                          const std::string& walPath,
                          std::shared_ptr<rocksdb::MergeOperator> mergeOp,
                          std::shared_ptr<rocksdb::CompactionFilterFactory> cfFactory,
-                         bool readonly)
+                         bool readonly,
+                         const std::string& coldPath)
     : KVEngine(spaceId),
       spaceId_(spaceId),
       dataPath_(folly::stringPrintf("%s/nebula/%d", dataPath.c_str(), spaceId)) {
@@ -73,8 +75,36 @@ RocksEngine::RocksEngine(GraphSpaceID spaceId,
   if (cfFactory != nullptr) {
     options.compaction_filter_factory = cfFactory;
   }
+  if (!coldPath.empty()) {
+    auto coldDataPath = folly::stringPrintf("%s/nebula/%d/data", coldPath.c_str(), spaceId);
+    if (FileUtils::fileType(coldDataPath.c_str()) == FileType::NOTEXIST &&
+        !FileUtils::makeDir(coldDataPath)) {
+      LOG(FATAL) << "makeDir " << coldDataPath << " failed";
+    }
+    status = initTieredDbPaths(options, path, coldDataPath);
+    CHECK(status.ok()) << status.ToString();
+    tiered_ = true;
+  }
 
-  if (readonly) {
+  // column families already on disk, the list is empty for a new instance
+  std::vector<std::string> existing;
+  rocksdb::DB::ListColumnFamilies(rocksdb::DBOptions(options), path, &existing);
+  if (spaceId_ != kDefaultSpaceId /* only for storage*/) {
+    if (readonly) {
+      // follow the layout on disk, since we can't move any data
+      keyTypeColumnFamilies_ =
+          std::find(existing.begin(),
+                    existing.end(),
+                    keyTypeColumnFamilyName(KeyTypeColumnFamily::kEdge)) != existing.end();
+    } else {
+      keyTypeColumnFamilies_ = FLAGS_enable_rocksdb_key_type_column_families &&
+                               FLAGS_rocksdb_table_format == "BlockBasedTable";
+    }
+  }
+
+  if (keyTypeColumnFamilies_ || existing.size() > 1) {
+    status = openColumnFamilies(options, path, vIdLen, readonly, existing, &db);
+  } else if (readonly) {
     status = rocksdb::DB::OpenForReadOnly(options, path, &db);
   } else {
     status = rocksdb::DB::Open(options, path, &db);
@@ -95,6 +125,7 @@ RocksEngine::RocksEngine(GraphSpaceID spaceId,
   std::string factoryName = options.table_factory->Name();
   if (factoryName == rocksdb::TableFactory::kBlockBasedTableName()) {
     extractorLen_ = sizeof(PartitionID) + vIdLen;
+    edgeExtractorLen_ = prefixExtractorLength(static_cast<uint8_t>(NebulaKeyType::kEdge), vIdLen);
   } else if (factoryName == rocksdb::TableFactory::kPlainTableName()) {
     // PlainTable only support prefix-based seek, which means if the prefix is not inserted into
     // rocksdb, we can't read them from "prefix" api anymore. For simplicity, we just set the length
@@ -102,6 +133,7 @@ RocksEngine::RocksEngine(GraphSpaceID spaceId,
     // tagPrefix(partId) or edgePrefix(partId).
     isPlainTable_ = true;
     extractorLen_ = sizeof(PartitionID);
+    edgeExtractorLen_ = sizeof(PartitionID);
   }
   partsNum_ = allParts().size();
   LOG(INFO) << "open rocksdb on " << path;
@@ -109,6 +141,134 @@ RocksEngine::RocksEngine(GraphSpaceID spaceId,
   backup();
 }
 
+rocksdb::Status RocksEngine::openColumnFamilies(const rocksdb::Options& options,
+                                                const std::string& path,
+                                                int32_t vIdLen,
+                                                bool readonly,
+                                                const std::vector<std::string>& existing,
+                                                rocksdb::DB** db) {
+  std::vector<std::string> names = existing;
+  if (names.empty()) {
+    names.emplace_back(rocksdb::kDefaultColumnFamilyName);
+  }
+  if (keyTypeColumnFamilies_) {
+    for (size_t i = 0; i < kNumKeyTypeColumnFamilies; i++) {
+      auto& name = keyTypeColumnFamilyName(static_cast<KeyTypeColumnFamily>(i));
+      if (std::find(names.begin(), names.end(), name) == names.end()) {
+        names.emplace_back(name);
+      }
+    }
+  }
+
+  std::vector<rocksdb::ColumnFamilyDescriptor> descriptors;
+  for (auto& name : names) {
+    rocksdb::ColumnFamilyOptions cfOpts(options);
+    for (size_t i = 0; keyTypeColumnFamilies_ && i < kNumKeyTypeColumnFamilies; i++) {
+      auto cf = static_cast<KeyTypeColumnFamily>(i);
+      if (keyTypeColumnFamilyName(cf) == name) {
+        auto status = initRocksdbColumnFamilyOptions(cfOpts, options, cf, vIdLen);
+        if (!status.ok()) {
+          return status;
+        }
+      }
+    }
+    descriptors.emplace_back(name, cfOpts);
+  }
+
+  rocksdb::DBOptions dbOpts(options);
+  dbOpts.create_missing_column_families = true;
+  std::vector<rocksdb::ColumnFamilyHandle*> handles;
+  rocksdb::Status status;
+  if (readonly) {
+    status = rocksdb::DB::OpenForReadOnly(dbOpts, path, descriptors, &handles, db);
+  } else {
+    status = rocksdb::DB::Open(dbOpts, path, descriptors, &handles, db);
+  }
+  if (!status.ok()) {
+    return status;
+  }
+  allHandles_ = handles;
+
+  if (keyTypeColumnFamilies_) {
+    cfHandles_.resize(kNumKeyTypeColumnFamilies, nullptr);
+    cfExtractorLen_.resize(kNumKeyTypeColumnFamilies, 0);
+    for (size_t i = 0; i < kNumKeyTypeColumnFamilies; i++) {
+      auto cf = static_cast<KeyTypeColumnFamily>(i);
+      for (size_t j = 0; j < names.size(); j++) {
+        if (names[j] == keyTypeColumnFamilyName(cf)) {
+          cfHandles_[i] = handles[j];
+        }
+      }
+      if (cfHandles_[i] == nullptr) {
+        return rocksdb::Status::NotFound("Column family " + keyTypeColumnFamilyName(cf));
+      }
+      cfExtractorLen_[i] = keyTypeColumnFamilyPrefixLength(cf, vIdLen);
+    }
+    LOG(INFO) << "space " << spaceId_ << " stores keys in column families by key type";
+  }
+
+  if (readonly) {
+    return status;
+  }
+  return migrateColumnFamilies(*db);
+}
+
+rocksdb::Status RocksEngine::migrateColumnFamilies(rocksdb::DB* db) {
+  static constexpr size_t kMigrateBatchKeys = 1024;
+  auto target = [&](uint8_t type) {
+    return keyTypeColumnFamilies_
+               ? cfHandles_[static_cast<size_t>(keyTypeColumnFamily(type))]
+               : db->DefaultColumnFamily();
+  };
+  rocksdb::WriteOptions writeOptions;
+  writeOptions.disableWAL = FLAGS_rocksdb_disable_wal;
+
+  for (auto* handle : allHandles_) {
+    rocksdb::ReadOptions readOptions;
+    readOptions.total_order_seek = true;
+    std::unique_ptr<rocksdb::Iterator> iter(db->NewIterator(readOptions, handle));
+    iter->SeekToFirst();
+    // keys of one key type are adjacent, so we only need to check the first key of each type
+    while (iter->Valid()) {
+      auto key = iter->key();
+      uint8_t type = key.empty() ? 0 : static_cast<uint8_t>(key[0]);
+      auto* dst = target(type);
+      if (dst->GetID() != handle->GetID()) {
+        size_t moved = 0;
+        rocksdb::WriteBatch batch;
+        for (; iter->Valid() && !iter->key().empty() &&
+               static_cast<uint8_t>(iter->key()[0]) == type;
+             iter->Next()) {
+          batch.Put(dst, iter->key(), iter->value());
+          batch.Delete(handle, iter->key());
+          if (++moved % kMigrateBatchKeys == 0) {
+            auto status = db->Write(writeOptions, &batch);
+            if (!status.ok()) {
+              return status;
+            }
+            batch.Clear();
+          }
+        }
+        auto status = db->Write(writeOptions, &batch);
+        if (!status.ok()) {
+          return status;
+        }
+        LOG(INFO) << "space " << spaceId_ << " moved " << moved << " keys of type "
+                  << static_cast<int32_t>(type) << " from column family " << handle->GetName()
+                  << " to " << dst->GetName();
+      }
+      if (type == 0xFF) {
+        break;
+      }
+      iter->Seek(rocksdb::Slice(std::string(1, static_cast<char>(type + 1))));
+    }
+    if (!iter->status().ok()) {
+      return iter->status();
+    }
+  }
+  return rocksdb::Status::OK();
+}
+
 void RocksEngine::stop() {
   if (db_) {
     // Because we trigger compaction in WebService, we need to stop all
@@ -118,7 +278,7 @@ void RocksEngine::stop() {
 }
 
 std::unique_ptr<WriteBatch> RocksEngine::startBatchWrite() {
-  return std::make_unique<RocksWriteBatch>();
+  return std::make_unique<RocksWriteBatch>(keyTypeColumnFamilies_ ? &cfHandles_ : nullptr);
 }
 
 nebula::cpp2::ErrorCode RocksEngine::commitBatchWrite(std::unique_ptr<WriteBatch> batch,
@@ -148,7 +308,7 @@ nebula::cpp2::ErrorCode RocksEngine::get(const std::string& key,
   if (UNLIKELY(snapshot != nullptr)) {
     options.snapshot = reinterpret_cast<const rocksdb::Snapshot*>(snapshot);
   }
-  rocksdb::Status status = db_->Get(options, rocksdb::Slice(key), value);
+  rocksdb::Status status = db_->Get(options, cfHandle(key), rocksdb::Slice(key), value);
   if (status.ok()) {
     return nebula::cpp2::ErrorCode::SUCCEEDED;
   } else if (status.IsNotFound()) {
@@ -169,7 +329,12 @@ std::vector<Status> RocksEngine::multiGet(const std::vector<std::string>& keys,
     slices.emplace_back(keys[index]);
   }
 
-  auto status = db_->MultiGet(options, slices, values);
+  std::vector<rocksdb::ColumnFamilyHandle*> handles;
+  for (size_t index = 0; index < keys.size(); index++) {
+    handles.emplace_back(cfHandle(keys[index]));
+  }
+
+  auto status = db_->MultiGet(options, handles, slices, values);
   std::vector<Status> ret;
   std::transform(status.begin(), status.end(), std::back_inserter(ret), [](const auto& s) {
     if (s.ok()) {
@@ -185,17 +350,24 @@ std::vector<Status> RocksEngine::multiGet(const std::vector<std::string>& keys,
 
 nebula::cpp2::ErrorCode RocksEngine::range(const std::string& start,
                                            const std::string& end,
-                                           std::unique_ptr<KVIterator>* storageIter) {
+                                           std::unique_ptr<KVIterator>* storageIter,
+                                           const void* snapshot) {
   memory::MemoryCheckOffGuard guard;
+  if (keyTypeColumnFamilies_ && keyTypeColumnFamiliesInRange(start, end).size() > 1) {
+    return rangeOfColumnFamilies(start, end, snapshot, storageIter);
+  }
   storageIter->reset(new RocksRangeIter(start, end));
   rocksdb::ReadOptions options;
   options.iterate_upper_bound = dynamic_cast<RocksRangeIter*>(storageIter->get())->upperBound();
+  if (UNLIKELY(snapshot != nullptr)) {
+    options.snapshot = reinterpret_cast<const rocksdb::Snapshot*>(snapshot);
+  }
   if (!isPlainTable_) {
     options.total_order_seek = FLAGS_enable_rocksdb_prefix_filtering;
   } else {
     options.prefix_same_as_start = true;
   }
-  std::unique_ptr<rocksdb::Iterator> iter(db_->NewIterator(options));
+  std::unique_ptr<rocksdb::Iterator> iter(db_->NewIterator(options, cfHandle(start)));
   if (iter) {
     iter->Seek(rocksdb::Slice(start));
     dynamic_cast<RocksRangeIter*>(storageIter->get())->reset(std::move(iter));
@@ -209,7 +381,10 @@ nebula::cpp2::ErrorCode RocksEngine::prefix(const std::string& prefix,
   memory::MemoryCheckOffGuard guard;
   // In fact, we don't need to check prefix.size() >= extractorLen_, which is caller's duty to make
   // sure the prefix bloom filter exists. But this is quite error-prone, so we do a check here.
-  if (FLAGS_enable_rocksdb_prefix_filtering && prefix.size() >= extractorLen_) {
+  if (keyTypeColumnFamilies_ && prefix.empty()) {
+    return rangeOfColumnFamilies("", "", snapshot, storageIter);
+  }
+  if (FLAGS_enable_rocksdb_prefix_filtering && prefix.size() >= extractorLen(prefix)) {
     return prefixWithExtractor(prefix, snapshot, storageIter);
   } else {
     return prefixWithoutExtractor(prefix, snapshot, storageIter);
@@ -227,7 +402,7 @@ nebula::cpp2::ErrorCode RocksEngine::prefixWithExtractor(const std::string& pref
     options.snapshot = reinterpret_cast<const rocksdb::Snapshot*>(snapshot);
   }
   options.prefix_same_as_start = true;
-  std::unique_ptr<rocksdb::Iterator> iter(db_->NewIterator(options));
+  std::unique_ptr<rocksdb::Iterator> iter(db_->NewIterator(options, cfHandle(prefix)));
   if (iter) {
     iter->Seek(rocksdb::Slice(prefix));
     dynamic_cast<RocksPrefixIter*>(storageIter->get())->reset(std::move(iter));
@@ -246,7 +421,7 @@ nebula::cpp2::ErrorCode RocksEngine::prefixWithoutExtractor(
   }
   // prefix_same_as_start is false by default
   options.total_order_seek = FLAGS_enable_rocksdb_prefix_filtering;
-  std::unique_ptr<rocksdb::Iterator> iter(db_->NewIterator(options));
+  std::unique_ptr<rocksdb::Iterator> iter(db_->NewIterator(options, cfHandle(prefix)));
   if (iter) {
     iter->Seek(rocksdb::Slice(prefix));
     dynamic_cast<RocksPrefixIter*>(storageIter->get())->reset(std::move(iter));
@@ -256,17 +431,21 @@ nebula::cpp2::ErrorCode RocksEngine::prefixWithoutExtractor(
 
 nebula::cpp2::ErrorCode RocksEngine::rangeWithPrefix(const std::string& start,
                                                      const std::string& prefix,
-                                                     std::unique_ptr<KVIterator>* storageIter) {
+                                                     std::unique_ptr<KVIterator>* storageIter,
+                                                     const void* snapshot) {
   memory::MemoryCheckOffGuard guard;
   storageIter->reset(new RocksPrefixIter(prefix));
   rocksdb::ReadOptions options;
   options.iterate_upper_bound = dynamic_cast<RocksPrefixIter*>(storageIter->get())->upperBound();
+  if (UNLIKELY(snapshot != nullptr)) {
+    options.snapshot = reinterpret_cast<const rocksdb::Snapshot*>(snapshot);
+  }
   if (!isPlainTable_) {
     options.total_order_seek = FLAGS_enable_rocksdb_prefix_filtering;
   } else {
     options.prefix_same_as_start = true;
   }
-  std::unique_ptr<rocksdb::Iterator> iter(db_->NewIterator(options));
+  std::unique_ptr<rocksdb::Iterator> iter(db_->NewIterator(options, cfHandle(prefix)));
   if (iter) {
     iter->Seek(rocksdb::Slice(start));
     dynamic_cast<RocksPrefixIter*>(storageIter->get())->reset(std::move(iter));
@@ -276,6 +455,9 @@ nebula::cpp2::ErrorCode RocksEngine::rangeWithPrefix(const std::string& start,
 
 nebula::cpp2::ErrorCode RocksEngine::scan(std::unique_ptr<KVIterator>* storageIter) {
   memory::MemoryCheckOffGuard guard;
+  if (keyTypeColumnFamilies_) {
+    return rangeOfColumnFamilies("", "", nullptr, storageIter);
+  }
   rocksdb::ReadOptions options;
   options.total_order_seek = true;
   std::unique_ptr<rocksdb::Iterator> iter(db_->NewIterator(options));
@@ -284,10 +466,51 @@ nebula::cpp2::ErrorCode RocksEngine::scan(std::unique_ptr<KVIterator>* storageIt
   return nebula::cpp2::ErrorCode::SUCCEEDED;
 }
 
+nebula::cpp2::ErrorCode RocksEngine::rangeOfColumnFamilies(
+    const std::string& start,
+    const std::string& end,
+    const void* snapshot,
+    std::unique_ptr<KVIterator>* storageIter) {
+  // split [start, end) by key type, adjacent key types in the same column family are merged
+  std::vector<std::unique_ptr<RocksConcatIter::Segment>> segments;
+  std::vector<KeyTypeColumnFamily> segmentCfs;
+  uint32_t first = start.empty() ? 0 : static_cast<uint8_t>(start[0]);
+  uint32_t last = end.empty() ? 0xFF : static_cast<uint8_t>(end[0]);
+  for (auto type = first; type <= last; type++) {
+    auto cf = keyTypeColumnFamily(static_cast<uint8_t>(type));
+    auto segStart = type == first ? start : std::string(1, static_cast<char>(type));
+    auto segEnd = (type == last) ? end : std::string(1, static_cast<char>(type + 1));
+    if (!segEnd.empty() && segStart >= segEnd) {
+      continue;
+    }
+    if (!segments.empty() && segmentCfs.back() == cf && segments.back()->end == segStart) {
+      segments.back()->end = std::move(segEnd);
+      continue;
+    }
+    auto segment = std::make_unique<RocksConcatIter::Segment>();
+    segment->start = std::move(segStart);
+    segment->end = std::move(segEnd);
+    segments.emplace_back(std::move(segment));
+    segmentCfs.emplace_back(cf);
+  }
+
+  for (size_t i = 0; i < segments.size(); i++) {
+    rocksdb::ReadOptions options;
+    if (snapshot != nullptr) {
+      options.snapshot = reinterpret_cast<const rocksdb::Snapshot*>(snapshot);
+    }
+    options.total_order_seek = true;
+    auto* handle = cfHandles_[static_cast<size_t>(segmentCfs[i])];
+    segments[i]->iter.reset(db_->NewIterator(options, handle));
+  }
+  storageIter->reset(new RocksConcatIter(std::move(segments)));
+  return nebula::cpp2::ErrorCode::SUCCEEDED;
+}
+
 nebula::cpp2::ErrorCode RocksEngine::put(std::string key, std::string value) {
   rocksdb::WriteOptions options;
   options.disableWAL = FLAGS_rocksdb_disable_wal;
-  rocksdb::Status status = db_->Put(options, key, value);
+  rocksdb::Status status = db_->Put(options, cfHandle(key), key, value);
   if (status.ok()) {
     return nebula::cpp2::ErrorCode::SUCCEEDED;
   } else {
@@ -299,7 +522,7 @@ nebula::cpp2::ErrorCode RocksEngine::put(std::string key, std::string value) {
 nebula::cpp2::ErrorCode RocksEngine::multiPut(std::vector<KV> keyValues) {
   rocksdb::WriteBatch updates(FLAGS_rocksdb_batch_size);
   for (size_t i = 0; i < keyValues.size(); i++) {
-    updates.Put(keyValues[i].first, keyValues[i].second);
+    updates.Put(cfHandle(keyValues[i].first), keyValues[i].first, keyValues[i].second);
   }
   rocksdb::WriteOptions options;
   options.disableWAL = FLAGS_rocksdb_disable_wal;
@@ -315,7 +538,7 @@ nebula::cpp2::ErrorCode RocksEngine::multiPut(std::vector<KV> keyValues) {
 nebula::cpp2::ErrorCode RocksEngine::remove(const std::string& key) {
   rocksdb::WriteOptions options;
   options.disableWAL = FLAGS_rocksdb_disable_wal;
-  auto status = db_->Delete(options, key);
+  auto status = db_->Delete(options, cfHandle(key), key);
   if (status.ok()) {
     return nebula::cpp2::ErrorCode::SUCCEEDED;
   } else {
@@ -327,7 +550,7 @@ nebula::cpp2::ErrorCode RocksEngine::remove(const std::string& key) {
 nebula::cpp2::ErrorCode RocksEngine::multiRemove(std::vector<std::string> keys) {
   rocksdb::WriteBatch deletes(FLAGS_rocksdb_batch_size);
   for (size_t i = 0; i < keys.size(); i++) {
-    deletes.Delete(keys[i]);
+    deletes.Delete(cfHandle(keys[i]), keys[i]);
   }
   rocksdb::WriteOptions options;
   options.disableWAL = FLAGS_rocksdb_disable_wal;
@@ -343,7 +566,22 @@ nebula::cpp2::ErrorCode RocksEngine::multiRemove(std::vector<std::string> keys)
 nebula::cpp2::ErrorCode RocksEngine::removeRange(const std::string& start, const std::string& end) {
   rocksdb::WriteOptions options;
   options.disableWAL = FLAGS_rocksdb_disable_wal;
-  auto status = db_->DeleteRange(options, db_->DefaultColumnFamily(), start, end);
+  if (!keyTypeColumnFamilies_) {
+    auto status = db_->DeleteRange(options, db_->DefaultColumnFamily(), start, end);
+    if (status.ok()) {
+      return nebula::cpp2::ErrorCode::SUCCEEDED;
+    } else {
+      VLOG(4) << "RemoveRange Failed: " << status.ToString();
+      return nebula::cpp2::ErrorCode::E_UNKNOWN;
+    }
+  }
+  // remove the range in one batch, so it is atomic across column families
+  RocksWriteBatch batch(&cfHandles_);
+  auto code = batch.removeRange(start, end);
+  if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+    return code;
+  }
+  auto status = db_->Write(options, batch.data());
   if (status.ok()) {
     return nebula::cpp2::ErrorCode::SUCCEEDED;
   } else {
@@ -474,6 +712,9 @@ nebula::cpp2::ErrorCode RocksEngine::ingest(const std::vector<std::string>& file
   if (files.empty()) {
     return nebula::cpp2::ErrorCode::SUCCEEDED;
   }
+  if (keyTypeColumnFamilies_) {
+    return ingestByColumnFamily(files, verifyFileChecksum);
+  }
   rocksdb::IngestExternalFileOptions options;
   options.move_files = FLAGS_move_files;
   options.verify_file_checksum = verifyFileChecksum;
@@ -486,11 +727,116 @@ nebula::cpp2::ErrorCode RocksEngine::ingest(const std::vector<std::string>& file
   }
 }
 
+nebula::cpp2::ErrorCode RocksEngine::ingestByColumnFamily(const std::vector<std::string>& files,
+                                                          bool verifyFileChecksum) {
+  std::vector<std::vector<std::string>> filesOfCf(kNumKeyTypeColumnFamilies);
+  // files split by us, need to be removed after ingestion
+  std::vector<std::string> splitFiles;
+  auto cleanup = [&splitFiles]() {
+    for (auto& file : splitFiles) {
+      if (FileUtils::exist(file)) {
+        FileUtils::remove(file.c_str());
+      }
+    }
+  };
+
+  for (auto& file : files) {
+    rocksdb::Options options;
+    rocksdb::SstFileReader reader(options);
+    auto status = reader.Open(file);
+    if (!status.ok()) {
+      LOG(WARNING) << "Open sst " << file << " failed: " << status.ToString();
+      cleanup();
+      return nebula::cpp2::ErrorCode::E_UNKNOWN;
+    }
+    std::unique_ptr<rocksdb::Iterator> iter(reader.NewIterator(rocksdb::ReadOptions()));
+    std::set<size_t> cfsInFile;
+    for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+      auto key = iter->key();
+      cfsInFile.emplace(static_cast<size_t>(
+          key.empty() ? KeyTypeColumnFamily::kDefault
+                      : keyTypeColumnFamily(static_cast<uint8_t>(key[0]))));
+    }
+    if (cfsInFile.size() <= 1) {
+      auto cf = cfsInFile.empty() ? 0 : *cfsInFile.begin();
+      filesOfCf[cf].emplace_back(file);
+      continue;
+    }
+
+    // keys of different column families are in one file, rewrite it into one file per family
+    LOG(INFO) << "Split sst " << file << " into " << cfsInFile.size() << " column families";
+    // the split files are written with the options of their column families, so that they have
+    // the same table options, e.g. the bloom filter and the prefix extractor
+    std::vector<std::unique_ptr<rocksdb::SstFileWriter>> writers(kNumKeyTypeColumnFamilies);
+    for (iter->SeekToFirst(); iter->Valid() && status.ok(); iter->Next()) {
+      auto key = iter->key();
+      auto cf = static_cast<size_t>(key.empty()
+                                        ? KeyTypeColumnFamily::kDefault
+                                        : keyTypeColumnFamily(static_cast<uint8_t>(key[0])));
+      if (writers[cf] == nullptr) {
+        auto& cfName = keyTypeColumnFamilyName(static_cast<KeyTypeColumnFamily>(cf));
+        auto splitFile = folly::stringPrintf("%s.%s", file.c_str(), cfName.c_str());
+        writers[cf] = std::make_unique<rocksdb::SstFileWriter>(
+            rocksdb::EnvOptions(), db_->GetOptions(cfHandles_[cf]), cfHandles_[cf]);
+        status = writers[cf]->Open(splitFile);
+        splitFiles.emplace_back(splitFile);
+        filesOfCf[cf].emplace_back(std::move(splitFile));
+        if (!status.ok()) {
+          break;
+        }
+      }
+      status = writers[cf]->Put(key, iter->value());
+    }
+    for (auto& writer : writers) {
+      if (writer != nullptr && status.ok()) {
+        status = writer->Finish();
+      }
+    }
+    if (!status.ok()) {
+      LOG(WARNING) << "Split sst " << file << " failed: " << status.ToString();
+      cleanup();
+      return nebula::cpp2::ErrorCode::E_UNKNOWN;
+    }
+  }
+
+  // ingest into all column families atomically
+  std::vector<rocksdb::IngestExternalFileArg> args;
+  for (size_t i = 0; i < kNumKeyTypeColumnFamilies; i++) {
+    if (filesOfCf[i].empty()) {
+      continue;
+    }
+    rocksdb::IngestExternalFileArg arg;
+    arg.column_family = cfHandles_[i];
+    arg.external_files = filesOfCf[i];
+    arg.options.move_files = FLAGS_move_files;
+    arg.options.verify_file_checksum = verifyFileChecksum;
+    args.emplace_back(std::move(arg));
+  }
+  rocksdb::Status status = db_->IngestExternalFiles(args);
+  cleanup();
+  if (status.ok()) {
+    return nebula::cpp2::ErrorCode::SUCCEEDED;
+  } else {
+    LOG(WARNING) << "Ingest Failed: " << status.ToString();
+    return nebula::cpp2::ErrorCode::E_UNKNOWN;
+  }
+}
+
 nebula::cpp2::ErrorCode RocksEngine::setOption(const std::string& configKey,
                                                const std::string& configValue) {
   std::unordered_map<std::string, std::string> configOptions = {{configKey, configValue}};
 
-  rocksdb::Status status = db_->SetOptions(configOptions);
+  rocksdb::Status status;
+  if (keyTypeColumnFamilies_) {
+    for (auto* handle : cfHandles_) {
+      status = db_->SetOptions(handle, configOptions);
+      if (!status.ok()) {
+        break;
+      }
+    }
+  } else {
+    status = db_->SetOptions(configOptions);
+  }
   if (status.ok()) {
     LOG(INFO) << "SetOption Succeeded: " << configKey << ":" << configValue;
     return nebula::cpp2::ErrorCode::SUCCEEDED;
@@ -517,6 +863,11 @@ nebula::cpp2::ErrorCode RocksEngine::setDBOption(const std::string& configKey,
 ErrorOr<nebula::cpp2::ErrorCode, std::string> RocksEngine::getProperty(
     const std::string& property) {
   std::string value;
+  uint64_t intValue = 0;
+  if (keyTypeColumnFamilies_ && db_->GetAggregatedIntProperty(property, &intValue)) {
+    // sum up the property of all column families
+    return folly::to<std::string>(intValue);
+  }
   if (!db_->GetProperty(property, &value)) {
     return nebula::cpp2::ErrorCode::E_INVALID_PARM;
   } else {
@@ -528,7 +879,17 @@ nebula::cpp2::ErrorCode RocksEngine::compact() {
   rocksdb::CompactRangeOptions options;
   options.change_level = FLAGS_rocksdb_compact_change_level;
   options.target_level = FLAGS_rocksdb_compact_target_level;
-  rocksdb::Status status = db_->CompactRange(options, nullptr, nullptr);
+  rocksdb::Status status;
+  if (keyTypeColumnFamilies_) {
+    for (auto* handle : cfHandles_) {
+      status = db_->CompactRange(options, handle, nullptr, nullptr);
+      if (!status.ok()) {
+        break;
+      }
+    }
+  } else {
+    status = db_->CompactRange(options, nullptr, nullptr);
+  }
   if (status.ok()) {
     return nebula::cpp2::ErrorCode::SUCCEEDED;
   } else {
@@ -539,7 +900,12 @@ nebula::cpp2::ErrorCode RocksEngine::compact() {
 
 nebula::cpp2::ErrorCode RocksEngine::flush() {
   rocksdb::FlushOptions options;
-  rocksdb::Status status = db_->Flush(options);
+  rocksdb::Status status;
+  if (keyTypeColumnFamilies_) {
+    status = db_->Flush(options, cfHandles_);
+  } else {
+    status = db_->Flush(options);
+  }
   if (status.ok()) {
     return nebula::cpp2::ErrorCode::SUCCEEDED;
   } else {
@@ -613,6 +979,12 @@ nebula::cpp2::ErrorCode RocksEngine::createCheckpoint(const std::string& checkpo
     return nebula::cpp2::ErrorCode::E_STORE_FAILURE;
   }
 
+  if (tiered_) {
+    // the checkpoint of rocksdb doesn't support more than one db_paths
+    LOG(WARNING) << "Checkpoint is not supported when the lower levels are in cold_data_path";
+    return nebula::cpp2::ErrorCode::E_UNSUPPORTED;
+  }
+
   rocksdb::Checkpoint* checkpoint;
   rocksdb::Status status = rocksdb::Checkpoint::Create(db_.get(), &checkpoint);
   if (!status.ok()) {
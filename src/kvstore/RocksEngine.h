@@ -173,6 +173,100 @@ class RocksCommonIter : public KVIterator {
   std::unique_ptr<rocksdb::Iterator> iter_;
 };
 
+/**
+ * @brief Rocksdb iterator over several column families. Each column family covers a disjoint key
+ * range [start, end), and the ranges are in ascending order, so the concatenation is still sorted.
+ * Only used when keys are dispatched into column families by key type.
+ */
+class RocksConcatIter : public KVIterator {
+ public:
+  struct Segment {
+    std::unique_ptr<rocksdb::Iterator> iter;
+    std::string start;
+    // empty end means no upper bound
+    std::string end;
+  };
+
+  explicit RocksConcatIter(std::vector<std::unique_ptr<Segment>> segments)
+      : segments_(std::move(segments)) {
+    if (!segments_.empty()) {
+      segments_[0]->iter->Seek(rocksdb::Slice(segments_[0]->start));
+      skipInvalid();
+    }
+  }
+
+  ~RocksConcatIter() = default;
+
+  bool valid() const override {
+    return curr_ < segments_.size() && inRange(*segments_[curr_]);
+  }
+
+  void next() override {
+    segments_[curr_]->iter->Next();
+    skipInvalid();
+  }
+
+  void prev() override {
+    segments_[curr_]->iter->Prev();
+    // step back into the previous column families, until a key is found or it's before the first
+    while (curr_ > 0 && !inRange(*segments_[curr_])) {
+      seekToLast(*segments_[--curr_]);
+    }
+  }
+
+  folly::StringPiece key() const override {
+    auto& iter = segments_[curr_]->iter;
+    return folly::StringPiece(iter->key().data(), iter->key().size());
+  }
+
+  folly::StringPiece val() const override {
+    auto& iter = segments_[curr_]->iter;
+    return folly::StringPiece(iter->value().data(), iter->value().size());
+  }
+
+ private:
+  static bool inRange(const Segment& segment) {
+    return segment.iter->Valid() && segment.iter->key().compare(segment.start) >= 0 &&
+           (segment.end.empty() || segment.iter->key().compare(segment.end) < 0);
+  }
+
+  static void seekToLast(Segment& segment) {
+    if (segment.end.empty()) {
+      segment.iter->SeekToLast();
+      return;
+    }
+    segment.iter->SeekForPrev(rocksdb::Slice(segment.end));
+    if (segment.iter->Valid() && segment.iter->key().compare(segment.end) >= 0) {
+      segment.iter->Prev();
+    }
+  }
+
+  void skipInvalid() {
+    while (curr_ < segments_.size() && !inRange(*segments_[curr_])) {
+      if (++curr_ < segments_.size()) {
+        segments_[curr_]->iter->Seek(rocksdb::Slice(segments_[curr_]->start));
+      }
+    }
+  }
+
+ private:
+  std::vector<std::unique_ptr<Segment>> segments_;
+  size_t curr_{0};
+};
+
+/**
+ * @brief Return the column family handle which stores the key
+ *
+ * @param handles Column family handles indexed by KeyTypeColumnFamily
+ * @param key
+ */
+inline rocksdb::ColumnFamilyHandle* keyTypeColumnFamilyHandle(
+    const std::vector<rocksdb::ColumnFamilyHandle*>& handles, folly::StringPiece key) {
+  auto cf = key.empty() ? KeyTypeColumnFamily::kDefault
+                        : keyTypeColumnFamily(static_cast<uint8_t>(key[0]));
+  return handles[static_cast<size_t>(cf)];
+}
+
 /***************************************
  *
  * Implementation of WriteBatch
@@ -181,14 +275,22 @@ class RocksCommonIter : public KVIterator {
 class RocksWriteBatch : public WriteBatch {
  private:
   rocksdb::WriteBatch batch_;
+  // column families dispatched by key type, nullptr if only default column family is used
+  const std::vector<rocksdb::ColumnFamilyHandle*>* cfHandles_{nullptr};
 
  public:
-  RocksWriteBatch() : batch_(FLAGS_rocksdb_batch_size) {}
+  explicit RocksWriteBatch(const std::vector<rocksdb::ColumnFamilyHandle*>* cfHandles = nullptr)
+      : batch_(FLAGS_rocksdb_batch_size), cfHandles_(cfHandles) {}
 
   virtual ~RocksWriteBatch() = default;
 
   nebula::cpp2::ErrorCode put(folly::StringPiece key, folly::StringPiece value) override {
-    if (batch_.Put(toSlice(key), toSlice(value)).ok()) {
+    auto status = cfHandles_ == nullptr
+                      ? batch_.Put(toSlice(key), toSlice(value))
+                      : batch_.Put(keyTypeColumnFamilyHandle(*cfHandles_, key),
+                                   toSlice(key),
+                                   toSlice(value));
+    if (status.ok()) {
       return nebula::cpp2::ErrorCode::SUCCEEDED;
     } else {
       return nebula::cpp2::ErrorCode::E_UNKNOWN;
@@ -196,7 +298,10 @@ class RocksWriteBatch : public WriteBatch {
   }
 
   nebula::cpp2::ErrorCode remove(folly::StringPiece key) override {
-    if (batch_.Delete(toSlice(key)).ok()) {
+    auto status = cfHandles_ == nullptr
+                      ? batch_.Delete(toSlice(key))
+                      : batch_.Delete(keyTypeColumnFamilyHandle(*cfHandles_, key), toSlice(key));
+    if (status.ok()) {
       return nebula::cpp2::ErrorCode::SUCCEEDED;
     } else {
       return nebula::cpp2::ErrorCode::E_UNKNOWN;
@@ -205,11 +310,20 @@ class RocksWriteBatch : public WriteBatch {
 
   // Remove all keys in the range [start, end)
   nebula::cpp2::ErrorCode removeRange(folly::StringPiece start, folly::StringPiece end) override {
-    if (batch_.DeleteRange(toSlice(start), toSlice(end)).ok()) {
-      return nebula::cpp2::ErrorCode::SUCCEEDED;
-    } else {
-      return nebula::cpp2::ErrorCode::E_UNKNOWN;
+    if (cfHandles_ == nullptr) {
+      if (batch_.DeleteRange(toSlice(start), toSlice(end)).ok()) {
+        return nebula::cpp2::ErrorCode::SUCCEEDED;
+      } else {
+        return nebula::cpp2::ErrorCode::E_UNKNOWN;
+      }
+    }
+    for (auto cf : keyTypeColumnFamiliesInRange(start, end)) {
+      auto* handle = (*cfHandles_)[static_cast<size_t>(cf)];
+      if (!batch_.DeleteRange(handle, toSlice(start), toSlice(end)).ok()) {
+        return nebula::cpp2::ErrorCode::E_UNKNOWN;
+      }
     }
+    return nebula::cpp2::ErrorCode::SUCCEEDED;
   }
 
   rocksdb::WriteBatch* data() {
@@ -222,6 +336,7 @@ class RocksWriteBatch : public WriteBatch {
  */
 class RocksEngine : public KVEngine {
   FRIEND_TEST(RocksEngineTest, SimpleTest);
+  FRIEND_TEST(KeyTypeColumnFamilyTest, MigrateTest);
 
  public:
   /**
@@ -234,6 +349,7 @@ class RocksEngine : public KVEngine {
    * @param mergeOp Rocksdb merge operation
    * @param cfFactory Rocksdb compaction filter factory
    * @param readonly Whether start as read only instance
+   * @param coldPath Cold path paired with dataPath, lower levels of rocksdb are placed in it
    */
   RocksEngine(GraphSpaceID spaceId,
               int32_t vIdLen,
@@ -241,9 +357,13 @@ class RocksEngine : public KVEngine {
               const std::string& walPath = "",
               std::shared_ptr<rocksdb::MergeOperator> mergeOp = nullptr,
               std::shared_ptr<rocksdb::CompactionFilterFactory> cfFactory = nullptr,
-              bool readonly = false);
+              bool readonly = false,
+              const std::string& coldPath = "");
 
   ~RocksEngine() {
+    for (auto* handle : allHandles_) {
+      db_->DestroyColumnFamilyHandle(handle);
+    }
     LOG(INFO) << "Release rocksdb on " << dataPath_;
   }
 
@@ -339,7 +459,8 @@ class RocksEngine : public KVEngine {
    */
   nebula::cpp2::ErrorCode range(const std::string& start,
                                 const std::string& end,
-                                std::unique_ptr<KVIterator>* iter) override;
+                                std::unique_ptr<KVIterator>* iter,
+                                const void* snapshot = nullptr) override;
 
   /**
    * @brief Get all results with 'prefix' str as prefix.
@@ -362,7 +483,8 @@ class RocksEngine : public KVEngine {
    */
   nebula::cpp2::ErrorCode rangeWithPrefix(const std::string& start,
                                           const std::string& prefix,
-                                          std::unique_ptr<KVIterator>* iter) override;
+                                          std::unique_ptr<KVIterator>* iter,
+                                          const void* snapshot = nullptr) override;
 
   /**
    * @brief Prefix scan with prefix extractor
@@ -571,6 +693,85 @@ class RocksEngine : public KVEngine {
       std::function<bool(const folly::StringPiece& key)> filter) override;
 
  private:
+  /**
+   * @brief Open rocksdb with all existing column families, and the key type column families if
+   * enabled. Keys stored in a column family other than the one of current layout are moved.
+   *
+   * @param options Rocksdb options of default column family
+   * @param path Rocksdb data path
+   * @param vIdLen Vertex id length
+   * @param readonly Whether open as read only instance
+   * @param existing Existing column families on disk
+   * @param db Opened rocksdb
+   * @return rocksdb::Status
+   */
+  rocksdb::Status openColumnFamilies(const rocksdb::Options& options,
+                                     const std::string& path,
+                                     int32_t vIdLen,
+                                     bool readonly,
+                                     const std::vector<std::string>& existing,
+                                     rocksdb::DB** db);
+
+  /**
+   * @brief Move keys into the column family of current layout, e.g. when key type column families
+   * is enabled on existing data, or disabled after enabled.
+   *
+   * @param db
+   * @return rocksdb::Status
+   */
+  rocksdb::Status migrateColumnFamilies(rocksdb::DB* db);
+
+  /**
+   * @brief Return the column family handle which stores the key
+   */
+  rocksdb::ColumnFamilyHandle* cfHandle(folly::StringPiece key) {
+    if (!keyTypeColumnFamilies_) {
+      return db_->DefaultColumnFamily();
+    }
+    return keyTypeColumnFamilyHandle(cfHandles_, key);
+  }
+
+  /**
+   * @brief Return the prefix extractor length of column family which stores the key
+   */
+  size_t extractorLen(folly::StringPiece key) {
+    if (key.empty()) {
+      return extractorLen_;
+    }
+    auto keyType = static_cast<uint8_t>(key[0]);
+    if (keyTypeColumnFamilies_) {
+      return cfExtractorLen_[static_cast<size_t>(keyTypeColumnFamily(keyType))];
+    }
+    return keyType == static_cast<uint8_t>(NebulaKeyType::kEdge) ? edgeExtractorLen_
+                                                                  : extractorLen_;
+  }
+
+  /**
+   * @brief Scan range [start, end) which may cross several key type column families. Empty end
+   * means no upper bound.
+   *
+   * @param start Start key, inclusive
+   * @param end End key, exclusive
+   * @param snapshot
+   * @param iter
+   * @return nebula::cpp2::ErrorCode
+   */
+  nebula::cpp2::ErrorCode rangeOfColumnFamilies(const std::string& start,
+                                                const std::string& end,
+                                                const void* snapshot,
+                                                std::unique_ptr<KVIterator>* iter);
+
+  /**
+   * @brief Ingest sst files when keys are stored by key type, a file with keys of several column
+   * families will be split first.
+   *
+   * @param files SST file path
+   * @param verifyFileChecksum Whether verify sst check-sum during ingestion
+   * @return nebula::cpp2::ErrorCode
+   */
+  nebula::cpp2::ErrorCode ingestByColumnFamily(const std::vector<std::string>& files,
+                                               bool verifyFileChecksum);
+
   /**
    * @brief System part key, indicate which partitions in rocksdb instance
    *
@@ -603,7 +804,18 @@ class RocksEngine : public KVEngine {
   std::unique_ptr<rocksdb::BackupEngine> backupDb_{nullptr};
   int32_t partsNum_ = -1;
   size_t extractorLen_;
+  // edge keys may have a longer prefix, see rocksdb_prefix_extractor
+  size_t edgeExtractorLen_;
   bool isPlainTable_{false};
+  // whether the lower levels are placed in a cold path, which rocksdb checkpoints don't support
+  bool tiered_{false};
+  // whether vertex, edge and index keys are stored in their own column families
+  bool keyTypeColumnFamilies_{false};
+  // indexed by KeyTypeColumnFamily, only used when keyTypeColumnFamilies_ is true
+  std::vector<rocksdb::ColumnFamilyHandle*> cfHandles_;
+  std::vector<size_t> cfExtractorLen_;
+  // all handles opened explicitly, need to be destroyed before db_
+  std::vector<rocksdb::ColumnFamilyHandle*> allHandles_;
 };
 
 }  // namespace kvstore
@@ -95,6 +95,14 @@ DEFINE_bool(enable_rocksdb_prefix_filtering,
             true,
             "Whether or not to enable rocksdb's prefix bloom filter.");
 
+DEFINE_string(rocksdb_prefix_extractor,
+              "vertex",
+              "Prefix used by prefix bloom filter, options: vertex, edge_type. "
+              "vertex: (part, vid) for all keys; edge_type: (part, srcVid, edgeType) for edge keys "
+              "and (part, vid) for others, scanning one edge type of a vertex could skip the data "
+              "blocks of other edge types, but scanning all edges of a vertex could not use the "
+              "prefix bloom filter any more.");
+
 DEFINE_bool(rocksdb_compact_change_level,
             true,
             "If true, compacted files will be moved to the minimum level capable "
@@ -142,6 +150,53 @@ DEFINE_bool(rocksdb_enable_blob_garbage_collection,
             "Set this to true to make BlobDB actively relocate valid blobs "
             "from the oldest blob files as they are encountered during compaction");
 
+DEFINE_bool(enable_rocksdb_key_type_column_families,
+            false,
+            "Whether to store vertex, edge and index keys of a space in separate column "
+            "families. Existing data is moved into (or back from) them when the space is opened. "
+            "Only BlockBasedTable is supported");
+
+DEFINE_string(rocksdb_vertex_column_family_options,
+              "{}",
+              "json string of ColumnFamilyOptions of vertex column family, "
+              "applied on top of rocksdb_column_family_options");
+
+DEFINE_string(rocksdb_edge_column_family_options,
+              "{}",
+              "json string of ColumnFamilyOptions of edge column family, "
+              "applied on top of rocksdb_column_family_options");
+
+DEFINE_string(rocksdb_index_column_family_options,
+              "{}",
+              "json string of ColumnFamilyOptions of index column family, "
+              "applied on top of rocksdb_column_family_options");
+
+DEFINE_string(rocksdb_vertex_block_based_table_options,
+              "{\"cache_index_and_filter_blocks_with_high_priority\":\"true\"}",
+              "json string of BlockBasedTableOptions of vertex column family, "
+              "applied on top of rocksdb_block_based_table_options");
+
+DEFINE_string(rocksdb_edge_block_based_table_options,
+              "{}",
+              "json string of BlockBasedTableOptions of edge column family, "
+              "applied on top of rocksdb_block_based_table_options");
+
+DEFINE_string(rocksdb_index_block_based_table_options,
+              "{\"block_size\":\"16384\"}",
+              "json string of BlockBasedTableOptions of index column family, "
+              "applied on top of rocksdb_block_based_table_options");
+
+DEFINE_int64(rocksdb_vertex_block_cache,
+             0,
+             "Size of a dedicated block cache for vertex column family, so that tags are not "
+             "evicted by edge scans. The unit is MB, 0 means share rocksdb_block_cache");
+
+DEFINE_int32(rocksdb_hot_tier_levels,
+             3,
+             "Number of upper levels (L0 included) kept in data_path when cold_data_path is set, "
+             "sst files of lower levels are placed in cold_data_path. Only leveled compaction is "
+             "supported, and level_compaction_dynamic_level_bytes is disabled by rocksdb");
+
 namespace nebula {
 namespace kvstore {
 
@@ -219,6 +274,41 @@ static rocksdb::Status initRocksdbKVSeparation(rocksdb::Options& baseOpts) {
   return rocksdb::Status::OK();
 }
 
+static rocksdb::Status initBlockBasedTableOptions(rocksdb::BlockBasedTableOptions& bbtOpts,
+                                                  const rocksdb::Options& baseOpts) {
+  // BlockBasedTableOptions
+  std::unordered_map<std::string, std::string> bbtOptsMap;
+  if (!loadOptionsMap(bbtOptsMap, FLAGS_rocksdb_block_based_table_options)) {
+    return rocksdb::Status::InvalidArgument();
+  }
+  auto s = GetBlockBasedTableOptionsFromMap(
+      rocksdb::BlockBasedTableOptions(), bbtOptsMap, &bbtOpts, true);
+  if (!s.ok()) {
+    return s;
+  }
+
+  if (FLAGS_rocksdb_block_cache <= 0) {
+    bbtOpts.no_block_cache = true;
+  } else {
+    static std::shared_ptr<rocksdb::Cache> blockCache =
+        rocksdb::NewLRUCache(FLAGS_rocksdb_block_cache * 1024 * 1024, FLAGS_cache_bucket_exp);
+    bbtOpts.block_cache = blockCache;
+  }
+
+  bbtOpts.filter_policy.reset(rocksdb::NewBloomFilterPolicy(10, false));
+  if (FLAGS_enable_partitioned_index_filter) {
+    bbtOpts.index_type = rocksdb::BlockBasedTableOptions::IndexType::kTwoLevelIndexSearch;
+    bbtOpts.partition_filters = true;
+    bbtOpts.cache_index_and_filter_blocks = true;
+    bbtOpts.cache_index_and_filter_blocks_with_high_priority = true;
+    bbtOpts.pin_top_level_index_and_filter = true;
+    bbtOpts.pin_l0_filter_and_index_blocks_in_cache =
+        baseOpts.compaction_style == rocksdb::CompactionStyle::kCompactionStyleLevel;
+  }
+  bbtOpts.whole_key_filtering = FLAGS_enable_rocksdb_whole_key_filtering;
+  return rocksdb::Status::OK();
+}
+
 rocksdb::Status initRocksdbOptions(rocksdb::Options& baseOpts,
                                    GraphSpaceID spaceId,
                                    int32_t vidLen) {
@@ -293,46 +383,27 @@ rocksdb::Status initRocksdbOptions(rocksdb::Options& baseOpts,
   }
 
   if (FLAGS_rocksdb_table_format == "BlockBasedTable") {
-    // BlockBasedTableOptions
-    std::unordered_map<std::string, std::string> bbtOptsMap;
-    if (!loadOptionsMap(bbtOptsMap, FLAGS_rocksdb_block_based_table_options)) {
-      return rocksdb::Status::InvalidArgument();
-    }
-    s = GetBlockBasedTableOptionsFromMap(
-        rocksdb::BlockBasedTableOptions(), bbtOptsMap, &bbtOpts, true);
+    s = initBlockBasedTableOptions(bbtOpts, baseOpts);
     if (!s.ok()) {
       return s;
     }
 
-    if (FLAGS_rocksdb_block_cache <= 0) {
-      bbtOpts.no_block_cache = true;
-    } else {
-      static std::shared_ptr<rocksdb::Cache> blockCache =
-          rocksdb::NewLRUCache(FLAGS_rocksdb_block_cache * 1024 * 1024, FLAGS_cache_bucket_exp);
-      bbtOpts.block_cache = blockCache;
-    }
-
     if (FLAGS_rocksdb_row_cache_num) {
       static std::shared_ptr<rocksdb::Cache> rowCache =
           rocksdb::NewLRUCache(FLAGS_rocksdb_row_cache_num, FLAGS_cache_bucket_exp);
       baseOpts.row_cache = rowCache;
     }
 
-    bbtOpts.filter_policy.reset(rocksdb::NewBloomFilterPolicy(10, false));
-    if (FLAGS_enable_partitioned_index_filter) {
-      bbtOpts.index_type = rocksdb::BlockBasedTableOptions::IndexType::kTwoLevelIndexSearch;
-      bbtOpts.partition_filters = true;
-      bbtOpts.cache_index_and_filter_blocks = true;
-      bbtOpts.cache_index_and_filter_blocks_with_high_priority = true;
-      bbtOpts.pin_top_level_index_and_filter = true;
-      bbtOpts.pin_l0_filter_and_index_blocks_in_cache =
-          baseOpts.compaction_style == rocksdb::CompactionStyle::kCompactionStyleLevel;
-    }
     if (FLAGS_enable_rocksdb_prefix_filtering) {
-      size_t prefixLength = sizeof(PartitionID) + vidLen;
-      baseOpts.prefix_extractor.reset(rocksdb::NewCappedPrefixTransform(prefixLength));
+      if (FLAGS_rocksdb_prefix_extractor == "edge_type") {
+        baseOpts.prefix_extractor.reset(new EdgeTypePrefixTransform(vidLen));
+      } else if (FLAGS_rocksdb_prefix_extractor == "vertex") {
+        size_t prefixLength = sizeof(PartitionID) + vidLen;
+        baseOpts.prefix_extractor.reset(rocksdb::NewCappedPrefixTransform(prefixLength));
+      } else {
+        return rocksdb::Status::InvalidArgument("Illegal rocksdb_prefix_extractor");
+      }
     }
-    bbtOpts.whole_key_filtering = FLAGS_enable_rocksdb_whole_key_filtering;
     baseOpts.table_factory.reset(NewBlockBasedTableFactory(bbtOpts));
     baseOpts.create_if_missing = true;
   } else if (FLAGS_rocksdb_table_format == "PlainTable") {
@@ -361,6 +432,174 @@ rocksdb::Status initRocksdbOptions(rocksdb::Options& baseOpts,
   return s;
 }
 
+KeyTypeColumnFamily keyTypeColumnFamily(uint8_t firstByte) {
+  switch (static_cast<NebulaKeyType>(firstByte)) {
+    case NebulaKeyType::kTag_:
+    case NebulaKeyType::kVertex:
+      return KeyTypeColumnFamily::kVertex;
+    case NebulaKeyType::kEdge:
+      return KeyTypeColumnFamily::kEdge;
+    case NebulaKeyType::kIndex:
+      return KeyTypeColumnFamily::kIndex;
+    default:
+      return KeyTypeColumnFamily::kDefault;
+  }
+}
+
+std::vector<KeyTypeColumnFamily> keyTypeColumnFamiliesInRange(folly::StringPiece start,
+                                                              folly::StringPiece end) {
+  uint32_t first = start.empty() ? 0 : static_cast<uint8_t>(start[0]);
+  uint32_t last = end.empty() ? 0xFF : static_cast<uint8_t>(end[0]);
+  std::vector<KeyTypeColumnFamily> ret;
+  for (auto b = first; b <= last; b++) {
+    auto cf = keyTypeColumnFamily(static_cast<uint8_t>(b));
+    if (std::find(ret.begin(), ret.end(), cf) == ret.end()) {
+      ret.emplace_back(cf);
+    }
+  }
+  return ret;
+}
+
+const std::string& keyTypeColumnFamilyName(KeyTypeColumnFamily cf) {
+  static const std::vector<std::string> kNames = {
+      rocksdb::kDefaultColumnFamilyName, "vertex", "edge", "index"};
+  return kNames[static_cast<size_t>(cf)];
+}
+
+size_t keyTypeColumnFamilyPrefixLength(KeyTypeColumnFamily cf, int32_t vidLen) {
+  if (cf == KeyTypeColumnFamily::kIndex) {
+    // index keys of one index are adjacent: type + part + indexId
+    return sizeof(PartitionID) + sizeof(IndexID);
+  }
+  if (cf == KeyTypeColumnFamily::kEdge) {
+    return prefixExtractorLength(static_cast<uint8_t>(NebulaKeyType::kEdge), vidLen);
+  }
+  return sizeof(PartitionID) + vidLen;
+}
+
+size_t prefixExtractorLength(uint8_t keyType, int32_t vidLen) {
+  if (FLAGS_rocksdb_prefix_extractor == "edge_type" &&
+      keyType == static_cast<uint8_t>(NebulaKeyType::kEdge)) {
+    // type + part + srcId + edgeType
+    return sizeof(PartitionID) + vidLen + sizeof(EdgeType);
+  }
+  return sizeof(PartitionID) + vidLen;
+}
+
+EdgeTypePrefixTransform::EdgeTypePrefixTransform(int32_t vidLen)
+    : vertexPrefixLen_(sizeof(PartitionID) + vidLen),
+      edgePrefixLen_(sizeof(PartitionID) + vidLen + sizeof(EdgeType)),
+      name_(folly::stringPrintf("nebula.EdgeTypePrefix.%d", vidLen)) {}
+
+rocksdb::Slice EdgeTypePrefixTransform::Transform(const rocksdb::Slice& key) const {
+  return rocksdb::Slice(key.data(), std::min(key.size(), prefixLen(key)));
+}
+
+size_t EdgeTypePrefixTransform::prefixLen(const rocksdb::Slice& key) const {
+  if (!key.empty() && static_cast<uint8_t>(key[0]) == static_cast<uint8_t>(NebulaKeyType::kEdge)) {
+    return edgePrefixLen_;
+  }
+  return vertexPrefixLen_;
+}
+
+rocksdb::Status initRocksdbColumnFamilyOptions(rocksdb::ColumnFamilyOptions& cfOpts,
+                                               const rocksdb::Options& baseOpts,
+                                               KeyTypeColumnFamily cf,
+                                               int32_t vidLen) {
+  cfOpts = rocksdb::ColumnFamilyOptions(baseOpts);
+  if (cf == KeyTypeColumnFamily::kDefault) {
+    return rocksdb::Status::OK();
+  }
+  if (FLAGS_rocksdb_table_format != "BlockBasedTable") {
+    return rocksdb::Status::NotSupported("Key type column family needs BlockBasedTable");
+  }
+
+  const std::string* cfOptsFlag = nullptr;
+  const std::string* bbtOptsFlag = nullptr;
+  switch (cf) {
+    case KeyTypeColumnFamily::kVertex:
+      cfOptsFlag = &FLAGS_rocksdb_vertex_column_family_options;
+      bbtOptsFlag = &FLAGS_rocksdb_vertex_block_based_table_options;
+      break;
+    case KeyTypeColumnFamily::kEdge:
+      cfOptsFlag = &FLAGS_rocksdb_edge_column_family_options;
+      bbtOptsFlag = &FLAGS_rocksdb_edge_block_based_table_options;
+      break;
+    case KeyTypeColumnFamily::kIndex:
+      cfOptsFlag = &FLAGS_rocksdb_index_column_family_options;
+      bbtOptsFlag = &FLAGS_rocksdb_index_block_based_table_options;
+      break;
+    default:
+      return rocksdb::Status::InvalidArgument("Unknown column family");
+  }
+
+  std::unordered_map<std::string, std::string> cfOptsMap;
+  if (!loadOptionsMap(cfOptsMap, *cfOptsFlag)) {
+    return rocksdb::Status::InvalidArgument();
+  }
+  auto s = GetColumnFamilyOptionsFromMap(
+      rocksdb::ColumnFamilyOptions(baseOpts), cfOptsMap, &cfOpts, true);
+  if (!s.ok()) {
+    return s;
+  }
+
+  rocksdb::BlockBasedTableOptions baseBbtOpts;
+  s = initBlockBasedTableOptions(baseBbtOpts, baseOpts);
+  if (!s.ok()) {
+    return s;
+  }
+  std::unordered_map<std::string, std::string> bbtOptsMap;
+  if (!loadOptionsMap(bbtOptsMap, *bbtOptsFlag)) {
+    return rocksdb::Status::InvalidArgument();
+  }
+  rocksdb::BlockBasedTableOptions bbtOpts;
+  s = GetBlockBasedTableOptionsFromMap(baseBbtOpts, bbtOptsMap, &bbtOpts, true);
+  if (!s.ok()) {
+    return s;
+  }
+  if (cf == KeyTypeColumnFamily::kVertex && FLAGS_rocksdb_vertex_block_cache > 0) {
+    static std::shared_ptr<rocksdb::Cache> vertexBlockCache = rocksdb::NewLRUCache(
+        FLAGS_rocksdb_vertex_block_cache * 1024 * 1024, FLAGS_cache_bucket_exp);
+    bbtOpts.no_block_cache = false;
+    bbtOpts.block_cache = vertexBlockCache;
+  }
+
+  if (FLAGS_enable_rocksdb_prefix_filtering) {
+    cfOpts.prefix_extractor.reset(
+        rocksdb::NewCappedPrefixTransform(keyTypeColumnFamilyPrefixLength(cf, vidLen)));
+  }
+  cfOpts.table_factory.reset(NewBlockBasedTableFactory(bbtOpts));
+  return rocksdb::Status::OK();
+}
+
+rocksdb::Status initTieredDbPaths(rocksdb::Options& baseOpts,
+                                  const std::string& hotPath,
+                                  const std::string& coldPath) {
+  // the paths are picked by the estimated size of the levels, which only leveled compaction has
+  if (baseOpts.compaction_style != rocksdb::CompactionStyle::kCompactionStyleLevel) {
+    return rocksdb::Status::NotSupported("cold_data_path only supports leveled compaction");
+  }
+  // the output of a compaction is placed in the first path which could hold the estimated size of
+  // all levels up to the output level, L0 is estimated as large as L1
+  uint64_t levelSize = baseOpts.max_bytes_for_level_base;
+  uint64_t hotSize = 0;
+  for (int32_t level = 0; level < FLAGS_rocksdb_hot_tier_levels; level++) {
+    hotSize += levelSize;
+    if (level > 0) {
+      levelSize = static_cast<uint64_t>(levelSize * baseOpts.max_bytes_for_level_multiplier);
+    }
+  }
+  if (baseOpts.level_compaction_dynamic_level_bytes) {
+    LOG(WARNING) << "level_compaction_dynamic_level_bytes is ignored with cold_data_path";
+  }
+  baseOpts.db_paths.clear();
+  baseOpts.db_paths.emplace_back(hotPath, hotSize);
+  baseOpts.db_paths.emplace_back(coldPath, std::numeric_limits<uint64_t>::max());
+  LOG(INFO) << "Place " << FLAGS_rocksdb_hot_tier_levels << " levels (" << hotSize
+            << " bytes) in " << hotPath << ", others in " << coldPath;
+  return rocksdb::Status::OK();
+}
+
 bool loadOptionsMap(std::unordered_map<std::string, std::string>& map, const std::string& gflags) {
   conf::Configuration conf;
   auto status = conf.parseFromString(gflags);
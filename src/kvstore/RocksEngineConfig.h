@@ -7,6 +7,7 @@
 #define KVSTORE_ROCKSENGINECONFIG_H_
 
 #include <rocksdb/db.h>
+#include <rocksdb/slice_transform.h>
 
 #include "common/base/Base.h"
 #include "common/thrift/ThriftTypes.h"
@@ -54,6 +55,7 @@ DECLARE_string(rocksdb_stats_level);
 
 DECLARE_bool(enable_rocksdb_prefix_filtering);
 DECLARE_bool(enable_rocksdb_whole_key_filtering);
+DECLARE_string(rocksdb_prefix_extractor);
 
 // rocksdb compact RangeOptions
 DECLARE_bool(rocksdb_compact_change_level);
@@ -67,9 +69,123 @@ DECLARE_int32(rocksdb_backup_interval_secs);
 DECLARE_bool(rocksdb_enable_kv_separation);
 DECLARE_uint64(rocksdb_kv_separation_threshold);
 
+// column family per key type
+DECLARE_bool(enable_rocksdb_key_type_column_families);
+DECLARE_string(rocksdb_vertex_column_family_options);
+DECLARE_string(rocksdb_edge_column_family_options);
+DECLARE_string(rocksdb_index_column_family_options);
+DECLARE_string(rocksdb_vertex_block_based_table_options);
+DECLARE_string(rocksdb_edge_block_based_table_options);
+DECLARE_string(rocksdb_index_block_based_table_options);
+DECLARE_int64(rocksdb_vertex_block_cache);
+
+// tiered storage
+DECLARE_int32(rocksdb_hot_tier_levels);
+
 namespace nebula {
 namespace kvstore {
 
+/**
+ * @brief Column families of a storage space when enable_rocksdb_key_type_column_families is on.
+ * A key is dispatched by its NebulaKeyType, which is the first byte of the key, so all keys of
+ * one column family are still sorted the same way as in a single column family.
+ */
+enum class KeyTypeColumnFamily : uint8_t {
+  kDefault = 0,  // system, operation, kv and toss keys
+  kVertex = 1,   // tag and vertex keys
+  kEdge = 2,
+  kIndex = 3,
+};
+
+static constexpr size_t kNumKeyTypeColumnFamilies = 4;
+
+/**
+ * @brief Return the column family which stores the keys start with given byte
+ *
+ * @param firstByte First byte of a key, which is the NebulaKeyType
+ * @return KeyTypeColumnFamily
+ */
+KeyTypeColumnFamily keyTypeColumnFamily(uint8_t firstByte);
+
+/**
+ * @brief Return the column families which may contain keys in range [start, end)
+ *
+ * @param start Start key, inclusive
+ * @param end End key, exclusive, empty means no upper bound
+ * @return std::vector<KeyTypeColumnFamily>
+ */
+std::vector<KeyTypeColumnFamily> keyTypeColumnFamiliesInRange(folly::StringPiece start,
+                                                              folly::StringPiece end);
+
+/**
+ * @brief Return the rocksdb name of column family
+ */
+const std::string &keyTypeColumnFamilyName(KeyTypeColumnFamily cf);
+
+/**
+ * @brief Length of prefix extractor of the column family
+ *
+ * @param cf
+ * @param vidLen
+ * @return size_t
+ */
+size_t keyTypeColumnFamilyPrefixLength(KeyTypeColumnFamily cf, int32_t vidLen);
+
+/**
+ * @brief Length of prefix extractor for keys of given NebulaKeyType in BlockBasedTable, depends
+ * on rocksdb_prefix_extractor. A prefix shorter than it can't use the prefix bloom filter.
+ *
+ * @param keyType First byte of a key, which is the NebulaKeyType
+ * @param vidLen
+ * @return size_t
+ */
+size_t prefixExtractorLength(uint8_t keyType, int32_t vidLen);
+
+/**
+ * @brief Prefix extractor when rocksdb_prefix_extractor is edge_type. Edge keys are capped at
+ * (part, srcId, edgeType), so all edges of one type of a vertex share a prefix in bloom filter, and
+ * other keys are capped at (part, vid) as the default capped prefix extractor.
+ */
+class EdgeTypePrefixTransform : public rocksdb::SliceTransform {
+ public:
+  explicit EdgeTypePrefixTransform(int32_t vidLen);
+
+  const char *Name() const override {
+    return name_.c_str();
+  }
+
+  rocksdb::Slice Transform(const rocksdb::Slice &key) const override;
+
+  bool InDomain(const rocksdb::Slice &) const override {
+    return true;
+  }
+
+  bool SameResultWhenAppended(const rocksdb::Slice &prefix) const override {
+    return prefix.size() >= prefixLen(prefix);
+  }
+
+ private:
+  size_t prefixLen(const rocksdb::Slice &key) const;
+
+  size_t vertexPrefixLen_;
+  size_t edgePrefixLen_;
+  std::string name_;
+};
+
+/**
+ * @brief Build the options of a key type column family, based on the options of the default one
+ *
+ * @param cfOpts Options of the column family
+ * @param baseOpts Rocksdb options built by initRocksdbOptions
+ * @param cf
+ * @param vidLen
+ * @return rocksdb::Status
+ */
+rocksdb::Status initRocksdbColumnFamilyOptions(rocksdb::ColumnFamilyOptions &cfOpts,
+                                               const rocksdb::Options &baseOpts,
+                                               KeyTypeColumnFamily cf,
+                                               int32_t vidLen);
+
 /**
  * @brief Build rocksdb options form gflags
  *
@@ -82,6 +198,20 @@ rocksdb::Status initRocksdbOptions(rocksdb::Options &baseOpts,
                                    GraphSpaceID spaceId,
                                    int32_t vidLen = 8);
 
+/**
+ * @brief Place the upper levels of rocksdb in the hot path and the lower levels in the cold path,
+ * by db_paths (column families without cf_paths share it). The memtable is always flushed into the
+ * hot path, and the rocksdb wal stays in the data dir.
+ *
+ * @param baseOpts Rocksdb options built by initRocksdbOptions
+ * @param hotPath Data dir of rocksdb
+ * @param coldPath Data dir in the cold path
+ * @return rocksdb::Status NotSupported if the compaction is not leveled
+ */
+rocksdb::Status initTieredDbPaths(rocksdb::Options &baseOpts,
+                                  const std::string &hotPath,
+                                  const std::string &coldPath);
+
 /**
  * @brief Load a gflag into map
  *
@@ -11,6 +11,7 @@
 
 #include "common/network/NetworkUtils.h"
 #include "common/stats/StatsManager.h"
+#include "common/thrift/ThriftCompression.h"
 #include "common/time/WallClock.h"
 #include "kvstore/raftex/RaftPart.h"
 #include "kvstore/stats/KVStats.h"
@@ -400,6 +401,7 @@ folly::Future<cpp2::AppendLogResponse> Host::sendAppendLogRequest(
                                << req->get_last_log_term_sent() << ", last_log_id_sent "
                                << req->get_last_log_id_sent() << ", logs in request "
                                << req->get_log_str_list().size();
+  thrift::sampleCompression(*req, kRaftRpcCompressedPercent, kRaftRpcCompressionUs);
   // Get client connection
   auto client = part_->clientMan_->client(addr_, eb, false, FLAGS_raft_rpc_timeout_ms);
   return client->future_appendLog(*req);
@@ -7,7 +7,9 @@
 
 #include <thrift/lib/cpp/util/EnumUtils.h>
 
+#include "common/thrift/ThriftCompression.h"
 #include "kvstore/raftex/RaftPart.h"
+#include "kvstore/stats/KVStats.h"
 
 DEFINE_int32(snapshot_worker_threads, 4, "Threads number for snapshot");
 DEFINE_int32(snapshot_io_threads, 4, "Threads number for snapshot");
@@ -129,6 +131,7 @@ folly::Future<raftex::cpp2::SendSnapshotResponse> SnapshotManager::send(
   req.total_size_ref() = totalSize;
   req.total_count_ref() = totalCount;
   req.done_ref() = finished;
+  thrift::sampleCompression(req, kRaftRpcCompressedPercent, kRaftRpcCompressionUs);
   auto* evb = ioThreadPool_->getEventBase();
   return folly::via(evb, [this, addr, evb, req = std::move(req)]() mutable {
     auto client = connManager_.client(addr, evb, false, FLAGS_snapshot_send_timeout_ms);
@@ -19,6 +19,10 @@ stats::CounterId kTransferLeaderLatencyUs;
 stats::CounterId kNumStartElect;
 stats::CounterId kNumGrantVotes;
 stats::CounterId kNumSendSnapshot;
+stats::CounterId kRaftRpcCompressedPercent;
+stats::CounterId kRaftRpcCompressionUs;
+stats::CounterId kDiskFreeBytes;
+stats::CounterId kDiskCapacityBytes;
 
 void initKVStats() {
   kCommitLogLatencyUs = stats::StatsManager::registerHisto(
@@ -36,6 +40,12 @@ void initKVStats() {
   kNumStartElect = stats::StatsManager::registerStats("num_start_elect", "rate, sum");
   kNumGrantVotes = stats::StatsManager::registerStats("num_grant_votes", "rate, sum");
   kNumSendSnapshot = stats::StatsManager::registerStats("num_send_snapshot", "rate, sum");
+  kRaftRpcCompressedPercent = stats::StatsManager::registerHisto(
+      "raft_rpc_compressed_percent", 1, 0, 100, "avg, p75, p95, p99, p999");
+  kRaftRpcCompressionUs = stats::StatsManager::registerHisto(
+      "raft_rpc_compression_us", 1000, 0, 2000000, "avg, p75, p95, p99, p999");
+  kDiskFreeBytes = stats::StatsManager::registerStats("disk_free_bytes", "avg");
+  kDiskCapacityBytes = stats::StatsManager::registerStats("disk_capacity_bytes", "avg");
 }
 
 }  // namespace nebula
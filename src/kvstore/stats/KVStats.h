@@ -21,6 +21,13 @@ extern stats::CounterId kTransferLeaderLatencyUs;
 extern stats::CounterId kNumStartElect;
 extern stats::CounterId kNumGrantVotes;
 extern stats::CounterId kNumSendSnapshot;
+// Sampled compression of the raft requests, see thrift::sampleCompression
+extern stats::CounterId kRaftRpcCompressedPercent;
+extern stats::CounterId kRaftRpcCompressionUs;
+
+// Disk related stats, labeled by tier (hot or cold)
+extern stats::CounterId kDiskFreeBytes;
+extern stats::CounterId kDiskCapacityBytes;
 
 void initKVStats();
 
@@ -178,6 +178,47 @@ TEST(DiskManagerTest, GetDiskPartsTest) {
   ASSERT_EQ(10, diskParts[spaceId2][path3].get_part_list().size());
 }
 
+TEST(DiskManagerTest, TieredPathTest) {
+  GraphSpaceID spaceId = 1;
+  fs::TempDir disk1("/tmp/disk_man_test.XXXXXX");
+  auto path1 = folly::stringPrintf("%s/nebula/%d", disk1.path(), spaceId);
+  boost::filesystem::create_directories(path1);
+  fs::TempDir disk2("/tmp/disk_man_test.XXXXXX");
+  auto path2 = folly::stringPrintf("%s/nebula/%d", disk2.path(), spaceId);
+  boost::filesystem::create_directories(path2);
+  fs::TempDir cold("/tmp/disk_man_test.XXXXXX");
+
+  {
+    std::vector<std::string> dataPaths = {disk1.path(), disk2.path()};
+    DiskManager diskMan(dataPaths);
+    EXPECT_FALSE(diskMan.coldPath(disk1.path()).ok());
+  }
+
+  std::vector<std::string> dataPaths = {disk1.path(), disk2.path()};
+  std::vector<std::string> coldPaths = {cold.path()};
+  DiskManager diskMan(dataPaths, nullptr, coldPaths);
+  auto coldCanonical = boost::filesystem::canonical(cold.path()).string();
+  // both data paths share the only cold path
+  for (const auto& dataPath : dataPaths) {
+    auto ret = diskMan.coldPath(dataPath);
+    ASSERT_TRUE(ret.ok());
+    EXPECT_EQ(coldCanonical, ret.value());
+  }
+  EXPECT_FALSE(diskMan.coldPath(cold.path()).ok());
+
+  diskMan.addPartToPath(spaceId, 1, path1);
+  diskMan.addPartToPath(spaceId, 2, path2);
+  diskMan.freeBytes_[0] = FLAGS_minimum_reserved_bytes;
+  diskMan.freeBytes_[1] = FLAGS_minimum_reserved_bytes;
+  diskMan.freeBytes_[2] = FLAGS_minimum_reserved_bytes;
+  EXPECT_TRUE(diskMan.hasEnoughSpace(spaceId, 1));
+  EXPECT_TRUE(diskMan.hasEnoughSpace(spaceId, 2));
+  // the cold path is full, which would make compaction fail
+  diskMan.freeBytes_[2] = 0;
+  EXPECT_FALSE(diskMan.hasEnoughSpace(spaceId, 1));
+  EXPECT_FALSE(diskMan.hasEnoughSpace(spaceId, 2));
+}
+
 }  // namespace kvstore
 }  // namespace nebula
 
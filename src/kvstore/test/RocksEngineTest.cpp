@@ -3,13 +3,16 @@
  * This source code is licensed under Apache 2.0 License.
  */
 
+#include <folly/ScopeGuard.h>
 #include <folly/lang/Bits.h>
 #include <gtest/gtest.h>
 #include <rocksdb/db.h>
 #include <rocksdb/table.h>
 
 #include "common/base/Base.h"
+#include "common/fs/FileUtils.h"
 #include "common/fs/TempDir.h"
+#include "common/utils/IndexKeyUtils.h"
 #include "common/utils/NebulaKeyUtils.h"
 #include "kvstore/RocksEngine.h"
 #include "kvstore/RocksEngineConfig.h"
@@ -908,6 +911,242 @@ TEST(RebuildPrefixBloomFilter, RebuildPrefixBloomFilter) {
   checkNewData();
 }
 
+TEST(KeyTypeColumnFamilyTest, MigrateTest) {
+  fs::TempDir dataPath("/tmp/rocksdb_engine_KeyTypeColumnFamilyTest.XXXXXX");
+  GraphSpaceID spaceId = 1;
+  PartitionID partId = 1;
+  std::vector<std::string> keys = {
+      NebulaKeyUtils::tagKey(kDefaultVIdLen, partId, "vertex", 1),
+      NebulaKeyUtils::edgeKey(kDefaultVIdLen, partId, "src", 1, 0, "dst"),
+      NebulaKeyUtils::edgeKey(kDefaultVIdLen, partId, "src", 2, 0, "dst"),
+      IndexKeyUtils::indexPrefix(partId, 1) + "index",
+  };
+
+  auto checkData = [&](RocksEngine* engine) {
+    for (const auto& key : keys) {
+      std::string val;
+      EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->get(key, &val));
+      EXPECT_EQ(key, val);
+    }
+    std::unique_ptr<KVIterator> iter;
+    auto prefix = NebulaKeyUtils::edgePrefix(kDefaultVIdLen, partId, "src");
+    EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->prefix(prefix, &iter));
+    int32_t count = 0;
+    for (; iter->valid(); iter->next()) {
+      count++;
+    }
+    EXPECT_EQ(2, count);
+
+    // keys across column families are still returned in order
+    EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->scan(&iter));
+    std::string prev;
+    size_t found = 0;
+    for (; iter->valid(); iter->next()) {
+      auto key = iter->key().str();
+      EXPECT_LT(prev, key);
+      if (std::find(keys.begin(), keys.end(), key) != keys.end()) {
+        found++;
+      }
+      prev = std::move(key);
+    }
+    EXPECT_EQ(keys.size(), found);
+
+    // and in the reverse order when moving backward across column families
+    std::vector<std::string> all;
+    EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->scan(&iter));
+    for (; iter->valid(); iter->next()) {
+      all.emplace_back(iter->key().str());
+    }
+    ASSERT_FALSE(all.empty());
+    EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->scan(&iter));
+    for (size_t i = 1; i < all.size(); i++) {
+      iter->next();
+    }
+    for (auto i = all.size(); i > 0; i--) {
+      ASSERT_TRUE(iter->valid());
+      EXPECT_EQ(all[i - 1], iter->key().str());
+      iter->prev();
+    }
+    EXPECT_FALSE(iter->valid());
+    EXPECT_EQ(std::vector<PartitionID>{partId}, engine->allParts());
+  };
+
+  {
+    FLAGS_enable_rocksdb_key_type_column_families = false;
+    auto engine = std::make_unique<RocksEngine>(spaceId, kDefaultVIdLen, dataPath.path());
+    engine->addPart(partId);
+    std::vector<KV> data;
+    for (const auto& key : keys) {
+      data.emplace_back(key, key);
+    }
+    EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->multiPut(std::move(data)));
+    EXPECT_FALSE(engine->keyTypeColumnFamilies_);
+    checkData(engine.get());
+  }
+  {
+    LOG(INFO) << "Enable key type column families, data should be moved";
+    FLAGS_enable_rocksdb_key_type_column_families = true;
+    auto engine = std::make_unique<RocksEngine>(spaceId, kDefaultVIdLen, dataPath.path());
+    EXPECT_TRUE(engine->keyTypeColumnFamilies_);
+    checkData(engine.get());
+
+    // edge is only in edge column family
+    std::string val;
+    auto* edgeCf = engine->cfHandles_[static_cast<size_t>(KeyTypeColumnFamily::kEdge)];
+    EXPECT_TRUE(engine->db_->Get(rocksdb::ReadOptions(), edgeCf, keys[1], &val).ok());
+    EXPECT_TRUE(engine->db_->Get(rocksdb::ReadOptions(), keys[1], &val).IsNotFound());
+
+    EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->remove(keys[2]));
+    EXPECT_EQ(nebula::cpp2::ErrorCode::E_KEY_NOT_FOUND, engine->get(keys[2], &val));
+    EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->put(keys[2], keys[2]));
+    EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->flush());
+    checkData(engine.get());
+  }
+  {
+    LOG(INFO) << "Disable key type column families, data should be moved back";
+    FLAGS_enable_rocksdb_key_type_column_families = false;
+    auto engine = std::make_unique<RocksEngine>(spaceId, kDefaultVIdLen, dataPath.path());
+    EXPECT_FALSE(engine->keyTypeColumnFamilies_);
+    checkData(engine.get());
+  }
+}
+
+TEST(EdgeTypePrefixExtractorTest, PrefixTest) {
+  fs::TempDir dataPath("/tmp/rocksdb_engine_EdgeTypePrefixExtractorTest.XXXXXX");
+  FLAGS_enable_rocksdb_prefix_filtering = true;
+  FLAGS_rocksdb_table_format = "BlockBasedTable";
+  GraphSpaceID spaceId = 1;
+  PartitionID partId = 1;
+
+  auto count = [](RocksEngine* engine, const std::string& prefix) {
+    std::unique_ptr<KVIterator> iter;
+    EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->prefix(prefix, &iter));
+    int32_t num = 0;
+    while (iter->valid()) {
+      EXPECT_TRUE(iter->key().startsWith(prefix));
+      num++;
+      iter->next();
+    }
+    return num;
+  };
+  auto checkData = [&](RocksEngine* engine) {
+    for (auto src : {"1", "2"}) {
+      for (EdgeType edgeType = 1; edgeType <= 3; edgeType++) {
+        auto outPrefix = NebulaKeyUtils::edgePrefix(kDefaultVIdLen, partId, src, edgeType);
+        auto inPrefix = NebulaKeyUtils::edgePrefix(kDefaultVIdLen, partId, src, -edgeType);
+        EXPECT_EQ(10, count(engine, outPrefix));
+        EXPECT_EQ(10, count(engine, inPrefix));
+      }
+      // prefix of all edges of a vertex is shorter than the extractor, but still works
+      EXPECT_EQ(60, count(engine, NebulaKeyUtils::edgePrefix(kDefaultVIdLen, partId, src)));
+      EXPECT_EQ(1, count(engine, NebulaKeyUtils::tagPrefix(kDefaultVIdLen, partId, src)));
+    }
+    EXPECT_EQ(0, count(engine, NebulaKeyUtils::edgePrefix(kDefaultVIdLen, partId, "1", 4)));
+    EXPECT_EQ(120, count(engine, NebulaKeyUtils::edgePrefix(partId)));
+  };
+
+  {
+    FLAGS_rocksdb_prefix_extractor = "edge_type";
+    auto engine = std::make_unique<RocksEngine>(spaceId, kDefaultVIdLen, dataPath.path());
+    std::vector<KV> data;
+    for (auto src : {"1", "2"}) {
+      data.emplace_back(NebulaKeyUtils::tagKey(kDefaultVIdLen, partId, src, 1), "tag");
+      for (EdgeType edgeType = 1; edgeType <= 3; edgeType++) {
+        for (auto dst = 0; dst < 10; dst++) {
+          auto dstId = folly::to<std::string>(dst);
+          data.emplace_back(
+              NebulaKeyUtils::edgeKey(kDefaultVIdLen, partId, src, edgeType, 0, dstId), "out");
+          data.emplace_back(
+              NebulaKeyUtils::edgeKey(kDefaultVIdLen, partId, src, -edgeType, 0, dstId), "in");
+        }
+      }
+    }
+    EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->multiPut(std::move(data)));
+    checkData(engine.get());
+    EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->flush());
+    checkData(engine.get());
+  }
+  {
+    LOG(INFO) << "Reopen with default extractor, sst built by edge_type is still readable";
+    FLAGS_rocksdb_prefix_extractor = "vertex";
+    auto engine = std::make_unique<RocksEngine>(spaceId, kDefaultVIdLen, dataPath.path());
+    checkData(engine.get());
+    EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->compact());
+    checkData(engine.get());
+  }
+}
+
+TEST(TieredStorageTest, LowerLevelsInColdPath) {
+  fs::TempDir dataPath("/tmp/rocksdb_engine_TieredStorageTest.XXXXXX");
+  fs::TempDir coldPath("/tmp/rocksdb_engine_TieredStorageTest.cold.XXXXXX");
+  FLAGS_rocksdb_table_format = "BlockBasedTable";
+  // only L0 is kept in the hot path
+  auto hotTierLevels = FLAGS_rocksdb_hot_tier_levels;
+  FLAGS_rocksdb_hot_tier_levels = 1;
+  SCOPE_EXIT {
+    FLAGS_rocksdb_hot_tier_levels = hotTierLevels;
+  };
+  GraphSpaceID spaceId = 1;
+  PartitionID partId = 1;
+  auto hotDir = folly::stringPrintf("%s/nebula/%d/data", dataPath.path(), spaceId);
+  auto coldDir = folly::stringPrintf("%s/nebula/%d/data", coldPath.path(), spaceId);
+  auto countSst = [](const std::string& dir) {
+    auto files = fs::FileUtils::listAllFilesInDir(dir.c_str(), false, "*.sst");
+    return static_cast<int32_t>(files.size());
+  };
+  auto checkData = [&](RocksEngine* engine) {
+    for (int32_t i = 0; i < 100; i++) {
+      std::string val;
+      auto key = NebulaKeyUtils::tagKey(kDefaultVIdLen, partId, folly::to<std::string>(i), 1);
+      EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->get(key, &val));
+      EXPECT_EQ(folly::to<std::string>(i), val);
+    }
+  };
+
+  {
+    auto engine = std::make_unique<RocksEngine>(
+        spaceId, kDefaultVIdLen, dataPath.path(), "", nullptr, nullptr, false, coldPath.path());
+    std::vector<KV> data;
+    for (int32_t i = 0; i < 100; i++) {
+      auto vId = folly::to<std::string>(i);
+      data.emplace_back(NebulaKeyUtils::tagKey(kDefaultVIdLen, partId, vId, 1), vId);
+    }
+    EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->multiPut(std::move(data)));
+    // memtable is flushed into L0 in the hot path
+    EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->flush());
+    EXPECT_EQ(1, countSst(hotDir));
+    EXPECT_EQ(0, countSst(coldDir));
+    // compaction output in lower levels is placed in the cold path
+    EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->compact());
+    EXPECT_EQ(0, countSst(hotDir));
+    EXPECT_EQ(1, countSst(coldDir));
+    checkData(engine.get());
+  }
+  {
+    LOG(INFO) << "Reopen, sst files in the cold path are still found";
+    auto engine = std::make_unique<RocksEngine>(
+        spaceId, kDefaultVIdLen, dataPath.path(), "", nullptr, nullptr, false, coldPath.path());
+    checkData(engine.get());
+
+    // rocksdb checkpoints don't support more than one path
+    auto checkpoint = folly::stringPrintf("%s/checkpoints/snapshot", dataPath.path());
+    EXPECT_EQ(nebula::cpp2::ErrorCode::E_UNSUPPORTED, engine->createCheckpoint(checkpoint));
+  }
+}
+
+TEST(TieredStorageTest, OnlyLeveledCompaction) {
+  rocksdb::Options options;
+  options.compaction_style = rocksdb::CompactionStyle::kCompactionStyleUniversal;
+  EXPECT_TRUE(initTieredDbPaths(options, "/hot", "/cold").IsNotSupported());
+  EXPECT_TRUE(options.db_paths.empty());
+
+  options.compaction_style = rocksdb::CompactionStyle::kCompactionStyleLevel;
+  EXPECT_TRUE(initTieredDbPaths(options, "/hot", "/cold").ok());
+  ASSERT_EQ(2, options.db_paths.size());
+  EXPECT_EQ("/hot", options.db_paths[0].path);
+  EXPECT_EQ("/cold", options.db_paths[1].path);
+}
+
 }  // namespace kvstore
 }  // namespace nebula
 
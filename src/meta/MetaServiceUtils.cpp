@@ -214,6 +214,11 @@ nebula::cpp2::ErrorCode MetaServiceUtils::alterSchemaProp(std::vector<cpp2::Colu
     schemaProp.comment_ref() = *alterSchemaProp.comment_ref();
   }
 
+  // the rows written before keep their format
+  if (alterSchemaProp.row_format_ref().has_value()) {
+    schemaProp.row_format_ref() = *alterSchemaProp.row_format_ref();
+  }
+
   return nebula::cpp2::ErrorCode::SUCCEEDED;
 }
 
@@ -19,8 +19,9 @@ IngestJobExecutor::IngestJobExecutor(GraphSpaceID space,
     : SimpleConcurrentJobExecutor(space, jobId, kvstore, adminClient, paras) {}
 
 nebula::cpp2::ErrorCode IngestJobExecutor::check() {
-  return paras_.empty() ? nebula::cpp2::ErrorCode::SUCCEEDED
-                        : nebula::cpp2::ErrorCode::E_INVALID_JOB;
+  // an optional path of csv files to bulk load from
+  return paras_.size() <= 1 ? nebula::cpp2::ErrorCode::SUCCEEDED
+                            : nebula::cpp2::ErrorCode::E_INVALID_JOB;
 }
 
 nebula::cpp2::ErrorCode IngestJobExecutor::prepare() {
@@ -37,7 +38,7 @@ folly::Future<Status> IngestJobExecutor::executeInternal(HostAddr&& address,
                 taskId_++,
                 space_,
                 std::move(address),
-                {},
+                paras_,
                 std::move(parts))
       .then([pro = std::move(pro)](auto&& t) mutable {
         CHECK(!t.hasException());
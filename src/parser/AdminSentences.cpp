@@ -260,7 +260,10 @@ std::string AdminJobSentence::toString() const {
         case meta::cpp2::JobType::DOWNLOAD:
           return folly::stringPrintf("SUBMIT JOB DOWNLOAD HDFS \"%s\"", paras_[0].c_str());
         case meta::cpp2::JobType::INGEST:
-          return "SUBMIT JOB INGEST";
+          if (paras_.empty()) {
+            return "SUBMIT JOB INGEST";
+          }
+          return folly::stringPrintf("SUBMIT JOB INGEST FROM \"%s\"", paras_[0].c_str());
         case meta::cpp2::JobType::DATA_BALANCE:
           if (paras_.empty()) {
             return "SUBMIT JOB BALANCE IN ZONE";
@@ -24,6 +24,8 @@ std::string SchemaPropItem::toString() const {
       return folly::stringPrintf("ttl_col = \"%s\"", std::get<std::string>(propValue_).c_str());
     case COMMENT:
       return folly::stringPrintf("comment = \"%s\"", std::get<std::string>(propValue_).c_str());
+    case ROW_FORMAT:
+      return folly::stringPrintf("row_format = %ld", std::get<int64_t>(propValue_));
   }
   DLOG(FATAL) << "Schema property type illegal";
   return "";
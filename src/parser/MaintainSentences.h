@@ -190,7 +190,7 @@ class SchemaPropItem final {
  public:
   using Value = std::variant<int64_t, bool, std::string>;
 
-  enum PropType : uint8_t { TTL_DURATION, TTL_COL, COMMENT };
+  enum PropType : uint8_t { TTL_DURATION, TTL_COL, COMMENT, ROW_FORMAT };
 
   SchemaPropItem(PropType op, int64_t val) {
     propType_ = op;
@@ -227,6 +227,16 @@ class SchemaPropItem final {
     }
   }
 
+  StatusOr<int64_t> getRowFormat() {
+    if (isInt()) {
+      return asInt();
+    } else {
+      std::visit([](const auto &val) { LOG(ERROR) << "Row_format value illegal: " << val; },
+                 propValue_);
+      return Status::Error("Row_format value illegal");
+    }
+  }
+
   StatusOr<std::string> getComment() {
     if (propType_ == COMMENT) {
       return asString();
@@ -183,7 +183,7 @@ using namespace nebula;
 %token KW_IF KW_NOT KW_EXISTS KW_WITH
 %token KW_BY KW_DOWNLOAD KW_HDFS KW_UUID KW_CONFIGS KW_FORCE
 %token KW_GET KW_DECLARE KW_GRAPH KW_META KW_STORAGE KW_AGENT
-%token KW_TTL KW_TTL_DURATION KW_TTL_COL KW_DATA KW_STOP
+%token KW_TTL KW_TTL_DURATION KW_TTL_COL KW_ROW_FORMAT KW_DATA KW_STOP
 %token KW_FETCH KW_PROP KW_UPDATE KW_UPSERT KW_WHEN
 %token KW_ORDER KW_ASC KW_LIMIT KW_SAMPLE KW_OFFSET KW_ASCENDING KW_DESCENDING
 %token KW_DISTINCT KW_ALL KW_OF
@@ -506,6 +506,7 @@ unreserved_keyword
     | KW_ATOMIC_EDGE        { $$ = new std::string("atomic_edge"); }
     | KW_TTL_DURATION       { $$ = new std::string("ttl_duration"); }
     | KW_TTL_COL            { $$ = new std::string("ttl_col"); }
+    | KW_ROW_FORMAT         { $$ = new std::string("row_format"); }
     | KW_SNAPSHOT           { $$ = new std::string("snapshot"); }
     | KW_SNAPSHOTS          { $$ = new std::string("snapshots"); }
     | KW_GRAPH              { $$ = new std::string("graph"); }
@@ -2432,6 +2433,9 @@ create_schema_prop_item
         $$ = new SchemaPropItem(SchemaPropItem::TTL_COL, *$3);
         delete $3;
     }
+    | KW_ROW_FORMAT ASSIGN legal_integer {
+        $$ = new SchemaPropItem(SchemaPropItem::ROW_FORMAT, $3);
+    }
     | comment_prop_assignment {
         $$ = new SchemaPropItem(SchemaPropItem::COMMENT, *$1);
         delete $1;
@@ -2504,6 +2508,9 @@ alter_schema_prop_item
         $$ = new SchemaPropItem(SchemaPropItem::TTL_COL, *$3);
         delete $3;
     }
+    | KW_ROW_FORMAT ASSIGN legal_integer {
+        $$ = new SchemaPropItem(SchemaPropItem::ROW_FORMAT, $3);
+    }
     | comment_prop_assignment {
         $$ = new SchemaPropItem(SchemaPropItem::COMMENT, *$1);
         delete $1;
@@ -3325,6 +3332,13 @@ admin_job_sentence
                                              meta::cpp2::JobType::INGEST);
         $$ = sentence;
     }
+    | KW_SUBMIT KW_JOB KW_INGEST KW_FROM STRING {
+        auto sentence = new AdminJobSentence(meta::cpp2::JobOp::ADD,
+                                             meta::cpp2::JobType::INGEST);
+        sentence->addPara(*$5);
+        $$ = sentence;
+        delete $5;
+    }
     | KW_SUBMIT KW_JOB KW_STATS {
         auto sentence = new AdminJobSentence(meta::cpp2::JobOp::ADD,
                                              meta::cpp2::JobType::STATS);
@@ -3099,6 +3099,8 @@ TEST_F(ParserTest, JobTest) {
             "SUBMIT JOB DOWNLOAD HDFS \"hdfs://127.0.0.1:9090/data\"");
 
   checkTest("SUBMIT JOB INGEST", "SUBMIT JOB INGEST");
+  checkTest("SUBMIT JOB INGEST FROM \"/data/bulk_load\"",
+            "SUBMIT JOB INGEST FROM \"/data/bulk_load\"");
 
   checkTest("SUBMIT JOB STATS", "SUBMIT JOB STATS");
   checkTest("SUBMIT JOB BALANCE LEADER", "SUBMIT JOB BALANCE LEADER");
@@ -341,6 +341,8 @@ TEST(Scanner, Basic) {
       CHECK_SEMANTIC_TYPE("TTL_COL", TokenType::KW_TTL_COL),
       CHECK_SEMANTIC_TYPE("ttl_col", TokenType::KW_TTL_COL),
       CHECK_SEMANTIC_TYPE("Ttl_col", TokenType::KW_TTL_COL),
+      CHECK_SEMANTIC_TYPE("ROW_FORMAT", TokenType::KW_ROW_FORMAT),
+      CHECK_SEMANTIC_TYPE("row_format", TokenType::KW_ROW_FORMAT),
       CHECK_SEMANTIC_TYPE("DOWNLOAD", TokenType::KW_DOWNLOAD),
       CHECK_SEMANTIC_TYPE("download", TokenType::KW_DOWNLOAD),
       CHECK_SEMANTIC_TYPE("Download", TokenType::KW_DOWNLOAD),
@@ -167,6 +167,9 @@ StatusOr<std::string> BaseProcessor<RESP>::encodeRowVal(const meta::NebulaSchema
     return Status::Error("Add field failed");
   }
 
+  if (schema->getRowFormat() == 3) {
+    return RowWriterV3::encode(schema, rowWrite.getEncodedStr());
+  }
   return std::move(rowWrite).moveEncodedStr();
 }
 
@@ -6,6 +6,7 @@
 #ifndef STORAGE_BASEPROCESSOR_H_
 #define STORAGE_BASEPROCESSOR_H_
 
+#include <folly/Random.h>
 #include <folly/SpinLock.h>
 #include <folly/futures/Future.h>
 #include <folly/futures/Promise.h>
@@ -13,11 +14,14 @@
 
 #include "codec/RowReaderWrapper.h"
 #include "codec/RowWriterV2.h"
+#include "codec/RowWriterV3.h"
 #include "common/base/Base.h"
 #include "common/stats/StatsManager.h"
 #include "common/time/Duration.h"
 #include "common/utils/IndexKeyUtils.h"
+#include "kvstore/ReadPerfContext.h"
 #include "storage/CommonUtils.h"
+#include "storage/StorageFlags.h"
 
 namespace nebula {
 namespace storage {
@@ -51,6 +55,7 @@ class BaseProcessor {
     if (!profileDetail_.empty()) {
       this->result_.latency_detail_us_ref() = std::move(profileDetail_);
     }
+    reportProfileCounters();
     this->result_.failed_parts_ref() = this->codes_;
     this->resp_.result_ref() = std::move(this->result_);
     this->promise_.setValue(std::move(this->resp_));
@@ -75,6 +80,7 @@ class BaseProcessor {
     if (!profileDetail_.empty()) {
       this->result_.latency_detail_us_ref() = std::move(profileDetail_);
     }
+    reportProfileCounters();
 
     cpp2::PartitionResult thriftRet;
     thriftRet.code_ref() = memoryExceeded_ ? nebula::cpp2::ErrorCode::E_STORAGE_MEMORY_EXCEEDED
@@ -138,6 +144,44 @@ class BaseProcessor {
                                      const std::vector<Value>& props,
                                      WriteResult& wRet);
 
+  // Count the rocksdb reads of the request if it's profiled, or sampled by
+  // --perf_context_sample_interval
+  void initPerfContextFlag() {
+    perfContextFlag_ = profileDetailFlag_ ||
+                       (counters_ != nullptr && FLAGS_perf_context_sample_interval > 0 &&
+                        folly::Random::rand32(FLAGS_perf_context_sample_interval) == 0);
+  }
+
+  // Add the rocksdb reads of a run of the request on the calling thread
+  void profilePerfContext(const kvstore::ReadPerfContext& perf) {
+    if (!perf.enabled()) {
+      return;
+    }
+    auto counters = perf.counters();
+    std::lock_guard<std::mutex> lck(profileMut_);
+    for (const auto& [name, value] : counters) {
+      profileCounters_[name] += value;
+    }
+  }
+
+  // Return the counters if it's profiled, and add the rocksdb reads to the histograms
+  void reportProfileCounters() {
+    if (perfContextFlag_ && counters_ != nullptr) {
+      auto addValue = [this](const stats::CounterId& id, const std::string& name) {
+        auto iter = profileCounters_.find(name);
+        if (iter != profileCounters_.end()) {
+          stats::StatsManager::addValue(id, iter->second);
+        }
+      };
+      addValue(counters_->blockReads_, "block_read_count");
+      addValue(counters_->blockCacheHits_, "block_cache_hit_count");
+      addValue(counters_->readBytes_, "read_bytes");
+    }
+    if (profileDetailFlag_ && !profileCounters_.empty()) {
+      this->result_.profile_counters_ref() = std::move(profileCounters_);
+    }
+  }
+
   virtual void profileDetail(const std::string& name, int32_t latency) {
     if (!profileDetail_.count(name)) {
       profileDetail_[name] = latency;
@@ -161,8 +205,11 @@ class BaseProcessor {
   int32_t spaceVidLen_;
   bool isIntId_;
   std::map<std::string, int32_t> profileDetail_;
+  // The inputs and rows of the plan nodes and the rocksdb reads, see ResponseCommon
+  std::map<std::string, int64_t> profileCounters_;
   std::mutex profileMut_;
   bool profileDetailFlag_{false};
+  bool perfContextFlag_{false};
   bool memoryExceeded_{false};
 };
 
@@ -5,6 +5,7 @@
 
 #include "storage/CommonUtils.h"
 
+#include "storage/ReadSnapshotManager.h"
 #include "storage/exec/QueryUtils.h"
 
 DEFINE_bool(ttl_use_ms,
@@ -14,6 +15,18 @@ DEFINE_bool(ttl_use_ms,
 namespace nebula {
 namespace storage {
 
+const void* RuntimeContext::snapshot(PartitionID partId) {
+  if (!planContext_->snapshotRead_ || env() == nullptr || env()->readSnapshots_ == nullptr) {
+    return nullptr;
+  }
+  if (snapshotPartId_ != partId) {
+    snapshot_ = env()->readSnapshots_->get(
+        planContext_->sessionId_, planContext_->planId_, spaceId(), partId);
+    snapshotPartId_ = partId;
+  }
+  return snapshot_ == nullptr ? nullptr : snapshot_->get();
+}
+
 bool CommonUtils::checkDataExpiredForTTL(const meta::NebulaSchemaProvider* schema,
                                          RowReaderWrapper* reader,
                                          const std::string& ttlCol,
@@ -26,6 +26,10 @@ struct ProcessorCounters {
   stats::CounterId numCalls_;
   stats::CounterId numErrors_;
   stats::CounterId latency_;
+  // The rocksdb reads of the requests which count them, see kvstore::ReadPerfContext
+  stats::CounterId blockReads_;
+  stats::CounterId blockCacheHits_;
+  stats::CounterId readBytes_;
 
   virtual ~ProcessorCounters() = default;
 
@@ -36,6 +40,12 @@ struct ProcessorCounters {
           stats::StatsManager::registerStats("num_" + counterName + "_errors", "rate, sum");
       latency_ = stats::StatsManager::registerHisto(
           counterName + "_latency_us", 1000, 0, 20000, "avg, p75, p95, p99");
+      blockReads_ = stats::StatsManager::registerHisto(
+          counterName + "_block_reads", 10, 0, 1000, "avg, p95, p99");
+      blockCacheHits_ = stats::StatsManager::registerHisto(
+          counterName + "_block_cache_hits", 10, 0, 1000, "avg, p95, p99");
+      readBytes_ = stats::StatsManager::registerHisto(
+          counterName + "_read_bytes", 4096, 0, 4194304, "avg, p95, p99");
       VLOG(1) << "Succeeded in initializing the ProcessorCounters instance";
     } else {
       VLOG(1) << "ProcessorCounters instance has been initialized";
@@ -62,6 +72,8 @@ using EdgesMemLock = MemoryLockCore<EMLI>;
 
 class TransactionManager;
 class InternalStorageClient;
+class ReadSnapshotManager;
+class ReadSnapshot;
 
 // unify TagID, EdgeType
 using SchemaID = TagID;
@@ -77,6 +89,7 @@ class StorageEnv {
   meta::MetaClient* metaClient_{nullptr};
   InternalStorageClient* interClient_{nullptr};
   TransactionManager* txnMan_{nullptr};
+  ReadSnapshotManager* readSnapshots_{nullptr};
   std::unique_ptr<VerticesMemLock> verticesML_{nullptr};
   std::unique_ptr<EdgesMemLock> edgesML_{nullptr};
   std::unique_ptr<kvstore::KVEngine> adminStore_{nullptr};
@@ -164,6 +177,7 @@ class PlanContext {
       auto& common = commonRef.value();
       sessionId_ = common.session_id_ref().value_or(0);
       planId_ = common.plan_id_ref().value_or(0);
+      snapshotRead_ = common.snapshot_read_ref().value_or(false);
     }
   }
 
@@ -183,6 +197,9 @@ class PlanContext {
   // will be true if query is killed during execution
   bool isKilled_ = false;
 
+  // whether the reads of the plan are served from the snapshots, see ReadSnapshotManager
+  bool snapshotRead_ = false;
+
   // Manage expressions
   ObjectPool objPool_;
 };
@@ -226,6 +243,14 @@ struct RuntimeContext {
            env()->metaClient_->checkIsPlanKilled(planContext_->sessionId_, planContext_->planId_);
   }
 
+  /**
+   * @brief The snapshot to read the part from, the last one is kept until another part is read.
+   *
+   * @return nullptr if the plan doesn't ask for snapshot reads or no snapshot is available, which
+   * means to read the latest data
+   */
+  const void* snapshot(PartitionID partId);
+
   PlanContext* planContext_;
   TagID tagId_ = 0;
   std::string tagName_ = "";
@@ -247,6 +272,10 @@ struct RuntimeContext {
   bool filterInvalidResultOut = false;
 
   ResultStatus resultStat_{ResultStatus::NORMAL};
+
+  // snapshot of the part read last time
+  std::optional<PartitionID> snapshotPartId_;
+  std::shared_ptr<ReadSnapshot> snapshot_;
 };
 
 class CommonUtils final {
@@ -6,26 +6,51 @@
 #include "GraphStorageLocalServer.h"
 
 #include <folly/ExceptionWrapper.h>
+#include <folly/futures/Future.h>
 #include <unistd.h>
 
 #include "common/base/Base.h"
 #include "storage/GraphStorageServiceHandler.h"
 
-using folly::exception_wrapper;
-
-#define LOCAL_RETURN_FUTURE(RespType, callFunc)                                                  \
-  auto promise = std::make_shared<folly::Promise<RespType>>();                                   \
-  auto f = promise->getFuture();                                                                 \
-  threadManager_->add([this, promise, request] {                                                 \
-    std::dynamic_pointer_cast<GraphStorageServiceHandler>(handler_)                              \
-        ->callFunc(std::move(request))                                                           \
-        .thenValue([promise](RespType&& resp) { promise->setValue(std::move(resp)); })           \
-        .thenError([promise](exception_wrapper&& ex) { promise->setException(std::move(ex)); }); \
-  });                                                                                            \
-  return f;
+DEFINE_bool(local_storage_call_inline,
+            false,
+            "Call the storage handler of cheap point requests, e.g. update and get props of a few "
+            "keys, on the calling thread in standalone mode, instead of hopping to the storage "
+            "worker threads");
+
+// Point requests with at most these keys are called inline
+static constexpr size_t kMaxInlineKeys = 16;
+
+// The request is neither copied nor serialized, and the future of the handler is returned as
+// is, so the response is moved to the caller once. Only the cheap point requests are called inline,
+// scans and traversals keep to the storage workers, so they do not hold the graph workers.
+#define LOCAL_RETURN_FUTURE_INLINE(RespType, callFunc, callInline)                        \
+  auto handler = std::dynamic_pointer_cast<GraphStorageServiceHandler>(handler_);         \
+  auto call = [handler, &request]() -> folly::Future<RespType> {                          \
+    return handler->callFunc(request);                                                    \
+  };                                                                                      \
+  if (FLAGS_local_storage_call_inline && (callInline)) {                                  \
+    return folly::makeFutureWith(std::move(call));                                        \
+  }                                                                                       \
+  return folly::via(threadManager_.get(), std::move(call));
+
+#define LOCAL_RETURN_FUTURE(RespType, callFunc) \
+  LOCAL_RETURN_FUTURE_INLINE(RespType, callFunc, false)
 
 namespace nebula::storage {
 
+template <typename Parts>
+static bool fewKeys(const Parts& parts) {
+  size_t numKeys = 0;
+  for (const auto& part : parts) {
+    numKeys += part.second.size();
+    if (numKeys > kMaxInlineKeys) {
+      return false;
+    }
+  }
+  return true;
+}
+
 std::mutex mutex_;
 std::shared_ptr<GraphStorageLocalServer> instance_ = nullptr;
 
@@ -66,7 +91,7 @@ folly::Future<cpp2::ExecResponse> GraphStorageLocalServer::future_addEdges(
 
 folly::Future<cpp2::GetPropResponse> GraphStorageLocalServer::future_getProps(
     const cpp2::GetPropRequest& request) {
-  LOCAL_RETURN_FUTURE(cpp2::GetPropResponse, future_getProps);
+  LOCAL_RETURN_FUTURE_INLINE(cpp2::GetPropResponse, future_getProps, fewKeys(request.get_parts()));
 }
 
 folly::Future<cpp2::ExecResponse> GraphStorageLocalServer::future_deleteEdges(
@@ -91,22 +116,22 @@ folly::Future<cpp2::ExecResponse> GraphStorageLocalServer::future_deleteTags(
 
 folly::Future<cpp2::UpdateResponse> GraphStorageLocalServer::future_updateVertex(
     const cpp2::UpdateVertexRequest& request) {
-  LOCAL_RETURN_FUTURE(cpp2::UpdateResponse, future_updateVertex);
+  LOCAL_RETURN_FUTURE_INLINE(cpp2::UpdateResponse, future_updateVertex, true);
 }
 
 folly::Future<cpp2::UpdateResponse> GraphStorageLocalServer::future_chainUpdateEdge(
     const cpp2::UpdateEdgeRequest& request) {
-  LOCAL_RETURN_FUTURE(cpp2::UpdateResponse, future_chainUpdateEdge);
+  LOCAL_RETURN_FUTURE_INLINE(cpp2::UpdateResponse, future_chainUpdateEdge, true);
 }
 
 folly::Future<cpp2::UpdateResponse> GraphStorageLocalServer::future_updateEdge(
     const cpp2::UpdateEdgeRequest& request) {
-  LOCAL_RETURN_FUTURE(cpp2::UpdateResponse, future_updateEdge);
+  LOCAL_RETURN_FUTURE_INLINE(cpp2::UpdateResponse, future_updateEdge, true);
 }
 
 folly::Future<cpp2::GetUUIDResp> GraphStorageLocalServer::future_getUUID(
     const cpp2::GetUUIDReq& request) {
-  LOCAL_RETURN_FUTURE(cpp2::GetUUIDResp, future_getUUID);
+  LOCAL_RETURN_FUTURE_INLINE(cpp2::GetUUIDResp, future_getUUID, true);
 }
 
 folly::Future<cpp2::LookupIndexResp> GraphStorageLocalServer::future_lookupIndex(
@@ -131,7 +156,7 @@ folly::Future<cpp2::ScanResponse> GraphStorageLocalServer::future_scanEdge(
 
 folly::Future<cpp2::KVGetResponse> GraphStorageLocalServer::future_get(
     const cpp2::KVGetRequest& request) {
-  LOCAL_RETURN_FUTURE(cpp2::KVGetResponse, future_get);
+  LOCAL_RETURN_FUTURE_INLINE(cpp2::KVGetResponse, future_get, fewKeys(request.get_parts()));
 }
 
 folly::Future<cpp2::ExecResponse> GraphStorageLocalServer::future_put(
@@ -144,4 +169,9 @@ folly::Future<cpp2::ExecResponse> GraphStorageLocalServer::future_remove(
   LOCAL_RETURN_FUTURE(cpp2::ExecResponse, future_remove);
 }
 
+folly::Future<cpp2::ExecResponse> GraphStorageLocalServer::future_releaseReadSnapshots(
+    const cpp2::ReleaseReadSnapshotsRequest& request) {
+  LOCAL_RETURN_FUTURE(cpp2::ExecResponse, future_releaseReadSnapshots);
+}
+
 }  // namespace nebula::storage
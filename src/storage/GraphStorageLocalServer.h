@@ -17,6 +17,11 @@
 #include "folly/fibers/Semaphore.h"
 #include "interface/gen-cpp2/GraphStorageServiceAsyncClient.h"
 namespace nebula::storage {
+/**
+ * GraphStorageLocalServer calls the storage handler in process for the standalone graphd, in
+ * place of the thrift client. As the thrift server does for a remote call, the caller must keep
+ * the request alive until the returned future is completed.
+ */
 class GraphStorageLocalServer final : public boost::noncopyable, public nebula::cpp::NonMovable {
  public:
   static std::shared_ptr<GraphStorageLocalServer> getInstance() {
@@ -54,6 +59,8 @@ class GraphStorageLocalServer final : public boost::noncopyable, public nebula::
   folly::Future<cpp2::KVGetResponse> future_get(const cpp2::KVGetRequest& request);
   folly::Future<cpp2::ExecResponse> future_put(const cpp2::KVPutRequest& request);
   folly::Future<cpp2::ExecResponse> future_remove(const cpp2::KVRemoveRequest& request);
+  folly::Future<cpp2::ExecResponse> future_releaseReadSnapshots(
+      const cpp2::ReleaseReadSnapshotsRequest& request);
 
  private:
   GraphStorageLocalServer() = default;
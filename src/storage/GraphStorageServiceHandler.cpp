@@ -6,6 +6,7 @@
 #include "storage/GraphStorageServiceHandler.h"
 
 #include "common/memory/MemoryTracker.h"
+#include "storage/ReadSnapshotManager.h"
 #include "storage/index/LookupProcessor.h"
 #include "storage/kv/GetProcessor.h"
 #include "storage/kv/PutProcessor.h"
@@ -47,6 +48,11 @@
   }                                          \
   return f;
 
+// The reads of a plan after its write should see the write, so the read snapshots of the plan are
+// dropped once the write is done
+#define RETURN_WRITE_FUTURE(processor) \
+  return releaseSnapshotsOnWrite(req.common_ref(), [&]() { RETURN_FUTURE(processor); }());
+
 namespace nebula {
 namespace storage {
 
@@ -85,55 +91,70 @@ GraphStorageServiceHandler::GraphStorageServiceHandler(StorageEnv* env) : env_(e
   kRemoveCounters.init("kv_remove");
 }
 
+template <class Response>
+folly::Future<Response> GraphStorageServiceHandler::releaseSnapshotsOnWrite(
+    apache::thrift::optional_field_ref<const cpp2::RequestCommon&> common,
+    folly::Future<Response>&& f) {
+  if (env_->readSnapshots_ == nullptr || !common.has_value()) {
+    return std::move(f);
+  }
+  auto sessionId = common->session_id_ref().value_or(0);
+  auto planId = common->plan_id_ref().value_or(0);
+  return std::move(f).thenValue([this, sessionId, planId](Response&& resp) {
+    env_->readSnapshots_->release(sessionId, planId);
+    return std::move(resp);
+  });
+}
+
 // Vertice section
 folly::Future<cpp2::ExecResponse> GraphStorageServiceHandler::future_addVertices(
     const cpp2::AddVerticesRequest& req) {
   auto* processor = AddVerticesProcessor::instance(env_, &kAddVerticesCounters);
-  RETURN_FUTURE(processor);
+  RETURN_WRITE_FUTURE(processor);
 }
 
 folly::Future<cpp2::ExecResponse> GraphStorageServiceHandler::future_deleteVertices(
     const cpp2::DeleteVerticesRequest& req) {
   auto* processor = DeleteVerticesProcessor::instance(env_, &kDelVerticesCounters);
-  RETURN_FUTURE(processor);
+  RETURN_WRITE_FUTURE(processor);
 }
 
 folly::Future<cpp2::ExecResponse> GraphStorageServiceHandler::future_deleteTags(
     const cpp2::DeleteTagsRequest& req) {
   auto* processor = DeleteTagsProcessor::instance(env_, &kDelTagsCounters);
-  RETURN_FUTURE(processor);
+  RETURN_WRITE_FUTURE(processor);
 }
 
 folly::Future<cpp2::UpdateResponse> GraphStorageServiceHandler::future_updateVertex(
     const cpp2::UpdateVertexRequest& req) {
   auto* processor =
       UpdateVertexProcessor::instance(env_, &kUpdateVertexCounters, readerPool_.get());
-  RETURN_FUTURE(processor);
+  RETURN_WRITE_FUTURE(processor);
 }
 
 // Edge section
 folly::Future<cpp2::ExecResponse> GraphStorageServiceHandler::future_addEdges(
     const cpp2::AddEdgesRequest& req) {
   auto* processor = AddEdgesProcessor::instance(env_, &kAddEdgesCounters);
-  RETURN_FUTURE(processor);
+  RETURN_WRITE_FUTURE(processor);
 }
 
 folly::Future<cpp2::ExecResponse> GraphStorageServiceHandler::future_deleteEdges(
     const cpp2::DeleteEdgesRequest& req) {
   auto* processor = DeleteEdgesProcessor::instance(env_, &kDelEdgesCounters);
-  RETURN_FUTURE(processor);
+  RETURN_WRITE_FUTURE(processor);
 }
 
 folly::Future<cpp2::UpdateResponse> GraphStorageServiceHandler::future_updateEdge(
     const cpp2::UpdateEdgeRequest& req) {
   auto* processor = UpdateEdgeProcessor::instance(env_, &kUpdateEdgeCounters, readerPool_.get());
-  RETURN_FUTURE(processor);
+  RETURN_WRITE_FUTURE(processor);
 }
 
 folly::Future<cpp2::UpdateResponse> GraphStorageServiceHandler::future_chainUpdateEdge(
     const cpp2::UpdateEdgeRequest& req) {
   auto* proc = ChainUpdateEdgeLocalProcessor::instance(env_);
-  RETURN_FUTURE(proc);
+  RETURN_WRITE_FUTURE(proc);
 }
 
 folly::Future<cpp2::GetNeighborsResponse> GraphStorageServiceHandler::future_getNeighbors(
@@ -191,13 +212,13 @@ folly::Future<cpp2::GetUUIDResp> GraphStorageServiceHandler::future_getUUID(
 folly::Future<cpp2::ExecResponse> GraphStorageServiceHandler::future_chainAddEdges(
     const cpp2::AddEdgesRequest& req) {
   auto* processor = ChainAddEdgesGroupProcessor::instance(env_);
-  RETURN_FUTURE(processor);
+  RETURN_WRITE_FUTURE(processor);
 }
 
 folly::Future<cpp2::ExecResponse> GraphStorageServiceHandler::future_chainDeleteEdges(
     const cpp2::DeleteEdgesRequest& req) {
   auto* processor = ChainDeleteEdgesGroupProcessor::instance(env_);
-  RETURN_FUTURE(processor);
+  RETURN_WRITE_FUTURE(processor);
 }
 
 folly::Future<cpp2::ExecResponse> GraphStorageServiceHandler::future_put(
@@ -218,5 +239,15 @@ folly::Future<cpp2::ExecResponse> GraphStorageServiceHandler::future_remove(
   RETURN_FUTURE(processor);
 }
 
+folly::Future<cpp2::ExecResponse> GraphStorageServiceHandler::future_releaseReadSnapshots(
+    const cpp2::ReleaseReadSnapshotsRequest& req) {
+  if (env_->readSnapshots_ != nullptr) {
+    env_->readSnapshots_->release(req.get_session_id(), req.get_plan_id());
+  }
+  cpp2::ExecResponse resp;
+  resp.result_ref() = cpp2::ResponseCommon();
+  return resp;
+}
+
 }  // namespace storage
 }  // namespace nebula
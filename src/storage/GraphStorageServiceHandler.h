@@ -73,7 +73,15 @@ class GraphStorageServiceHandler final : public cpp2::GraphStorageServiceSvIf {
 
   folly::Future<cpp2::ExecResponse> future_remove(const cpp2::KVRemoveRequest& req) override;
 
+  folly::Future<cpp2::ExecResponse> future_releaseReadSnapshots(
+      const cpp2::ReleaseReadSnapshotsRequest& req) override;
+
  private:
+  template <class Response>
+  folly::Future<Response> releaseSnapshotsOnWrite(
+      apache::thrift::optional_field_ref<const cpp2::RequestCommon&> common,
+      folly::Future<Response>&& f);
+
   StorageEnv* env_{nullptr};
   std::shared_ptr<folly::Executor> readerPool_;
 };
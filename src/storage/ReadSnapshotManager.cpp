@@ -0,0 +1,182 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "storage/ReadSnapshotManager.h"
+
+#include "common/time/WallClock.h"
+#include "kvstore/NebulaStore.h"
+#include "storage/StorageFlags.h"
+#include "storage/stats/StorageStats.h"
+
+namespace nebula {
+namespace storage {
+
+ReadSnapshotManager::ReadSnapshotManager(kvstore::KVStore* kvstore)
+    : store_(dynamic_cast<kvstore::NebulaStore*>(kvstore)) {
+  if (store_ != nullptr) {
+    store_->registerBeforeRemoveSpace("ReadSnapshotManager",
+                                      [this](GraphSpaceID spaceId) { releaseSpace(spaceId); });
+  }
+  cleaner_ = std::make_unique<thread::GenericWorker>();
+  if (!cleaner_->start("read-snapshot-cleaner")) {
+    LOG(ERROR) << "Fail to start the read snapshot cleaner";
+    cleaner_.reset();
+    return;
+  }
+  cleaner_->addRepeatTask(1000, [this]() { cleanExpired(); });
+}
+
+ReadSnapshotManager::~ReadSnapshotManager() {
+  stop();
+}
+
+std::shared_ptr<ReadSnapshot> ReadSnapshotManager::get(SessionID sessionId,
+                                                       ExecutionPlanID planId,
+                                                       GraphSpaceID spaceId,
+                                                       PartitionID partId) {
+  if (store_ == nullptr) {
+    return nullptr;
+  }
+  auto partRet = store_->part(spaceId, partId);
+  if (!nebula::ok(partRet)) {
+    return nullptr;
+  }
+  auto* engine = nebula::value(partRet)->engine();
+  auto now = time::WallClock::fastNowInSec();
+  Key key{sessionId, planId, spaceId, engine};
+  {
+    auto snapshots = snapshots_.rlock();
+    auto iter = snapshots->find(key);
+    if (iter != snapshots->end()) {
+      iter->second->lastUsedAt_ = now;
+      return iter->second;
+    }
+  }
+
+  // The snapshot pins the space, so its engine outlives the snapshot. It's looked up before the
+  // lock of the snapshots, which removeSpace takes under the lock of the store.
+  auto spaceRet = store_->space(spaceId);
+  if (!nebula::ok(spaceRet)) {
+    return nullptr;
+  }
+  auto space = nebula::value(spaceRet);
+
+  auto snapshots = snapshots_.wlock();
+  auto iter = snapshots->find(key);
+  if (iter != snapshots->end()) {
+    iter->second->lastUsedAt_ = now;
+    return iter->second;
+  }
+  if (snapshots->size() >= static_cast<size_t>(FLAGS_max_read_snapshots)) {
+    stats::StatsManager::addValue(kNumReadSnapshotsRejected);
+    LOG_EVERY_N(WARNING, 100) << "Too many read snapshots, the reads of session " << sessionId
+                              << " plan " << planId << " go on without snapshot, "
+                              << google::COUNTER << " times in total";
+    return nullptr;
+  }
+  auto* raw = engine->GetSnapshot();
+  if (raw == nullptr) {
+    return nullptr;
+  }
+  auto snapshot = std::make_shared<ReadSnapshot>(std::move(space), engine, raw, now);
+  snapshots->emplace(std::move(key), snapshot);
+  stats::StatsManager::addValue(kNumReadSnapshotsCreated);
+  stats::StatsManager::addValue(kNumReadSnapshots);
+  VLOG(2) << "Take read snapshot of space " << spaceId << " for session " << sessionId
+          << " plan " << planId;
+  return snapshot;
+}
+
+bool ReadSnapshotManager::expired(const ReadSnapshot& snapshot, int64_t now) const {
+  return now - snapshot.lastUsedAt_ > FLAGS_read_snapshot_idle_secs ||
+         now - snapshot.createdAt_ > FLAGS_read_snapshot_max_lifetime_secs;
+}
+
+size_t ReadSnapshotManager::release(SessionID sessionId, ExecutionPlanID planId) {
+  // Called on every write, most of which come with no snapshot at all
+  if (snapshots_.rlock()->empty()) {
+    return 0;
+  }
+  // Drop them out of the lock, the release of a snapshot in RocksDB takes its mutex
+  std::vector<std::shared_ptr<ReadSnapshot>> released;
+  {
+    auto snapshots = snapshots_.wlock();
+    for (auto iter = snapshots->begin(); iter != snapshots->end();) {
+      if (std::get<0>(iter->first) == sessionId && std::get<1>(iter->first) == planId) {
+        released.emplace_back(std::move(iter->second));
+        iter = snapshots->erase(iter);
+      } else {
+        ++iter;
+      }
+    }
+  }
+  if (!released.empty()) {
+    stats::StatsManager::addValue(kNumReadSnapshotsReleased, released.size());
+    stats::StatsManager::decValue(kNumReadSnapshots, released.size());
+    VLOG(2) << "Release " << released.size() << " read snapshots of session " << sessionId
+            << " plan " << planId;
+  }
+  return released.size();
+}
+
+void ReadSnapshotManager::releaseSpace(GraphSpaceID spaceId) {
+  std::vector<std::shared_ptr<ReadSnapshot>> released;
+  {
+    auto snapshots = snapshots_.wlock();
+    for (auto iter = snapshots->begin(); iter != snapshots->end();) {
+      if (std::get<2>(iter->first) == spaceId) {
+        released.emplace_back(std::move(iter->second));
+        iter = snapshots->erase(iter);
+      } else {
+        ++iter;
+      }
+    }
+  }
+  if (!released.empty()) {
+    stats::StatsManager::addValue(kNumReadSnapshotsReleased, released.size());
+    stats::StatsManager::decValue(kNumReadSnapshots, released.size());
+    LOG(INFO) << "Release " << released.size() << " read snapshots of the removed space "
+              << spaceId;
+  }
+}
+
+size_t ReadSnapshotManager::cleanExpired() {
+  auto now = time::WallClock::fastNowInSec();
+  // Drop them out of the lock, the release of a snapshot in RocksDB takes its mutex
+  std::vector<std::shared_ptr<ReadSnapshot>> expiredSnapshots;
+  {
+    auto snapshots = snapshots_.wlock();
+    for (auto iter = snapshots->begin(); iter != snapshots->end();) {
+      if (expired(*iter->second, now)) {
+        expiredSnapshots.emplace_back(std::move(iter->second));
+        iter = snapshots->erase(iter);
+      } else {
+        ++iter;
+      }
+    }
+  }
+  if (!expiredSnapshots.empty()) {
+    stats::StatsManager::addValue(kNumReadSnapshotsExpired, expiredSnapshots.size());
+    stats::StatsManager::decValue(kNumReadSnapshots, expiredSnapshots.size());
+  }
+  return expiredSnapshots.size();
+}
+
+void ReadSnapshotManager::stop() {
+  if (store_ != nullptr) {
+    store_->unregisterBeforeRemoveSpace("ReadSnapshotManager");
+  }
+  if (cleaner_ != nullptr) {
+    cleaner_->stop();
+    cleaner_->wait();
+    cleaner_.reset();
+  }
+  auto snapshots = snapshots_.wlock();
+  stats::StatsManager::decValue(kNumReadSnapshots, snapshots->size());
+  snapshots->clear();
+}
+
+}  // namespace storage
+}  // namespace nebula
@@ -0,0 +1,129 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef STORAGE_READSNAPSHOTMANAGER_H_
+#define STORAGE_READSNAPSHOTMANAGER_H_
+
+#include <folly/Synchronized.h>
+
+#include "common/base/Base.h"
+#include "common/thread/GenericWorker.h"
+#include "kvstore/NebulaStore.h"
+
+namespace nebula {
+namespace storage {
+
+/**
+ * @brief A RocksDB snapshot retained for the reads of one query. It's a ref-counted handle, the
+ * snapshot is released in its engine by the last one holding it, either the manager or a request
+ * still reading it.
+ */
+class ReadSnapshot final {
+ public:
+  ReadSnapshot(std::shared_ptr<kvstore::SpacePartInfo> space,
+               kvstore::KVEngine* engine,
+               const void* snapshot,
+               int64_t now)
+      : space_(std::move(space)),
+        engine_(engine),
+        snapshot_(snapshot),
+        createdAt_(now),
+        lastUsedAt_(now) {}
+
+  ~ReadSnapshot() {
+    engine_->ReleaseSnapshot(snapshot_);
+  }
+
+  ReadSnapshot(const ReadSnapshot&) = delete;
+  ReadSnapshot& operator=(const ReadSnapshot&) = delete;
+
+  // The snapshot, valid as long as this handle is held
+  const void* get() const {
+    return snapshot_;
+  }
+
+ private:
+  friend class ReadSnapshotManager;
+
+  // Keeps the engines of the space alive after the space is removed, until the snapshot is
+  // released in its engine
+  std::shared_ptr<kvstore::SpacePartInfo> space_;
+  kvstore::KVEngine* engine_;
+  const void* snapshot_;
+  int64_t createdAt_;
+  std::atomic<int64_t> lastUsedAt_;
+};
+
+/**
+ * @brief ReadSnapshotManager keeps the snapshots of the queries which ask for snapshot reads.
+ *
+ * A query asks for it by RequestCommon.snapshot_read, and all the reads of its plan on a storaged
+ * are served from the snapshots taken when the plan reads each engine for the first time. The
+ * parts of a space on one data path share the engine, so the reads of them see a single point in
+ * time, no matter how many steps of the query read them and when. The snapshots pin the old
+ * versions of the data in RocksDB, so graphd releases the ones of a query when it ends. In case
+ * it never does, one is also released once it's idle for --read_snapshot_idle_secs or older than
+ * --read_snapshot_max_lifetime_secs. No more than --max_read_snapshots are kept, the reads of a
+ * new query beyond that see the latest data. Once a plan writes, its snapshots are dropped, so
+ * that its reads after the write see it.
+ */
+class ReadSnapshotManager final {
+ public:
+  explicit ReadSnapshotManager(kvstore::KVStore* kvstore);
+
+  ~ReadSnapshotManager();
+
+  /**
+   * @brief Get the snapshot of the engine of the part for the plan, which is taken on the first
+   * call of the plan to the engine.
+   *
+   * @return The snapshot, or nullptr if the part is not found or there are too many snapshots, in
+   * which case the read should go on without snapshot.
+   */
+  std::shared_ptr<ReadSnapshot> get(SessionID sessionId,
+                                    ExecutionPlanID planId,
+                                    GraphSpaceID spaceId,
+                                    PartitionID partId);
+
+  // Release the snapshots of the plan, when the query ends, returns the number of them
+  size_t release(SessionID sessionId, ExecutionPlanID planId);
+
+  // Release the snapshots idle or living too long, returns the number of them
+  size_t cleanExpired();
+
+  // Drop the snapshots of the space when it's removed, the requests still holding them keep
+  // reading them, and the engines of the space, until they are done
+  void releaseSpace(GraphSpaceID spaceId);
+
+  // Release all snapshots, called before the kvstore is stopped
+  void stop();
+
+  size_t size() const {
+    return snapshots_.rlock()->size();
+  }
+
+ private:
+  // session, plan, space and the engine
+  using Key = std::tuple<SessionID, ExecutionPlanID, GraphSpaceID, const kvstore::KVEngine*>;
+
+  struct KeyHash {
+    size_t operator()(const Key& key) const {
+      return folly::hash::hash_combine(std::get<0>(key),
+                                       std::get<1>(key),
+                                       std::get<2>(key),
+                                       reinterpret_cast<uintptr_t>(std::get<3>(key)));
+    }
+  };
+
+  bool expired(const ReadSnapshot& snapshot, int64_t now) const;
+
+  kvstore::NebulaStore* store_;
+  folly::Synchronized<std::unordered_map<Key, std::shared_ptr<ReadSnapshot>, KeyHash>> snapshots_;
+  std::unique_ptr<thread::GenericWorker> cleaner_;
+};
+
+}  // namespace storage
+}  // namespace nebula
+#endif  // STORAGE_READSNAPSHOTMANAGER_H_
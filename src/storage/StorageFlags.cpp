@@ -40,6 +40,16 @@ DEFINE_string(reader_handlers_type, "cpu", "Type of reader handlers, options: cp
 
 DEFINE_bool(trace_toss, false, "output verbose log of toss");
 
+DEFINE_int32(toss_remote_batch_size,
+             128,
+             "max edges of concurrent toss chains sent to one remote part in a single rpc, "
+             "set to 1 to disable batching");
+
+DEFINE_int32(toss_remote_batch_window_ms,
+             0,
+             "how long a toss remote batch waits for more chains before sending, "
+             "0 means only merge the chains already in flight");
+
 DEFINE_int32(max_edge_returned_per_vertex, INT_MAX, "Max edge number returned searching vertex");
 
 DEFINE_bool(query_concurrently,
@@ -47,4 +57,30 @@ DEFINE_bool(query_concurrently,
             "whether to run query of each part concurrently, only lookup and "
             "go are supported");
 
+DEFINE_int32(perf_context_sample_interval,
+             100,
+             "count the rocksdb reads of one in every so many read requests into the histograms "
+             "of their processors, 0 means only the profiled requests count them");
+
 DEFINE_bool(use_vertex_key, false, "whether allow insert or query the vertex key");
+
+DEFINE_int32(bulk_load_buffer_size_mb,
+             64,
+             "memory used by each input file of bulk load to sort keys before spilling to disk");
+
+DEFINE_int32(bulk_load_sst_file_size_mb, 256, "target size of sst files generated by bulk load");
+
+DEFINE_int32(read_snapshot_idle_secs,
+             30,
+             "release the snapshot of a query asking for snapshot reads if it's not read for so "
+             "long");
+
+DEFINE_int32(read_snapshot_max_lifetime_secs,
+             600,
+             "release the snapshot of a query asking for snapshot reads after so long, the "
+             "reads of the query after that see the latest data");
+
+DEFINE_int32(max_read_snapshots,
+             1024,
+             "max number of snapshots kept for the queries asking for snapshot reads, the reads of "
+             "new queries beyond that see the latest data");
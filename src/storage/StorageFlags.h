@@ -30,10 +30,26 @@ DECLARE_string(reader_handlers_type);
 
 DECLARE_bool(trace_toss);
 
+DECLARE_int32(toss_remote_batch_size);
+
+DECLARE_int32(toss_remote_batch_window_ms);
+
 DECLARE_int32(max_edge_returned_per_vertex);
 
 DECLARE_bool(query_concurrently);
 
+DECLARE_int32(perf_context_sample_interval);
+
 DECLARE_bool(use_vertex_key);
 
+DECLARE_int32(bulk_load_buffer_size_mb);
+
+DECLARE_int32(bulk_load_sst_file_size_mb);
+
+DECLARE_int32(read_snapshot_idle_secs);
+
+DECLARE_int32(read_snapshot_max_lifetime_secs);
+
+DECLARE_int32(max_read_snapshots);
+
 #endif  // STORAGE_STORAGEFLAGS_H_
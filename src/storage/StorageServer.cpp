@@ -278,6 +278,8 @@ bool StorageServer::start() {
 
   env_->verticesML_ = std::make_unique<VerticesMemLock>();
   env_->edgesML_ = std::make_unique<EdgesMemLock>();
+  readSnapshots_ = std::make_unique<ReadSnapshotManager>(kvstore_.get());
+  env_->readSnapshots_ = readSnapshots_.get();
   env_->adminStore_ = getAdminStoreInstance();
   env_->adminSeqId_ = getAdminStoreSeqId();
   if (env_->adminSeqId_ < 0) {
@@ -356,6 +358,9 @@ void StorageServer::stop() {
   if (metaClient_) {
     metaClient_->stop();
   }
+  if (readSnapshots_) {
+    readSnapshots_->stop();
+  }
 
   // Stop kvstore
   if (kvstore_) {
@@ -17,6 +17,7 @@
 #include "kvstore/NebulaStore.h"
 #include "storage/CommonUtils.h"
 #include "storage/GraphStorageLocalServer.h"
+#include "storage/ReadSnapshotManager.h"
 #include "storage/admin/AdminTaskManager.h"
 #include "storage/transaction/TransactionManager.h"
 #include "webservice/WebService.h"
@@ -110,6 +111,7 @@ class StorageServer final {
   std::unique_ptr<meta::SchemaManager> schemaMan_;
   std::unique_ptr<meta::IndexManager> indexMan_;
   std::unique_ptr<storage::StorageEnv> env_;
+  std::unique_ptr<ReadSnapshotManager> readSnapshots_;
 
   HostAddr localHost_;
   std::vector<HostAddr> metaAddrs_;
@@ -5,6 +5,7 @@
 
 #include "storage/admin/AdminTask.h"
 
+#include "storage/admin/BulkLoadTask.h"
 #include "storage/admin/CompactTask.h"
 #include "storage/admin/DownloadTask.h"
 #include "storage/admin/FlushTask.h"
@@ -43,7 +44,13 @@ std::shared_ptr<AdminTask> AdminTaskFactory::createAdminTask(StorageEnv* env, Ta
       ret = std::make_shared<DownloadTask>(env, std::move(ctx));
       break;
     case meta::cpp2::JobType::INGEST:
-      ret = std::make_shared<IngestTask>(env, std::move(ctx));
+      // ingest with a path builds the sst files from csv files first
+      if (ctx.parameters_.task_specific_paras_ref().has_value() &&
+          !ctx.parameters_.task_specific_paras_ref()->empty()) {
+        ret = std::make_shared<BulkLoadTask>(env, std::move(ctx));
+      } else {
+        ret = std::make_shared<IngestTask>(env, std::move(ctx));
+      }
       break;
     default:
       break;
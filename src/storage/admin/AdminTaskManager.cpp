@@ -26,7 +26,7 @@ bool AdminTaskManager::init() {
   if (env_ != nullptr) {
     static_cast<::nebula::kvstore::NebulaStore*>(env_->kvstore_)
         ->registerBeforeRemoveSpace(
-            [this](GraphSpaceID spaceId) { this->waitCancelTasks(spaceId); });
+            "AdminTaskManager", [this](GraphSpaceID spaceId) { this->waitCancelTasks(spaceId); });
   }
   if (!bgThread_->start()) {
     LOG(WARNING) << "background thread start failed";
@@ -0,0 +1,709 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "storage/admin/BulkLoadTask.h"
+
+#include <rocksdb/sst_file_reader.h>
+#include <rocksdb/sst_file_writer.h>
+
+#include <fstream>
+#include <queue>
+
+#include "clients/meta/MetaClient.h"
+#include "codec/RowReaderWrapper.h"
+#include "codec/RowWriterV2.h"
+#include "common/fs/FileUtils.h"
+#include "common/geo/io/wkt/WKTReader.h"
+#include "common/time/TimeUtils.h"
+#include "common/utils/IndexKeyUtils.h"
+#include "common/utils/NebulaKeyUtils.h"
+#include "kvstore/RocksEngineConfig.h"
+#include "storage/StorageFlags.h"
+
+namespace nebula {
+namespace storage {
+
+namespace {
+
+// Split a csv line. A field could be quoted by double quotes, and a double quote in a quoted field
+// is escaped by another one. Quoted fields across lines are not supported.
+std::vector<std::optional<std::string>> splitCsvLine(const std::string& line) {
+  std::vector<std::optional<std::string>> fields;
+  std::string field;
+  bool quoted = false;
+  bool inQuotes = false;
+  for (size_t i = 0; i < line.size(); i++) {
+    char c = line[i];
+    if (inQuotes) {
+      if (c == '"') {
+        if (i + 1 < line.size() && line[i + 1] == '"') {
+          field.push_back('"');
+          i++;
+        } else {
+          inQuotes = false;
+        }
+      } else {
+        field.push_back(c);
+      }
+    } else if (c == '"') {
+      inQuotes = true;
+      quoted = true;
+    } else if (c == ',') {
+      if (field.empty() && !quoted) {
+        fields.emplace_back(std::nullopt);
+      } else {
+        fields.emplace_back(std::move(field));
+      }
+      field.clear();
+      quoted = false;
+    } else {
+      field.push_back(c);
+    }
+  }
+  if (field.empty() && !quoted) {
+    fields.emplace_back(std::nullopt);
+  } else {
+    fields.emplace_back(std::move(field));
+  }
+  return fields;
+}
+
+StatusOr<Value> parseValue(const meta::NebulaSchemaProvider::SchemaField* field,
+                           const std::string& str) {
+  switch (field->type()) {
+    case nebula::cpp2::PropertyType::BOOL: {
+      auto lower = boost::algorithm::to_lower_copy(str);
+      if (lower == "true" || lower == "1") {
+        return Value(true);
+      } else if (lower == "false" || lower == "0") {
+        return Value(false);
+      }
+      break;
+    }
+    case nebula::cpp2::PropertyType::INT8:
+    case nebula::cpp2::PropertyType::INT16:
+    case nebula::cpp2::PropertyType::INT32:
+    case nebula::cpp2::PropertyType::INT64:
+    case nebula::cpp2::PropertyType::VID:
+    case nebula::cpp2::PropertyType::TIMESTAMP: {
+      auto ret = folly::tryTo<int64_t>(str);
+      if (ret.hasValue()) {
+        return Value(ret.value());
+      }
+      break;
+    }
+    case nebula::cpp2::PropertyType::FLOAT:
+    case nebula::cpp2::PropertyType::DOUBLE: {
+      auto ret = folly::tryTo<double>(str);
+      if (ret.hasValue()) {
+        return Value(ret.value());
+      }
+      break;
+    }
+    case nebula::cpp2::PropertyType::STRING:
+    case nebula::cpp2::PropertyType::FIXED_STRING:
+      return Value(str);
+    case nebula::cpp2::PropertyType::DATE: {
+      auto ret = time::TimeUtils::parseDate(str);
+      if (ret.ok()) {
+        return Value(ret.value());
+      }
+      break;
+    }
+    case nebula::cpp2::PropertyType::TIME: {
+      auto ret = time::TimeUtils::parseTime(str);
+      if (ret.ok()) {
+        return ret.value().withTimeZone ? Value(ret.value().t)
+                                        : Value(time::TimeUtils::timeToUTC(ret.value().t));
+      }
+      break;
+    }
+    case nebula::cpp2::PropertyType::DATETIME: {
+      auto ret = time::TimeUtils::parseDateTime(str);
+      if (ret.ok()) {
+        return ret.value().withTimeZone ? Value(ret.value().dt)
+                                        : Value(time::TimeUtils::dateTimeToUTC(ret.value().dt));
+      }
+      break;
+    }
+    case nebula::cpp2::PropertyType::GEOGRAPHY: {
+      geo::WKTReader reader;
+      auto ret = reader.read(str);
+      if (ret.ok()) {
+        return Value(std::move(ret).value());
+      }
+      break;
+    }
+    default:
+      return Status::Error("Type of field `%s' is not supported by bulk load", field->name());
+  }
+  return Status::Error("Invalid value `%s' of field `%s'", str.c_str(), field->name());
+}
+
+nebula::cpp2::ErrorCode toErrorCode(WriteResult code) {
+  switch (code) {
+    case WriteResult::SUCCEEDED:
+      return nebula::cpp2::ErrorCode::SUCCEEDED;
+    case WriteResult::NOT_NULLABLE:
+      return nebula::cpp2::ErrorCode::E_NOT_NULLABLE;
+    case WriteResult::TYPE_MISMATCH:
+      return nebula::cpp2::ErrorCode::E_DATA_TYPE_MISMATCH;
+    case WriteResult::FIELD_UNSET:
+      return nebula::cpp2::ErrorCode::E_FIELD_UNSET;
+    case WriteResult::OUT_OF_RANGE:
+      return nebula::cpp2::ErrorCode::E_OUT_OF_RANGE;
+    default:
+      return nebula::cpp2::ErrorCode::E_INVALID_FIELD_VALUE;
+  }
+}
+
+}  // namespace
+
+bool BulkLoadTask::check() {
+  return env_->kvstore_ != nullptr;
+}
+
+ErrorOr<nebula::cpp2::ErrorCode, std::vector<AdminSubTask>> BulkLoadTask::genSubTasks() {
+  auto code = prepare();
+  if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+    return code;
+  }
+
+  // The subtasks are taken in order, so all the files are being encoded or done when a part
+  // starts to merge, and the merge of a part waits for the encoding of all files to finish.
+  std::vector<AdminSubTask> tasks;
+  encodingFiles_ = sources_.size();
+  for (size_t i = 0; i < sources_.size(); i++) {
+    TaskFunction task = std::bind(&BulkLoadTask::encodeFileAndNotify, this, i);
+    tasks.emplace_back(std::move(task));
+  }
+  for (auto& [part, engine] : engines_) {
+    UNUSED(engine);
+    TaskFunction task = std::bind(&BulkLoadTask::waitAndMerge, this, part);
+    tasks.emplace_back(std::move(task));
+  }
+  return tasks;
+}
+
+nebula::cpp2::ErrorCode BulkLoadTask::prepare() {
+  spaceId_ = *ctx_.parameters_.space_id_ref();
+  auto paras = ctx_.parameters_.task_specific_paras_ref();
+  if (!paras.has_value() || paras->size() != 1) {
+    LOG(ERROR) << "Bulk load task should have the path of input files";
+    return nebula::cpp2::ErrorCode::E_INVALID_PARM;
+  }
+  path_ = (*paras)[0];
+  if (fs::FileUtils::fileType(path_.c_str()) != fs::FileType::DIRECTORY) {
+    LOG(ERROR) << "Bulk load path " << path_ << " is not a directory";
+    return nebula::cpp2::ErrorCode::E_INVALID_PARM;
+  }
+
+  auto vIdLen = env_->schemaMan_->getSpaceVidLen(spaceId_);
+  auto vIdType = env_->schemaMan_->getSpaceVidType(spaceId_);
+  auto numParts = env_->schemaMan_->getPartsNum(spaceId_);
+  if (!vIdLen.ok() || !vIdType.ok() || !numParts.ok()) {
+    LOG(ERROR) << "Get space " << spaceId_ << " failed";
+    return nebula::cpp2::ErrorCode::E_SPACE_NOT_FOUND;
+  }
+  vIdLen_ = vIdLen.value();
+  isIntId_ = vIdType.value() == nebula::cpp2::PropertyType::INT64;
+  numParts_ = numParts.value();
+
+  auto* store = dynamic_cast<kvstore::NebulaStore*>(env_->kvstore_);
+  if (store == nullptr) {
+    LOG(ERROR) << "Bulk load is only supported by NebulaStore";
+    return nebula::cpp2::ErrorCode::E_UNSUPPORTED;
+  }
+  auto space = store->space(spaceId_);
+  if (!ok(space)) {
+    LOG(ERROR) << "Space " << spaceId_ << " not found";
+    return error(space);
+  }
+  std::unordered_set<PartitionID> parts;
+  if (ctx_.parameters_.parts_ref().has_value()) {
+    parts.insert(ctx_.parameters_.parts_ref()->begin(), ctx_.parameters_.parts_ref()->end());
+  }
+  for (auto& engine : value(space)->engines_) {
+    for (auto part : engine->allParts()) {
+      if (parts.empty() || parts.count(part)) {
+        engines_.emplace(part, engine.get());
+      }
+    }
+  }
+
+  for (auto& [part, engine] : engines_) {
+    UNUSED(engine);
+    auto dir = runDir(part);
+    fs::FileUtils::remove(dir.c_str(), true);
+    if (!fs::FileUtils::makeDir(dir)) {
+      LOG(ERROR) << "Create dir " << dir << " failed";
+      return nebula::cpp2::ErrorCode::E_TASK_EXECUTION_FAILED;
+    }
+  }
+
+  auto code = listSources(false);
+  if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+    return code;
+  }
+  code = listSources(true);
+  if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+    return code;
+  }
+  LOG(INFO) << "Bulk load " << sources_.size() << " files of space " << spaceId_ << " into "
+            << engines_.size() << " parts";
+  return nebula::cpp2::ErrorCode::SUCCEEDED;
+}
+
+nebula::cpp2::ErrorCode BulkLoadTask::listSources(bool isEdge) {
+  auto dir = folly::stringPrintf("%s/%s", path_.c_str(), isEdge ? "edge" : "vertex");
+  if (!fs::FileUtils::exist(dir)) {
+    return nebula::cpp2::ErrorCode::SUCCEEDED;
+  }
+
+  std::vector<std::shared_ptr<meta::cpp2::IndexItem>> allIndexes;
+  auto indexes = isEdge ? env_->indexMan_->getEdgeIndexes(spaceId_)
+                        : env_->indexMan_->getTagIndexes(spaceId_);
+  if (indexes.ok()) {
+    allIndexes = std::move(indexes).value();
+  }
+
+  for (auto& name : fs::FileUtils::listAllDirsInDir(dir.c_str())) {
+    Source source;
+    source.isEdge = isEdge;
+    if (isEdge) {
+      auto edgeType = env_->schemaMan_->toEdgeType(spaceId_, name);
+      if (!edgeType.ok()) {
+        LOG(ERROR) << "Edge " << name << " not found";
+        return nebula::cpp2::ErrorCode::E_EDGE_NOT_FOUND;
+      }
+      source.schemaId = edgeType.value();
+      source.schema = env_->schemaMan_->getEdgeSchema(spaceId_, source.schemaId);
+    } else {
+      auto tagId = env_->schemaMan_->toTagID(spaceId_, name);
+      if (!tagId.ok()) {
+        LOG(ERROR) << "Tag " << name << " not found";
+        return nebula::cpp2::ErrorCode::E_TAG_NOT_FOUND;
+      }
+      source.schemaId = tagId.value();
+      source.schema = env_->schemaMan_->getTagSchema(spaceId_, source.schemaId);
+    }
+    if (source.schema == nullptr) {
+      LOG(ERROR) << "Schema of " << name << " not found";
+      return isEdge ? nebula::cpp2::ErrorCode::E_EDGE_NOT_FOUND
+                    : nebula::cpp2::ErrorCode::E_TAG_NOT_FOUND;
+    }
+    for (auto& index : allIndexes) {
+      auto& schemaId = index->get_schema_id();
+      if ((isEdge && schemaId.get_edge_type() == source.schemaId) ||
+          (!isEdge && schemaId.get_tag_id() == source.schemaId)) {
+        source.indexes.emplace_back(index);
+      }
+    }
+
+    auto subDir = folly::stringPrintf("%s/%s", dir.c_str(), name.c_str());
+    auto files = fs::FileUtils::listAllFilesInDir(subDir.c_str(), true, "*.csv");
+    // keep the order same on every replica, so they resolve duplicated keys in the same way
+    std::sort(files.begin(), files.end());
+    for (auto& file : files) {
+      source.file = file;
+      sources_.emplace_back(source);
+    }
+  }
+  return nebula::cpp2::ErrorCode::SUCCEEDED;
+}
+
+nebula::cpp2::ErrorCode BulkLoadTask::encodeFileAndNotify(size_t fileIdx) {
+  auto code = encodeFile(fileIdx, sources_[fileIdx]);
+  // Fail the task before the merges see the encoding done
+  if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+    subTaskFinish(code);
+  }
+  {
+    std::lock_guard<std::mutex> guard(lock_);
+    --encodingFiles_;
+  }
+  encoded_.notify_all();
+  return code;
+}
+
+nebula::cpp2::ErrorCode BulkLoadTask::waitAndMerge(PartitionID part) {
+  {
+    std::unique_lock<std::mutex> guard(lock_);
+    // A subtask is skipped rather than run once the task fails, so check the status as well
+    while (encodingFiles_ > 0 && rc_ == nebula::cpp2::ErrorCode::SUCCEEDED && !canceled_) {
+      encoded_.wait_for(guard, std::chrono::milliseconds(100));
+    }
+  }
+  if (rc_ != nebula::cpp2::ErrorCode::SUCCEEDED || canceled_) {
+    return rc_;
+  }
+  return mergeAndIngest(part);
+}
+
+nebula::cpp2::ErrorCode BulkLoadTask::encodeFile(size_t fileIdx, const Source& source) {
+  LOG(INFO) << "Bulk load encoding " << source.file;
+  std::ifstream in(source.file);
+  if (!in.is_open()) {
+    LOG(ERROR) << "Open " << source.file << " failed";
+    return nebula::cpp2::ErrorCode::E_TASK_EXECUTION_FAILED;
+  }
+
+  PartBuffers buffers;
+  size_t bufferSize = 0;
+  size_t seq = 0;
+  size_t lineNo = 0;
+  size_t bufferLimit = static_cast<size_t>(FLAGS_bulk_load_buffer_size_mb) * 1024 * 1024;
+  std::string line;
+  while (std::getline(in, line)) {
+    lineNo++;
+    if (canceled_) {
+      return nebula::cpp2::ErrorCode::E_USER_CANCEL;
+    }
+    if (!line.empty() && line.back() == '\r') {
+      line.pop_back();
+    }
+    if (line.empty()) {
+      continue;
+    }
+
+    auto fields = splitCsvLine(line);
+    auto code = source.isEdge ? encodeEdge(source, fields, buffers, bufferSize)
+                              : encodeVertex(source, fields, buffers, bufferSize);
+    if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+      LOG(ERROR) << "Bulk load failed at " << source.file << ":" << lineNo << ", "
+                 << apache::thrift::util::enumNameSafe(code);
+      return code;
+    }
+    if (bufferSize >= bufferLimit) {
+      code = spill(fileIdx, seq, buffers);
+      if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+        return code;
+      }
+      bufferSize = 0;
+    }
+  }
+  return spill(fileIdx, seq, buffers);
+}
+
+nebula::cpp2::ErrorCode BulkLoadTask::encodeVertex(const Source& source,
+                                                   const Fields& fields,
+                                                   PartBuffers& buffers,
+                                                   size_t& bufferSize) {
+  if (fields.empty() || !fields[0].has_value()) {
+    return nebula::cpp2::ErrorCode::E_INVALID_VID;
+  }
+  auto vIdRet = toVid(*fields[0]);
+  if (!ok(vIdRet)) {
+    return error(vIdRet);
+  }
+  auto vId = value(vIdRet);
+  auto part = meta::MetaClient::partId(numParts_, vId);
+  if (!engines_.count(part)) {
+    // the part is not on this host
+    return nebula::cpp2::ErrorCode::SUCCEEDED;
+  }
+
+  auto valRet = encodeRow(source, fields, 1);
+  if (!ok(valRet)) {
+    return error(valRet);
+  }
+  auto val = value(valRet);
+  auto& buffer = buffers[part];
+  auto add = [&buffer, &bufferSize](std::string&& key, std::string&& v) {
+    bufferSize += key.size() + v.size();
+    buffer.emplace_back(std::move(key), std::move(v));
+  };
+
+  if (!source.indexes.empty()) {
+    auto reader = RowReaderWrapper::getRowReader(source.schema.get(), val);
+    auto ttl = CommonUtils::ttlValue(source.schema.get(), &reader);
+    auto indexVal = ttl.ok() ? IndexKeyUtils::indexVal(std::move(ttl).value()) : "";
+    for (auto& index : source.indexes) {
+      auto values = IndexKeyUtils::collectIndexValues(&reader, index.get(), source.schema.get());
+      if (!values.ok()) {
+        continue;
+      }
+      auto indexKeys = IndexKeyUtils::vertexIndexKeys(
+          vIdLen_, part, index->get_index_id(), vId, std::move(values).value());
+      for (auto& indexKey : indexKeys) {
+        add(std::move(indexKey), std::string(indexVal));
+      }
+    }
+  }
+  if (FLAGS_use_vertex_key) {
+    add(NebulaKeyUtils::vertexKey(vIdLen_, part, vId), "");
+  }
+  add(NebulaKeyUtils::tagKey(vIdLen_, part, vId, source.schemaId), std::move(val));
+  return nebula::cpp2::ErrorCode::SUCCEEDED;
+}
+
+nebula::cpp2::ErrorCode BulkLoadTask::encodeEdge(const Source& source,
+                                                 const Fields& fields,
+                                                 PartBuffers& buffers,
+                                                 size_t& bufferSize) {
+  if (fields.size() < 2 || !fields[0].has_value() || !fields[1].has_value()) {
+    return nebula::cpp2::ErrorCode::E_INVALID_VID;
+  }
+  auto srcRet = toVid(*fields[0]);
+  if (!ok(srcRet)) {
+    return error(srcRet);
+  }
+  auto dstRet = toVid(*fields[1]);
+  if (!ok(dstRet)) {
+    return error(dstRet);
+  }
+  EdgeRanking rank = 0;
+  if (fields.size() > 2 && fields[2].has_value()) {
+    auto rankRet = folly::tryTo<EdgeRanking>(*fields[2]);
+    if (!rankRet.hasValue()) {
+      return nebula::cpp2::ErrorCode::E_INVALID_DATA;
+    }
+    rank = rankRet.value();
+  }
+  auto src = value(srcRet);
+  auto dst = value(dstRet);
+  auto srcPart = meta::MetaClient::partId(numParts_, src);
+  auto dstPart = meta::MetaClient::partId(numParts_, dst);
+  bool hasOut = engines_.count(srcPart);
+  bool hasIn = engines_.count(dstPart);
+  if (!hasOut && !hasIn) {
+    return nebula::cpp2::ErrorCode::SUCCEEDED;
+  }
+
+  auto valRet = encodeRow(source, fields, 3);
+  if (!ok(valRet)) {
+    return error(valRet);
+  }
+  auto val = value(valRet);
+  auto add = [&buffers, &bufferSize](PartitionID part, std::string&& key, std::string&& v) {
+    bufferSize += key.size() + v.size();
+    buffers[part].emplace_back(std::move(key), std::move(v));
+  };
+
+  if (hasIn) {
+    add(dstPart,
+        NebulaKeyUtils::edgeKey(vIdLen_, dstPart, dst, -source.schemaId, rank, src),
+        std::string(val));
+  }
+  if (hasOut) {
+    // index is only built on out-edge, the same as AddEdgesProcessor
+    if (!source.indexes.empty()) {
+      auto reader = RowReaderWrapper::getRowReader(source.schema.get(), val);
+      auto ttl = CommonUtils::ttlValue(source.schema.get(), &reader);
+      auto indexVal = ttl.ok() ? IndexKeyUtils::indexVal(std::move(ttl).value()) : "";
+      for (auto& index : source.indexes) {
+        auto values = IndexKeyUtils::collectIndexValues(&reader, index.get(), source.schema.get());
+        if (!values.ok()) {
+          continue;
+        }
+        auto indexKeys = IndexKeyUtils::edgeIndexKeys(
+            vIdLen_, srcPart, index->get_index_id(), src, rank, dst, std::move(values).value());
+        for (auto& indexKey : indexKeys) {
+          add(srcPart, std::move(indexKey), std::string(indexVal));
+        }
+      }
+    }
+    add(srcPart,
+        NebulaKeyUtils::edgeKey(vIdLen_, srcPart, src, source.schemaId, rank, dst),
+        std::move(val));
+  }
+  return nebula::cpp2::ErrorCode::SUCCEEDED;
+}
+
+ErrorOr<nebula::cpp2::ErrorCode, std::string> BulkLoadTask::encodeRow(const Source& source,
+                                                                      const Fields& fields,
+                                                                      size_t offset) {
+  auto* schema = source.schema.get();
+  if (fields.size() > offset + schema->getNumFields()) {
+    return nebula::cpp2::ErrorCode::E_INVALID_DATA;
+  }
+  RowWriterV2 writer(schema);
+  for (size_t i = offset; i < fields.size(); i++) {
+    if (!fields[i].has_value()) {
+      // null or default value, filled when finish
+      continue;
+    }
+    auto index = i - offset;
+    auto v = parseValue(schema->field(index), *fields[i]);
+    if (!v.ok()) {
+      LOG(ERROR) << v.status();
+      return nebula::cpp2::ErrorCode::E_INVALID_FIELD_VALUE;
+    }
+    auto wRet = writer.setValue(index, v.value());
+    if (wRet != WriteResult::SUCCEEDED) {
+      return toErrorCode(wRet);
+    }
+  }
+  auto wRet = writer.finish();
+  if (wRet != WriteResult::SUCCEEDED) {
+    return toErrorCode(wRet);
+  }
+  return std::move(writer).moveEncodedStr();
+}
+
+ErrorOr<nebula::cpp2::ErrorCode, std::string> BulkLoadTask::toVid(const std::string& field) {
+  if (isIntId_) {
+    auto ret = folly::tryTo<int64_t>(field);
+    if (!ret.hasValue()) {
+      return nebula::cpp2::ErrorCode::E_INVALID_VID;
+    }
+    int64_t vId = ret.value();
+    return std::string(reinterpret_cast<const char*>(&vId), sizeof(int64_t));
+  }
+  if (!NebulaKeyUtils::isValidVidLen(vIdLen_, field)) {
+    return nebula::cpp2::ErrorCode::E_INVALID_VID;
+  }
+  return field;
+}
+
+nebula::cpp2::ErrorCode BulkLoadTask::spill(size_t fileIdx, size_t& seq, PartBuffers& buffers) {
+  for (auto& [part, data] : buffers) {
+    if (data.empty()) {
+      continue;
+    }
+    auto path = folly::stringPrintf("%s/%08zu.%08zu.sst", runDir(part).c_str(), fileIdx, seq);
+    auto code = writeSst(path, data);
+    if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+      return code;
+    }
+  }
+  seq++;
+  buffers.clear();
+  return nebula::cpp2::ErrorCode::SUCCEEDED;
+}
+
+nebula::cpp2::ErrorCode BulkLoadTask::writeSst(const std::string& path,
+                                               std::vector<kvstore::KV>& data) {
+  std::stable_sort(data.begin(), data.end(), [](const auto& a, const auto& b) {
+    return a.first < b.first;
+  });
+
+  rocksdb::Options options;
+  options.compression = rocksdb::kNoCompression;
+  rocksdb::SstFileWriter writer(rocksdb::EnvOptions(), options);
+  auto s = writer.Open(path);
+  for (size_t i = 0; s.ok() && i < data.size(); i++) {
+    // the latest one of the same key wins
+    if (i + 1 < data.size() && data[i].first == data[i + 1].first) {
+      continue;
+    }
+    s = writer.Put(data[i].first, data[i].second);
+  }
+  if (s.ok()) {
+    s = writer.Finish();
+  }
+  if (!s.ok()) {
+    LOG(ERROR) << "Write " << path << " failed: " << s.ToString();
+    return nebula::cpp2::ErrorCode::E_TASK_EXECUTION_FAILED;
+  }
+  return nebula::cpp2::ErrorCode::SUCCEEDED;
+}
+
+void BulkLoadTask::finish(nebula::cpp2::ErrorCode rc) {
+  for (auto& [part, engine] : engines_) {
+    UNUSED(engine);
+    fs::FileUtils::remove(runDir(part).c_str(), true);
+  }
+  AdminTask::finish(rc);
+}
+
+nebula::cpp2::ErrorCode BulkLoadTask::mergeAndIngest(PartitionID part) {
+  auto dir = runDir(part);
+  auto runs = fs::FileUtils::listAllFilesInDir(dir.c_str(), true, "*.sst");
+  if (runs.empty()) {
+    return nebula::cpp2::ErrorCode::SUCCEEDED;
+  }
+  // run names are in the order of input, a key of later run overwrites the former one
+  std::sort(runs.begin(), runs.end());
+
+  rocksdb::Options runOptions;
+  std::vector<std::unique_ptr<rocksdb::SstFileReader>> readers;
+  std::vector<std::unique_ptr<rocksdb::Iterator>> iters;
+  for (auto& run : runs) {
+    auto reader = std::make_unique<rocksdb::SstFileReader>(runOptions);
+    auto s = reader->Open(run);
+    if (!s.ok()) {
+      LOG(ERROR) << "Open " << run << " failed: " << s.ToString();
+      return nebula::cpp2::ErrorCode::E_TASK_EXECUTION_FAILED;
+    }
+    iters.emplace_back(reader->NewIterator(rocksdb::ReadOptions()));
+    iters.back()->SeekToFirst();
+    readers.emplace_back(std::move(reader));
+  }
+
+  // min heap of keys, the later run is popped first when keys are equal
+  auto cmp = [&iters](size_t a, size_t b) {
+    auto c = iters[a]->key().compare(iters[b]->key());
+    return c == 0 ? a < b : c > 0;
+  };
+  std::priority_queue<size_t, std::vector<size_t>, decltype(cmp)> heap(cmp);
+  for (size_t i = 0; i < iters.size(); i++) {
+    if (iters[i]->Valid()) {
+      heap.push(i);
+    }
+  }
+
+  // the output uses the options of the space, so prefix bloom filter are built in the same way
+  rocksdb::Options options;
+  auto s = kvstore::initRocksdbOptions(options, spaceId_, vIdLen_);
+  if (!s.ok()) {
+    LOG(ERROR) << "Init rocksdb options failed: " << s.ToString();
+    return nebula::cpp2::ErrorCode::E_TASK_EXECUTION_FAILED;
+  }
+  auto fileSizeLimit = static_cast<uint64_t>(FLAGS_bulk_load_sst_file_size_mb) * 1024 * 1024;
+  std::vector<std::string> files;
+  std::unique_ptr<rocksdb::SstFileWriter> writer;
+  std::string lastKey;
+  while (s.ok() && !heap.empty()) {
+    if (canceled_) {
+      return nebula::cpp2::ErrorCode::E_USER_CANCEL;
+    }
+    auto idx = heap.top();
+    heap.pop();
+    auto* iter = iters[idx].get();
+    auto key = iter->key().ToString();
+    if (files.empty() || key != lastKey) {
+      if (writer != nullptr && writer->FileSize() >= fileSizeLimit) {
+        s = writer->Finish();
+        writer.reset();
+      }
+      if (s.ok() && writer == nullptr) {
+        files.emplace_back(folly::stringPrintf("%s/ingest.%06zu.sst", dir.c_str(), files.size()));
+        writer = std::make_unique<rocksdb::SstFileWriter>(rocksdb::EnvOptions(), options);
+        s = writer->Open(files.back());
+      }
+      if (s.ok()) {
+        s = writer->Put(iter->key(), iter->value());
+      }
+      lastKey = std::move(key);
+    }
+    iter->Next();
+    if (iter->Valid()) {
+      heap.push(idx);
+    } else if (!iter->status().ok()) {
+      s = iter->status();
+    }
+  }
+  if (s.ok() && writer != nullptr) {
+    s = writer->Finish();
+  }
+  if (!s.ok()) {
+    LOG(ERROR) << "Merge runs of part " << part << " failed: " << s.ToString();
+    return nebula::cpp2::ErrorCode::E_TASK_EXECUTION_FAILED;
+  }
+
+  // all files of a part are ingested in one call, which is atomic
+  LOG(INFO) << "Bulk load ingest " << files.size() << " files into space " << spaceId_ << " part "
+            << part;
+  return engines_.at(part)->ingest(files);
+}
+
+std::string BulkLoadTask::runDir(PartitionID part) const {
+  return folly::stringPrintf(
+      "%s/bulk_load/%d/%d", engines_.at(part)->getDataRoot(), ctx_.jobId_, part);
+}
+
+}  // namespace storage
+}  // namespace nebula
@@ -0,0 +1,120 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef STORAGE_ADMIN_BULKLOADTASK_H_
+#define STORAGE_ADMIN_BULKLOADTASK_H_
+
+#include "common/meta/NebulaSchemaProvider.h"
+#include "kvstore/KVEngine.h"
+#include "storage/admin/AdminTask.h"
+
+namespace nebula {
+namespace storage {
+
+/**
+ * @brief Task class to build sst files from csv files and ingest them, the csv files are read from
+ * a local directory of every storage host:
+ *
+ *   <path>/vertex/<tag name>/*.csv      vid,prop1,prop2,...
+ *   <path>/edge/<edge name>/*.csv       srcId,dstId,rank,prop1,prop2,...
+ *
+ * Properties are in the order of the latest schema, an empty field means null (or the default
+ * value). Each input file is a subtask: rows of parts on this host are encoded into keys (with
+ * index keys), sorted in memory and spilled as sorted runs per part. Each part is a subtask after
+ * them: when all files are done, the runs of the part are merged into non-overlapping sst files
+ * and ingested together, so a part either gets all of the data or none. Every replica builds the
+ * same files by itself, like ingest.
+ *
+ * It is designed for the initial load of a space: old values of existing keys are overwritten
+ * without cleaning up their index keys.
+ */
+class BulkLoadTask : public AdminTask {
+ public:
+  using AdminTask::finish;
+
+  BulkLoadTask(StorageEnv* env, TaskContext&& ctx) : AdminTask(env, std::move(ctx)) {}
+
+  bool check() override;
+
+  ErrorOr<nebula::cpp2::ErrorCode, std::vector<AdminSubTask>> genSubTasks() override;
+
+  /**
+   * @brief Remove the sorted runs of all parts.
+   *
+   * @param rc Errorcode of subtasks.
+   */
+  void finish(nebula::cpp2::ErrorCode rc) override;
+
+ private:
+  struct Source {
+    bool isEdge;
+    // tag id or edge type
+    int32_t schemaId;
+    std::shared_ptr<const meta::NebulaSchemaProvider> schema;
+    std::vector<std::shared_ptr<meta::cpp2::IndexItem>> indexes;
+    std::string file;
+  };
+
+  using PartBuffers = std::unordered_map<PartitionID, std::vector<kvstore::KV>>;
+  // fields of a csv line, an empty field without quotes is std::nullopt
+  using Fields = std::vector<std::optional<std::string>>;
+
+  nebula::cpp2::ErrorCode prepare();
+
+  nebula::cpp2::ErrorCode listSources(bool isEdge);
+
+  nebula::cpp2::ErrorCode encodeFileAndNotify(size_t fileIdx);
+
+  // Wait for all files to be encoded, then merge and ingest the part if none of them failed
+  nebula::cpp2::ErrorCode waitAndMerge(PartitionID part);
+
+  nebula::cpp2::ErrorCode encodeFile(size_t fileIdx, const Source& source);
+
+  nebula::cpp2::ErrorCode encodeVertex(const Source& source,
+                                       const Fields& fields,
+                                       PartBuffers& buffers,
+                                       size_t& bufferSize);
+
+  nebula::cpp2::ErrorCode encodeEdge(const Source& source,
+                                     const Fields& fields,
+                                     PartBuffers& buffers,
+                                     size_t& bufferSize);
+
+  ErrorOr<nebula::cpp2::ErrorCode, std::string> encodeRow(const Source& source,
+                                                          const Fields& fields,
+                                                          size_t offset);
+
+  ErrorOr<nebula::cpp2::ErrorCode, std::string> toVid(const std::string& field);
+
+  /**
+   * @brief Sort the buffer of each part and write them as sorted runs, the name of a run is
+   * <fileIdx>.<seq>.sst, a key in later runs overwrites the same key in former runs
+   */
+  nebula::cpp2::ErrorCode spill(size_t fileIdx, size_t& seq, PartBuffers& buffers);
+
+  nebula::cpp2::ErrorCode writeSst(const std::string& path, std::vector<kvstore::KV>& data);
+
+  nebula::cpp2::ErrorCode mergeAndIngest(PartitionID part);
+
+  std::string runDir(PartitionID part) const;
+
+ private:
+  GraphSpaceID spaceId_;
+  std::string path_;
+  int32_t vIdLen_;
+  bool isIntId_;
+  int32_t numParts_;
+  std::vector<Source> sources_;
+  // parts of this task on this host, and the engine which stores it
+  std::unordered_map<PartitionID, kvstore::KVEngine*> engines_;
+  std::mutex lock_;
+  std::condition_variable encoded_;
+  size_t encodingFiles_{0};
+};
+
+}  // namespace storage
+}  // namespace nebula
+
+#endif  // STORAGE_ADMIN_BULKLOADTASK_H_
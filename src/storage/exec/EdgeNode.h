@@ -133,7 +133,8 @@ class FetchEdgeNode final : public EdgeNode<cpp2::EdgeKey> {
                                    *edgeKey.edge_type_ref(),
                                    *edgeKey.ranking_ref(),
                                    (*edgeKey.dst_ref()).getStr());
-    ret = context_->env()->kvstore_->get(context_->spaceId(), partId, key_, &val_);
+    ret = context_->env()->kvstore_->get(
+        context_->spaceId(), partId, key_, &val_, false, context_->snapshot(partId));
     if (ret == nebula::cpp2::ErrorCode::SUCCEEDED) {
       return doExecute(key_, val_);
     } else if (ret == nebula::cpp2::ErrorCode::E_KEY_NOT_FOUND) {
@@ -225,8 +226,11 @@ class SingleEdgeNode final : public EdgeNode<VertexID> {
     VLOG(1) << "partId " << partId << ", vId " << vId << ", edgeType " << edgeType_
             << ", prop size " << props_->size();
     std::unique_ptr<kvstore::KVIterator> iter;
+    // The prefix covers (part, srcId, edgeType), which is never shorter than the prefix extractor,
+    // so the iterator is bounded by the prefix and could be filtered by prefix bloom filter.
     prefix_ = NebulaKeyUtils::edgePrefix(context_->vIdLen(), partId, vId, edgeType_);
-    ret = context_->env()->kvstore_->prefix(context_->spaceId(), partId, prefix_, &iter);
+    ret = context_->env()->kvstore_->prefix(
+        context_->spaceId(), partId, prefix_, &iter, false, context_->snapshot(partId));
     if (ret == nebula::cpp2::ErrorCode::SUCCEEDED && iter && iter->valid()) {
       if (!skipDecode_) {
         iter_.reset(new SingleEdgeIterator(context_, std::move(iter), edgeType_, schemas_, &ttl_));
@@ -47,6 +47,7 @@ class FilterNode : public IterateNode<T> {
         filterExp_(exp),
         tagFilterExp_(tagFilterExp) {
     IterateNode<T>::name_ = "FilterNode";
+    IterateNode<T>::numRows_ = 0;
   }
 
   nebula::cpp2::ErrorCode doExecute(PartitionID partId, const T& vId) override {
@@ -77,6 +78,14 @@ class FilterNode : public IterateNode<T> {
 
  private:
   bool check() override {
+    auto passed = test();
+    if (passed) {
+      ++this->numRows_;
+    }
+    return passed;
+  }
+
+  bool test() {
     if (filterExp_ == nullptr) {
       return true;
     }
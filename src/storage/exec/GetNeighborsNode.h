@@ -36,6 +36,7 @@ class GetNeighborsNode : public QueryNode<VertexID> {
         resultDataSet_(resultDataSet),
         limit_(limit) {
     name_ = "GetNeighborsNode";
+    numRows_ = 0;
   }
 
   nebula::cpp2::ErrorCode doExecute(PartitionID partId, const VertexID& vId) override {
@@ -94,6 +95,7 @@ class GetNeighborsNode : public QueryNode<VertexID> {
     // so if it it an edge, this test is always true
     if (!context_->filterInvalidResultOut || context_->resultStat_ == ResultStatus::NORMAL) {
       resultDataSet_->rows.emplace_back(std::move(row));
+      ++numRows_;
     }
 
     return nebula::cpp2::ErrorCode::SUCCEEDED;
@@ -125,9 +127,16 @@ class GetNeighborsNode : public QueryNode<VertexID> {
 
       list.reserve(props->size());
       // collect props need to return
-      if (!QueryUtils::collectEdgeProps(
-               key, context_->vIdLen(), context_->isIntId(), reader, props, list)
-               .ok()) {
+      auto status = QueryUtils::collectEdgeProps(key,
+                                                 context_->vIdLen(),
+                                                 context_->isIntId(),
+                                                 reader,
+                                                 props,
+                                                 list,
+                                                 nullptr,
+                                                 "",
+                                                 &decoders_);
+      if (!status.ok()) {
         return nebula::cpp2::ErrorCode::E_EDGE_PROP_NOT_FOUND;
       }
 
@@ -165,6 +174,7 @@ class GetNeighborsNode : public QueryNode<VertexID> {
   EdgeContext* edgeContext_;
   nebula::DataSet* resultDataSet_;
   int64_t limit_;
+  PropDecoders decoders_;
 };
 
 class GetNeighborsSampleNode : public GetNeighborsNode {
@@ -33,6 +33,7 @@ class GetTagPropNode : public QueryNode<VertexID> {
         limit_(limit),
         tagContext_(tagContext) {
     name_ = "GetTagPropNode";
+    numRows_ = 0;
   }
 
   nebula::cpp2::ErrorCode doExecute(PartitionID partId, const VertexID& vId) override {
@@ -55,7 +56,8 @@ class GetTagPropNode : public QueryNode<VertexID> {
         auto kvstore = context_->env()->kvstore_;
         auto vertexKey = NebulaKeyUtils::vertexKey(context_->vIdLen(), partId, vId);
         std::string value;
-        ret = kvstore->get(context_->spaceId(), partId, vertexKey, &value);
+        ret = kvstore->get(
+            context_->spaceId(), partId, vertexKey, &value, false, context_->snapshot(partId));
         if (ret == nebula::cpp2::ErrorCode::E_KEY_NOT_FOUND) {
           return nebula::cpp2::ErrorCode::SUCCEEDED;
         } else if (ret != nebula::cpp2::ErrorCode::SUCCEEDED) {
@@ -65,7 +67,8 @@ class GetTagPropNode : public QueryNode<VertexID> {
         // check if vId has any valid tag by prefix scan
         std::unique_ptr<kvstore::KVIterator> iter;
         auto tagPrefix = NebulaKeyUtils::tagPrefix(context_->vIdLen(), partId, vId);
-        ret = context_->env()->kvstore_->prefix(context_->spaceId(), partId, tagPrefix, &iter);
+        ret = context_->env()->kvstore_->prefix(
+            context_->spaceId(), partId, tagPrefix, &iter, false, context_->snapshot(partId));
         if (ret != nebula::cpp2::ErrorCode::SUCCEEDED) {
           return ret;
         } else if (!iter->valid()) {
@@ -130,8 +133,15 @@ class GetTagPropNode : public QueryNode<VertexID> {
               folly::StringPiece key,
               RowReaderWrapper* reader,
               const std::vector<PropContext>* props) -> nebula::cpp2::ErrorCode {
-            auto status = QueryUtils::collectVertexProps(
-                key, vIdLen, isIntId, reader, props, row, expCtx_.get(), tagNode->getTagName());
+            auto status = QueryUtils::collectVertexProps(key,
+                                                         vIdLen,
+                                                         isIntId,
+                                                         reader,
+                                                         props,
+                                                         row,
+                                                         expCtx_.get(),
+                                                         tagNode->getTagName(),
+                                                         &decoders_);
             if (!status.ok()) {
               return nebula::cpp2::ErrorCode::E_TAG_PROP_NOT_FOUND;
             }
@@ -143,10 +153,12 @@ class GetTagPropNode : public QueryNode<VertexID> {
     }
     if (filter_ == nullptr) {
       resultDataSet_->rows.emplace_back(std::move(row));
+      ++numRows_;
     } else {
       auto result = QueryUtils::vTrue(filter_->eval(*expCtx_));
       if (result.ok() && result.value()) {
         resultDataSet_->rows.emplace_back(std::move(row));
+        ++numRows_;
       }
     }
     if (expCtx_ != nullptr) {
@@ -163,6 +175,7 @@ class GetTagPropNode : public QueryNode<VertexID> {
   Expression* filter_{nullptr};
   const std::size_t limit_{std::numeric_limits<std::size_t>::max()};
   TagContext* tagContext_;
+  PropDecoders decoders_;
 };
 
 class GetEdgePropNode : public QueryNode<cpp2::EdgeKey> {
@@ -183,6 +196,7 @@ class GetEdgePropNode : public QueryNode<cpp2::EdgeKey> {
         filter_(filter),
         limit_(limit) {
     QueryNode::name_ = "GetEdgePropNode";
+    QueryNode::numRows_ = 0;
   }
 
   nebula::cpp2::ErrorCode doExecute(PartitionID partId, const cpp2::EdgeKey& edgeKey) override {
@@ -214,8 +228,15 @@ class GetEdgePropNode : public QueryNode<cpp2::EdgeKey> {
               folly::StringPiece key,
               RowReaderWrapper* reader,
               const std::vector<PropContext>* props) -> nebula::cpp2::ErrorCode {
-            auto status = QueryUtils::collectEdgeProps(
-                key, vIdLen, isIntId, reader, props, row, expCtx_.get(), edgeNode->getEdgeName());
+            auto status = QueryUtils::collectEdgeProps(key,
+                                                       vIdLen,
+                                                       isIntId,
+                                                       reader,
+                                                       props,
+                                                       row,
+                                                       expCtx_.get(),
+                                                       edgeNode->getEdgeName(),
+                                                       &decoders_);
             if (!status.ok()) {
               return nebula::cpp2::ErrorCode::E_TAG_PROP_NOT_FOUND;
             }
@@ -227,10 +248,12 @@ class GetEdgePropNode : public QueryNode<cpp2::EdgeKey> {
     }
     if (filter_ == nullptr) {
       resultDataSet_->rows.emplace_back(std::move(row));
+      ++numRows_;
     } else {
       auto result = QueryUtils::vTrue(filter_->eval(*expCtx_));
       if (result.ok() && result.value()) {
         resultDataSet_->rows.emplace_back(std::move(row));
+        ++numRows_;
       }
     }
     if (expCtx_ != nullptr) {
@@ -246,6 +269,7 @@ class GetEdgePropNode : public QueryNode<cpp2::EdgeKey> {
   std::unique_ptr<StorageExpressionContext> expCtx_{nullptr};
   Expression* filter_{nullptr};
   const std::size_t limit_{std::numeric_limits<std::size_t>::max()};
+  PropDecoders decoders_;
 };
 
 }  // namespace storage
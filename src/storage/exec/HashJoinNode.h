@@ -76,7 +76,8 @@ class HashJoinNode : public IterateNode<VertexID> {
                                                          props,
                                                          list,
                                                          expCtx_,
-                                                         tagName);
+                                                         tagName,
+                                                         &decoders_);
             if (!status.ok()) {
               return nebula::cpp2::ErrorCode::E_TAG_PROP_NOT_FOUND;
             }
@@ -158,6 +159,7 @@ class HashJoinNode : public IterateNode<VertexID> {
   TagContext* tagContext_;
   EdgeContext* edgeContext_;
   StorageExpressionContext* expCtx_;
+  PropDecoders decoders_;
 
   std::unique_ptr<MultiEdgeIterator> iter_;
 };
@@ -88,7 +88,8 @@ nebula::cpp2::ErrorCode IndexEdgeScanNode::getBaseData(folly::StringPiece key,
                                      context_->edgeType_,
                                      IndexKeyUtils::getIndexRank(vIdLen, key),
                                      IndexKeyUtils::getIndexDstId(vIdLen, key).str());
-  return kvstore_->get(context_->spaceId(), partId_, kv.first, &kv.second);
+  return kvstore_->get(
+      context_->spaceId(), partId_, kv.first, &kv.second, false, context_->snapshot(partId_));
 }
 
 Map<std::string, Value> IndexEdgeScanNode::decodeFromBase(const std::string& key,
@@ -253,6 +253,13 @@ class IndexNode {
    */
   inline const time::Duration& duration();
 
+  /**
+   * @brief The rows output by next(), only counted when the profile detail is enabled
+   */
+  int64_t rows() const {
+    return rows_;
+  }
+
  protected:
   virtual Result doNext() = 0;
   void beforeNext();
@@ -285,6 +292,7 @@ class IndexNode {
    * @brief whether record execution time or not.
    */
   bool profileDetail_{false};
+  int64_t rows_{0};
 };
 
 /* Definition of inline function */
@@ -295,6 +303,9 @@ inline IndexNode::Result IndexNode::next() {
   }
   Result ret = doNext();
   afterNext();
+  if (UNLIKELY(profileDetail_) && ret.hasData()) {
+    ++rows_;
+  }
   return ret;
 }
 
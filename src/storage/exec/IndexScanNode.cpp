@@ -489,10 +489,17 @@ nebula::cpp2::ErrorCode IndexScanNode::resetIter(PartitionID partId) {
   nebula::cpp2::ErrorCode ret = nebula::cpp2::ErrorCode::SUCCEEDED;
   if (path_->isRange()) {
     auto rangePath = dynamic_cast<RangePath*>(path_.get());
-    kvstore_->range(spaceId_, partId, rangePath->getStartKey(), rangePath->getEndKey(), &iter_);
+    kvstore_->range(spaceId_,
+                    partId,
+                    rangePath->getStartKey(),
+                    rangePath->getEndKey(),
+                    &iter_,
+                    false,
+                    context_->snapshot(partId));
   } else {
     auto prefixPath = dynamic_cast<PrefixPath*>(path_.get());
-    ret = kvstore_->prefix(spaceId_, partId, prefixPath->getPrefixKey(), &iter_);
+    ret = kvstore_->prefix(
+        spaceId_, partId, prefixPath->getPrefixKey(), &iter_, false, context_->snapshot(partId));
   }
   return ret;
 }
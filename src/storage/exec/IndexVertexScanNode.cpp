@@ -58,7 +58,8 @@ nebula::cpp2::ErrorCode IndexVertexScanNode::getBaseData(folly::StringPiece key,
                                     partId_,
                                     key.subpiece(key.size() - context_->vIdLen()).toString(),
                                     context_->tagId_);
-  return kvstore_->get(context_->spaceId(), partId_, kv.first, &kv.second);
+  return kvstore_->get(
+      context_->spaceId(), partId_, kv.first, &kv.second, false, context_->snapshot(partId_));
 }
 
 Row IndexVertexScanNode::decodeFromIndex(folly::StringPiece key) {
@@ -0,0 +1,67 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef STORAGE_EXEC_PROPDECODERS_H_
+#define STORAGE_EXEC_PROPDECODERS_H_
+
+#include "codec/RowDecoder.h"
+#include "common/base/Base.h"
+#include "storage/query/QueryBaseProcessor.h"
+
+namespace nebula {
+namespace storage {
+
+/**
+ * @brief PropDecoders keeps the row decoders compiled for a list of props to read and each schema
+ * version of the rows. A node of a plan owns it, so it's only accessed by one thread, and the prop
+ * contexts are not changed once the plan is built.
+ */
+class PropDecoders final {
+ public:
+  /**
+   * @brief Decode the props in value to read of the row, the props in key and the ones neither
+   * returned nor filtered are skipped. The decoder is compiled at the first row of a schema
+   * version.
+   *
+   * @param props Props to read
+   * @param reader Reader of the row
+   * @return The decoded values in the order of props, or nullptr if the row could not be decoded
+   */
+  std::vector<Value>* decode(const std::vector<PropContext>* props, RowReaderWrapper* reader) {
+    if (reader == nullptr || !*reader) {
+      return nullptr;
+    }
+    auto key = std::make_pair(props, reader->getSchema());
+    auto iter = decoders_.find(key);
+    if (iter == decoders_.end()) {
+      std::vector<std::string> names;
+      names.reserve(props->size());
+      for (const auto& prop : *props) {
+        if (prop.propInKeyType_ == PropContext::PropInKeyType::NONE &&
+            (prop.returned_ || prop.filtered_)) {
+          names.emplace_back(prop.name_);
+        } else {
+          names.emplace_back();
+        }
+      }
+      iter = decoders_.emplace(key, std::make_unique<RowDecoder>(key.second, names)).first;
+    }
+    if (!iter->second->decode(reader->rowData(), values_)) {
+      return nullptr;
+    }
+    return &values_;
+  }
+
+ private:
+  std::unordered_map<std::pair<const std::vector<PropContext>*, const meta::NebulaSchemaProvider*>,
+                     std::unique_ptr<RowDecoder>>
+      decoders_;
+  // reused across rows
+  std::vector<Value> values_;
+};
+
+}  // namespace storage
+}  // namespace nebula
+#endif  // STORAGE_EXEC_PROPDECODERS_H_
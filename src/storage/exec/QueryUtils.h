@@ -12,6 +12,7 @@
 #include "common/utils/NebulaKeyUtils.h"
 #include "storage/CommonUtils.h"
 #include "storage/context/StorageExpressionContext.h"
+#include "storage/exec/PropDecoders.h"
 #include "storage/query/QueryBaseProcessor.h"
 
 namespace nebula {
@@ -75,7 +76,20 @@ class QueryUtils final {
   static StatusOr<nebula::Value> readValue(RowReaderWrapper* reader,
                                            const std::string& propName,
                                            const meta::NebulaSchemaProvider::SchemaField* field) {
-    auto value = reader->getValueByName(propName);
+    return readValue(reader->getValueByName(propName), propName, field);
+  }
+
+  /**
+   * @brief Get value with propName from the value decoded from a row
+   *
+   * @param value Value decoded by the row reader or decoder
+   * @param propName Field name
+   * @param field Field definition
+   * @return StatusOr<nebula::Value>
+   */
+  static StatusOr<nebula::Value> readValue(nebula::Value value,
+                                           const std::string& propName,
+                                           const meta::NebulaSchemaProvider::SchemaField* field) {
     if (value.type() == Value::Type::NULLVALUE) {
       // read null value
       auto nullType = value.getNull();
@@ -203,12 +217,17 @@ class QueryUtils final {
                                    const std::vector<PropContext>* props,
                                    nebula::List& list,
                                    StorageExpressionContext* expCtx = nullptr,
-                                   const std::string& tagName = "") {
-    for (const auto& prop : *props) {
+                                   const std::string& tagName = "",
+                                   PropDecoders* decoders = nullptr) {
+    auto* decoded = decoders != nullptr ? decoders->decode(props, reader) : nullptr;
+    for (size_t i = 0; i < props->size(); ++i) {
+      const auto& prop = (*props)[i];
       if (!(prop.returned_ || (prop.filtered_ && expCtx != nullptr))) {
         continue;
       }
-      auto value = QueryUtils::readVertexProp(key, vIdLen, isIntId, reader, prop);
+      auto value = decoded != nullptr && prop.propInKeyType_ == PropContext::PropInKeyType::NONE
+                       ? QueryUtils::readValue(std::move((*decoded)[i]), prop.name_, prop.field_)
+                       : QueryUtils::readVertexProp(key, vIdLen, isIntId, reader, prop);
       NG_RETURN_IF_ERROR(value);
       if (prop.returned_) {
         VLOG(2) << "Collect prop " << prop.name_;
@@ -228,12 +247,17 @@ class QueryUtils final {
                                  const std::vector<PropContext>* props,
                                  nebula::List& list,
                                  StorageExpressionContext* expCtx = nullptr,
-                                 const std::string& edgeName = "") {
-    for (const auto& prop : *props) {
+                                 const std::string& edgeName = "",
+                                 PropDecoders* decoders = nullptr) {
+    auto* decoded = decoders != nullptr ? decoders->decode(props, reader) : nullptr;
+    for (size_t i = 0; i < props->size(); ++i) {
+      const auto& prop = (*props)[i];
       if (!(prop.returned_ || (prop.filtered_ && expCtx != nullptr))) {
         continue;
       }
-      auto value = QueryUtils::readEdgeProp(key, vIdLen, isIntId, reader, prop);
+      auto value = decoded != nullptr && prop.propInKeyType_ == PropContext::PropInKeyType::NONE
+                       ? QueryUtils::readValue(std::move((*decoded)[i]), prop.name_, prop.field_)
+                       : QueryUtils::readEdgeProp(key, vIdLen, isIntId, reader, prop);
       NG_RETURN_IF_ERROR(value);
       if (prop.returned_) {
         VLOG(2) << "Collect prop " << prop.name_;
@@ -47,6 +47,7 @@ class RelNode {
    *
    */
   virtual nebula::cpp2::ErrorCode execute(PartitionID partId, const T& input) {
+    ++numInputs_;
     duration_.resume();
     auto ret = doExecute(partId, input);
     duration_.pause();
@@ -63,6 +64,7 @@ class RelNode {
   }
 
   virtual nebula::cpp2::ErrorCode execute(PartitionID partId) {
+    ++numInputs_;
     duration_.resume();
     auto ret = doExecute(partId);
     duration_.pause();
@@ -97,6 +99,10 @@ class RelNode {
   std::vector<RelNode<T>*> dependencies_;
   bool isDependent_ = false;
   time::Duration duration_{true};
+  // The times the node is executed
+  int64_t numInputs_ = 0;
+  // The rows output by the node, -1 if the node doesn't count them
+  int64_t numRows_ = -1;
 };
 
 // QueryNode is the node which would read data from kvstore, it usually generate
@@ -71,7 +71,13 @@ class ScanVertexPropNode : public QueryNode<Cursor> {
 
     std::unique_ptr<kvstore::KVIterator> iter;
     auto kvRet = context_->env()->kvstore_->rangeWithPrefix(
-        context_->planContext_->spaceId_, partId, start, prefix, &iter, enableReadFollower_);
+        context_->planContext_->spaceId_,
+        partId,
+        start,
+        prefix,
+        &iter,
+        enableReadFollower_,
+        context_->snapshot(partId));
     if (kvRet != nebula::cpp2::ErrorCode::SUCCEEDED) {
       return kvRet;
     }
@@ -245,7 +251,13 @@ class ScanEdgePropNode : public QueryNode<Cursor> {
 
     std::unique_ptr<kvstore::KVIterator> iter;
     auto kvRet = context_->env()->kvstore_->rangeWithPrefix(
-        context_->spaceId(), partId, start, prefix, &iter, enableReadFollower_);
+        context_->spaceId(),
+        partId,
+        start,
+        prefix,
+        &iter,
+        enableReadFollower_,
+        context_->snapshot(partId));
     if (kvRet != nebula::cpp2::ErrorCode::SUCCEEDED) {
       return kvRet;
     }
@@ -40,6 +40,7 @@ void LookupProcessor::doProcess(const cpp2::LookupIndexRequest& req) {
   if (req.common_ref().has_value() && req.get_common()->profile_detail_ref().value_or(false)) {
     profileDetailFlag_ = true;
   }
+  initPerfContextFlag();
   auto code = prepare(req);
   if (UNLIKELY(code != ::nebula::cpp2::ErrorCode::SUCCEEDED)) {
     for (auto& p : req.get_parts()) {
@@ -219,6 +220,7 @@ ErrorOr<nebula::cpp2::ErrorCode, std::unique_ptr<IndexNode>> LookupProcessor::bu
 void LookupProcessor::runInSingleThread(const std::vector<PartitionID>& parts,
                                         std::unique_ptr<IndexNode> plan) {
   memory::MemoryCheckGuard guard;
+  kvstore::ReadPerfContext perf(perfContextFlag_);
   // printPlan(plan.get());
   std::vector<std::deque<Row>> datasetList;
   std::vector<::nebula::cpp2::ErrorCode> codeList;
@@ -260,6 +262,7 @@ void LookupProcessor::runInSingleThread(const std::vector<PartitionID>& parts,
   if (UNLIKELY(profileDetailFlag_)) {
     profilePlan(plan.get());
   }
+  profilePerfContext(perf);
   onProcessFinished();
   onFinished();
 }
@@ -277,6 +280,7 @@ void LookupProcessor::runInMultipleThread(const std::vector<PartitionID>& parts,
                      memory::MemoryCheckGuard guard;
                      ::nebula::cpp2::ErrorCode code = ::nebula::cpp2::ErrorCode::SUCCEEDED;
                      std::deque<Row> dataset;
+                     kvstore::ReadPerfContext perf(perfContextFlag_);
                      plan->execute(part);
                      do {
                        auto result = plan->next();
@@ -293,6 +297,7 @@ void LookupProcessor::runInMultipleThread(const std::vector<PartitionID>& parts,
                      if (UNLIKELY(profileDetailFlag_)) {
                        profilePlan(plan.get());
                      }
+                     profilePerfContext(perf);
                      Row statResult;
                      if (code == nebula::cpp2::ErrorCode::SUCCEEDED && statTypes_.size() > 0) {
                        auto indexAgg = dynamic_cast<IndexAggregateNode*>(plan.get());
@@ -467,6 +472,7 @@ void LookupProcessor::profilePlan(IndexNode* root) {
     } else {
       iter->second += node->duration().elapsedInUSec();
     }
+    profileCounters_[id + "_rows"] += node->rows();
     for (auto& child : node->children()) {
       q.push(child.get());
     }
@@ -56,6 +56,8 @@ void UpdateEdgeProcessor::doProcess(const cpp2::UpdateEdgeRequest& req) {
   }
   this->planContext_ = std::make_unique<PlanContext>(
       this->env_, spaceId_, this->spaceVidLen_, this->isIntId_, req.common_ref());
+  // The update reads what it writes, which must be the latest data rather than a snapshot
+  planContext_->snapshotRead_ = false;
   context_ = std::make_unique<RuntimeContext>(planContext_.get());
   retCode = checkAndBuildContexts(req);
   if (retCode != nebula::cpp2::ErrorCode::SUCCEEDED) {
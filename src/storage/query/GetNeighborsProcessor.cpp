@@ -42,6 +42,7 @@ void GetNeighborsProcessor::doProcess(const cpp2::GetNeighborsRequest& req) {
   if (req.common_ref().has_value() && req.get_common()->profile_detail_ref().value_or(false)) {
     profileDetailFlag_ = true;
   }
+  initPerfContextFlag();
   this->planContext_ = std::make_unique<PlanContext>(
       this->env_, spaceId_, this->spaceVidLen_, this->isIntId_, req.common_ref());
 
@@ -78,6 +79,7 @@ void GetNeighborsProcessor::runInSingleThread(const cpp2::GetNeighborsRequest& r
                                               int64_t limit,
                                               bool random) {
   memory::MemoryCheckGuard guard;
+  kvstore::ReadPerfContext perf(perfContextFlag_);
   contexts_.emplace_back(RuntimeContext(planContext_.get()));
   expCtxs_.emplace_back(StorageExpressionContext(spaceVidLen_, isIntId_));
   auto plan = buildPlan(&contexts_.front(), &expCtxs_.front(), &resultDataSet_, limit, random);
@@ -109,6 +111,7 @@ void GetNeighborsProcessor::runInSingleThread(const cpp2::GetNeighborsRequest& r
   if (UNLIKELY(profileDetailFlag_)) {
     profilePlan(plan);
   }
+  profilePerfContext(perf);
   onProcessFinished();
   onFinished();
 }
@@ -178,6 +181,7 @@ folly::Future<std::pair<nebula::cpp2::ErrorCode, PartitionID>> GetNeighborsProce
                if (memoryExceeded_) {
                  return std::make_pair(nebula::cpp2::ErrorCode::E_STORAGE_MEMORY_EXCEEDED, partId);
                }
+               kvstore::ReadPerfContext perf(perfContextFlag_);
                auto plan = buildPlan(context, expCtx, result, limit, random);
                for (const auto& vid : input) {
                  auto vId = vid.getStr();
@@ -197,6 +201,7 @@ folly::Future<std::pair<nebula::cpp2::ErrorCode, PartitionID>> GetNeighborsProce
                if (UNLIKELY(this->profileDetailFlag_)) {
                  profilePlan(plan);
                }
+               profilePerfContext(perf);
                return std::make_pair(nebula::cpp2::ErrorCode::SUCCEEDED, partId);
              })
       .thenError(folly::tag_t<std::bad_alloc>{}, [this, partId](const std::bad_alloc&) {
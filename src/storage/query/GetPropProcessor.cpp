@@ -35,6 +35,10 @@ void GetPropProcessor::doProcess(const cpp2::GetPropRequest& req) {
     onFinished();
     return;
   }
+  if (req.common_ref().has_value() && req.get_common()->profile_detail_ref().value_or(false)) {
+    profileDetailFlag_ = true;
+  }
+  initPerfContextFlag();
   this->planContext_ = std::make_unique<PlanContext>(
       this->env_, spaceId_, this->spaceVidLen_, this->isIntId_, req.common_ref());
 
@@ -57,6 +61,7 @@ void GetPropProcessor::doProcess(const cpp2::GetPropRequest& req) {
 
 void GetPropProcessor::runInSingleThread(const cpp2::GetPropRequest& req) {
   memory::MemoryCheckGuard guard;
+  kvstore::ReadPerfContext perf(perfContextFlag_);
   contexts_.emplace_back(RuntimeContext(planContext_.get()));
   std::unordered_set<PartitionID> failedParts;
   if (!isEdge_) {
@@ -82,6 +87,9 @@ void GetPropProcessor::runInSingleThread(const cpp2::GetPropRequest& req) {
         }
       }
     }
+    if (UNLIKELY(profileDetailFlag_)) {
+      profilePlan(plan);
+    }
   } else {
     auto plan = buildEdgePlan(&contexts_.front(), &resultDataSet_);
     for (const auto& partEntry : req.get_parts()) {
@@ -111,7 +119,11 @@ void GetPropProcessor::runInSingleThread(const cpp2::GetPropRequest& req) {
         }
       }
     }
+    if (UNLIKELY(profileDetailFlag_)) {
+      profilePlan(plan);
+    }
   }
+  profilePerfContext(perf);
   onProcessFinished();
   onFinished();
 }
@@ -174,6 +186,7 @@ folly::Future<std::pair<nebula::cpp2::ErrorCode, PartitionID>> GetPropProcessor:
                         return std::make_pair(nebula::cpp2::ErrorCode::E_STORAGE_MEMORY_EXCEEDED,
                                               partId);
                       }
+                      kvstore::ReadPerfContext perf(perfContextFlag_);
                       if (!isEdge_) {
                         auto plan = buildTagPlan(context, result);
                         for (const auto& row : input) {
@@ -190,6 +203,10 @@ folly::Future<std::pair<nebula::cpp2::ErrorCode, PartitionID>> GetPropProcessor:
                             return std::make_pair(ret, partId);
                           }
                         }
+                        if (UNLIKELY(profileDetailFlag_)) {
+                          profilePlan(plan);
+                        }
+                        profilePerfContext(perf);
                         return std::make_pair(nebula::cpp2::ErrorCode::SUCCEEDED, partId);
                       } else {
                         auto plan = buildEdgePlan(context, result);
@@ -215,6 +232,10 @@ folly::Future<std::pair<nebula::cpp2::ErrorCode, PartitionID>> GetPropProcessor:
                             return std::make_pair(ret, partId);
                           }
                         }
+                        if (UNLIKELY(profileDetailFlag_)) {
+                          profilePlan(plan);
+                        }
+                        profilePerfContext(perf);
                         return std::make_pair(nebula::cpp2::ErrorCode::SUCCEEDED, partId);
                       }
                     })
@@ -690,8 +690,13 @@ template <typename IdType>
 void QueryBaseProcessor<REQ, RESP>::profilePlan(const StoragePlan<IdType>& plan) {
   auto& nodes = plan.getNodes();
   std::lock_guard<std::mutex> lck(BaseProcessor<RESP>::profileMut_);
+  auto& counters = BaseProcessor<RESP>::profileCounters_;
   for (auto& node : nodes) {
     BaseProcessor<RESP>::profileDetail(node->name_, node->duration_.elapsedInUSec());
+    counters[node->name_ + "_inputs"] += node->numInputs_;
+    if (node->numRows_ >= 0) {
+      counters[node->name_ + "_rows"] += node->numRows_;
+    }
   }
 }
 
@@ -13,6 +13,13 @@ stats::CounterId kNumVerticesInserted;
 stats::CounterId kNumEdgesDeleted;
 stats::CounterId kNumTagsDeleted;
 stats::CounterId kNumVerticesDeleted;
+stats::CounterId kNumTossRemoteBatches;
+stats::CounterId kNumTossRemoteChains;
+stats::CounterId kNumReadSnapshots;
+stats::CounterId kNumReadSnapshotsCreated;
+stats::CounterId kNumReadSnapshotsExpired;
+stats::CounterId kNumReadSnapshotsReleased;
+stats::CounterId kNumReadSnapshotsRejected;
 
 void initStorageStats() {
   kNumEdgesInserted = stats::StatsManager::registerStats("num_edges_inserted", "rate, sum");
@@ -20,6 +27,18 @@ void initStorageStats() {
   kNumEdgesDeleted = stats::StatsManager::registerStats("num_edges_deleted", "rate, sum");
   kNumTagsDeleted = stats::StatsManager::registerStats("num_tags_deleted", "rate, sum");
   kNumVerticesDeleted = stats::StatsManager::registerStats("num_vertices_deleted", "rate, sum");
+  kNumTossRemoteBatches =
+      stats::StatsManager::registerStats("num_toss_remote_batches", "rate, sum");
+  kNumTossRemoteChains = stats::StatsManager::registerStats("num_toss_remote_chains", "rate, sum");
+  kNumReadSnapshots = stats::StatsManager::registerStats("num_read_snapshots", "sum");
+  kNumReadSnapshotsCreated =
+      stats::StatsManager::registerStats("num_read_snapshots_created", "rate, sum");
+  kNumReadSnapshotsExpired =
+      stats::StatsManager::registerStats("num_read_snapshots_expired", "rate, sum");
+  kNumReadSnapshotsReleased =
+      stats::StatsManager::registerStats("num_read_snapshots_released", "rate, sum");
+  kNumReadSnapshotsRejected =
+      stats::StatsManager::registerStats("num_read_snapshots_rejected", "rate, sum");
 
 #ifndef BUILD_STANDALONE
   initMetaClientStats();
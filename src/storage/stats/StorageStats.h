@@ -15,6 +15,13 @@ extern stats::CounterId kNumVerticesInserted;
 extern stats::CounterId kNumEdgesDeleted;
 extern stats::CounterId kNumTagsDeleted;
 extern stats::CounterId kNumVerticesDeleted;
+extern stats::CounterId kNumTossRemoteBatches;
+extern stats::CounterId kNumTossRemoteChains;
+extern stats::CounterId kNumReadSnapshots;
+extern stats::CounterId kNumReadSnapshotsCreated;
+extern stats::CounterId kNumReadSnapshotsExpired;
+extern stats::CounterId kNumReadSnapshotsReleased;
+extern stats::CounterId kNumReadSnapshotsRejected;
 
 /**
  * @brief Init storage statistic points for storage/meta client/kv
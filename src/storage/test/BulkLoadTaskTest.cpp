@@ -0,0 +1,188 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include <folly/synchronization/Baton.h>
+#include <gtest/gtest.h>
+
+#include <fstream>
+
+#include "clients/meta/MetaClient.h"
+#include "codec/RowReaderWrapper.h"
+#include "common/base/Base.h"
+#include "common/fs/FileUtils.h"
+#include "common/fs/TempDir.h"
+#include "common/utils/IndexKeyUtils.h"
+#include "common/utils/NebulaKeyUtils.h"
+#include "interface/gen-cpp2/meta_types.h"
+#include "mock/MockCluster.h"
+#include "storage/admin/AdminTaskManager.h"
+#include "storage/admin/BulkLoadTask.h"
+
+namespace nebula {
+namespace storage {
+
+class BulkLoadTaskTest : public ::testing::Test {
+ protected:
+  static void SetUpTestCase() {
+    LOG(INFO) << "SetUp BulkLoadTaskTest TestCase";
+    rootPath_ = std::make_unique<fs::TempDir>("/tmp/BulkLoadTaskTest.XXXXXX");
+    cluster_ = std::make_unique<nebula::mock::MockCluster>();
+    cluster_->initStorageKV(rootPath_->path());
+    env_ = cluster_->storageEnv_.get();
+    manager_ = AdminTaskManager::instance();
+    manager_->init();
+  }
+
+  static void TearDownTestCase() {
+    LOG(INFO) << "TearDown BulkLoadTaskTest TestCase";
+    manager_->shutdown();
+    cluster_.reset();
+    rootPath_.reset();
+  }
+
+  static void writeFile(const std::string& dir, const std::vector<std::string>& lines) {
+    ASSERT_TRUE(fs::FileUtils::makeDir(dir));
+    std::ofstream out(folly::stringPrintf("%s/data.csv", dir.c_str()));
+    for (auto& line : lines) {
+      out << line << "\n";
+    }
+  }
+
+  static nebula::cpp2::ErrorCode runTask(int32_t jobId, const std::string& path) {
+    cpp2::TaskPara para;
+    para.space_id_ref() = 1;
+    std::vector<PartitionID> parts = {1, 2, 3, 4, 5, 6};
+    para.parts_ref() = std::move(parts);
+    para.task_specific_paras_ref() = {path};
+
+    cpp2::AddTaskRequest request;
+    request.job_type_ref() = meta::cpp2::JobType::INGEST;
+    request.job_id_ref() = jobId;
+    request.task_id_ref() = 0;
+    request.para_ref() = std::move(para);
+
+    folly::Baton<> baton;
+    auto code = nebula::cpp2::ErrorCode::E_UNKNOWN;
+    auto callback = [&](nebula::cpp2::ErrorCode ret, nebula::meta::cpp2::StatsItem&) {
+      code = ret;
+      baton.post();
+    };
+    TaskContext context(request, callback);
+    auto task = std::make_shared<BulkLoadTask>(env_, std::move(context));
+    manager_->addAsyncTask(task);
+    baton.wait();
+    return code;
+  }
+
+  static StorageEnv* env_;
+  static AdminTaskManager* manager_;
+
+ private:
+  static std::unique_ptr<fs::TempDir> rootPath_;
+  static std::unique_ptr<nebula::mock::MockCluster> cluster_;
+};
+
+StorageEnv* BulkLoadTaskTest::env_{nullptr};
+AdminTaskManager* BulkLoadTaskTest::manager_{nullptr};
+std::unique_ptr<fs::TempDir> BulkLoadTaskTest::rootPath_{nullptr};
+std::unique_ptr<nebula::mock::MockCluster> BulkLoadTaskTest::cluster_{nullptr};
+
+TEST_F(BulkLoadTaskTest, LoadVerticesAndEdges) {
+  fs::TempDir input("/tmp/BulkLoadTaskTest.input.XXXXXX");
+  std::string path = input.path();
+  // tag 2 is team(name), edge 101 is serve
+  std::vector<std::string> teams;
+  std::vector<std::string> serves;
+  for (int32_t i = 0; i < 20; i++) {
+    teams.emplace_back(folly::stringPrintf("team_%d,\"Team %d\"", i, i));
+    serves.emplace_back(
+        folly::stringPrintf("player_%d,team_%d,0,player_%d,team_%d,2000,2010,10,,", i, i, i, i));
+  }
+  writeFile(path + "/vertex/2", teams);
+  writeFile(path + "/edge/101", serves);
+
+  ASSERT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, runTask(1, path));
+
+  GraphSpaceID spaceId = 1;
+  size_t vIdLen = 32;
+  for (int32_t i = 0; i < 20; i++) {
+    auto team = folly::stringPrintf("team_%d", i);
+    auto player = folly::stringPrintf("player_%d", i);
+    auto teamPart = meta::MetaClient::partId(6, team);
+    auto playerPart = meta::MetaClient::partId(6, player);
+
+    std::string val;
+    auto key = NebulaKeyUtils::tagKey(vIdLen, teamPart, team, 2);
+    ASSERT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED,
+              env_->kvstore_->get(spaceId, teamPart, key, &val));
+    auto reader = RowReaderWrapper::getTagPropReader(env_->schemaMan_, spaceId, 2, val);
+    ASSERT_TRUE(reader != nullptr);
+    EXPECT_EQ(Value(folly::stringPrintf("Team %d", i)), reader->getValueByName("name"));
+
+    key = NebulaKeyUtils::edgeKey(vIdLen, playerPart, player, 101, 0, team);
+    ASSERT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED,
+              env_->kvstore_->get(spaceId, playerPart, key, &val));
+    reader = RowReaderWrapper::getEdgePropReader(env_->schemaMan_, spaceId, 101, val);
+    ASSERT_TRUE(reader != nullptr);
+    EXPECT_EQ(Value(2000L), reader->getValueByName("startYear"));
+    EXPECT_EQ(Value(10L), reader->getValueByName("teamCareer"));
+
+    key = NebulaKeyUtils::edgeKey(vIdLen, teamPart, team, -101, 0, player);
+    ASSERT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED,
+              env_->kvstore_->get(spaceId, teamPart, key, &val));
+  }
+
+  // every vertex and out-edge has one index key
+  size_t tagIndexNum = 0;
+  size_t edgeIndexNum = 0;
+  for (PartitionID part = 1; part <= 6; part++) {
+    std::unique_ptr<kvstore::KVIterator> iter;
+    auto prefix = IndexKeyUtils::indexPrefix(part, 2);
+    ASSERT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED,
+              env_->kvstore_->prefix(spaceId, part, prefix, &iter));
+    for (; iter->valid(); iter->next()) {
+      tagIndexNum++;
+    }
+    prefix = IndexKeyUtils::indexPrefix(part, 101);
+    ASSERT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED,
+              env_->kvstore_->prefix(spaceId, part, prefix, &iter));
+    for (; iter->valid(); iter->next()) {
+      edgeIndexNum++;
+    }
+  }
+  EXPECT_EQ(20, tagIndexNum);
+  EXPECT_EQ(20, edgeIndexNum);
+}
+
+TEST_F(BulkLoadTaskTest, InvalidInput) {
+  fs::TempDir input("/tmp/BulkLoadTaskTest.input.XXXXXX");
+  std::string path = input.path();
+  // the required teamCareer is missing
+  writeFile(path + "/edge/101", {"player_a,team_a,0,player_a,team_a,2000,2010,,,"});
+  EXPECT_NE(nebula::cpp2::ErrorCode::SUCCEEDED, runTask(2, path));
+
+  // nothing is ingested
+  GraphSpaceID spaceId = 1;
+  std::string player = "player_a";
+  auto part = meta::MetaClient::partId(6, player);
+  std::string val;
+  auto key = NebulaKeyUtils::edgeKey(32, part, player, 101, 0, "team_a");
+  EXPECT_EQ(nebula::cpp2::ErrorCode::E_KEY_NOT_FOUND,
+            env_->kvstore_->get(spaceId, part, key, &val));
+
+  // path is not a directory
+  EXPECT_NE(nebula::cpp2::ErrorCode::SUCCEEDED, runTask(3, path + "/not_exist"));
+}
+
+}  // namespace storage
+}  // namespace nebula
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  folly::init(&argc, &argv, true);
+  google::SetStderrLogging(google::INFO);
+
+  return RUN_ALL_TESTS();
+}
@@ -4,6 +4,7 @@
  */
 
 #include <folly/Format.h>
+#include <folly/ScopeGuard.h>
 #include <folly/String.h>
 #include <folly/container/Enumerate.h>
 #include <folly/init/Init.h>
@@ -14,6 +15,7 @@
 #include "mock/MockCluster.h"
 #include "mock/MockData.h"
 #include "storage/CommonUtils.h"
+#include "storage/StorageFlags.h"
 #include "storage/test/ChainTestUtils.h"
 #include "storage/test/TestUtils.h"
 #include "storage/transaction/ChainAddEdgesGroupProcessor.h"
@@ -176,6 +178,49 @@ TEST(ChainAddEdgesTest, processRemoteUnknownTest) {
   EXPECT_EQ(334, numOfKey(req, util.genDoublePrime, env));
 }
 
+// concurrent chains to the same remote part should share one rpc
+TEST(ChainAddEdgesTest, BatchRemoteRequestTest) {
+  fs::TempDir rootPath("/tmp/AddEdgesTest.XXXXXX");
+  mock::MockCluster cluster;
+  cluster.initStorageKV(rootPath.path());
+  auto* env = cluster.storageEnv_.get();
+  auto mClient = MetaClientTestUpdater::makeDefault();
+  env->metaClient_ = mClient.get();
+  MetaClientTestUpdater::addPartTerm(env->metaClient_, mockSpaceId, mockPartNum, fackTerm);
+
+  UPCLT iClient(FakeInternalStorageClient::instance(env));
+  FakeInternalStorageClient::hookInternalStorageClient(env, iClient.get());
+
+  auto batchSize = FLAGS_toss_remote_batch_size;
+  auto batchWindowMs = FLAGS_toss_remote_batch_window_ms;
+  SCOPE_EXIT {
+    FLAGS_toss_remote_batch_size = batchSize;
+    FLAGS_toss_remote_batch_window_ms = batchWindowMs;
+  };
+  FLAGS_toss_remote_batch_size = 4;
+  FLAGS_toss_remote_batch_window_ms = 60 * 1000;
+  cpp2::AddEdgesRequest req = mock::MockData::mockAddEdgesReq(false, 1);
+  auto& edges = req.get_parts().begin()->second;
+  ASSERT_GE(edges.size(), 4);
+
+  auto* batcher = env->txnMan_->addEdgesBatcher();
+  std::vector<folly::Future<Code>> futs;
+  for (auto i = 0; i < 4; ++i) {
+    cpp2::AddEdgesRequest single;
+    single.space_id_ref() = req.get_space_id();
+    single.prop_names_ref() = req.get_prop_names();
+    single.if_not_exists_ref() = req.get_if_not_exists();
+    (*single.parts_ref())[1].emplace_back(edges[i]);
+    futs.emplace_back(batcher->add(single, 1, fackTerm, std::nullopt));
+  }
+
+  for (auto& code : folly::collectAll(futs).get()) {
+    EXPECT_EQ(suc, code.value());
+  }
+  EXPECT_EQ(1, iClient->numOfChainAddEdges());
+  EXPECT_EQ(4, iClient->numOfEdgesSent());
+}
+
 }  // namespace storage
 }  // namespace nebula
 
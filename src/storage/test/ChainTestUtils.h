@@ -403,9 +403,12 @@ class FakeInternalStorageClient : public InternalStorageClient {
                      std::optional<int64_t> optVersion,
                      folly::Promise<::nebula::cpp2::ErrorCode>&& p,
                      folly::EventBase* evb = nullptr) override {
-    UNUSED(req);
     UNUSED(termId);
     UNUSED(optVersion);
+    ++numOfChainAddEdges_;
+    for (auto& part : req.get_parts()) {
+      numOfEdgesSent_ += part.second.size();
+    }
     p.setValue(code_);
     UNUSED(evb);
   }
@@ -422,6 +425,14 @@ class FakeInternalStorageClient : public InternalStorageClient {
     UNUSED(evb);
   }
 
+  int32_t numOfChainAddEdges() const {
+    return numOfChainAddEdges_;
+  }
+
+  size_t numOfEdgesSent() const {
+    return numOfEdgesSent_;
+  }
+
   static FakeInternalStorageClient* instance(StorageEnv* env, Code fakeCode = Code::SUCCEEDED) {
     auto pool = std::make_shared<folly::IOThreadPoolExecutor>(3);
     return new FakeInternalStorageClient(env, pool, fakeCode);
@@ -434,6 +445,8 @@ class FakeInternalStorageClient : public InternalStorageClient {
  private:
   StorageEnv* env_{nullptr};
   Code code_{Code::SUCCEEDED};
+  std::atomic<int32_t> numOfChainAddEdges_{0};
+  std::atomic<size_t> numOfEdgesSent_{0};
 };
 
 using UPCLT = std::unique_ptr<FakeInternalStorageClient>;
@@ -619,6 +619,55 @@ TEST(GetPropTest, AllPropertyInAllSchemaTest) {
   }
 }
 
+TEST(GetPropTest, ProfileTest) {
+  fs::TempDir rootPath("/tmp/GetPropTest.XXXXXX");
+  mock::MockCluster cluster;
+  cluster.initStorageKV(rootPath.path());
+  auto* env = cluster.storageEnv_.get();
+  auto totalParts = cluster.getTotalParts();
+  ASSERT_EQ(true, QueryTestUtils::mockVertexData(env, totalParts));
+
+  TagID player = 1;
+  std::vector<VertexID> vertices = {"Tim Duncan", "Tony Parker", "Not Exists"};
+  std::vector<std::pair<TagID, std::vector<std::string>>> tags;
+  tags.emplace_back(player, std::vector<std::string>{"name"});
+  {
+    LOG(INFO) << "NotProfiled";
+    auto req = buildVertexRequest(totalParts, vertices, tags);
+    auto* processor = GetPropProcessor::instance(env, nullptr, nullptr);
+    auto fut = processor->getFuture();
+    processor->process(req);
+    auto resp = std::move(fut).get();
+    ASSERT_EQ(0, (*resp.result_ref()).failed_parts.size());
+    EXPECT_FALSE(resp.result_ref()->profile_counters_ref().has_value());
+  }
+  {
+    LOG(INFO) << "Profiled";
+    auto req = buildVertexRequest(totalParts, vertices, tags);
+    cpp2::RequestCommon common;
+    common.profile_detail_ref() = true;
+    req.common_ref() = std::move(common);
+    auto* processor = GetPropProcessor::instance(env, nullptr, nullptr);
+    auto fut = processor->getFuture();
+    processor->process(req);
+    auto resp = std::move(fut).get();
+    ASSERT_EQ(0, (*resp.result_ref()).failed_parts.size());
+    // The vertex not exists is not returned
+    ASSERT_EQ(2, resp.props_ref()->rowSize());
+
+    ASSERT_TRUE(resp.result_ref()->latency_detail_us_ref().has_value());
+    EXPECT_EQ(1, resp.result_ref()->latency_detail_us_ref()->count("GetTagPropNode"));
+    ASSERT_TRUE(resp.result_ref()->profile_counters_ref().has_value());
+    const auto& counters = *resp.result_ref()->profile_counters_ref();
+    EXPECT_EQ(3, counters.at("GetTagPropNode_inputs"));
+    EXPECT_EQ(2, counters.at("GetTagPropNode_rows"));
+    // The counters of rocksdb are there, though the data may be all in the memtable
+    EXPECT_EQ(1, counters.count("block_read_count"));
+    EXPECT_EQ(1, counters.count("block_cache_hit_count"));
+    EXPECT_GT(counters.at("read_bytes"), 0);
+  }
+}
+
 TEST(GetPropTest, ConcurrencyTest) {
   FLAGS_query_concurrently = true;
   fs::TempDir rootPath("/tmp/GetPropTest.XXXXXX");
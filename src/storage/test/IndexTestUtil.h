@@ -125,7 +125,8 @@ class MockKVStore : public ::nebula::kvstore::KVStore {
                                 const std::string& start,
                                 const std::string& end,
                                 std::unique_ptr<KVIterator>* iter,
-                                bool) override {
+                                bool,
+                                const void*) override {
     CHECK_EQ(spaceId, spaceId_);
     std::unique_ptr<MockKVIterator> mockIter;
     mockIter = std::make_unique<MockKVIterator>(kv_, kv_.lower_bound(start));
@@ -167,8 +168,10 @@ class MockKVStore : public ::nebula::kvstore::KVStore {
                                           const std::string& start,
                                           const std::string& prefix,
                                           std::unique_ptr<KVIterator>* iter,
-                                          bool canReadFromFollower = false) override {
+                                          bool canReadFromFollower = false,
+                                          const void* snapshot = nullptr) override {
     UNUSED(canReadFromFollower);
+    UNUSED(snapshot);
     UNUSED(spaceId);
     UNUSED(partId);
     CHECK_EQ(spaceId, spaceId_);
@@ -0,0 +1,110 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/futures/Future.h>
+#include <folly/init/Init.h>
+#include <thrift/lib/cpp2/protocol/Serializer.h>
+
+#include "common/base/Base.h"
+#include "common/datatypes/CommonCpp2Ops.h"
+#include "interface/gen-cpp2/storage_types.h"
+
+// Per call cost of a GetNeighbors hop between graphd and storaged, without the processing:
+// the distributed one encodes and decodes both the request and the response, the old standalone
+// one copies the request and hops to the storage workers through a promise, and the new one calls
+// the handler in place, see GraphStorageLocalServer.
+
+DEFINE_int32(request_vids, 100, "Number of vids in a request");
+DEFINE_int32(response_rows, 100, "Number of rows in a response");
+
+namespace nebula {
+namespace storage {
+
+using Serializer = apache::thrift::CompactSerializer;
+
+cpp2::GetNeighborsRequest request;
+cpp2::GetNeighborsResponse response;
+std::unique_ptr<folly::CPUThreadPoolExecutor> workers;
+
+void prepare() {
+  request.space_id_ref() = 1;
+  request.column_names_ref() = {"_vid"};
+  for (int32_t i = 0; i < FLAGS_request_vids; ++i) {
+    (*request.parts_ref())[i % 10 + 1].emplace_back(folly::to<std::string>(i));
+  }
+
+  DataSet ds({"_vid", "_stats", "_tag:player:name:age", "_edge:+serve:_dst:start_year"});
+  for (int32_t i = 0; i < FLAGS_response_rows; ++i) {
+    auto vid = folly::to<std::string>(i);
+    List tag({Value("player" + vid), Value(i)});
+    List edges({Value(List({Value("team" + vid), Value(1997)}))});
+    ds.emplace_back(Row({vid, Value::kEmpty, tag, edges}));
+  }
+  response.vertices_ref() = std::move(ds);
+  response.result_ref().latency_in_us_ref() = 100;
+
+  workers = std::make_unique<folly::CPUThreadPoolExecutor>(1);
+}
+
+// The handler, which returns a ready response
+folly::Future<cpp2::GetNeighborsResponse> handle(const cpp2::GetNeighborsRequest& req) {
+  folly::doNotOptimizeAway(req);
+  return response;
+}
+
+void distributedHop(size_t iters) {
+  for (size_t i = 0; i < iters; ++i) {
+    auto reqBuf = Serializer::serialize<std::string>(request);
+    auto req = Serializer::deserialize<cpp2::GetNeighborsRequest>(reqBuf);
+    auto resp = handle(req).get();
+    auto respBuf = Serializer::serialize<std::string>(resp);
+    auto result = Serializer::deserialize<cpp2::GetNeighborsResponse>(respBuf);
+    folly::doNotOptimizeAway(result);
+  }
+}
+
+void standalonePromiseHop(size_t iters) {
+  for (size_t i = 0; i < iters; ++i) {
+    auto promise = std::make_shared<folly::Promise<cpp2::GetNeighborsResponse>>();
+    auto f = promise->getFuture();
+    workers->add([promise, req = request] {
+      handle(req)
+          .thenValue([promise](auto&& resp) { promise->setValue(std::move(resp)); })
+          .thenError([promise](auto&& ex) { promise->setException(std::move(ex)); });
+    });
+    auto result = std::move(f).get();
+    folly::doNotOptimizeAway(result);
+  }
+}
+
+void standaloneInlineHop(size_t iters) {
+  for (size_t i = 0; i < iters; ++i) {
+    auto result = folly::makeFutureWith([] { return handle(request); }).get();
+    folly::doNotOptimizeAway(result);
+  }
+}
+
+BENCHMARK(Distributed, iters) {
+  distributedHop(iters);
+}
+BENCHMARK_RELATIVE(StandalonePromise, iters) {
+  standalonePromiseHop(iters);
+}
+BENCHMARK_RELATIVE(StandaloneInline, iters) {
+  standaloneInlineHop(iters);
+}
+
+}  // namespace storage
+}  // namespace nebula
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv, true);
+  nebula::storage::prepare();
+  folly::runBenchmarks();
+  nebula::storage::workers.reset();
+  return 0;
+}
@@ -0,0 +1,192 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+#include <folly/synchronization/Baton.h>
+#include <gtest/gtest.h>
+
+#include "common/base/Base.h"
+#include "common/fs/TempDir.h"
+#include "storage/GraphStorageServiceHandler.h"
+#include "storage/ReadSnapshotManager.h"
+#include "storage/StorageFlags.h"
+#include "storage/query/GetPropProcessor.h"
+#include "storage/test/QueryTestUtils.h"
+
+namespace nebula {
+namespace storage {
+
+static void removeKey(StorageEnv* env, PartitionID partId, const std::string& key) {
+  folly::Baton<true, std::atomic> baton;
+  env->kvstore_->asyncRemove(1, partId, key, [&](nebula::cpp2::ErrorCode code) {
+    EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, code);
+    baton.post();
+  });
+  baton.wait();
+}
+
+static cpp2::GetPropRequest buildRequest(int32_t totalParts,
+                                         const VertexID& vId,
+                                         ExecutionPlanID planId) {
+  cpp2::GetPropRequest req;
+  req.space_id_ref() = 1;
+  PartitionID partId = (std::hash<std::string>()(vId) % totalParts) + 1;
+  nebula::Row row;
+  row.values.emplace_back(vId);
+  (*req.parts_ref())[partId].emplace_back(std::move(row));
+  cpp2::VertexProp tagProp;
+  tagProp.tag_ref() = 1;
+  (*tagProp.props_ref()).emplace_back("name");
+  req.vertex_props_ref() = {std::move(tagProp)};
+  cpp2::RequestCommon common;
+  common.session_id_ref() = 1;
+  common.plan_id_ref() = planId;
+  common.snapshot_read_ref() = true;
+  req.common_ref() = std::move(common);
+  return req;
+}
+
+static size_t getRows(StorageEnv* env, cpp2::GetPropRequest req) {
+  auto* processor = GetPropProcessor::instance(env, nullptr, nullptr);
+  auto fut = processor->getFuture();
+  processor->process(req);
+  auto resp = std::move(fut).get();
+  EXPECT_EQ(0, (*resp.result_ref()).failed_parts.size());
+  return resp.props_ref()->rowSize();
+}
+
+TEST(ReadSnapshotTest, ManagerTest) {
+  fs::TempDir rootPath("/tmp/ReadSnapshotTest.XXXXXX");
+  mock::MockCluster cluster;
+  cluster.initStorageKV(rootPath.path());
+  auto* env = cluster.storageEnv_.get();
+  auto vIdLen = env->schemaMan_->getSpaceVidLen(1).value();
+  auto key = NebulaKeyUtils::tagKey(vIdLen, 1, "Tim Duncan", 1);
+  {
+    folly::Baton<true, std::atomic> baton;
+    env->kvstore_->asyncMultiPut(1, 1, {{key, "v1"}}, [&](nebula::cpp2::ErrorCode code) {
+      EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, code);
+      baton.post();
+    });
+    baton.wait();
+  }
+
+  ReadSnapshotManager manager(env->kvstore_);
+  auto snapshot = manager.get(1, 1, 1, 1);
+  ASSERT_NE(nullptr, snapshot);
+  // The parts on the same engine share the snapshot of the plan
+  EXPECT_EQ(snapshot, manager.get(1, 1, 1, 2));
+  EXPECT_EQ(1, manager.size());
+  EXPECT_EQ(nullptr, manager.get(1, 1, 1, 10000));
+
+  removeKey(env, 1, key);
+  std::string value;
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED,
+            env->kvstore_->get(1, 1, key, &value, false, snapshot->get()));
+  EXPECT_EQ("v1", value);
+  EXPECT_EQ(nebula::cpp2::ErrorCode::E_KEY_NOT_FOUND, env->kvstore_->get(1, 1, key, &value));
+
+  // Another plan reads the latest data
+  auto another = manager.get(1, 2, 1, 1);
+  ASSERT_NE(nullptr, another);
+  EXPECT_EQ(nebula::cpp2::ErrorCode::E_KEY_NOT_FOUND,
+            env->kvstore_->get(1, 1, key, &value, false, another->get()));
+  EXPECT_EQ(2, manager.size());
+
+  {
+    FLAGS_max_read_snapshots = 2;
+    EXPECT_EQ(nullptr, manager.get(1, 3, 1, 1));
+    FLAGS_max_read_snapshots = 1024;
+  }
+  {
+    FLAGS_read_snapshot_idle_secs = -1;
+    EXPECT_EQ(2, manager.cleanExpired());
+    FLAGS_read_snapshot_idle_secs = 30;
+    EXPECT_EQ(0, manager.size());
+    // The snapshot is still readable by the one holding it
+    EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED,
+              env->kvstore_->get(1, 1, key, &value, false, snapshot->get()));
+  }
+  {
+    auto ended = manager.get(1, 4, 1, 1);
+    auto running = manager.get(1, 5, 1, 1);
+    ASSERT_NE(nullptr, ended);
+    ASSERT_NE(nullptr, running);
+    // The snapshots of a query are released once it ends
+    EXPECT_EQ(1, manager.release(1, 4));
+    EXPECT_EQ(0, manager.release(1, 4));
+    EXPECT_EQ(1, manager.size());
+    // The ones of a removed space are dropped, but still readable by the requests holding them
+    manager.releaseSpace(1);
+    EXPECT_EQ(0, manager.size());
+    ASSERT_NE(nullptr, running->get());
+    EXPECT_EQ(nebula::cpp2::ErrorCode::E_KEY_NOT_FOUND,
+              env->kvstore_->get(1, 1, key, &value, false, running->get()));
+  }
+}
+
+TEST(ReadSnapshotTest, GetPropTest) {
+  fs::TempDir rootPath("/tmp/ReadSnapshotTest.XXXXXX");
+  mock::MockCluster cluster;
+  cluster.initStorageKV(rootPath.path());
+  auto* env = cluster.storageEnv_.get();
+  auto totalParts = cluster.getTotalParts();
+  ASSERT_EQ(true, QueryTestUtils::mockVertexData(env, totalParts));
+  ReadSnapshotManager manager(env->kvstore_);
+  env->readSnapshots_ = &manager;
+
+  VertexID vId = "Tim Duncan";
+  EXPECT_EQ(1, getRows(env, buildRequest(totalParts, vId, 1)));
+
+  auto vIdLen = env->schemaMan_->getSpaceVidLen(1).value();
+  PartitionID partId = (std::hash<std::string>()(vId) % totalParts) + 1;
+  removeKey(env, partId, NebulaKeyUtils::tagKey(vIdLen, partId, vId, 1));
+
+  // The plan still sees the vertex in its snapshot, while a new one doesn't
+  EXPECT_EQ(1, getRows(env, buildRequest(totalParts, vId, 1)));
+  EXPECT_EQ(0, getRows(env, buildRequest(totalParts, vId, 2)));
+  env->readSnapshots_ = nullptr;
+}
+
+TEST(ReadSnapshotTest, WriteTest) {
+  fs::TempDir rootPath("/tmp/ReadSnapshotTest.XXXXXX");
+  mock::MockCluster cluster;
+  cluster.initStorageKV(rootPath.path());
+  auto* env = cluster.storageEnv_.get();
+  auto totalParts = cluster.getTotalParts();
+  ASSERT_EQ(true, QueryTestUtils::mockVertexData(env, totalParts));
+  ReadSnapshotManager manager(env->kvstore_);
+  env->readSnapshots_ = &manager;
+  GraphStorageServiceHandler handler(env);
+
+  VertexID vId = "Tim Duncan";
+  EXPECT_EQ(1, getRows(env, buildRequest(totalParts, vId, 1)));
+  EXPECT_EQ(1, manager.size());
+
+  // The plan deletes the vertex, and its snapshot is dropped once the write is done
+  cpp2::DeleteVerticesRequest req;
+  req.space_id_ref() = 1;
+  PartitionID partId = (std::hash<std::string>()(vId) % totalParts) + 1;
+  (*req.parts_ref())[partId].emplace_back(vId);
+  cpp2::RequestCommon common;
+  common.session_id_ref() = 1;
+  common.plan_id_ref() = 1;
+  req.common_ref() = std::move(common);
+  auto resp = handler.future_deleteVertices(req).get();
+  EXPECT_EQ(0, (*resp.result_ref()).failed_parts.size());
+  EXPECT_EQ(0, manager.size());
+
+  // So the reads of the plan after it see the write
+  EXPECT_EQ(0, getRows(env, buildRequest(totalParts, vId, 1)));
+  env->readSnapshots_ = nullptr;
+}
+
+}  // namespace storage
+}  // namespace nebula
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  folly::init(&argc, &argv, true);
+  google::SetStderrLogging(google::INFO);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,134 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "storage/transaction/ChainAddEdgesBatcher.h"
+
+#include <thrift/lib/cpp/util/EnumUtils.h>
+
+#include "clients/storage/InternalStorageClient.h"
+#include "storage/StorageFlags.h"
+#include "storage/stats/StorageStats.h"
+
+namespace nebula {
+namespace storage {
+
+folly::Future<Code> ChainAddEdgesBatcher::add(const cpp2::AddEdgesRequest& req,
+                                              PartitionID localPartId,
+                                              TermID termId,
+                                              std::optional<int64_t> optVersion) {
+  CHECK_EQ(req.get_parts().size(), 1);
+  if (FLAGS_toss_remote_batch_size <= 1 || optVersion.has_value()) {
+    folly::Promise<Code> p;
+    auto f = p.getFuture();
+    auto directReq = req;
+    env_->interClient_->chainAddEdges(directReq, termId, optVersion, std::move(p));
+    return f;
+  }
+
+  auto key = batchKey(req, localPartId, termId);
+  auto remotePartId = req.get_parts().begin()->first;
+  auto& edges = req.get_parts().begin()->second;
+
+  std::shared_ptr<Batch> full;
+  std::shared_ptr<Batch> created;
+  folly::Future<Code> fut = folly::Future<Code>::makeEmpty();
+  {
+    std::lock_guard<std::mutex> lk(lock_);
+    auto& batch = pending_[key];
+    if (batch == nullptr) {
+      batch = std::make_shared<Batch>();
+      batch->req.space_id_ref() = req.get_space_id();
+      batch->req.prop_names_ref() = req.get_prop_names();
+      batch->req.if_not_exists_ref() = req.get_if_not_exists();
+      batch->termId = termId;
+      created = batch;
+    }
+    auto& batchEdges = (*batch->req.parts_ref())[remotePartId];
+    batchEdges.insert(batchEdges.end(), edges.begin(), edges.end());
+    batch->numOfEdges += edges.size();
+    batch->promises.emplace_back();
+    fut = batch->promises.back().getFuture();
+    if (batch->numOfEdges >= static_cast<size_t>(FLAGS_toss_remote_batch_size)) {
+      full = std::move(batch);
+      pending_.erase(key);
+    }
+  }
+
+  if (full != nullptr) {
+    flush(std::move(full));
+  } else if (created != nullptr) {
+    scheduleFlush(key, std::move(created));
+  }
+  return fut;
+}
+
+std::string ChainAddEdgesBatcher::batchKey(const cpp2::AddEdgesRequest& req,
+                                           PartitionID localPartId,
+                                           TermID termId) {
+  // requests can only be merged if they will be written the same way on remote side
+  std::string key = folly::sformat("{}:{}:{}:{}:{}",
+                                   req.get_space_id(),
+                                   req.get_parts().begin()->first,
+                                   localPartId,
+                                   termId,
+                                   req.get_if_not_exists());
+  for (auto& name : req.get_prop_names()) {
+    key.append(":").append(name);
+  }
+  return key;
+}
+
+void ChainAddEdgesBatcher::scheduleFlush(const std::string& key, std::shared_ptr<Batch> batch) {
+  auto fn = [weak = weak_from_this(), key, batch = std::move(batch)]() mutable {
+    auto self = weak.lock();
+    if (self == nullptr) {
+      // shutting down, the promises of a batch not flushed yet are broken once it's dropped,
+      // which the chains take as E_RPC_FAILURE
+      return;
+    }
+    if (self->detach(key, batch)) {
+      self->flush(std::move(batch));
+    }
+  };
+  if (FLAGS_toss_remote_batch_window_ms <= 0) {
+    evb_->runInEventBaseThread(std::move(fn));
+  } else {
+    auto* evb = evb_;
+    evb_->runInEventBaseThread([evb, fn = std::move(fn)]() mutable {
+      evb->runAfterDelay(std::move(fn), FLAGS_toss_remote_batch_window_ms);
+    });
+  }
+}
+
+bool ChainAddEdgesBatcher::detach(const std::string& key, const std::shared_ptr<Batch>& batch) {
+  std::lock_guard<std::mutex> lk(lock_);
+  auto it = pending_.find(key);
+  if (it == pending_.end() || it->second != batch) {
+    return false;
+  }
+  pending_.erase(it);
+  return true;
+}
+
+void ChainAddEdgesBatcher::flush(std::shared_ptr<Batch> batch) {
+  VLOG(2) << "flush toss remote batch, chains = " << batch->promises.size()
+          << ", edges = " << batch->numOfEdges;
+  stats::StatsManager::addValue(kNumTossRemoteBatches);
+  stats::StatsManager::addValue(kNumTossRemoteChains, batch->promises.size());
+
+  folly::Promise<Code> p;
+  auto f = p.getFuture();
+  env_->interClient_->chainAddEdges(batch->req, batch->termId, std::nullopt, std::move(p));
+  std::move(f).thenTry([batch](auto&& t) {
+    auto code = t.hasValue() ? t.value() : Code::E_RPC_FAILURE;
+    VLOG(2) << "toss remote batch: " << apache::thrift::util::enumNameSafe(code);
+    for (auto& pro : batch->promises) {
+      pro.setValue(code);
+    }
+  });
+}
+
+}  // namespace storage
+}  // namespace nebula
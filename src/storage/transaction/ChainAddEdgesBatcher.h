@@ -0,0 +1,83 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef STORAGE_TRANSACTION_CHAINADDEDGESBATCHER_H
+#define STORAGE_TRANSACTION_CHAINADDEDGESBATCHER_H
+
+#include <folly/futures/Future.h>
+
+#include "interface/gen-cpp2/storage_types.h"
+#include "storage/CommonUtils.h"
+#include "storage/transaction/ChainBaseProcessor.h"
+
+namespace nebula {
+namespace storage {
+
+/**
+ * @brief Coalesce the remote (reversed edge) writes of concurrent add-edge chains.
+ *
+ *        Every chain used to send its own chainAddEdges rpc after its prime was committed.
+ *        Chains which come from the same local part (same term) and target the same
+ *        remote part can share one rpc: the remote side writes all edges of a part in a
+ *        single raft log, so the batch succeeds or fails as a whole, and every chain
+ *        receives the same error code as if it had sent the rpc itself.
+ *
+ *        A batch is flushed when it reaches toss_remote_batch_size edges, or after
+ *        toss_remote_batch_window_ms, whichever comes first. A window of 0 means the batch
+ *        is flushed in the next loop of the event base, which only groups chains that
+ *        are already in flight.
+ *
+ *        It's held by a shared_ptr, and the delayed flushes only keep a weak one, so a flush
+ *        fired after the batcher is destroyed drops the batch instead of touching the batcher.
+ */
+class ChainAddEdgesBatcher : public std::enable_shared_from_this<ChainAddEdgesBatcher> {
+ public:
+  ChainAddEdgesBatcher(StorageEnv* env, folly::EventBase* evb) : env_(env), evb_(evb) {}
+
+  /**
+   * @brief add the reversed request of one chain, the returned future is fulfilled
+   *        by the result of the rpc which carries it.
+   *
+   * @param req reversed request, contains exactly one (remote) part
+   * @param localPartId part of the out-edge, used to check term on remote side
+   * @param termId term of local part when the prime was written
+   * @param optVersion edge version, requests with a version are never batched
+   */
+  folly::Future<Code> add(const cpp2::AddEdgesRequest& req,
+                          PartitionID localPartId,
+                          TermID termId,
+                          std::optional<int64_t> optVersion);
+
+ protected:
+  struct Batch {
+    cpp2::AddEdgesRequest req;
+    TermID termId;
+    size_t numOfEdges{0};
+    std::vector<folly::Promise<Code>> promises;
+  };
+
+  std::string batchKey(const cpp2::AddEdgesRequest& req, PartitionID localPartId, TermID termId);
+
+  void scheduleFlush(const std::string& key, std::shared_ptr<Batch> batch);
+
+  void flush(std::shared_ptr<Batch> batch);
+
+  /**
+   * @brief take the batch out of pending map, if it is still there.
+   * @return false if this batch has already been flushed (e.g. it was full)
+   */
+  bool detach(const std::string& key, const std::shared_ptr<Batch>& batch);
+
+ protected:
+  StorageEnv* env_{nullptr};
+  folly::EventBase* evb_{nullptr};
+
+  std::mutex lock_;
+  std::unordered_map<std::string, std::shared_ptr<Batch>> pending_;
+};
+
+}  // namespace storage
+}  // namespace nebula
+#endif
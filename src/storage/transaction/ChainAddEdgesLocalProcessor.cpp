@@ -149,10 +149,8 @@ void ChainAddEdgesLocalProcessor::doRpc(folly::Promise<Code>&& promise,
     promise.setValue(Code::E_LEADER_CHANGED);
     return;
   }
-  auto* iClient = env_->interClient_;
-  folly::Promise<Code> p;
-  auto f = p.getFuture();
-  iClient->chainAddEdges(req, term_, edgeVer_, std::move(p));
+  // chains to the same remote part are merged into one rpc by the batcher
+  auto f = env_->txnMan_->addEdgesBatcher()->add(req, localPartId_, term_, edgeVer_);
 
   std::move(f).thenTry([=, p = std::move(promise)](auto&& t) mutable {
     rcRemote_ = t.hasValue() ? t.value() : Code::E_RPC_FAILURE;
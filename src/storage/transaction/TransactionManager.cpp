@@ -24,6 +24,7 @@ TransactionManager::TransactionManager(StorageEnv* env) : env_(env) {
   LOG(INFO) << "TransactionManager ctor()";
   worker_ = std::make_shared<folly::IOThreadPoolExecutor>(FLAGS_toss_worker_num);
   controller_ = std::make_shared<folly::IOThreadPoolExecutor>(1);
+  addEdgesBatcher_ = std::make_shared<ChainAddEdgesBatcher>(env_, worker_->getEventBase());
 }
 
 bool TransactionManager::start() {
@@ -19,6 +19,7 @@
 #include "kvstore/KVStore.h"
 #include "kvstore/Part.h"
 #include "storage/CommonUtils.h"
+#include "storage/transaction/ChainAddEdgesBatcher.h"
 #include "storage/transaction/ConsistUtil.h"
 
 namespace nebula {
@@ -109,6 +110,15 @@ class TransactionManager {
    */
   folly::EventBase* getEventBase();
 
+  /**
+   * @brief Get the batcher which merges remote writes of concurrent add-edge chains
+   *
+   * @return ChainAddEdgesBatcher*
+   */
+  ChainAddEdgesBatcher* addEdgesBatcher() {
+    return addEdgesBatcher_.get();
+  }
+
   /**
    * @brief stat thread, used for debug
    */
@@ -139,6 +149,8 @@ class TransactionManager {
   std::shared_ptr<folly::IOThreadPoolExecutor> worker_;
   // only used for waiting some job stop.
   std::shared_ptr<folly::IOThreadPoolExecutor> controller_;
+  // merge chainAddEdges rpc of chains which target the same remote part
+  std::shared_ptr<ChainAddEdgesBatcher> addEdgesBatcher_;
 
   /**
    * @brief used for a remote processor to record the term of its "local Processor"
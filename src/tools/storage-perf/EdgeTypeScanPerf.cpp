@@ -0,0 +1,116 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+#include <rocksdb/iostats_context.h>
+#include <rocksdb/perf_context.h>
+
+#include "common/base/Base.h"
+#include "common/fs/TempDir.h"
+#include "common/utils/NebulaKeyUtils.h"
+#include "kvstore/RocksEngine.h"
+#include "kvstore/RocksEngineConfig.h"
+
+DEFINE_int32(edge_scan_vertex_num, 1000, "vertex count");
+DEFINE_int32(edge_scan_edge_types, 20, "edge types of each vertex");
+DEFINE_int32(edge_scan_edges_per_type, 20, "edges of each edge type of a vertex");
+DEFINE_int32(edge_scan_value_size, 64, "size of edge value");
+
+/**
+ * Scan cost of one edge type of a vertex, which is what SingleEdgeNode does for each edge type in
+ * GetNeighbors. When a vertex has many edge types, prefix bloom filter on (part, vid) can't skip
+ * the data blocks of other edge types, prefix on (part, srcId, edgeType) could.
+ *
+ * Usage: edge_scan_perf --rocksdb_block_cache=0 --edge_scan_edge_types=50
+ *
+ * The block read count and bloom filter hit/miss of each case is logged after the scan.
+ */
+
+namespace nebula {
+namespace kvstore {
+
+static constexpr int32_t kVIdLen = 16;
+static constexpr PartitionID kPartId = 1;
+
+std::unique_ptr<RocksEngine> prepare(const std::string& path, const std::string& extractor) {
+  FLAGS_enable_rocksdb_prefix_filtering = true;
+  FLAGS_rocksdb_prefix_extractor = extractor;
+  // keep every flushed file in L0, each of them holds one edge type of all vertices, which is the
+  // layout when edges of different types are inserted at different time
+  FLAGS_rocksdb_column_family_options = R"({
+        "level0_file_num_compaction_trigger":"1000",
+        "level0_slowdown_writes_trigger":"1000",
+        "level0_stop_writes_trigger":"1000",
+        "disable_auto_compactions":"true"
+    })";
+  auto engine = std::make_unique<RocksEngine>(1, kVIdLen, path);
+  std::string val(FLAGS_edge_scan_value_size, 'v');
+  for (EdgeType edgeType = 1; edgeType <= FLAGS_edge_scan_edge_types; edgeType++) {
+    std::vector<KV> data;
+    for (int32_t vId = 0; vId < FLAGS_edge_scan_vertex_num; vId++) {
+      auto src = folly::to<std::string>(vId);
+      for (int32_t dst = 0; dst < FLAGS_edge_scan_edges_per_type; dst++) {
+        data.emplace_back(NebulaKeyUtils::edgeKey(
+                              kVIdLen, kPartId, src, edgeType, 0, folly::to<std::string>(dst)),
+                          val);
+      }
+    }
+    CHECK_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->multiPut(std::move(data)));
+    CHECK_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->flush());
+  }
+  return engine;
+}
+
+void scanOneEdgeType(RocksEngine* engine, size_t iters, const std::string& name) {
+  rocksdb::SetPerfLevel(rocksdb::PerfLevel::kEnableCount);
+  rocksdb::get_perf_context()->Reset();
+  rocksdb::get_iostats_context()->Reset();
+  size_t rows = 0;
+  for (size_t i = 0; i < iters; i++) {
+    auto src = folly::to<std::string>(folly::Random::rand32(FLAGS_edge_scan_vertex_num));
+    auto edgeType = folly::Random::rand32(FLAGS_edge_scan_edge_types) + 1;
+    auto prefix = NebulaKeyUtils::edgePrefix(kVIdLen, kPartId, src, edgeType);
+    std::unique_ptr<KVIterator> iter;
+    CHECK_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->prefix(prefix, &iter));
+    while (iter->valid()) {
+      folly::doNotOptimizeAway(iter->val());
+      rows++;
+      iter->next();
+    }
+  }
+  auto* ctx = rocksdb::get_perf_context();
+  LOG(INFO) << name << ": scans " << iters << ", rows " << rows << ", block read "
+            << ctx->block_read_count << ", block read bytes " << ctx->block_read_byte
+            << ", bloom sst hit " << ctx->bloom_sst_hit_count << ", bloom sst miss "
+            << ctx->bloom_sst_miss_count;
+  rocksdb::SetPerfLevel(rocksdb::PerfLevel::kDisable);
+}
+
+void runScan(const std::string& extractor, size_t iters) {
+  folly::BenchmarkSuspender braces;
+  fs::TempDir rootPath("/tmp/EdgeTypeScanPerf.XXXXXX");
+  auto engine = prepare(rootPath.path(), extractor);
+  braces.dismiss();
+  scanOneEdgeType(engine.get(), iters, extractor);
+}
+
+BENCHMARK(ScanEdgeTypeWithVertexPrefix, n) {
+  runScan("vertex", n);
+}
+
+BENCHMARK_RELATIVE(ScanEdgeTypeWithEdgeTypePrefix, n) {
+  runScan("edge_type", n);
+}
+
+}  // namespace kvstore
+}  // namespace nebula
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv, true);
+  google::SetStderrLogging(google::INFO);
+  folly::runBenchmarks();
+  return 0;
+}
@@ -0,0 +1,135 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "webservice/CpuProfileHandler.h"
+
+#include <folly/executors/GlobalExecutor.h>
+#include <folly/io/async/EventBaseManager.h>
+#include <proxygen/httpserver/ResponseBuilder.h>
+#include <proxygen/lib/http/ProxygenErrorEnum.h>
+
+#include "webservice/CpuProfiler.h"
+
+namespace nebula {
+
+using proxygen::HTTPMessage;
+using proxygen::HTTPMethod;
+using proxygen::ProxygenError;
+using proxygen::ResponseBuilder;
+using proxygen::UpgradeProtocol;
+
+static constexpr int32_t kMaxProfileSeconds = 300;
+
+void CpuProfileHandler::onRequest(std::unique_ptr<HTTPMessage> headers) noexcept {
+  if (!headers->getMethod() || headers->getMethod().value() != HTTPMethod::GET) {
+    // Unsupported method
+    err_ = HttpCode::E_UNSUPPORTED_METHOD;
+    return;
+  }
+
+  auto getInt = [&headers, this](const std::string& name, int32_t min, int32_t max, int32_t* val) {
+    if (!headers->hasQueryParam(name)) {
+      return;
+    }
+    auto ret = folly::tryTo<int32_t>(headers->getQueryParam(name));
+    if (!ret.hasValue() || ret.value() < min || ret.value() > max) {
+      err_ = HttpCode::E_ILLEGAL_ARGUMENT;
+      errMsg_ = folly::sformat("{} should be an integer in [{}, {}]", name, min, max);
+      return;
+    }
+    *val = ret.value();
+  };
+  getInt("seconds", 1, kMaxProfileSeconds, &seconds_);
+  getInt("hz", 1, 1000, &hz_);
+  if (headers->hasQueryParam("history_minutes")) {
+    historyMinutes_ = FLAGS_ws_cpu_sampling_history_minutes;
+    getInt("history_minutes", 1, FLAGS_ws_cpu_sampling_history_minutes, &historyMinutes_);
+  }
+}
+
+void CpuProfileHandler::onBody(std::unique_ptr<folly::IOBuf>) noexcept {
+  // Do nothing, we only support GET
+}
+
+void CpuProfileHandler::onEOM() noexcept {
+  switch (err_) {
+    case HttpCode::E_UNSUPPORTED_METHOD:
+      sendError(HttpStatusCode::METHOD_NOT_ALLOWED, "");
+      return;
+    case HttpCode::E_ILLEGAL_ARGUMENT:
+      sendError(HttpStatusCode::BAD_REQUEST, errMsg_);
+      return;
+    default:
+      break;
+  }
+
+  auto now = CpuProfiler::nowInMs();
+  if (historyMinutes_ > 0) {
+    sendProfile(now - historyMinutes_ * 60 * 1000L, now);
+    return;
+  }
+
+  auto status = CpuProfiler::instance().beginSession(hz_);
+  if (!status.ok()) {
+    sendError(HttpStatusCode::FORBIDDEN, status.toString());
+    return;
+  }
+  // Respond in the event base of the request when it's done, without blocking it
+  auto* evb = folly::EventBaseManager::get()->getEventBase();
+  evb->runAfterDelay(
+      [this, alive = alive_, now]() {
+        CpuProfiler::instance().endSession();
+        if (*alive) {
+          sendProfile(now, CpuProfiler::nowInMs());
+        }
+      },
+      seconds_ * 1000);
+}
+
+void CpuProfileHandler::sendProfile(int64_t fromMs, int64_t toMs) {
+  // The symbolization takes a while, so it's done in a worker, and the response is sent back in
+  // the event base of the request
+  auto* evb = folly::EventBaseManager::get()->getEventBase();
+  folly::via(folly::getGlobalCPUExecutor())
+      .thenValue([fromMs, toMs](auto&&) {
+        return foldStacks(CpuProfiler::instance().stacks(fromMs, toMs));
+      })
+      .via(evb)
+      .thenValue([this, alive = alive_](std::string folded) {
+        if (!*alive) {
+          return;
+        }
+        ResponseBuilder(downstream_)
+            .status(WebServiceUtils::to(HttpStatusCode::OK),
+                    WebServiceUtils::toString(HttpStatusCode::OK))
+            .header("Content-Type", "text/plain")
+            .body(std::move(folded))
+            .sendWithEOM();
+      });
+}
+
+void CpuProfileHandler::sendError(HttpStatusCode code, const std::string& message) {
+  ResponseBuilder(downstream_)
+      .status(WebServiceUtils::to(code), WebServiceUtils::toString(code))
+      .body(message)
+      .sendWithEOM();
+}
+
+void CpuProfileHandler::onUpgrade(UpgradeProtocol) noexcept {
+  // Do nothing
+}
+
+void CpuProfileHandler::requestComplete() noexcept {
+  *alive_ = false;
+  delete this;
+}
+
+void CpuProfileHandler::onError(ProxygenError err) noexcept {
+  LOG(ERROR) << "Web service CpuProfileHandler got error: " << proxygen::getErrorString(err);
+  *alive_ = false;
+  delete this;
+}
+
+}  // namespace nebula
@@ -0,0 +1,56 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef WEBSERVICE_CPUPROFILEHANDLER_H_
+#define WEBSERVICE_CPUPROFILEHANDLER_H_
+
+#include <proxygen/httpserver/RequestHandler.h>
+
+#include "common/base/Base.h"
+#include "webservice/Common.h"
+
+namespace nebula {
+
+/**
+ * @brief Serve the cpu profile of the process in the folded format of the flame graph tools.
+ *
+ *   GET /profile/cpu?seconds=10&hz=99 samples the process for the seconds, up to 300, at the hz,
+ *   and responds when it's done.
+ *   GET /profile/cpu?history_minutes=5 responds the samples of the always-on sampling in the last
+ *   minutes right away.
+ */
+class CpuProfileHandler : public proxygen::RequestHandler {
+ public:
+  CpuProfileHandler() = default;
+
+  void onRequest(std::unique_ptr<proxygen::HTTPMessage> headers) noexcept override;
+
+  void onBody(std::unique_ptr<folly::IOBuf> body) noexcept override;
+
+  void onEOM() noexcept override;
+
+  void onUpgrade(proxygen::UpgradeProtocol proto) noexcept override;
+
+  void requestComplete() noexcept override;
+
+  void onError(proxygen::ProxygenError err) noexcept override;
+
+ private:
+  void sendProfile(int64_t fromMs, int64_t toMs);
+
+  void sendError(HttpStatusCode code, const std::string& message);
+
+ private:
+  HttpCode err_{HttpCode::SUCCEEDED};
+  std::string errMsg_;
+  int32_t seconds_{10};
+  int32_t hz_{99};
+  int32_t historyMinutes_{0};
+  // Cleared when the handler is deleted before the profile is done
+  std::shared_ptr<bool> alive_{std::make_shared<bool>(true)};
+};
+
+}  // namespace nebula
+#endif  // WEBSERVICE_CPUPROFILEHANDLER_H_
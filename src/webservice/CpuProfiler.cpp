@@ -0,0 +1,277 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "webservice/CpuProfiler.h"
+
+#define UNW_LOCAL_ONLY
+#include <dlfcn.h>
+#include <folly/Demangle.h>
+#include <folly/String.h>
+#include <libunwind.h>
+#include <sys/time.h>
+
+DEFINE_int32(ws_cpu_sampling_hz,
+             0,
+             "The rate of the always-on cpu sampling of the process, whose samples of the last "
+             "minutes are served by /profile/cpu?history_minutes=N, 0 to disable it");
+DEFINE_int32(ws_cpu_sampling_history_minutes,
+             10,
+             "The most minutes of the always-on samples served by /profile/cpu?history_minutes, "
+             "as long as they are still kept by ws_cpu_profile_max_samples");
+DEFINE_int32(ws_cpu_profile_max_samples,
+             65536,
+             "The number of samples kept by the cpu profiler, the oldest ones are overwritten");
+
+namespace nebula {
+
+namespace {
+
+std::string symbolize(uintptr_t frame) {
+  // The frames are return addresses, look up the call instruction before it
+  auto pc = reinterpret_cast<void*>(frame - 1);
+  Dl_info info;
+  if (dladdr(pc, &info) == 0) {
+    return folly::sformat("{:#x}", frame);
+  }
+  if (info.dli_sname != nullptr) {
+    return folly::demangle(info.dli_sname).toStdString();
+  }
+  std::string binary = info.dli_fname == nullptr ? "" : info.dli_fname;
+  auto pos = binary.rfind('/');
+  if (pos != std::string::npos) {
+    binary = binary.substr(pos + 1);
+  }
+  auto base = reinterpret_cast<uintptr_t>(info.dli_fbase);
+  return folly::sformat("{}+{:#x}", binary, frame - 1 - base);
+}
+
+}  // namespace
+
+std::string foldStacks(const StackCounts& stacks, const StackCounts* base) {
+  std::unordered_map<uintptr_t, std::string> symbols;
+  auto fold = [&symbols](const std::vector<uintptr_t>& frames) {
+    std::vector<std::string> names;
+    names.reserve(frames.size());
+    for (auto frame : frames) {
+      auto iter = symbols.find(frame);
+      if (iter == symbols.end()) {
+        // The separators of the folded format are not allowed in a frame
+        auto name = symbolize(frame);
+        std::replace(name.begin(), name.end(), ';', ':');
+        std::replace(name.begin(), name.end(), ' ', '_');
+        iter = symbols.emplace(frame, std::move(name)).first;
+      }
+      names.emplace_back(iter->second);
+    }
+    return folly::join(";", names);
+  };
+
+  // stack, count in base and count, sorted by the change
+  std::vector<std::tuple<std::string, int64_t, int64_t>> lines;
+  if (base == nullptr) {
+    for (const auto& [frames, count] : stacks) {
+      lines.emplace_back(fold(frames), 0, count);
+    }
+  } else {
+    auto changes = *base;
+    for (auto& [frames, count] : changes) {
+      count = -count;
+    }
+    for (const auto& [frames, count] : stacks) {
+      changes[frames] += count;
+    }
+    for (const auto& [frames, change] : changes) {
+      if (change == 0) {
+        continue;
+      }
+      auto iter = stacks.find(frames);
+      auto count = iter == stacks.end() ? 0 : iter->second;
+      lines.emplace_back(fold(frames), count - change, count);
+    }
+  }
+  std::sort(lines.begin(), lines.end(), [](const auto& a, const auto& b) {
+    return std::get<2>(a) - std::get<1>(a) > std::get<2>(b) - std::get<1>(b);
+  });
+  std::string folded;
+  for (const auto& [stack, baseCount, count] : lines) {
+    if (base == nullptr) {
+      folded.append(folly::sformat("{} {}\n", stack, count));
+    } else {
+      folded.append(folly::sformat("{} {} {}\n", stack, baseCount, count));
+    }
+  }
+  return folded;
+}
+
+// static
+CpuProfiler& CpuProfiler::instance() {
+  static CpuProfiler profiler;
+  return profiler;
+}
+
+// static
+int64_t CpuProfiler::nowInMs() {
+  // clock_gettime is async signal safe
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+// static
+void CpuProfiler::onSignal(int, siginfo_t*, void*) {
+  auto savedErrno = errno;
+  instance().record();
+  errno = savedErrno;
+}
+
+void CpuProfiler::record() {
+  if (capacity_ == 0) {
+    return;
+  }
+  auto seq = next_.fetch_add(1, std::memory_order_relaxed);
+  auto& sample = samples_[seq % capacity_];
+  sample.seq.store(0, std::memory_order_relaxed);
+  std::atomic_signal_fence(std::memory_order_seq_cst);
+  sample.timeInMs = nowInMs();
+  // Not backtrace() of glibc, which may allocate, the local unwinding of libunwind is async signal
+  // safe. The walk starts from record(), the frames up to the interrupted one are skipped later.
+  unw_context_t context;
+  unw_cursor_t cursor;
+  int32_t depth = 0;
+  if (unw_getcontext(&context) == 0 && unw_init_local(&cursor, &context) == 0) {
+    do {
+      unw_word_t ip;
+      if (unw_get_reg(&cursor, UNW_REG_IP, &ip) < 0 || ip == 0) {
+        break;
+      }
+      sample.frames[depth++] = reinterpret_cast<void*>(ip);
+    } while (depth < kMaxFrames && unw_step(&cursor) > 0);
+  }
+  sample.depth = depth;
+  sample.seq.store(seq + 1, std::memory_order_release);
+}
+
+Status CpuProfiler::init() {
+  if (inited_) {
+    return Status::OK();
+  }
+  if (FLAGS_ws_cpu_profile_max_samples <= 0) {
+    return Status::Error("The cpu profiler is disabled by ws_cpu_profile_max_samples");
+  }
+  capacity_ = static_cast<size_t>(FLAGS_ws_cpu_profile_max_samples);
+  samples_ = std::make_unique<Sample[]>(capacity_);
+  // The first unwinding initializes libunwind, which is not safe in a signal handler
+  unw_context_t context;
+  unw_cursor_t cursor;
+  if (unw_getcontext(&context) == 0 && unw_init_local(&cursor, &context) == 0) {
+    while (unw_step(&cursor) > 0) {
+    }
+  }
+
+  struct sigaction action;
+  memset(&action, 0, sizeof(action));
+  action.sa_sigaction = &CpuProfiler::onSignal;
+  action.sa_flags = SA_RESTART | SA_SIGINFO;
+  sigemptyset(&action.sa_mask);
+  if (sigaction(SIGPROF, &action, nullptr) != 0) {
+    capacity_ = 0;
+    samples_.reset();
+    return Status::Error("Failed to install the handler of SIGPROF: %s", strerror(errno));
+  }
+  inited_ = true;
+  return Status::OK();
+}
+
+void CpuProfiler::resetTimer() {
+  auto hz = std::max(hz_, sessionHz_);
+  struct itimerval timer;
+  memset(&timer, 0, sizeof(timer));
+  if (hz > 0) {
+    timer.it_interval.tv_sec = 0;
+    timer.it_interval.tv_usec = std::max(1000000 / hz, 1);
+    timer.it_value = timer.it_interval;
+  }
+  PCHECK(setitimer(ITIMER_PROF, &timer, nullptr) == 0);
+}
+
+Status CpuProfiler::start(int32_t hz) {
+  if (hz <= 0 || hz > 1000) {
+    return Status::Error("Invalid sampling rate %d, it should be in (0, 1000]", hz);
+  }
+  std::lock_guard<std::mutex> guard(lock_);
+  NG_RETURN_IF_ERROR(init());
+  hz_ = hz;
+  resetTimer();
+  LOG(INFO) << "Start the cpu sampling at " << hz << "hz";
+  return Status::OK();
+}
+
+void CpuProfiler::stop() {
+  std::lock_guard<std::mutex> guard(lock_);
+  if (!inited_) {
+    return;
+  }
+  hz_ = 0;
+  resetTimer();
+}
+
+Status CpuProfiler::beginSession(int32_t hz) {
+  if (hz <= 0 || hz > 1000) {
+    return Status::Error("Invalid sampling rate %d, it should be in (0, 1000]", hz);
+  }
+  std::lock_guard<std::mutex> guard(lock_);
+  if (sessionHz_ > 0) {
+    return Status::Error("Another cpu profile is running");
+  }
+  NG_RETURN_IF_ERROR(init());
+  sessionHz_ = hz;
+  resetTimer();
+  return Status::OK();
+}
+
+void CpuProfiler::endSession() {
+  std::lock_guard<std::mutex> guard(lock_);
+  if (!inited_) {
+    return;
+  }
+  sessionHz_ = 0;
+  resetTimer();
+}
+
+StackCounts CpuProfiler::stacks(int64_t fromMs, int64_t toMs) const {
+  StackCounts stacks;
+  {
+    std::lock_guard<std::mutex> guard(lock_);
+    if (!inited_) {
+      return stacks;
+    }
+  }
+  auto next = next_.load(std::memory_order_acquire);
+  auto begin = next > capacity_ ? next - capacity_ : 0;
+  for (auto seq = begin; seq < next; ++seq) {
+    const auto& sample = samples_[seq % capacity_];
+    if (sample.seq.load(std::memory_order_acquire) != seq + 1) {
+      // Being written, or overwritten by a newer one
+      continue;
+    }
+    auto timeInMs = sample.timeInMs;
+    auto depth = std::min(sample.depth, kMaxFrames);
+    std::vector<uintptr_t> frames;
+    for (auto i = depth - 1; i >= kSkippedFrames; --i) {
+      frames.emplace_back(reinterpret_cast<uintptr_t>(sample.frames[i]));
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (sample.seq.load(std::memory_order_relaxed) != seq + 1) {
+      continue;
+    }
+    if (timeInMs < fromMs || timeInMs > toMs || frames.empty()) {
+      continue;
+    }
+    ++stacks[std::move(frames)];
+  }
+  return stacks;
+}
+
+}  // namespace nebula
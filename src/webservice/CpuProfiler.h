@@ -0,0 +1,110 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef WEBSERVICE_CPUPROFILER_H_
+#define WEBSERVICE_CPUPROFILER_H_
+
+#include <folly/CPortability.h>
+#include <signal.h>
+
+#include "common/base/Base.h"
+#include "common/base/Status.h"
+
+DECLARE_int32(ws_cpu_sampling_hz);
+DECLARE_int32(ws_cpu_sampling_history_minutes);
+DECLARE_int32(ws_cpu_profile_max_samples);
+
+namespace nebula {
+
+// Call stacks from the root frame to the leaf one, and their counts or bytes
+using StackCounts = std::map<std::vector<uintptr_t>, int64_t>;
+
+/**
+ * @brief Print the stacks in the folded format of the flame graph tools, "root;...;leaf count" in
+ * each line, the frames are symbolized by the dynamic symbols of the process, the ones without
+ * a symbol are printed as `binary+0xoffset` for addr2line.
+ *
+ * @param base If it's given, print "root;...;leaf base_count count" of the stacks changed, which
+ * is the format of a differential flame graph
+ */
+std::string foldStacks(const StackCounts& stacks, const StackCounts* base = nullptr);
+
+/**
+ * @brief CpuProfiler samples the call stacks of the process by the SIGPROF of ITIMER_PROF, which
+ * ticks on the cpu time of all the threads, so the idle threads are not sampled.
+ *
+ * The samples are kept in a ring of --ws_cpu_profile_max_samples, preallocated at the first start,
+ * the signal handler only takes a slot of it and fills the frames walked by libunwind in. It runs
+ * in two modes:
+ *   1. Always-on at --ws_cpu_sampling_hz, started with the web service when it's positive. A low
+ *      rate, e.g. 10, costs little, and the ring keeps the samples of the last minutes.
+ *   2. A session of a time-boxed profile, which takes the samples at a higher rate for a while.
+ * Only one session runs at a time, the rate of the timer is the higher one of the two.
+ */
+class CpuProfiler final {
+ public:
+  static CpuProfiler& instance();
+
+  ~CpuProfiler() = default;
+
+  /**
+   * @brief Start the always-on sampling at hz
+   */
+  Status start(int32_t hz);
+
+  // Stop the always-on sampling, a running session goes on
+  void stop();
+
+  /**
+   * @brief Begin a session sampling at hz at least
+   *
+   * @return Error if another session is running
+   */
+  Status beginSession(int32_t hz);
+
+  void endSession();
+
+  /**
+   * @brief The stacks of the samples taken in [fromMs, toMs] of the steady clock
+   */
+  StackCounts stacks(int64_t fromMs, int64_t toMs) const;
+
+  static int64_t nowInMs();
+
+ private:
+  static constexpr int32_t kMaxFrames = 48;
+  // The frames of record(), the signal handler and the signal trampoline
+  static constexpr int32_t kSkippedFrames = 3;
+
+  struct Sample {
+    // 0 when it's being written, or the sequence of the sample plus 1
+    std::atomic<uint64_t> seq{0};
+    int64_t timeInMs{0};
+    int32_t depth{0};
+    void* frames[kMaxFrames];
+  };
+
+  CpuProfiler() = default;
+
+  static void onSignal(int sig, siginfo_t* info, void* context);
+
+  FOLLY_NOINLINE void record();
+
+  Status init();
+
+  // Set the timer by the rates of the always-on sampling and the session, 0 stops it
+  void resetTimer();
+
+  mutable std::mutex lock_;
+  bool inited_{false};
+  int32_t hz_{0};
+  int32_t sessionHz_{0};
+  std::unique_ptr<Sample[]> samples_;
+  size_t capacity_{0};
+  std::atomic<uint64_t> next_{0};
+};
+
+}  // namespace nebula
+#endif  // WEBSERVICE_CPUPROFILER_H_
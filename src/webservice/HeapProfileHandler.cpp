@@ -0,0 +1,101 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "webservice/HeapProfileHandler.h"
+
+#include <folly/executors/GlobalExecutor.h>
+#include <folly/io/async/EventBaseManager.h>
+#include <proxygen/httpserver/ResponseBuilder.h>
+#include <proxygen/lib/http/ProxygenErrorEnum.h>
+
+#include "webservice/HeapProfiler.h"
+
+namespace nebula {
+
+using proxygen::HTTPMessage;
+using proxygen::HTTPMethod;
+using proxygen::ProxygenError;
+using proxygen::ResponseBuilder;
+using proxygen::UpgradeProtocol;
+
+void HeapProfileHandler::onRequest(std::unique_ptr<HTTPMessage> headers) noexcept {
+  if (!headers->getMethod() || headers->getMethod().value() != HTTPMethod::GET) {
+    // Unsupported method
+    err_ = HttpCode::E_UNSUPPORTED_METHOD;
+    return;
+  }
+
+  if (headers->hasQueryParam("diff")) {
+    diff_ = (headers->getQueryParam("diff") == "true");
+  }
+}
+
+void HeapProfileHandler::onBody(std::unique_ptr<folly::IOBuf>) noexcept {
+  // Do nothing, we only support GET
+}
+
+void HeapProfileHandler::onEOM() noexcept {
+  switch (err_) {
+    case HttpCode::E_UNSUPPORTED_METHOD:
+      ResponseBuilder(downstream_)
+          .status(WebServiceUtils::to(HttpStatusCode::METHOD_NOT_ALLOWED),
+                  WebServiceUtils::toString(HttpStatusCode::METHOD_NOT_ALLOWED))
+          .sendWithEOM();
+      return;
+    default:
+      break;
+  }
+
+  // The dump and the symbolization take a while, so they are done in a worker, and the response
+  // is sent back in the event base of the request
+  auto* evb = folly::EventBaseManager::get()->getEventBase();
+  folly::via(folly::getGlobalCPUExecutor())
+      .thenValue([diff = diff_](auto&&) -> StatusOr<std::pair<std::string, std::string>> {
+        StackCounts base;
+        std::string path;
+        auto stacks = HeapProfiler::instance().dumpStacks(&base, &path);
+        NG_RETURN_IF_ERROR(stacks);
+        return std::make_pair(std::move(path), foldStacks(stacks.value(), diff ? &base : nullptr));
+      })
+      .via(evb)
+      .thenValue([this, alive = alive_](StatusOr<std::pair<std::string, std::string>> profile) {
+        if (!*alive) {
+          return;
+        }
+        if (!profile.ok()) {
+          ResponseBuilder(downstream_)
+              .status(WebServiceUtils::to(HttpStatusCode::FORBIDDEN),
+                      WebServiceUtils::toString(HttpStatusCode::FORBIDDEN))
+              .body(profile.status().toString())
+              .sendWithEOM();
+          return;
+        }
+        auto& [path, folded] = profile.value();
+        ResponseBuilder(downstream_)
+            .status(WebServiceUtils::to(HttpStatusCode::OK),
+                    WebServiceUtils::toString(HttpStatusCode::OK))
+            .header("Content-Type", "text/plain")
+            .header("X-Heap-Profile", path)
+            .body(std::move(folded))
+            .sendWithEOM();
+      });
+}
+
+void HeapProfileHandler::onUpgrade(UpgradeProtocol) noexcept {
+  // Do nothing
+}
+
+void HeapProfileHandler::requestComplete() noexcept {
+  *alive_ = false;
+  delete this;
+}
+
+void HeapProfileHandler::onError(ProxygenError err) noexcept {
+  LOG(ERROR) << "Web service HeapProfileHandler got error: " << proxygen::getErrorString(err);
+  *alive_ = false;
+  delete this;
+}
+
+}  // namespace nebula
@@ -0,0 +1,49 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef WEBSERVICE_HEAPPROFILEHANDLER_H_
+#define WEBSERVICE_HEAPPROFILEHANDLER_H_
+
+#include <proxygen/httpserver/RequestHandler.h>
+
+#include "common/base/Base.h"
+#include "webservice/Common.h"
+
+namespace nebula {
+
+/**
+ * @brief Dump the heap profile of jemalloc, and serve the live bytes of each stack in the folded
+ * format of the flame graph tools, the path of the dump for jeprof is in the header
+ * X-Heap-Profile.
+ *
+ *   GET /profile/heap
+ *   GET /profile/heap?diff=true responds the bytes of the stacks changed since the last dump, as
+ *   "stack bytes_before bytes_now" for a differential flame graph.
+ */
+class HeapProfileHandler : public proxygen::RequestHandler {
+ public:
+  HeapProfileHandler() = default;
+
+  void onRequest(std::unique_ptr<proxygen::HTTPMessage> headers) noexcept override;
+
+  void onBody(std::unique_ptr<folly::IOBuf> body) noexcept override;
+
+  void onEOM() noexcept override;
+
+  void onUpgrade(proxygen::UpgradeProtocol proto) noexcept override;
+
+  void requestComplete() noexcept override;
+
+  void onError(proxygen::ProxygenError err) noexcept override;
+
+ private:
+  HttpCode err_{HttpCode::SUCCEEDED};
+  bool diff_{false};
+  // Cleared when the handler is deleted before the profile is done
+  std::shared_ptr<bool> alive_{std::make_shared<bool>(true)};
+};
+
+}  // namespace nebula
+#endif  // WEBSERVICE_HEAPPROFILEHANDLER_H_
@@ -0,0 +1,142 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "webservice/HeapProfiler.h"
+
+#include <folly/FileUtil.h>
+#include <folly/String.h>
+
+#if ENABLE_JEMALLOC
+#include <jemalloc/jemalloc.h>
+#endif
+
+#include "common/fs/FileUtils.h"
+#include "common/time/WallClock.h"
+
+DEFINE_string(ws_heap_profile_dir, "/tmp", "The directory to keep the heap profiles dumped");
+
+namespace nebula {
+
+// static
+HeapProfiler& HeapProfiler::instance() {
+  static HeapProfiler profiler;
+  return profiler;
+}
+
+StatusOr<std::string> HeapProfiler::dump() {
+#if ENABLE_JEMALLOC
+  bool active = false;
+  size_t len = sizeof(active);
+  if (mallctl("prof.active", &active, &len, nullptr, 0) != 0 || !active) {
+    return Status::Error(
+        "The heap profiling is not active, start the process with "
+        "MALLOC_CONF=\"prof:true,prof_active:true\"");
+  }
+  if (!fs::FileUtils::exist(FLAGS_ws_heap_profile_dir) &&
+      !fs::FileUtils::makeDir(FLAGS_ws_heap_profile_dir)) {
+    return Status::Error("Failed to create the directory %s", FLAGS_ws_heap_profile_dir.c_str());
+  }
+  auto path = folly::sformat("{}/heap.{}.{}.{}.prof",
+                             FLAGS_ws_heap_profile_dir,
+                             getpid(),
+                             time::WallClock::fastNowInSec(),
+                             ++seq_);
+  const char* file = path.c_str();
+  if (mallctl("prof.dump", nullptr, nullptr, &file, sizeof(file)) != 0) {
+    return Status::Error("Failed to dump the heap profile to %s", file);
+  }
+  dumps_.emplace_back(path);
+  while (dumps_.size() > kMaxDumps) {
+    fs::FileUtils::remove(dumps_.front().c_str());
+    dumps_.pop_front();
+  }
+  return path;
+#else
+  return Status::Error("The heap profile is only supported with jemalloc");
+#endif
+}
+
+StatusOr<StackCounts> HeapProfiler::dumpStacks(StackCounts* base, std::string* path) {
+  std::lock_guard<std::mutex> guard(lock_);
+  auto file = dump();
+  NG_RETURN_IF_ERROR(file);
+  std::string content;
+  if (!folly::readFile(file.value().c_str(), content)) {
+    return Status::Error("Failed to read the heap profile %s", file.value().c_str());
+  }
+  auto stacks = parse(content);
+  NG_RETURN_IF_ERROR(stacks);
+  if (base != nullptr) {
+    *base = std::move(last_);
+  }
+  if (path != nullptr) {
+    *path = file.value();
+  }
+  last_ = stacks.value();
+  return stacks;
+}
+
+// static
+StatusOr<StackCounts> HeapProfiler::parse(const std::string& content) {
+  // heap_v2/<sample period>
+  //   t*: <objects>: <bytes> [<objects>: <bytes>]    of all the threads
+  //   t<n>: ...                                      of each thread
+  // @ <frame> <frame> ...                            from the leaf to the root
+  //   t*: <objects>: <bytes> [<objects>: <bytes>]    live ones of the stack
+  //   t<n>: ...
+  // MAPPED_LIBRARIES:
+  std::vector<folly::StringPiece> lines;
+  folly::split('\n', content, lines);
+  if (lines.empty() || !lines[0].startsWith("heap_v2/")) {
+    return Status::Error("Unknown format of the heap profile");
+  }
+  auto period = folly::tryTo<double>(lines[0].subpiece(strlen("heap_v2/")));
+  if (!period.hasValue() || period.value() <= 0) {
+    return Status::Error("Invalid sample period of the heap profile");
+  }
+
+  StackCounts stacks;
+  std::vector<uintptr_t> frames;
+  for (auto line : lines) {
+    if (line.startsWith("MAPPED_LIBRARIES")) {
+      break;
+    }
+    if (line.startsWith("@")) {
+      std::vector<folly::StringPiece> tokens;
+      folly::split(' ', line.subpiece(1), tokens, true);
+      frames.clear();
+      for (auto iter = tokens.rbegin(); iter != tokens.rend(); ++iter) {
+        auto token = iter->str();
+        char* end = nullptr;
+        auto frame = strtoull(token.c_str(), &end, 16);
+        if (end == token.c_str() || *end != '\0') {
+          return Status::Error("Invalid frame of the heap profile: %s", token.c_str());
+        }
+        frames.emplace_back(frame);
+      }
+      continue;
+    }
+    auto trimmed = folly::trimWhitespace(line);
+    if (frames.empty() || !trimmed.startsWith("t*:")) {
+      continue;
+    }
+    int64_t objects = 0;
+    int64_t bytes = 0;
+    if (sscanf(trimmed.str().c_str(), "t*: %ld: %ld", &objects, &bytes) != 2) {
+      return Status::Error("Invalid line of the heap profile: %s", trimmed.str().c_str());
+    }
+    if (objects > 0 && bytes > 0) {
+      // Each allocation of the average size is sampled with the probability of
+      // 1 - exp(-size / period)
+      auto ratio = static_cast<double>(bytes) / objects / period.value();
+      auto scale = 1 / (1 - std::exp(-ratio));
+      stacks[frames] += static_cast<int64_t>(bytes * scale);
+    }
+    frames.clear();
+  }
+  return stacks;
+}
+
+}  // namespace nebula
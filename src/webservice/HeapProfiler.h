@@ -0,0 +1,63 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef WEBSERVICE_HEAPPROFILER_H_
+#define WEBSERVICE_HEAPPROFILER_H_
+
+#include "common/base/Base.h"
+#include "common/base/StatusOr.h"
+#include "webservice/CpuProfiler.h"
+
+DECLARE_string(ws_heap_profile_dir);
+
+namespace nebula {
+
+/**
+ * @brief HeapProfiler dumps the heap profiles of jemalloc, which samples the allocations when the
+ * process is started with MALLOC_CONF="prof:true".
+ *
+ * The dumps are kept under --ws_heap_profile_dir for jeprof, the last few of them only. The live
+ * bytes of each stack of a dump are also served in the folded format, or the change of them since
+ * the last dump, to see the growth of the heap between two dumps.
+ */
+class HeapProfiler final {
+ public:
+  static HeapProfiler& instance();
+
+  /**
+   * @brief Dump the heap profile to a file
+   *
+   * @return The path of the file, or error if the heap profiling of jemalloc is not active
+   */
+  StatusOr<std::string> dump();
+
+  /**
+   * @brief Dump the heap profile, and return the live bytes of each stack in it
+   *
+   * @param base Set to the stacks of the last dump if it's not null, empty if there isn't one
+   * @param path Set to the path of the dump if it's not null
+   */
+  StatusOr<StackCounts> dumpStacks(StackCounts* base, std::string* path);
+
+  /**
+   * @brief Parse a heap profile of jemalloc into the live bytes of each stack, scaled up from the
+   * sampled ones in the way of jeprof.
+   */
+  static StatusOr<StackCounts> parse(const std::string& content);
+
+ private:
+  // The dumps kept on the disk
+  static constexpr size_t kMaxDumps = 10;
+
+  HeapProfiler() = default;
+
+  std::mutex lock_;
+  int64_t seq_{0};
+  std::deque<std::string> dumps_;
+  StackCounts last_;
+};
+
+}  // namespace nebula
+#endif  // WEBSERVICE_HEAPPROFILER_H_
@@ -10,8 +10,11 @@
 #include <proxygen/httpserver/RequestHandlerFactory.h>
 
 #include "common/thread/NamedThread.h"
+#include "webservice/CpuProfileHandler.h"
+#include "webservice/CpuProfiler.h"
 #include "webservice/GetFlagsHandler.h"
 #include "webservice/GetStatsHandler.h"
+#include "webservice/HeapProfileHandler.h"
 #include "webservice/NotFoundHandler.h"
 #include "webservice/Router.h"
 #include "webservice/SetFlagsHandler.h"
@@ -87,6 +90,21 @@ Status WebService::start(uint16_t httpPort) {
     DCHECK(params.empty());
     return new StatusHandler();
   });
+  router().get("/profile/cpu").handler([](web::PathParams&& params) {
+    DCHECK(params.empty());
+    return new CpuProfileHandler();
+  });
+  router().get("/profile/heap").handler([](web::PathParams&& params) {
+    DCHECK(params.empty());
+    return new HeapProfileHandler();
+  });
+
+  if (FLAGS_ws_cpu_sampling_hz > 0) {
+    auto status = CpuProfiler::instance().start(FLAGS_ws_cpu_sampling_hz);
+    if (!status.ok()) {
+      LOG(ERROR) << "Failed to start the cpu sampling: " << status;
+    }
+  }
 
   started_ = true;
 
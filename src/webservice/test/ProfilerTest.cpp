@@ -0,0 +1,101 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include <folly/init/Init.h>
+#include <gtest/gtest.h>
+
+#include "common/base/Base.h"
+#include "webservice/CpuProfiler.h"
+#include "webservice/HeapProfiler.h"
+
+namespace nebula {
+
+TEST(ProfilerTest, FoldStacks) {
+  // The frames out of any binary are printed as the addresses
+  StackCounts base = {{{0x1, 0x2}, 10}, {{0x1, 0x3}, 5}};
+  StackCounts stacks = {{{0x1, 0x2}, 30}, {{0x1, 0x4}, 7}};
+  EXPECT_EQ("0x1;0x2 30\n0x1;0x4 7\n", foldStacks(stacks));
+  EXPECT_EQ("0x1;0x2 10 30\n0x1;0x4 0 7\n0x1;0x3 5 0\n", foldStacks(stacks, &base));
+  EXPECT_EQ("", foldStacks(stacks, &stacks));
+}
+
+TEST(ProfilerTest, ParseHeapProfile) {
+  std::string content =
+      "heap_v2/524288\n"
+      "  t*: 3: 2097664 [0: 0]\n"
+      "  t0: 3: 2097664 [0: 0]\n"
+      "@ 0x30 0x20 0x10\n"
+      "  t*: 1: 1048576 [0: 0]\n"
+      "  t0: 1: 1048576 [0: 0]\n"
+      "@ 0x40 0x10\n"
+      "  t*: 0: 0 [0: 0]\n"
+      "@ 0x50 0x10\n"
+      "  t*: 2: 1049088 [0: 0]\n"
+      "\n"
+      "MAPPED_LIBRARIES:\n"
+      "00400000-00401000 r-xp 00000000 08:01 1 /usr/bin/nebula-graphd\n";
+  auto result = HeapProfiler::parse(content);
+  ASSERT_TRUE(result.ok()) << result.status();
+  auto& stacks = result.value();
+  ASSERT_EQ(2, stacks.size());
+  // The frames are from the root, the sampled bytes are scaled up
+  std::vector<uintptr_t> frames = {0x10, 0x20, 0x30};
+  ASSERT_EQ(1, stacks.count(frames));
+  EXPECT_EQ(static_cast<int64_t>(1048576 / (1 - std::exp(-2.0))), stacks[frames]);
+  frames = {0x10, 0x50};
+  ASSERT_EQ(1, stacks.count(frames));
+  EXPECT_LT(1049088, stacks[frames]);
+
+  EXPECT_FALSE(HeapProfiler::parse("heap_v1/524288\n").ok());
+  EXPECT_FALSE(HeapProfiler::parse("heap_v2/524288\n@ 0xzz\n  t*: 1: 1 [0: 0]\n").ok());
+}
+
+static FOLLY_NOINLINE int64_t burnCpu(int64_t ms) {
+  int64_t sum = 0;
+  auto end = CpuProfiler::nowInMs() + ms;
+  while (CpuProfiler::nowInMs() < end) {
+    for (int64_t i = 0; i < 100000; i++) {
+      sum += i * i;
+    }
+  }
+  return sum;
+}
+
+TEST(ProfilerTest, CpuSession) {
+  auto& profiler = CpuProfiler::instance();
+  auto from = CpuProfiler::nowInMs();
+  ASSERT_TRUE(profiler.beginSession(1000).ok());
+  // Only one session at a time
+  EXPECT_FALSE(profiler.beginSession(100).ok());
+  LOG(INFO) << burnCpu(500);
+  profiler.endSession();
+  auto to = CpuProfiler::nowInMs();
+
+  auto stacks = profiler.stacks(from, to);
+  ASSERT_FALSE(stacks.empty());
+  int64_t samples = 0;
+  for (const auto& [frames, count] : stacks) {
+    EXPECT_FALSE(frames.empty());
+    samples += count;
+  }
+  EXPECT_LT(0, samples);
+  EXPECT_FALSE(foldStacks(stacks).empty());
+  // Nothing is sampled out of the window
+  EXPECT_TRUE(profiler.stacks(0, from - 1).empty());
+
+  EXPECT_TRUE(profiler.beginSession(100).ok());
+  profiler.endSession();
+  EXPECT_FALSE(profiler.beginSession(0).ok());
+}
+
+}  // namespace nebula
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  folly::init(&argc, &argv, true);
+  google::SetStderrLogging(google::INFO);
+
+  return RUN_ALL_TESTS();
+}
@@ -31,10 +31,12 @@ Feature: Explain and Profile
       | EXPLAIN | dot        |
       | EXPLAIN | dot:struct |
       | EXPLAIN | tck        |
+      | EXPLAIN | json       |
       | PROFILE | row        |
       | PROFILE | dot        |
       | PROFILE | dot:struct |
       | PROFILE | tck        |
+      | PROFILE | json       |
 
   Scenario Outline: Error format
     When executing query:
@@ -0,0 +1,82 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "geometric_mean.h"
+
+#include <cmath>
+#include <vector>
+
+#include "../src/common/datatypes/List.h"
+
+extern "C" GraphFunction *create() {
+  return new geometric_mean;
+}
+extern "C" void destroy(GraphFunction *function) {
+  delete function;
+}
+extern "C" int abiVersion() {
+  return NEBULA_UDF_ABI_VERSION;
+}
+
+char *geometric_mean::name() {
+  const char *name = "geometric_mean";
+  return const_cast<char *>(name);
+}
+
+std::vector<std::vector<nebula::Value::Type>> geometric_mean::inputType() {
+  return {{nebula::Value::Type::INT}, {nebula::Value::Type::FLOAT}};
+}
+
+nebula::Value::Type geometric_mean::returnType() {
+  return nebula::Value::Type::FLOAT;
+}
+
+size_t geometric_mean::minArity() {
+  return 1;
+}
+
+size_t geometric_mean::maxArity() {
+  return 1;
+}
+
+bool geometric_mean::isPure() {
+  return true;
+}
+
+nebula::Value geometric_mean::body(
+    const std::vector<std::reference_wrapper<const nebula::Value>> &args) {
+  // only called as an aggregate function
+  (void)args;
+  return nebula::Value::kNullBadData;
+}
+
+bool geometric_mean::isAggregate() {
+  return true;
+}
+
+// The state is [sum of the logarithms, count]
+void geometric_mean::aggregate(nebula::Value &state, const nebula::Value &arg) {
+  if (!arg.isNumeric()) {
+    return;
+  }
+  double number = arg.isInt() ? arg.getInt() : arg.getFloat();
+  if (number <= 0) {
+    return;
+  }
+  if (state.empty()) {
+    state = nebula::List({0.0, static_cast<int64_t>(0)});
+  }
+  auto &values = state.mutableList().values;
+  values[0] = values[0].getFloat() + std::log(number);
+  values[1] = values[1].getInt() + 1;
+}
+
+nebula::Value geometric_mean::result(const nebula::Value &state) {
+  if (state.empty()) {
+    return nebula::Value::kNullValue;
+  }
+  const auto &values = state.getList().values;
+  return std::exp(values[0].getFloat() / values[1].getInt());
+}
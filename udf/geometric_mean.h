@@ -0,0 +1,44 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef UDF_PROJECT_GEOMETRIC_MEAN_H
+#define UDF_PROJECT_GEOMETRIC_MEAN_H
+
+#include "../src/common/function/GraphFunction.h"
+
+// Example of an aggregate UDF that calculates the geometric mean of the positive numbers of a
+// group, which needs the UDF ABI version 2.
+// > GO FROM "player100" OVER follow YIELD properties(edge).degree AS d
+//     | YIELD geometric_mean($-.d)
+// +----------------------+
+// | geometric_mean($-.d) |
+// +----------------------+
+// | 92.4662120845        |
+// +----------------------+
+
+class geometric_mean : public GraphFunction {
+ public:
+  char *name() override;
+
+  std::vector<std::vector<nebula::Value::Type>> inputType() override;
+
+  nebula::Value::Type returnType() override;
+
+  size_t minArity() override;
+
+  size_t maxArity() override;
+
+  bool isPure() override;
+
+  nebula::Value body(const std::vector<std::reference_wrapper<const nebula::Value>> &args) override;
+
+  bool isAggregate() override;
+
+  void aggregate(nebula::Value &state, const nebula::Value &arg) override;
+
+  nebula::Value result(const nebula::Value &state) override;
+};
+
+#endif  // UDF_PROJECT_GEOMETRIC_MEAN_H
@@ -16,6 +16,9 @@ extern "C" GraphFunction *create() {
 extern "C" void destroy(GraphFunction *function) {
   delete function;
 }
+extern "C" int abiVersion() {
+  return NEBULA_UDF_ABI_VERSION;
+}
 
 char *standard_deviation::name() {
   const char *name = "standard_deviation";